@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include "graphics/Model.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <atomic>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    // 同步读取网格并解码全部纹理（Upload 之前的CPU部分）
+    size_t LoadModelCpu(const std::string& objPath) {
+        graphics::ModelData data = graphics::Model::LoadData(objPath);
+        size_t bytes = 0;
+        for (const auto& path : data.GetTexturePaths()) {
+            if (fs::exists(path)) bytes += graphics::ImageData::LoadFromFile(path).GetByteSize();
+        }
+        return bytes;
+    }
+
+} // namespace
+
+    void RunAsyncLoad() {
+        std::vector<std::string> models;
+        for (const char* relative : ShippedModels()) {
+            std::string path = PathResolver::Resolve(relative);
+            if (fs::exists(path)) models.push_back(path);
+        }
+
+        core::JobSystem::Initialize();
+        size_t serialBytes = 0;
+        double serialMs = MeasureMs([&] {
+            serialBytes = 0;
+            for (const auto& path : models) serialBytes += LoadModelCpu(path);
+        }, 3);
+
+        size_t parallelBytes = 0;
+        // 与 ResourceManager 相同的拆分：网格与每张纹理各自作为独立的后台任务，网格任务读取完成后提交纹理解码任务
+        double parallelMs = MeasureMs([&] {
+            std::atomic<size_t> bytes{0};
+            core::JobCounter loads;
+            for (const auto& path : models) {
+                core::JobSystem::RunBackground([path, &bytes, &loads] {
+                    for (const auto& texture : graphics::Model::LoadData(path).GetTexturePaths()) {
+                        if (!fs::exists(texture)) continue;
+                        core::JobSystem::RunBackground([texture, &bytes] {
+                            bytes += graphics::ImageData::LoadFromFile(texture).GetByteSize();
+                        }, &loads);
+                    }
+                }, &loads);
+            }
+            core::JobSystem::Wait(loads);
+            parallelBytes = bytes;
+        }, 3);
+
+        std::printf("%zu models, %.1f MB decoded texels, %zu worker threads\n",
+                    models.size(), serialBytes / (1024.0 * 1024.0), core::JobSystem::GetThreadCount() - 1);
+        std::printf("serial   %10.1f ms\n", serialMs);
+        std::printf("parallel %10.1f ms (%.2fx)%s\n", parallelMs, serialMs / parallelMs,
+                    parallelBytes == serialBytes ? "" : "  [MISMATCH]");
+    }
+
+} // namespace bench
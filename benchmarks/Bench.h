@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace bench {
+
+    /**
+     * @brief 重复执行 fn，返回单次耗时的中位数（毫秒）
+     */
+    template <typename Fn>
+    double MeasureMs(Fn&& fn, int iterations = 5) {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    /// 已发布OBJ模型（相对项目根目录）
+    inline const std::vector<const char*>& ShippedModels() {
+        static const std::vector<const char*> models = {
+            "assets/objects/nanosuit/nanosuit.obj",
+            "assets/objects/cyborg/cyborg.obj",
+            "assets/objects/planet/planet.obj",
+            "assets/objects/rock/rock.obj",
+        };
+        return models;
+    }
+
+    // 各基准入口
+    void RunObjLoad();
+    void RunMeshCache();
+    void RunAsyncLoad();
+    void RunTextureCompress();
+    void RunMipGen();
+    void RunCook();
+    void RunVfs();
+    void RunVertexCache();
+    void RunVertexQuant();
+    void RunMeshlet();
+    void RunLod();
+    void RunTextureCache();
+    void RunShader();
+    void RunTransform();
+    void RunSceneGraph();
+    void RunFrustum();
+    void RunSpatial();
+    void RunOcclusion();
+    void RunPicking();
+    void RunSceneFile();
+    void RunJobs();
+    void RunCommands();
+    void RunRenderQueue();
+
+} // namespace bench
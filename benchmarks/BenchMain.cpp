@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+    struct BenchEntry {
+        const char* name;
+        void (*run)();
+    };
+
+    const BenchEntry kBenches[] = {
+        {"objload", bench::RunObjLoad},
+        {"meshcache", bench::RunMeshCache},
+        {"asyncload", bench::RunAsyncLoad},
+        {"texcompress", bench::RunTextureCompress},
+        {"mipgen", bench::RunMipGen},
+        {"cook", bench::RunCook},
+        {"vfs", bench::RunVfs},
+        {"vcache", bench::RunVertexCache},
+        {"vquant", bench::RunVertexQuant},
+        {"meshlet", bench::RunMeshlet},
+        {"lod", bench::RunLod},
+        {"texcache", bench::RunTextureCache},
+        {"shader", bench::RunShader},
+        {"transform", bench::RunTransform},
+        {"scenegraph", bench::RunSceneGraph},
+        {"frustum", bench::RunFrustum},
+        {"spatial", bench::RunSpatial},
+        {"occlusion", bench::RunOcclusion},
+        {"picking", bench::RunPicking},
+        {"scenefile", bench::RunSceneFile},
+        {"jobs", bench::RunJobs},
+        {"commands", bench::RunCommands},
+        {"renderqueue", bench::RunRenderQueue},
+    };
+
+} // namespace
+
+// 用法：RrenderBench [名称...]，不带参数时运行全部基准
+int main(int argc, char** argv) {
+    bool ranAny = false;
+    for (const auto& entry : kBenches) {
+        bool selected = argc <= 1;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], entry.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        std::cout << "==== " << entry.name << " ====" << std::endl;
+        try {
+            entry.run();
+        } catch (const std::exception& e) {
+            std::cerr << "[Bench Error] " << entry.name << ": " << e.what() << std::endl;
+            return -1;
+        }
+        ranAny = true;
+    }
+
+    if (!ranAny) {
+        std::cerr << "Unknown benchmark. Available:";
+        for (const auto& entry : kBenches) std::cerr << " " << entry.name;
+        std::cerr << std::endl;
+        return -1;
+    }
+    return 0;
+}
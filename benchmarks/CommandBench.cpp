@@ -0,0 +1,157 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include "graphics/MeshOptimizer.h"
+#include "graphics/Meshlet.h"
+#include "graphics/ObjParser.h"
+#include "graphics/RenderCommand.h"
+#include "utils/PathResolver.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    /// 一个实体的录制：与 Model::Record / Mesh::Record 相同的命令序列（网格只有CPU数据，VAO 为虚构的编号）
+    void RecordEntity(graphics::CommandBuffer& buffer, const std::vector<graphics::MeshData>& meshes,
+                      const glm::mat4& viewProjection, const glm::vec3& eye, const glm::vec3& front,
+                      const glm::mat4& model) {
+        const auto view = graphics::MeshletCullView::Create(viewProjection, model, eye, front, false);
+        buffer.SetDrawData(model);
+        const unsigned int textures[3] = {1, 2, 0};
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            buffer.BindMaterial(textures, 3);
+            graphics::DrawCommand command{};
+            command.vao = static_cast<uint32_t>(m + 1);
+            command.indexCount = static_cast<uint32_t>(meshes[m].indices.size());
+            auto& drawList = buffer.GetCullScratch();
+            auto& stats = buffer.GetMeshletStats();
+            const size_t visibleBefore = stats.visibleTriangles;
+            graphics::MeshletCuller::Cull(meshes[m].meshlets.data(), meshes[m].meshlets.size(), view, drawList, stats);
+            if (drawList.counts.empty()) continue;
+            command.triangles = static_cast<uint32_t>(stats.visibleTriangles - visibleBefore);
+            buffer.Draw(command, &drawList);
+        }
+    }
+
+    /// 不调用GL的回放：解码全部命令并累加绘制参数，衡量单个提交线程的解码与分发开销
+    size_t NullSubmit(const graphics::CommandList& list, uint64_t& checksum) {
+        size_t draws = 0;
+        for (size_t b = 0; b < list.GetBufferCount(); ++b) {
+            list.GetBuffer(b).ForEach([&](const graphics::RenderCommandHeader& header) {
+                switch (header.type) {
+                    case graphics::RenderCommandType::BindPipeline:
+                        checksum += reinterpret_cast<const graphics::BindPipelineCommand&>(header).program;
+                        break;
+                    case graphics::RenderCommandType::BindMaterial: {
+                        const auto& command = reinterpret_cast<const graphics::BindMaterialCommand&>(header);
+                        for (uint32_t i = 0; i < command.textureCount; ++i) checksum += command.textures[i];
+                        break;
+                    }
+                    case graphics::RenderCommandType::SetDrawData:
+                        checksum += static_cast<uint64_t>(
+                            reinterpret_cast<const graphics::SetDrawDataCommand&>(header).model[3][0]);
+                        break;
+                    case graphics::RenderCommandType::Draw: {
+                        const auto& command = reinterpret_cast<const graphics::DrawCommand&>(header);
+                        const GLsizei* counts = command.GetCounts();
+                        for (uint32_t i = 0; i < command.rangeCount; ++i) checksum += static_cast<uint64_t>(counts[i]);
+                        ++draws;
+                        break;
+                    }
+                }
+            });
+        }
+        return draws;
+    }
+
+    /// 按段的顺序拼接全部命令字节，与串行录制的结果逐字节比较（每段开头的 BindPipeline 数量随分段变化，不计入）
+    std::vector<uint8_t> Flatten(const graphics::CommandList& list) {
+        std::vector<uint8_t> bytes;
+        for (size_t b = 0; b < list.GetBufferCount(); ++b) {
+            list.GetBuffer(b).ForEach([&](const graphics::RenderCommandHeader& header) {
+                if (header.type == graphics::RenderCommandType::BindPipeline) return;
+                const auto* begin = reinterpret_cast<const uint8_t*>(&header);
+                bytes.insert(bytes.end(), begin, begin + header.size);
+            });
+        }
+        return bytes;
+    }
+
+} // namespace
+
+    void RunCommands() {
+        constexpr size_t kEntities = 20000;
+
+        const std::string path = PathResolver::Resolve("assets/objects/rock/rock.obj");
+        if (!fs::exists(path)) {
+            std::printf("missing %s\n", path.c_str());
+            return;
+        }
+        graphics::ObjData obj = graphics::ObjParser::Parse(path);
+        std::vector<graphics::MeshData> meshes = graphics::ObjParser::BuildMeshes(obj);
+        graphics::MeshOptimizer::OptimizeMeshes(meshes);
+        graphics::MeshletBuilder::BuildMeshes(meshes, 1);
+
+        // 实体铺成 200 x 100 的网格，相机位于中央斜向下看，约一半在视锥内（这里不做实体级剔除，全部录制）
+        std::vector<glm::mat4> models(kEntities);
+        for (size_t i = 0; i < kEntities; ++i) {
+            const float x = static_cast<float>(i % 200) * 3.0f - 300.0f;
+            const float z = static_cast<float>(i / 200) * 3.0f - 150.0f;
+            models[i] = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, z)),
+                                    static_cast<float>(i) * 0.37f, glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        const glm::vec3 eye(0.0f, 20.0f, 0.0f), front = glm::normalize(glm::vec3(0.3f, -0.4f, 1.0f));
+        const glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+                                         glm::lookAt(eye, eye + front, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        graphics::CommandList list;
+        const auto record = [&](graphics::CommandBuffer& buffer, size_t begin, size_t end) {
+            buffer.BindPipeline(7, 0);
+            for (size_t i = begin; i < end; ++i) RecordEntity(buffer, meshes, viewProjection, eye, front, models[i]);
+        };
+
+        const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<size_t> threadCounts;
+        // JobSystem 的后台线程不超过硬件线程数，更多线程的行与前一行相同
+        for (size_t t = 1; t <= std::max(4u, hw) && t <= hw + 1; t *= 2) threadCounts.push_back(t);
+        if (threadCounts.back() != hw && hw > 4) threadCounts.push_back(hw);
+
+        std::printf("%zu entities x %zu submeshes, %u hardware threads; submit = decode on one thread without GL\n",
+                    kEntities, meshes.size(), hw);
+        std::printf("%7s %8s %10s %12s %8s %10s %12s %9s\n", "threads", "buffers", "record ms", "draws/ms", "speedup",
+                    "submit ms", "draws/ms", "B/draw");
+        std::vector<uint8_t> reference;
+        double baselineMs = 0.0;
+        for (size_t threads : threadCounts) {
+            core::JobSystem::Shutdown();
+            core::JobSystem::Initialize(threads - 1);
+
+            // 单线程时分成一段，即顺序录制
+            const size_t sliceSize = threads == 1 ? kEntities : 0;
+            const double recordMs = MeasureMs([&] { list.Record(kEntities, record, sliceSize); });
+            const size_t draws = list.GetDrawCount();
+
+            uint64_t checksum = 0;
+            size_t submitted = 0;
+            const double submitMs = MeasureMs([&] { submitted = NullSubmit(list, checksum); });
+
+            const std::vector<uint8_t> bytes = Flatten(list);
+            if (threads == 1) {
+                reference = bytes;
+                baselineMs = recordMs;
+            }
+            const bool identical = bytes == reference && submitted == draws;
+            std::printf("%7zu %8zu %10.2f %12.0f %7.2fx %10.3f %12.0f %9.1f%s\n", threads, list.GetBufferCount(),
+                        recordMs, draws / recordMs, baselineMs / recordMs, submitMs, draws / submitMs,
+                        static_cast<double>(list.GetByteSize()) / std::max<size_t>(draws, 1),
+                        identical ? "" : "  MISMATCH");
+        }
+        core::JobSystem::Shutdown();
+    }
+
+} // namespace bench
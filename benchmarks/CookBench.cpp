@@ -0,0 +1,44 @@
+#include "Bench.h"
+#include "resource/AssetCooker.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    void PrintStats(const char* label, const core::AssetCooker::Stats& stats) {
+        std::printf("%-14s %8zu %8zu %8zu %10.1f %10.1f %10.1f\n", label, stats.cooked, stats.upToDate, stats.rehashed,
+                    stats.inputBytes / (1024.0 * 1024.0), stats.outputBytes / (1024.0 * 1024.0), stats.totalMs);
+    }
+
+} // namespace
+
+    void RunCook() {
+        // 使用独立的依赖数据库，不影响项目根目录下的烘焙状态
+        core::AssetCooker::Options options;
+        options.roots = {PathResolver::Resolve("assets"), PathResolver::Resolve("shaders")};
+        options.databasePath = (fs::temp_directory_path() / "rrender_cook_bench.db").string();
+
+        std::printf("%-14s %8s %8s %8s %10s %10s %10s\n", "run", "cooked", "skipped", "rehashed", "in MB", "out MB", "ms");
+        options.force = true;
+        PrintStats("full", core::AssetCooker::Run(options));
+        options.force = false;
+        PrintStats("incremental", core::AssetCooker::Run(options));
+
+        // 修改时间变化但内容不变：只重新计算哈希
+        const fs::path shaderDir = PathResolver::Resolve("shaders");
+        for (const auto& entry : fs::recursive_directory_iterator(shaderDir)) {
+            core::AssetKind kind;
+            if (entry.is_regular_file() && core::AssetCooker::Classify(entry.path().string(), kind))
+                fs::last_write_time(entry.path(), fs::file_time_type::clock::now());
+        }
+        PrintStats("touch shaders", core::AssetCooker::Run(options));
+
+        fs::remove(options.databasePath);
+    }
+
+} // namespace bench
@@ -0,0 +1,68 @@
+#include "Bench.h"
+#include "graphics/Frustum.h"
+#include "scene/TransformSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+    void RunFrustum() {
+        using graphics::BoundingBox;
+        using graphics::Frustum;
+        using graphics::FrustumCuller;
+        constexpr size_t kCount = 100000;
+
+        // 随机分布在 400 x 400 x 400 空间中的实体，模型包围盒为单位立方体附近的随机盒
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> pos(-200.0f, 200.0f), angle(-180.0f, 180.0f), size(0.2f, 3.0f);
+        std::vector<BoundingBox> localBoxes(kCount);
+        std::vector<glm::mat4> worlds(kCount);
+        for (size_t i = 0; i < kCount; ++i) {
+            const glm::vec3 half(size(rng), size(rng), size(rng));
+            localBoxes[i] = BoundingBox{-half, half};
+            worlds[i] = scene::TransformSystem::ComposeMatrix({pos(rng), pos(rng), pos(rng)},
+                                                              {angle(rng), angle(rng), angle(rng)}, glm::vec3(1.0f));
+        }
+
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 20.0f, 150.0f), glm::vec3(0.0f), glm::vec3(0, 1, 0));
+        const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+        // 变换到世界空间并按分量收集（Scene::Cull 每帧的准备工作）
+        FrustumCuller::BoxList boxes;
+        const double gatherMs = MeasureMs([&] {
+            boxes.Clear();
+            boxes.Reserve(kCount);
+            for (size_t i = 0; i < kCount; ++i) boxes.Push(localBoxes[i].Transform(worlds[i]));
+        }, 21);
+
+        std::vector<uint32_t> simdVisible, scalarVisible;
+        const double simdMs = MeasureMs([&] { FrustumCuller::Cull(frustum, boxes, simdVisible); }, 21);
+        FrustumCuller::SetSimdEnabled(false);
+        const double scalarMs = MeasureMs([&] { FrustumCuller::Cull(frustum, boxes, scalarVisible); }, 21);
+        FrustumCuller::SetSimdEnabled(true);
+
+        // 对照：逐个 BoundingBox 调用 Frustum::Intersects
+        std::vector<BoundingBox> worldBoxes(kCount);
+        for (size_t i = 0; i < kCount; ++i) worldBoxes[i] = localBoxes[i].Transform(worlds[i]);
+        std::vector<uint32_t> naiveVisible;
+        const double naiveMs = MeasureMs([&] {
+            naiveVisible.clear();
+            for (size_t i = 0; i < kCount; ++i)
+                if (frustum.Intersects(worldBoxes[i])) naiveVisible.push_back(static_cast<uint32_t>(i));
+        }, 21);
+        FrustumCuller::ResetStats();
+
+        std::printf("%zu boxes, %zu visible (%.1f%%), simd == scalar: %s, simd == per-box: %s\n", kCount,
+                    simdVisible.size(), 100.0 * simdVisible.size() / kCount,
+                    simdVisible == scalarVisible ? "yes" : "NO", simdVisible == naiveVisible ? "yes" : "NO");
+        std::printf("%-34s %10s\n", "per frame", "ms");
+        std::printf("%-34s %10.3f\n", "transform + gather boxes", gatherMs);
+        std::printf("%-34s %10.3f\n", "batch cull (SIMD)", simdMs);
+        std::printf("%-34s %10.3f\n", "batch cull (scalar)", scalarMs);
+        std::printf("%-34s %10.3f\n", "Frustum::Intersects per box", naiveMs);
+    }
+
+} // namespace bench
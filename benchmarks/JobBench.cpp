@@ -0,0 +1,139 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include "scene/TransformSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+    /// 每个元素约几十纳秒的计算量，模拟逐实体的剔除 / 动画求值
+    float Work(size_t i) {
+        float x = static_cast<float>(i) * 1e-3f;
+        for (int k = 0; k < 16; ++k) x = std::sin(x) * 0.5f + std::sqrt(x + 1.0f);
+        return x;
+    }
+
+    struct Result {
+        double forMs = 0.0;
+        double tinyUs = 0.0;      ///< 每个空任务的提交 + 执行 + 等待耗时
+        double graphMs = 0.0;
+        double transformMs = 0.0;
+        bool correct = true;
+    };
+
+} // namespace
+
+    void RunJobs() {
+        constexpr size_t kElements = 1 << 18;
+        constexpr size_t kTinyJobs = 100000;
+        constexpr size_t kGraphStages = 64, kGraphWidth = 32;
+        constexpr size_t kTransforms = 200000;
+
+        std::vector<float> expected(kElements), output(kElements);
+        for (size_t i = 0; i < kElements; ++i) expected[i] = Work(i);
+
+        // 根节点变换：每帧全部旋转，Update 的批量重算与传播经任务系统分发
+        std::vector<scene::TransformHandle> handles(kTransforms);
+        for (size_t i = 0; i < kTransforms; ++i) handles[i] = scene::TransformSystem::Create();
+        for (size_t i = 1; i < kTransforms; ++i) {
+            if (i % 4 != 0) scene::TransformSystem::SetParent(handles[i], handles[i - i % 4]);
+        }
+        int frame = 0;
+        const auto rotateAll = [&] {
+            const float angle = static_cast<float>(++frame);
+            for (const auto handle : handles) scene::TransformSystem::SetRotation(handle, glm::vec3(0.0f, angle, 0.0f));
+            scene::TransformSystem::Update();
+        };
+
+        const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<size_t> threadCounts;
+        // JobSystem 的后台线程不超过硬件线程数，更多线程的行与前一行相同
+        for (size_t t = 1; t <= std::max(4u, hw) && t <= hw + 1; t *= 2) threadCounts.push_back(t);
+        if (threadCounts.back() != hw && hw > 4) threadCounts.push_back(hw);
+
+        std::printf("%u hardware threads\n", hw);
+        std::printf("%7s %10s %8s %10s %10s %12s %8s %9s\n", "threads", "for ms", "speedup", "tiny us", "graph ms",
+                    "transform ms", "speedup", "stolen %");
+        Result baseline;
+        for (size_t threads : threadCounts) {
+            // 1 线程为不经任务系统的串行基准，其余为 1 个主线程 + threads - 1 个后台线程
+            core::JobSystem::Shutdown();
+            const bool serial = threads == 1;
+            if (!serial) core::JobSystem::Initialize(threads - 1);
+            const core::JobSystem::Stats before = core::JobSystem::GetStats();
+            Result result;
+
+            result.forMs = MeasureMs([&] {
+                const auto body = [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) output[i] = Work(i);
+                };
+                if (serial) body(0, kElements);
+                else core::JobSystem::ParallelFor(kElements, body);
+            });
+            result.correct &= output == expected;
+
+            std::atomic<size_t> executed{0};
+            const double tinyMs = MeasureMs([&] {
+                executed = 0;
+                if (serial) {
+                    for (size_t i = 0; i < kTinyJobs; ++i) executed.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                core::JobCounter counter;
+                for (size_t i = 0; i < kTinyJobs; ++i)
+                    core::JobSystem::Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                core::JobSystem::Wait(counter);
+            });
+            result.tinyUs = 1e3 * tinyMs / kTinyJobs;
+            result.correct &= executed.load() == kTinyJobs;
+
+            // 依赖图：每级 kGraphWidth 个任务，依赖上一级全部完成；每个任务检查上一级确实已全部执行
+            std::vector<std::atomic<uint32_t>> stageDone(kGraphStages);
+            result.graphMs = MeasureMs([&] {
+                for (auto& done : stageDone) done.store(0);
+                std::atomic<bool> ordered{true};
+                const auto stage = [&](size_t s) {
+                    if (s > 0 && stageDone[s - 1].load() != kGraphWidth) ordered = false;
+                    float sink = 0.0f;
+                    for (size_t i = 0; i < 200; ++i) sink += Work(i);
+                    if (sink != 0.0f) stageDone[s].fetch_add(1);
+                };
+                if (serial) {
+                    for (size_t s = 0; s < kGraphStages; ++s)
+                        for (size_t w = 0; w < kGraphWidth; ++w) stage(s);
+                } else {
+                    std::vector<core::JobCounter> counters(kGraphStages);
+                    for (size_t s = 0; s < kGraphStages; ++s) {
+                        for (size_t w = 0; w < kGraphWidth; ++w)
+                            core::JobSystem::Run([&stage, s] { stage(s); }, &counters[s], s > 0 ? &counters[s - 1] : nullptr);
+                    }
+                    core::JobSystem::Wait(counters.back());
+                }
+                result.correct &= ordered.load();
+            }, 3);
+
+            scene::TransformSystem::SetThreadCount(serial ? 1 : 0);
+            result.transformMs = MeasureMs(rotateAll, 7);
+            scene::TransformSystem::SetThreadCount(1);
+
+            const core::JobSystem::Stats after = core::JobSystem::GetStats();
+            const uint64_t jobs = after.executed - before.executed;
+            if (serial) baseline = result;
+            std::printf("%7zu %10.2f %7.2fx %10.3f %10.2f %12.2f %7.2fx %8.1f%%%s\n", threads, result.forMs,
+                        baseline.forMs / result.forMs, result.tinyUs, result.graphMs, result.transformMs,
+                        baseline.transformMs / result.transformMs,
+                        jobs > 0 ? 100.0 * static_cast<double>(after.stolen - before.stolen) / jobs : 0.0,
+                        result.correct ? "" : "  MISMATCH");
+        }
+
+        for (const auto handle : handles) scene::TransformSystem::Destroy(handle);
+        core::JobSystem::Shutdown();
+    }
+
+} // namespace bench
@@ -0,0 +1,160 @@
+#include "Bench.h"
+#include "graphics/Camera.h"
+#include "graphics/MeshOptimizer.h"
+#include "graphics/MeshSimplifier.h"
+#include "graphics/Meshlet.h"
+#include "graphics/ObjParser.h"
+#include "scene/Entity.h"
+#include "utils/PathResolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    /// 与 Model::Upload 相同的规则汇总出的模型级 LOD 信息
+    struct LodModel {
+        std::string name;
+        float scale = 1.0f;
+        std::vector<float> errors;
+        std::vector<size_t> triangles;
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+    };
+
+    LodModel Summarize(const std::string& name, float scale, const std::vector<graphics::MeshData>& meshes) {
+        LodModel model;
+        model.name = name;
+        model.scale = scale;
+        size_t levels = 1;
+        for (const auto& mesh : meshes) levels = std::max(levels, mesh.lods.size());
+        model.errors.assign(levels, 0.0f);
+        model.triangles.assign(levels, 0);
+        glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+        for (const auto& mesh : meshes) {
+            for (size_t lod = 0; lod < levels && !mesh.lods.empty(); ++lod) {
+                const auto& level = mesh.lods[std::min(lod, mesh.lods.size() - 1)];
+                model.errors[lod] = std::max(model.errors[lod], level.error);
+                model.triangles[lod] += level.indexCount / 3;
+            }
+            for (const auto& v : mesh.vertices) {
+                boundsMin = glm::min(boundsMin, v.Position);
+                boundsMax = glm::max(boundsMax, v.Position);
+            }
+        }
+        model.center = 0.5f * (boundsMin + boundsMax);
+        model.radius = 0.5f * glm::length(boundsMax - boundsMin);
+        return model;
+    }
+
+    struct FlyResult {
+        double avgTriangles = 0.0;
+        size_t minTriangles = SIZE_MAX, maxTriangles = 0;
+        size_t switches = 0;
+        double selectUs = 0.0;
+    };
+
+    // 相机沿网格中线向前飞行，逐帧为每个实例选择 LOD 并统计提交的三角形
+    FlyResult FlyThrough(const std::vector<LodModel>& models, int entityCount, bool lodEnabled, float hysteresis) {
+        constexpr int kFrames = 240;
+        const int gridSize = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(entityCount))));
+        scene::Entity::SetLodHysteresis(hysteresis);
+
+        graphics::Camera camera(graphics::Camera::ProjectionType::Perspective);
+        camera.SetAspectRatio(16.0f / 9.0f);
+        std::vector<uint32_t> lods(entityCount, 0);
+        FlyResult result;
+        double totalTriangles = 0.0, totalMs = 0.0;
+        for (int frame = 0; frame < kFrames; ++frame) {
+            camera.SetPosition(glm::vec3(0.0f, 1.5f, 5.0f - 0.35f * frame));
+            const glm::mat4 projection = camera.GetProjectionMatrix();
+            size_t triangles = 0;
+            totalMs += MeasureMs([&] {
+                triangles = 0;
+                for (int i = 0; i < entityCount; ++i) {
+                    const LodModel& model = models[i % models.size()];
+                    const glm::vec3 position(4.0f * (i % gridSize - gridSize / 2), 0.0f, -8.0f - 4.0f * (i / gridSize));
+                    uint32_t lod = 0;
+                    if (lodEnabled) {
+                        const glm::vec3 center = position + model.center * model.scale;
+                        const float depth = glm::length(center - camera.GetPosition()) - model.radius * model.scale;
+                        const float screenPerUnit = 0.5f * projection[1][1] / std::max(depth, 1e-3f);
+                        float screenErrors[scene::Entity::kMaxLods];
+                        const uint32_t count = std::min<uint32_t>(static_cast<uint32_t>(model.errors.size()),
+                                                                  scene::Entity::kMaxLods);
+                        for (uint32_t l = 0; l < count; ++l) screenErrors[l] = model.errors[l] * model.scale * screenPerUnit;
+                        lod = scene::Entity::SelectLod(lods[i], screenErrors, count);
+                    }
+                    if (lod != lods[i]) ++result.switches;
+                    lods[i] = lod;
+                    triangles += model.triangles[lod];
+                }
+            }, 1);
+            totalTriangles += static_cast<double>(triangles);
+            result.minTriangles = std::min(result.minTriangles, triangles);
+            result.maxTriangles = std::max(result.maxTriangles, triangles);
+        }
+        result.avgTriangles = totalTriangles / kFrames;
+        result.selectUs = totalMs * 1000.0 / kFrames;
+        return result;
+    }
+
+} // namespace
+
+    void RunLod() {
+        // 与示例程序相同的模型缩放
+        const float scales[] = {0.2f, 1.0f, 0.5f, 1.0f};
+        std::vector<LodModel> models;
+
+        std::printf("%-12s %9s   %s\n", "model", "gen ms", "triangles per level (error as % of bounds diagonal)");
+        for (size_t m = 0; m < ShippedModels().size(); ++m) {
+            const char* relative = ShippedModels()[m];
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+
+            graphics::ObjData obj = graphics::ObjParser::Parse(path);
+            std::vector<graphics::MeshData> meshes = graphics::ObjParser::BuildMeshes(obj);
+            graphics::MeshOptimizer::OptimizeMeshes(meshes);
+            graphics::MeshletBuilder::BuildMeshes(meshes);
+            const std::vector<graphics::MeshData> base = meshes;
+            double ms = MeasureMs([&] {
+                meshes = base;
+                graphics::MeshSimplifier::GenerateLods(meshes, 1, {});
+            }, 3);
+
+            LodModel model = Summarize(fs::path(relative).stem().string(), scales[m], meshes);
+            std::printf("%-12s %9.1f  ", model.name.c_str(), ms);
+            for (size_t lod = 0; lod < model.triangles.size(); ++lod) {
+                std::printf(" L%zu %6zu (%5.2f%%)", lod, model.triangles[lod],
+                            100.0f * model.errors[lod] / std::max(2.0f * model.radius, 1e-6f));
+            }
+            std::printf("\n");
+            models.push_back(std::move(model));
+        }
+        if (models.empty()) return;
+
+        std::printf("\nfly-through, 240 frames, threshold %.4f of screen height\n", scene::Entity::GetLodThreshold());
+        std::printf("%-9s %-16s %12s %12s %12s %9s %10s\n", "entities", "mode", "avg tris", "min tris", "max tris",
+                    "switches", "select us");
+        const float defaultHysteresis = scene::Entity::GetLodHysteresis();
+        for (int entities : {100, 400, 900}) {
+            const struct {
+                const char* name;
+                bool enabled;
+                float hysteresis;
+            } modes[] = {{"no lod", false, 0.0f}, {"lod", true, 0.0f}, {"lod+hysteresis", true, defaultHysteresis}};
+            for (const auto& mode : modes) {
+                FlyResult r = FlyThrough(models, entities, mode.enabled, mode.hysteresis);
+                std::printf("%-9d %-16s %12.0f %12zu %12zu %9zu %10.1f\n", entities, mode.name, r.avgTriangles,
+                            r.minTriangles, r.maxTriangles, r.switches, r.selectUs);
+            }
+        }
+        scene::Entity::SetLodHysteresis(defaultHysteresis);
+    }
+
+} // namespace bench
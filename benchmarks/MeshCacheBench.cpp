@@ -0,0 +1,45 @@
+#include "Bench.h"
+#include "graphics/MeshCache.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+    void RunMeshCache() {
+        std::printf("%-12s %10s %12s %14s %10s\n", "model", "cache KB", "parse ms", "cache open ms", "speedup");
+
+        for (const char* relative : ShippedModels()) {
+            const std::string objPath = PathResolver::Resolve(relative);
+            if (!fs::exists(objPath)) continue;
+
+            const std::string cachePath = (fs::temp_directory_path() / (fs::path(relative).stem().string() + ".bench.rmesh")).string();
+            auto obj = graphics::ObjParser::Parse(objPath);
+            auto meshes = graphics::ObjParser::BuildMeshes(obj);
+            graphics::MeshCache::Write(cachePath, objPath, meshes, obj.materials, obj.materialLibraries);
+
+            double parseMs = MeasureMs([&] { graphics::ObjParser::BuildMeshes(graphics::ObjParser::Parse(objPath)); });
+
+            // 打开缓存（含源文件哈希校验），并读取全部顶点/索引字节以计入缺页开销
+            volatile unsigned int sink = 0;
+            double cacheMs = MeasureMs([&] {
+                graphics::MeshCache cache;
+                if (!cache.Open(cachePath, objPath)) throw std::runtime_error("cache rejected");
+                unsigned int sum = 0;
+                for (const auto& view : cache.GetMeshes()) {
+                    for (uint32_t i = 0; i < view.indexCount; ++i) sum += view.indices[i];
+                    for (uint32_t i = 0; i < view.vertexCount; ++i) sum += static_cast<unsigned int>(view.vertices[i].Position.x);
+                }
+                sink = sink + sum;
+            });
+
+            std::printf("%-12s %10.1f %12.2f %14.3f %9.1fx\n", fs::path(relative).stem().string().c_str(),
+                        fs::file_size(cachePath) / 1024.0, parseMs, cacheMs, parseMs / cacheMs);
+            fs::remove(cachePath);
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,154 @@
+#include "Bench.h"
+#include "graphics/MeshOptimizer.h"
+#include "graphics/Meshlet.h"
+#include "graphics/ObjParser.h"
+#include "utils/PathResolver.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    struct ViewResult {
+        size_t triangles = 0;
+        size_t frustumCulled = 0;
+        size_t backfaceCulled = 0;
+        size_t visible = 0;
+        size_t ranges = 0;
+        size_t wrongCulls = 0; ///< 被背面剔除的簇中实际朝向相机的三角形（应为 0）
+        double cullUs = 0.0;
+    };
+
+    // 检查背面剔除是否保守：被剔除簇内不能有正面三角形
+    size_t CountWrongCulls(const graphics::MeshData& mesh, const graphics::MeshletCuller::DrawList& drawList,
+                           const glm::vec3& eye, const graphics::MeshletCullView& view) {
+        size_t wrong = 0;
+        for (const auto& meshlet : mesh.meshlets) {
+            bool inside = true;
+            for (const auto& plane : view.planes)
+                inside = inside && glm::dot(glm::vec3(plane), meshlet.center) + plane.w >= -meshlet.radius;
+            if (!inside) continue;
+            bool drawn = false;
+            for (size_t r = 0; r < drawList.counts.size() && !drawn; ++r) {
+                const size_t first = reinterpret_cast<uintptr_t>(drawList.offsets[r]) / sizeof(unsigned int);
+                drawn = meshlet.firstIndex >= first && meshlet.firstIndex < first + drawList.counts[r];
+            }
+            if (drawn) continue;
+            for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+                const unsigned int* tri = mesh.indices.data() + meshlet.firstIndex + t * 3;
+                const glm::vec3& a = mesh.vertices[tri[0]].Position;
+                const glm::vec3 n = glm::cross(mesh.vertices[tri[1]].Position - a, mesh.vertices[tri[2]].Position - a);
+                if (glm::dot(a - eye, n) < 0.0f) ++wrong;
+            }
+        }
+        return wrong;
+    }
+
+    // 从球面均匀分布的多个方向观察模型，distance 为相机到模型中心的距离
+    ViewResult Evaluate(const std::vector<graphics::MeshData>& meshes, const glm::vec3& center, float distance) {
+        constexpr int kViews = 32;
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.01f, 1000.0f);
+        graphics::MeshletCuller::DrawList drawList;
+        graphics::MeshletCuller::ResetStats();
+        ViewResult result;
+        double totalMs = 0.0;
+        for (int i = 0; i < kViews; ++i) {
+            // 斐波那契球面采样
+            const float y = 1.0f - 2.0f * (i + 0.5f) / kViews;
+            const float r = std::sqrt(1.0f - y * y);
+            const float phi = 2.39996323f * i;
+            const glm::vec3 direction(r * std::cos(phi), y, r * std::sin(phi));
+            const glm::vec3 eye = center + direction * distance;
+            const glm::vec3 up = std::abs(y) > 0.99f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+            const glm::mat4 viewMatrix = glm::lookAt(eye, center, up);
+            const auto view = graphics::MeshletCullView::Create(projection * viewMatrix, glm::mat4(1.0f), eye,
+                                                                glm::normalize(center - eye));
+            totalMs += MeasureMs([&] {
+                for (const auto& mesh : meshes)
+                    graphics::MeshletCuller::Cull(mesh.meshlets.data(), mesh.meshlets.size(), view, drawList);
+            }, 1);
+            for (const auto& mesh : meshes) {
+                graphics::MeshletCuller::Cull(mesh.meshlets.data(), mesh.meshlets.size(), view, drawList);
+                result.wrongCulls += CountWrongCulls(mesh, drawList, eye, view);
+            }
+        }
+        // 每个视角统计了两次（计时与校验），取一半
+        const auto& stats = graphics::MeshletCuller::GetStats();
+        result.triangles = stats.triangles / 2;
+        result.frustumCulled = stats.frustumCulledTriangles / 2;
+        result.backfaceCulled = stats.backfaceCulledTriangles / 2;
+        result.visible = stats.visibleTriangles / 2;
+        result.ranges = stats.drawRanges / 2;
+        result.cullUs = totalMs * 1000.0 / kViews;
+        return result;
+    }
+
+    void PrintView(const char* model, const char* label, const ViewResult& r) {
+        const double total = static_cast<double>(std::max<size_t>(r.triangles, 1));
+        std::printf("%-12s %-8s %12zu %12zu %7.1f%% %8.1f%% %8.1f%% %8zu %8zu %9.1f\n", model, label, r.triangles,
+                    r.visible, 100.0 * r.visible / total, 100.0 * r.frustumCulled / total,
+                    100.0 * r.backfaceCulled / total, r.ranges, r.wrongCulls, r.cullUs);
+    }
+
+} // namespace
+
+    void RunMeshlet() {
+        std::printf("meshlet limits: %u vertices, %u triangles; 32 views per row, totals summed over views\n",
+                    graphics::MeshletBuilder::kMaxVertices, graphics::MeshletBuilder::kMaxTriangles);
+        std::printf("%-12s %9s %9s %9s %9s\n", "model", "meshlets", "avg tris", "avg verts", "build ms");
+        struct Loaded {
+            std::string name;
+            std::vector<graphics::MeshData> meshes;
+            glm::vec3 center;
+            float diagonal;
+        };
+        std::vector<Loaded> models;
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+
+            graphics::ObjData obj = graphics::ObjParser::Parse(path);
+            Loaded loaded{fs::path(relative).stem().string(), graphics::ObjParser::BuildMeshes(obj), glm::vec3(0.0f), 0.0f};
+            graphics::MeshOptimizer::OptimizeMeshes(loaded.meshes);
+            const std::vector<graphics::MeshData> optimized = loaded.meshes;
+            double ms = MeasureMs([&] {
+                loaded.meshes = optimized;
+                graphics::MeshletBuilder::BuildMeshes(loaded.meshes, 1);
+            }, 3);
+
+            size_t meshletCount = 0, triangles = 0, vertices = 0;
+            glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+            for (const auto& mesh : loaded.meshes) {
+                meshletCount += mesh.meshlets.size();
+                for (const auto& meshlet : mesh.meshlets) {
+                    triangles += meshlet.triangleCount;
+                    vertices += meshlet.vertexCount;
+                }
+                for (const auto& v : mesh.vertices) {
+                    boundsMin = glm::min(boundsMin, v.Position);
+                    boundsMax = glm::max(boundsMax, v.Position);
+                }
+            }
+            loaded.center = 0.5f * (boundsMin + boundsMax);
+            loaded.diagonal = glm::length(boundsMax - boundsMin);
+            std::printf("%-12s %9zu %9.1f %9.1f %9.2f\n", loaded.name.c_str(), meshletCount,
+                        static_cast<double>(triangles) / std::max<size_t>(meshletCount, 1),
+                        static_cast<double>(vertices) / std::max<size_t>(meshletCount, 1), ms);
+            models.push_back(std::move(loaded));
+        }
+
+        std::printf("\n%-12s %-8s %12s %12s %8s %9s %9s %8s %8s %9s\n", "model", "view", "submitted", "visible",
+                    "visible", "frustum", "backface", "ranges", "wrong", "cull us");
+        for (const auto& model : models) {
+            // orbit：整个模型在视野内；close：相机贴近表面，只看到一部分
+            PrintView(model.name.c_str(), "orbit", Evaluate(model.meshes, model.center, model.diagonal * 1.5f));
+            PrintView(model.name.c_str(), "close", Evaluate(model.meshes, model.center, model.diagonal * 0.6f));
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,140 @@
+#include "Bench.h"
+#include "graphics/MipGenerator.h"
+#include "graphics/TextureFile.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    const char* GetFilterName(graphics::MipFilter filter) {
+        switch (filter) {
+            case graphics::MipFilter::Box: return "box";
+            case graphics::MipFilter::Kaiser: return "kaiser";
+            case graphics::MipFilter::Lanczos: return "lanczos";
+        }
+        return "?";
+    }
+
+    // 掩码（取R通道）高于阈值的像素比例
+    double MaskCoverage(const std::vector<uint8_t>& level) {
+        size_t covered = 0;
+        for (size_t i = 0; i < level.size(); i += 4) {
+            if (level[i] > 127) ++covered;
+        }
+        return static_cast<double>(covered) / (level.size() / 4);
+    }
+
+    // 以 8 位 2x2 盒式滤波模拟运行时 glGenerateMipmap 的工作量
+    size_t BoxMipChain(const graphics::ImageData& image) {
+        std::vector<uint8_t> src(image.pixels.get(), image.pixels.get() + image.GetByteSize());
+        int width = image.width, height = image.height;
+        size_t total = src.size();
+        while (width > 1 || height > 1) {
+            const int dstWidth = std::max(1, width / 2), dstHeight = std::max(1, height / 2);
+            const int channels = image.channels;
+            std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * channels);
+            for (int y = 0; y < dstHeight; ++y) {
+                const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                for (int x = 0; x < dstWidth; ++x) {
+                    const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                    for (int ch = 0; ch < channels; ++ch) {
+                        int sum = src[(static_cast<size_t>(y0) * width + x0) * channels + ch] +
+                                  src[(static_cast<size_t>(y0) * width + x1) * channels + ch] +
+                                  src[(static_cast<size_t>(y1) * width + x0) * channels + ch] +
+                                  src[(static_cast<size_t>(y1) * width + x1) * channels + ch];
+                        dst[(static_cast<size_t>(y) * dstWidth + x) * channels + ch] = static_cast<uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+            total += dst.size();
+            src = std::move(dst);
+            width = dstWidth;
+            height = dstHeight;
+        }
+        return total;
+    }
+
+} // namespace
+
+    void RunMipGen() {
+        const char* samples[] = {
+            "assets/objects/cyborg/cyborg_diffuse.png",
+            "assets/objects/planet/mars.png",
+        };
+
+        // 各滤波器生成完整 mip 链的吞吐（SIMD 与标量对比）
+        std::printf("%-20s %-8s %12s %12s %8s\n", "texture", "filter", "scalar ms", "simd ms", "speedup");
+        for (const char* relative : samples) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+            graphics::ImageData image = graphics::ImageData::LoadFromFile(path, 4);
+
+            for (auto filter : {graphics::MipFilter::Box, graphics::MipFilter::Kaiser, graphics::MipFilter::Lanczos}) {
+                graphics::MipGenerator::Options options;
+                options.filter = filter;
+                options.srgb = true;
+                options.simd = false;
+                double scalarMs = MeasureMs([&] {
+                    graphics::MipGenerator::Generate(image.pixels.get(), image.width, image.height, options);
+                }, 3);
+                options.simd = true;
+                double simdMs = MeasureMs([&] {
+                    graphics::MipGenerator::Generate(image.pixels.get(), image.width, image.height, options);
+                }, 3);
+                std::printf("%-20s %-8s %12.1f %12.1f %7.2fx\n", fs::path(relative).filename().string().c_str(),
+                            GetFilterName(filter), scalarMs, simdMs, scalarMs / simdMs);
+            }
+        }
+        std::printf("\n");
+
+        // alpha 测试遮罩的覆盖率：普通滤波逐级衰减，开启保持后与第0级一致
+        const std::string maskPath = PathResolver::Resolve("assets/objects/nanosuit/cell_arm_alpha.png");
+        if (fs::exists(maskPath)) {
+            graphics::ImageData mask = graphics::ImageData::LoadFromFile(maskPath, 4);
+            graphics::MipGenerator::Options options;
+            auto plain = graphics::MipGenerator::Generate(mask.pixels.get(), mask.width, mask.height, options);
+            options.coverageChannel = 0;
+            auto preserved = graphics::MipGenerator::Generate(mask.pixels.get(), mask.width, mask.height, options);
+            std::printf("%-6s %14s %14s\n", "level", "plain cover", "preserved");
+            for (size_t level = 0; level < plain.size() && level <= 8; level += 2) {
+                std::printf("%-6zu %13.1f%% %13.1f%%\n", level, 100.0 * MaskCoverage(plain[level]),
+                            100.0 * MaskCoverage(preserved[level]));
+            }
+            std::printf("\n");
+        }
+
+        // 运行时单次加载：解码 + 运行时生成 mip（CPU 盒式滤波近似）对比映射烘焙文件
+        std::printf("%-20s %16s %16s\n", "texture", "decode+mip ms", "cooked open ms");
+        const fs::path tempDir = fs::temp_directory_path();
+        for (const char* relative : samples) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+            const std::string cookedPath = (tempDir / (fs::path(path).filename().string() + ".mipbench.rtex")).string();
+            graphics::TextureFile::Cook(path, cookedPath, graphics::TextureFile::GetDefaultCookOptions(path));
+
+            double runtimeMs = MeasureMs([&] {
+                graphics::ImageData image = graphics::ImageData::LoadFromFile(path);
+                BoxMipChain(image);
+            });
+            double cookedMs = MeasureMs([&] {
+                graphics::TextureFile file;
+                if (!file.Open(cookedPath, path))
+                    throw std::runtime_error("cooked texture rejected: " + cookedPath);
+                // 含源文件哈希校验；触摸所有级别，计入缺页开销
+                volatile uint8_t sink = 0;
+                for (const auto& level : file.GetLevels()) {
+                    for (size_t i = 0; i < level.size; i += 4096) sink = sink + level.data[i];
+                }
+            });
+            fs::remove(cookedPath);
+            std::printf("%-20s %16.1f %16.2f\n", fs::path(relative).filename().string().c_str(), runtimeMs, cookedMs);
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,130 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include "graphics/ObjParser.h"
+#include "utils/PathResolver.h"
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+namespace bench {
+
+namespace {
+
+    // 旧路径：tinyobj 解析 + std::map 三元组去重（与替换前的 Model::ProcessMeshData 相同）
+    std::vector<graphics::MeshData> LoadWithTinyObj(const std::string& path) {
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn, err;
+        std::string baseDir = std::filesystem::path(path).parent_path().string() + "/";
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str(), baseDir.c_str()))
+            throw std::runtime_error("tinyobj failed: " + err);
+
+        std::vector<graphics::MeshData> result;
+        for (const auto& shape : shapes) {
+            std::map<int, std::vector<graphics::Vertex>> matID_to_vertices;
+            std::map<int, std::vector<unsigned int>> matID_to_indices;
+            std::map<int, std::map<std::tuple<int, int, int>, unsigned int>> matID_to_vertexCache;
+
+            size_t index_offset = 0;
+            for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); ++f) {
+                int fv = shape.mesh.num_face_vertices[f];
+                int matID = shape.mesh.material_ids.empty() ? -1 : shape.mesh.material_ids[f];
+                for (int v = 0; v < fv; ++v) {
+                    tinyobj::index_t idx = shape.mesh.indices[index_offset + v];
+                    auto key = std::make_tuple(idx.vertex_index, idx.normal_index, idx.texcoord_index);
+                    auto& vertexCache = matID_to_vertexCache[matID];
+                    auto& vertices = matID_to_vertices[matID];
+                    unsigned int vertIndex;
+                    if (vertexCache.find(key) != vertexCache.end()) {
+                        vertIndex = vertexCache[key];
+                    } else {
+                        graphics::Vertex vertex{};
+                        vertex.Position = {attrib.vertices[3 * idx.vertex_index + 0],
+                                           attrib.vertices[3 * idx.vertex_index + 1],
+                                           attrib.vertices[3 * idx.vertex_index + 2]};
+                        if (idx.normal_index >= 0) {
+                            vertex.Normal = {attrib.normals[3 * idx.normal_index + 0],
+                                             attrib.normals[3 * idx.normal_index + 1],
+                                             attrib.normals[3 * idx.normal_index + 2]};
+                        }
+                        if (idx.texcoord_index >= 0) {
+                            vertex.TexCoords = {attrib.texcoords[2 * idx.texcoord_index + 0],
+                                                attrib.texcoords[2 * idx.texcoord_index + 1]};
+                        }
+                        vertIndex = static_cast<unsigned int>(vertices.size());
+                        vertices.push_back(vertex);
+                        vertexCache[key] = vertIndex;
+                    }
+                    matID_to_indices[matID].push_back(vertIndex);
+                }
+                index_offset += fv;
+            }
+
+            for (auto& [matID, indices] : matID_to_indices) {
+                graphics::MeshData mesh;
+                mesh.materialId = matID;
+                mesh.vertices = std::move(matID_to_vertices[matID]);
+                mesh.indices = std::move(indices);
+                result.push_back(std::move(mesh));
+            }
+        }
+        return result;
+    }
+
+    std::vector<graphics::MeshData> LoadWithObjParser(const std::string& path, unsigned int threads) {
+        return graphics::ObjParser::BuildMeshes(graphics::ObjParser::Parse(path, threads), threads);
+    }
+
+    // 校验两条路径输出一致，返回顶点属性的最大绝对误差
+    float Compare(const std::vector<graphics::MeshData>& a, const std::vector<graphics::MeshData>& b) {
+        if (a.size() != b.size()) throw std::runtime_error("mesh count mismatch");
+        float maxError = 0.0f;
+        for (size_t m = 0; m < a.size(); ++m) {
+            if (a[m].materialId != b[m].materialId || a[m].indices != b[m].indices ||
+                a[m].vertices.size() != b[m].vertices.size())
+                throw std::runtime_error("mesh " + std::to_string(m) + " topology mismatch");
+            for (size_t v = 0; v < a[m].vertices.size(); ++v) {
+                const float* x = &a[m].vertices[v].Position.x;
+                const float* y = &b[m].vertices[v].Position.x;
+                for (int k = 0; k < 8; ++k) maxError = std::max(maxError, std::fabs(x[k] - y[k]));
+            }
+        }
+        return maxError;
+    }
+
+} // namespace
+
+    void RunObjLoad() {
+        // 0：经任务系统并行；1：调用线程串行
+        const unsigned int threads = 0;
+        std::printf("%-12s %8s %12s %12s %12s %9s %10s\n",
+                    "model", "meshes", "tinyobj ms", "parser(1) ms", "parser(N) ms", "speedup", "max err");
+
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!std::filesystem::exists(path)) {
+                std::printf("%-12s (missing)\n", std::filesystem::path(relative).stem().string().c_str());
+                continue;
+            }
+
+            auto reference = LoadWithTinyObj(path);
+            float maxError = Compare(reference, LoadWithObjParser(path, threads));
+
+            double legacyMs = MeasureMs([&] { LoadWithTinyObj(path); });
+            double singleMs = MeasureMs([&] { LoadWithObjParser(path, 1); });
+            double parallelMs = MeasureMs([&] { LoadWithObjParser(path, threads); });
+
+            std::printf("%-12s %8zu %12.2f %12.2f %12.2f %8.1fx %10.2g\n",
+                        std::filesystem::path(relative).stem().string().c_str(),
+                        reference.size(), legacyMs, singleMs, parallelMs, legacyMs / parallelMs, maxError);
+        }
+        std::printf("threads: %zu\n", core::JobSystem::GetThreadCount());
+    }
+
+} // namespace bench
@@ -0,0 +1,160 @@
+#include "Bench.h"
+#include "graphics/OcclusionCuller.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+    using graphics::BoundingBox;
+    using graphics::OccluderMesh;
+
+    /// 轴对齐长方体，外表面逆时针
+    OccluderMesh MakeBox(const glm::vec3& min, const glm::vec3& max) {
+        glm::vec3 corners[8];
+        for (int i = 0; i < 8; ++i) {
+            corners[i] = glm::vec3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+        }
+        const unsigned int indices[] = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+                                        2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+        OccluderMesh mesh;
+        mesh.Append(corners, 8, sizeof(glm::vec3), indices, 36);
+        return mesh;
+    }
+
+    /// 经纬球，外表面逆时针
+    OccluderMesh MakeSphere(float radius, uint32_t rings, uint32_t segments) {
+        std::vector<glm::vec3> positions;
+        for (uint32_t r = 0; r <= rings; ++r) {
+            const float phi = glm::pi<float>() * static_cast<float>(r) / static_cast<float>(rings);
+            for (uint32_t s = 0; s <= segments; ++s) {
+                const float theta = glm::two_pi<float>() * static_cast<float>(s) / static_cast<float>(segments);
+                positions.emplace_back(radius * std::sin(phi) * std::cos(theta), radius * std::cos(phi),
+                                       radius * std::sin(phi) * std::sin(theta));
+            }
+        }
+        std::vector<unsigned int> indices;
+        for (uint32_t r = 0; r < rings; ++r) {
+            for (uint32_t s = 0; s < segments; ++s) {
+                const unsigned int a = r * (segments + 1) + s, b = a + segments + 1;
+                indices.insert(indices.end(), {a, a + 1, b, a + 1, b + 1, b});
+            }
+        }
+        OccluderMesh mesh;
+        mesh.Append(positions.data(), positions.size(), sizeof(glm::vec3), indices.data(), indices.size());
+        return mesh;
+    }
+
+    /// 逐像素检查矩形内是否有像素比包围盒最近点更远（对照）
+    bool BruteVisible(const graphics::OcclusionBuffer& buffer, const glm::mat4& viewProjection, const BoundingBox& box) {
+        glm::vec2 ndcMin(1e30f), ndcMax(-1e30f);
+        float nearest = 1e30f;
+        for (int i = 0; i < 8; ++i) {
+            const glm::vec3 corner((i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y,
+                                   (i & 4) ? box.max.z : box.min.z);
+            const glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+            if (clip.z + clip.w <= 0.0f || clip.w <= 0.0f) return true;
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+            ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+            nearest = std::min(nearest, ndc.z);
+        }
+        const int w = static_cast<int>(buffer.GetWidth()), h = static_cast<int>(buffer.GetHeight());
+        const int x0 = std::max(0, static_cast<int>(std::floor((ndcMin.x + 1.0f) * 0.5f * w)));
+        const int x1 = std::min(w - 1, static_cast<int>(std::floor((ndcMax.x + 1.0f) * 0.5f * w)));
+        const int y0 = std::max(0, static_cast<int>(std::floor((ndcMin.y + 1.0f) * 0.5f * h)));
+        const int y1 = std::min(h - 1, static_cast<int>(std::floor((ndcMax.y + 1.0f) * 0.5f * h)));
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                if (nearest <= buffer.GetDepth()[static_cast<size_t>(y) * w + x]) return true;
+        return false;
+    }
+
+} // namespace
+
+    void RunOcclusion() {
+        using graphics::OcclusionBuffer;
+        using graphics::OcclusionCuller;
+
+        // 室内走廊：两侧墙与隔断、几个高面数的球作为遮挡体，墙后散布 10^4 个小物体
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 10.0f), glm::vec3(0.0f, 1.5f, 0.0f), glm::vec3(0, 1, 0));
+        const glm::mat4 viewProjection = projection * view;
+
+        std::vector<OccluderMesh> occluders;
+        std::vector<glm::mat4> transforms;
+        for (int i = 0; i < 6; ++i) {
+            const float z = -6.0f * static_cast<float>(i);
+            // 左右墙与中间带门洞的隔断
+            occluders.push_back(MakeBox(glm::vec3(-6.0f, 0.0f, z - 6.0f), glm::vec3(-5.5f, 4.0f, z)));
+            occluders.push_back(MakeBox(glm::vec3(5.5f, 0.0f, z - 6.0f), glm::vec3(6.0f, 4.0f, z)));
+            occluders.push_back(MakeBox(glm::vec3(-5.5f, 0.0f, z - 3.2f), glm::vec3(-1.0f, 4.0f, z - 2.8f)));
+            occluders.push_back(MakeBox(glm::vec3(1.0f, 0.0f, z - 3.2f), glm::vec3(5.5f, 4.0f, z - 2.8f)));
+            transforms.insert(transforms.end(), 4, glm::mat4(1.0f));
+        }
+        const OccluderMesh sphere = MakeSphere(1.0f, 64, 128);
+        for (int i = 0; i < 4; ++i) {
+            occluders.push_back(sphere);
+            transforms.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f + 2.0f * i, 1.0f, -1.0f - 2.5f * i)));
+        }
+        size_t sourceTriangles = 0;
+        for (const auto& mesh : occluders) sourceTriangles += mesh.GetTriangleCount();
+
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<float> x(-12.0f, 12.0f), y(0.0f, 3.5f), z(-40.0f, 2.0f), half(0.1f, 0.6f);
+        std::vector<BoundingBox> objects(10000);
+        for (auto& box : objects) {
+            const glm::vec3 c(x(rng), y(rng), z(rng)), h(half(rng));
+            box = BoundingBox{c - h, c + h};
+        }
+
+        OcclusionBuffer buffer;
+        auto rasterize = [&](bool simd, unsigned int threads) {
+            OcclusionCuller::SetSimdEnabled(simd);
+            return MeasureMs([&] {
+                buffer.Begin(viewProjection);
+                for (size_t i = 0; i < occluders.size(); ++i) buffer.AddOccluder(occluders[i], transforms[i]);
+                buffer.Rasterize(threads);
+            }, 11);
+        };
+        const double scalarMs = rasterize(false, 1);
+        const std::vector<float> scalarDepth = buffer.GetDepth();
+        const double simdMs = rasterize(true, 1);
+        const double threadedMs = rasterize(true, 0);
+        size_t depthMismatch = 0;
+        for (size_t i = 0; i < scalarDepth.size(); ++i) depthMismatch += std::abs(scalarDepth[i] - buffer.GetDepth()[i]) > 1e-6f;
+
+        size_t occluded = 0;
+        const double testMs = MeasureMs([&] {
+            occluded = 0;
+            for (const auto& box : objects) occluded += !buffer.IsVisible(box);
+        }, 11);
+        size_t bruteOccluded = 0, disagreements = 0;
+        const double bruteMs = MeasureMs([&] {
+            bruteOccluded = disagreements = 0;
+            for (const auto& box : objects) {
+                const bool visible = BruteVisible(buffer, viewProjection, box);
+                bruteOccluded += !visible;
+                disagreements += visible != buffer.IsVisible(box);
+            }
+        }, 3);
+
+        std::printf("%zu occluders (%zu triangles, %zu front-facing after clipping), %ux%u depth buffer\n",
+                    occluders.size(), sourceTriangles, buffer.GetTriangleCount(), buffer.GetWidth(), buffer.GetHeight());
+        std::printf("%-34s %10s\n", "per frame", "ms");
+        std::printf("%-34s %10.3f\n", "rasterize (scalar)", scalarMs);
+        std::printf("%-34s %10.3f\n", "rasterize (SSE)", simdMs);
+        std::printf("%-34s %10.3f\n", "rasterize (SSE, all threads)", threadedMs);
+        std::printf("%-34s %10.3f  (%zu / %zu occluded)\n", "test 10^4 boxes (hierarchical)", testMs, occluded,
+                    objects.size());
+        std::printf("%-34s %10.3f  (%zu occluded, %zu disagreements)\n", "test 10^4 boxes (per pixel)", bruteMs,
+                    bruteOccluded, disagreements);
+        std::printf("scalar vs SSE depth mismatches: %zu pixels\n", depthMismatch);
+    }
+
+} // namespace bench
@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include "graphics/ObjParser.h"
+#include "graphics/TriangleBvh.h"
+#include "utils/PathResolver.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    /// 逐三角形求交（对照），返回最近距离，没有交点时为 maxDistance
+    float BruteForce(const std::vector<graphics::MeshData>& meshes, const glm::vec3& origin, const glm::vec3& direction,
+                     float maxDistance) {
+        float best = maxDistance;
+        for (const auto& mesh : meshes) {
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                const glm::vec3 v0 = mesh.vertices[mesh.indices[i]].Position;
+                const glm::vec3 e1 = mesh.vertices[mesh.indices[i + 1]].Position - v0;
+                const glm::vec3 e2 = mesh.vertices[mesh.indices[i + 2]].Position - v0;
+                const glm::vec3 p = glm::cross(direction, e2);
+                const float det = glm::dot(e1, p);
+                if (det == 0.0f) continue;
+                const glm::vec3 s = origin - v0;
+                const float u = glm::dot(s, p) / det;
+                const glm::vec3 q = glm::cross(s, e1);
+                const float v = glm::dot(direction, q) / det;
+                const float t = glm::dot(e2, q) / det;
+                if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < best) best = t;
+            }
+        }
+        return best;
+    }
+
+} // namespace
+
+    void RunPicking() {
+        constexpr int kRays = 100000;
+        constexpr int kBruteRays = 200;
+
+        std::printf("%-10s %9s %8s %7s %6s %9s %10s %9s %10s %8s\n", "model", "triangles", "build ms", "nodes", "depth",
+                    "KB", "Mrays/s", "us/ray", "brute us", "hit %");
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+            const graphics::ObjData obj = graphics::ObjParser::Parse(path);
+            const std::vector<graphics::MeshData> meshes = graphics::ObjParser::BuildMeshes(obj);
+
+            // 与 Model::LoadData 相同：每个子网格一棵
+            std::vector<graphics::TriangleBvh> bvhs(meshes.size());
+            const double buildMs = MeasureMs([&] {
+                for (size_t m = 0; m < meshes.size(); ++m) {
+                    const auto& mesh = meshes[m];
+                    if (mesh.vertices.empty()) continue;
+                    bvhs[m].Build(&mesh.vertices[0].Position, mesh.vertices.size(), sizeof(graphics::Vertex),
+                                  mesh.indices.data(), mesh.indices.size());
+                }
+            }, 3);
+            size_t triangles = 0, nodes = 0, bytes = 0;
+            uint32_t depth = 0;
+            glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+            for (const auto& bvh : bvhs) {
+                if (bvh.IsEmpty()) continue;
+                triangles += bvh.GetTriangleCount();
+                nodes += bvh.GetNodeCount();
+                bytes += bvh.GetMemoryBytes();
+                depth = std::max(depth, bvh.GetDepth());
+                boundsMin = glm::min(boundsMin, bvh.GetBounds().min);
+                boundsMax = glm::max(boundsMax, bvh.GetBounds().max);
+            }
+
+            // 从包围球外随机一点射向包围盒内随机一点，模拟在模型周围点选
+            const glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+            const float radius = 0.5f * glm::length(boundsMax - boundsMin);
+            std::mt19937 rng(3);
+            std::normal_distribution<float> gauss;
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            std::vector<glm::vec3> origins(kRays), directions(kRays);
+            for (int i = 0; i < kRays; ++i) {
+                origins[i] = center + 2.0f * radius * glm::normalize(glm::vec3(gauss(rng), gauss(rng), gauss(rng)));
+                const glm::vec3 target = boundsMin + (boundsMax - boundsMin) * glm::vec3(unit(rng), unit(rng), unit(rng));
+                directions[i] = glm::normalize(target - origins[i]);
+            }
+
+            std::vector<float> distances(kRays);
+            const double rayMs = MeasureMs([&] {
+                for (int i = 0; i < kRays; ++i) {
+                    float best = 1e30f;
+                    graphics::RayHit hit;
+                    for (const auto& bvh : bvhs)
+                        if (bvh.Intersect(origins[i], directions[i], best, hit)) best = hit.distance;
+                    distances[i] = best;
+                }
+            }, 3);
+            size_t hits = 0;
+            for (float d : distances) hits += d < 1e30f;
+
+            bool match = true;
+            const double bruteMs = MeasureMs([&] {
+                for (int i = 0; i < kBruteRays; ++i) {
+                    const float expected = BruteForce(meshes, origins[i], directions[i], 1e30f);
+                    match &= std::abs(expected - distances[i]) <= 1e-4f * std::max(1.0f, expected);
+                }
+            }, 1);
+
+            std::printf("%-10s %9zu %8.1f %7zu %6u %9.0f %10.2f %9.3f %10.1f %8.1f%s\n",
+                        fs::path(relative).stem().string().c_str(), triangles, buildMs, nodes, depth, bytes / 1024.0,
+                        kRays / rayMs / 1e3, 1e3 * rayMs / kRays, 1e3 * bruteMs / kBruteRays, 100.0 * hits / kRays,
+                        match ? "" : "  MISMATCH");
+        }
+    }
+
+} // namespace bench
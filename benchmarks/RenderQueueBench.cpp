@@ -0,0 +1,150 @@
+#include "Bench.h"
+#include "core/JobSystem.h"
+#include "graphics/RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <random>
+
+namespace bench {
+
+namespace {
+
+    /// 合成场景中的一种模型：若干子网格，每个子网格一个 VAO 与一组纹理
+    struct SyntheticModel {
+        std::vector<uint32_t> vaos;
+        std::vector<uint32_t> materials;   ///< 纹理组下标
+    };
+
+    /// 不调用GL执行，返回执行器统计
+    template <typename Fn>
+    graphics::CommandExecutor::Stats DryRun(Fn&& submit) {
+        graphics::CommandExecutor executor(true);
+        submit(executor);
+        const auto stats = executor.GetLocalStats();
+        executor.Finish();
+        return stats;
+    }
+
+    /// 每个绘制项的实体深度（沿视线方向）
+    float ItemDepth(const graphics::RenderQueue& queue, const graphics::RenderQueue::Item& item, const glm::vec3& eye,
+                    const glm::vec3& forward) {
+        return glm::dot(glm::vec3(queue.GetDraw(item).drawData->model[3]) - eye, forward);
+    }
+
+} // namespace
+
+    void RunRenderQueue() {
+        constexpr size_t kEntities = 20000;
+        constexpr size_t kModels = 24;
+        constexpr size_t kTextureSets = 32;
+
+        // 模型与材质随机组合，实体按随机顺序插入，与场景中按加载顺序排列的情形类似
+        std::mt19937 rng(7);
+        std::vector<SyntheticModel> models(kModels);
+        uint32_t nextVao = 1;
+        for (auto& model : models) {
+            const size_t submeshes = 1 + rng() % 4;
+            for (size_t s = 0; s < submeshes; ++s) {
+                model.vaos.push_back(nextVao++);
+                model.materials.push_back(static_cast<uint32_t>(rng() % kTextureSets));
+            }
+        }
+        std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+        std::vector<glm::mat4> transforms(kEntities);
+        std::vector<uint32_t> modelOf(kEntities);
+        for (size_t i = 0; i < kEntities; ++i) {
+            transforms[i] = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng)));
+            modelOf[i] = static_cast<uint32_t>(rng() % kModels);
+        }
+
+        const glm::vec3 eye(0.0f, 10.0f, -220.0f), forward(0.0f, 0.0f, 1.0f);
+        graphics::CommandList list;
+        list.Record(kEntities, [&](graphics::CommandBuffer& buffer, size_t begin, size_t end) {
+            buffer.BindPipeline(3, 0);
+            for (size_t i = begin; i < end; ++i) {
+                buffer.SetDrawData(transforms[i]);
+                const SyntheticModel& model = models[modelOf[i]];
+                for (size_t s = 0; s < model.vaos.size(); ++s) {
+                    const unsigned int set = 1 + model.materials[s] * 3;
+                    const unsigned int textures[3] = {set, set + 1, set + 2};
+                    buffer.BindMaterial(textures, 3);
+                    graphics::DrawCommand command{};
+                    command.vao = model.vaos[s];
+                    command.indexCount = 3000;
+                    command.triangles = 1000;
+                    command.dequantScale[0] = command.dequantScale[1] = command.dequantScale[2] = 1.0f;
+                    command.dequantOffset[0] = static_cast<float>(model.vaos[s]);
+                    buffer.Draw(command);
+                }
+            }
+        });
+        const size_t draws = list.GetDrawCount();
+
+        // 录制顺序直接回放（执行器过滤冗余绑定，issued + skipped 即逐个绑定的旧路径）
+        const auto replayed = DryRun([&](graphics::CommandExecutor& executor) { list.Submit(&executor); });
+
+        graphics::RenderQueue queue;
+        const double buildMs = MeasureMs([&] {
+            queue.Clear();
+            queue.Add(list, graphics::RenderPass::Opaque, eye, forward, 0.1f, 500.0f);
+        });
+        const std::vector<graphics::RenderQueue::Item> unsorted = queue.GetItems();
+
+        std::vector<graphics::RenderQueue::Item> items, scratch, reference;
+        size_t passes = 0;
+        const double radixMs = MeasureMs([&] {
+            items = unsorted;
+            passes = graphics::RenderQueue::RadixSort(items, scratch);
+        });
+        const double stdMs = MeasureMs([&] {
+            reference = unsorted;
+            std::stable_sort(reference.begin(), reference.end(),
+                             [](const auto& a, const auto& b) { return a.key < b.key; });
+        });
+        bool correct = items.size() == reference.size();
+        for (size_t i = 0; correct && i < items.size(); ++i) correct = items[i].index == reference[i].index;
+
+        queue.Sort();
+        const auto sorted = DryRun([&](graphics::CommandExecutor& executor) { queue.Submit(executor); });
+        const double submitMs = MeasureMs([&] {
+            DryRun([&](graphics::CommandExecutor& executor) { queue.Submit(executor); });
+        });
+
+        // 同一状态组内由近到远
+        for (size_t i = 1; i < queue.GetItemCount(); ++i) {
+            const auto& a = queue.GetItems()[i - 1];
+            const auto& b = queue.GetItems()[i];
+            if (a.key >> 16 == b.key >> 16 && ItemDepth(queue, a, eye, forward) > ItemDepth(queue, b, eye, forward) + 0.1f)
+                correct = false;
+        }
+        // 半透明整体由远到近
+        graphics::RenderQueue transparent;
+        transparent.Add(list, graphics::RenderPass::Transparent, eye, forward, 0.1f, 500.0f);
+        transparent.Sort();
+        for (size_t i = 1; i < transparent.GetItemCount(); ++i) {
+            if (ItemDepth(transparent, transparent.GetItems()[i - 1], eye, forward) + 0.1f <
+                ItemDepth(transparent, transparent.GetItems()[i], eye, forward))
+                correct = false;
+        }
+
+        std::printf("%zu entities, %zu draws, %zu models, %zu texture sets%s\n", kEntities, draws, kModels, kTextureSets,
+                    correct ? "" : "  MISMATCH");
+        std::printf("build %.3f ms, radix sort %.3f ms (%zu passes), std::stable_sort %.3f ms, dry submit %.3f ms\n",
+                    buildMs, radixMs, passes, stdMs, submitMs);
+        std::printf("%-18s %9s %9s %9s %9s %9s %9s\n", "order", "program", "texture", "mesh", "model", "issued",
+                    "saved");
+        const auto row = [](const char* name, const graphics::CommandExecutor::Stats& s, bool naive) {
+            const auto count = [naive](const graphics::CommandExecutor::BindCount& c) {
+                return naive ? c.issued + c.skipped : c.issued;
+            };
+            std::printf("%-18s %9zu %9zu %9zu %9zu %9zu %9zu\n", name, count(s.programs), count(s.textures),
+                        count(s.meshes), count(s.drawData), naive ? s.GetIssued() + s.GetSaved() : s.GetIssued(),
+                        naive ? size_t(0) : s.GetSaved());
+        };
+        row("insertion, naive", replayed, true);
+        row("insertion, cached", replayed, false);
+        row("sorted, cached", sorted, false);
+        core::JobSystem::Shutdown();
+    }
+
+} // namespace bench
@@ -0,0 +1,132 @@
+#include "Bench.h"
+#include "resource/ResourceManager.h"
+#include "scene/Scene.h"
+#include "scene/TransformSystem.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    /// 逐个 make_shared + SetPosition + AddEntity（main.cpp 的做法，对照）
+    void BuildByHand(scene::Scene& scene, const std::vector<std::shared_ptr<graphics::Model>>& models,
+                     const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& rotations) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            auto entity = std::make_shared<scene::Entity>(models.empty() ? nullptr : models[i % models.size()]);
+            entity->SetPosition(positions[i]);
+            entity->SetRotation(rotations[i]);
+            scene.AddEntity(entity);
+        }
+    }
+
+    bool SameFile(const std::string& a, const std::string& b) {
+        std::ifstream fa(a, std::ios::binary), fb(b, std::ios::binary);
+        std::stringstream sa, sb;
+        sa << fa.rdbuf();
+        sb << fb.rdbuf();
+        return sa.str() == sb.str();
+    }
+
+} // namespace
+
+    void RunSceneFile() {
+        constexpr size_t kEntities = 100000;
+        constexpr size_t kChildrenPerGroup = 4;   // 每 5 个实体一组：1 个根 + 4 个子节点
+        constexpr size_t kLights = 64;
+
+        std::vector<std::shared_ptr<graphics::Model>> models;
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (fs::exists(path)) models.push_back(core::ResourceManager::LoadModelAsync(path).Get());
+        }
+
+        std::mt19937 rng(22);
+        std::uniform_real_distribution<float> pos(-500.0f, 500.0f), angle(-180.0f, 180.0f);
+        std::vector<glm::vec3> positions(kEntities), rotations(kEntities);
+        for (size_t i = 0; i < kEntities; ++i) {
+            positions[i] = glm::vec3(pos(rng), pos(rng), pos(rng));
+            rotations[i] = glm::vec3(0.0f, angle(rng), 0.0f);
+        }
+
+        const fs::path directory = fs::temp_directory_path();
+        const std::string scenePath = (directory / "rrender_bench.rscene").string();
+        const std::string resavePath = (directory / "rrender_bench_resave.rscene").string();
+        graphics::Camera camera(graphics::Camera::ProjectionType::Perspective);
+        camera.SetPosition(glm::vec3(0.0f, 10.0f, 30.0f));
+        camera.SetRotation(-90.0f, -15.0f);
+
+        double handMs = 0.0, saveMs = 0.0;
+        {
+            scene::Scene scene;
+            handMs = MeasureMs([&] { BuildByHand(scene, models, positions, rotations); }, 1);
+            const auto& entities = scene.GetEntities();
+            for (size_t i = 0; i < kEntities; ++i) {
+                if (i % (kChildrenPerGroup + 1) != 0) entities[i]->SetParent(entities[i - i % (kChildrenPerGroup + 1)]);
+                if (i % 97 == 0) entities[i]->SetOccluder(true);
+            }
+            for (size_t i = 0; i < kLights; ++i) {
+                auto light = std::make_shared<graphics::PointLight>();
+                light->SetPosition(positions[i]);
+                light->SetColor(glm::vec3(1.0f, 0.9f, 0.8f));
+                scene.AddLight(light);
+                if (i % 2 == 0) scene.AttachLight(light, entities[i * 7], glm::vec3(0.0f, 2.0f, 0.0f));
+            }
+            saveMs = MeasureMs([&] { scene.Save(scenePath, &camera); }, 3);
+        }
+        const auto fileBytes = fs::file_size(scenePath);
+
+        size_t loaded = 0;
+        const double loadMs = MeasureMs([&] {
+            scene::Scene scene;
+            graphics::Camera restored(graphics::Camera::ProjectionType::Orthographic);
+            loaded = scene.Load(scenePath, &restored);
+        }, 5);
+        // 上面的计时含 Scene 析构，单独测一次析构以便扣除
+        double destroyMs = 0.0;
+        {
+            auto scene = std::make_unique<scene::Scene>();
+            scene->Load(scenePath);
+            destroyMs = MeasureMs([&] { scene.reset(); }, 1);
+        }
+
+        // 往返：载入后再次保存应逐字节相同
+        bool roundTrip = false;
+        {
+            scene::Scene scene;
+            graphics::Camera restored(graphics::Camera::ProjectionType::Orthographic);
+            scene.Load(scenePath, &restored);
+            scene.Save(resavePath, &restored);
+            roundTrip = SameFile(scenePath, resavePath);
+        }
+
+        size_t textBytes = 0;
+        const double textMs = MeasureMs([&] {
+            std::ostringstream out;
+            scene::Scene::ExportText(scenePath, out);
+            textBytes = out.str().size();
+        }, 3);
+
+        std::printf("%-22s %10s\n", "entities", std::to_string(loaded).c_str());
+        std::printf("%-22s %10.1f KB\n", "file size", fileBytes / 1024.0);
+        std::printf("%-22s %10.2f ms\n", "build by hand", handMs);
+        std::printf("%-22s %10.2f ms\n", "save", saveMs);
+        std::printf("%-22s %10.2f ms  (scene teardown %.2f ms)\n", "load", loadMs, destroyMs);
+        std::printf("%-22s %10.2f ms  (%.1f MB)\n", "export text", textMs, textBytes / (1024.0 * 1024.0));
+        std::printf("%-22s %10s\n", "round trip", roundTrip ? "identical" : "MISMATCH");
+
+        fs::remove(scenePath);
+        fs::remove(resavePath);
+        models.clear();
+        core::ResourceManager::Shutdown();
+    }
+
+} // namespace bench
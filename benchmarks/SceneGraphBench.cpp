@@ -0,0 +1,121 @@
+#include "Bench.h"
+#include "scene/TransformSystem.h"
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+    using scene::TransformHandle;
+    using scene::TransformSystem;
+
+    constexpr size_t kNodeCount = 100000;
+
+    /// 层级形状：返回每个节点的父节点下标（-1 为根），父节点总在子节点之前创建
+    struct Shape {
+        const char* name;
+        std::function<int(size_t)> parentOf;
+    };
+
+    /// 对照：指针树每帧从根递归（显式栈）重算全部世界矩阵
+    struct PointerNode {
+        glm::mat4 local{1.0f};
+        glm::mat4 world{1.0f};
+        std::vector<PointerNode*> children;
+    };
+
+    double MeasurePointerTree(const std::vector<int>& parents) {
+        std::vector<std::unique_ptr<PointerNode>> nodes;
+        std::vector<PointerNode*> roots;
+        for (size_t i = 0; i < parents.size(); ++i) {
+            nodes.push_back(std::make_unique<PointerNode>());
+            nodes.back()->local = TransformSystem::ComposeMatrix(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+                                                                 glm::vec3(1.0f));
+            if (parents[i] < 0) roots.push_back(nodes.back().get());
+            else nodes[parents[i]]->children.push_back(nodes.back().get());
+        }
+        std::vector<std::pair<PointerNode*, const glm::mat4*>> stack;
+        const glm::mat4 identity(1.0f);
+        return MeasureMs([&] {
+            for (PointerNode* root : roots) stack.emplace_back(root, &identity);
+            while (!stack.empty()) {
+                auto [node, parentWorld] = stack.back();
+                stack.pop_back();
+                node->world = *parentWorld * node->local;
+                for (PointerNode* child : node->children) stack.emplace_back(child, &node->world);
+            }
+        }, 11);
+    }
+
+} // namespace
+
+    void RunSceneGraph() {
+        const std::vector<Shape> shapes = {
+            {"wide (1 root, 99999 children)", [](size_t i) { return i == 0 ? -1 : 0; }},
+            {"8-ary tree", [](size_t i) { return i == 0 ? -1 : static_cast<int>((i - 1) / 8); }},
+            {"100 chains x 1000 deep", [](size_t i) { return i % 1000 == 0 ? -1 : static_cast<int>(i - 1); }},
+            {"single chain 100000 deep", [](size_t i) { return static_cast<int>(i) - 1; }},
+        };
+        const unsigned int hwThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::printf("%zu nodes, %u hardware threads\n", kNodeCount, hwThreads);
+        std::printf("%-30s %7s %9s %9s %9s %9s %9s %9s\n", "hierarchy", "levels", "build ms", "root ms",
+                    "root mt", "1% ms", "clean ms", "ptr ms");
+        for (const auto& shape : shapes) {
+            std::vector<int> parents(kNodeCount);
+            for (size_t i = 0; i < kNodeCount; ++i) parents[i] = shape.parentOf(i);
+
+            std::vector<TransformHandle> handles(kNodeCount);
+            for (size_t i = 0; i < kNodeCount; ++i) {
+                handles[i] = TransformSystem::Create(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+                if (parents[i] >= 0) TransformSystem::SetParent(handles[i], handles[parents[i]]);
+            }
+            // 首次更新包含广度优先重排与全部矩阵计算
+            const double buildMs = MeasureMs([] { TransformSystem::Update(); }, 1);
+            const size_t levels = TransformSystem::GetStats().levels;
+
+            // 移动所有根节点：整棵树都要重新传播
+            std::vector<TransformHandle> roots;
+            for (size_t i = 0; i < kNodeCount; ++i)
+                if (parents[i] < 0) roots.push_back(handles[i]);
+            int frame = 0;
+            auto moveRoots = [&] {
+                const float t = static_cast<float>(++frame);
+                for (auto root : roots) TransformSystem::SetPosition(root, glm::vec3(t, 0.0f, 0.0f));
+                TransformSystem::Update();
+            };
+            const double rootMs = MeasureMs(moveRoots, 11);
+            TransformSystem::SetThreadCount(0);
+            const double rootParallelMs = MeasureMs(moveRoots, 11);
+            TransformSystem::SetThreadCount(1);
+
+            // 随机旋转 1% 的节点：只传播它们的子树
+            std::mt19937 rng(5);
+            std::uniform_int_distribution<size_t> pick(0, kNodeCount - 1);
+            const double sparseMs = MeasureMs([&] {
+                const float t = static_cast<float>(++frame);
+                for (size_t i = 0; i < kNodeCount / 100; ++i)
+                    TransformSystem::SetRotation(handles[pick(rng)], glm::vec3(0.0f, t, 0.0f));
+                TransformSystem::Update();
+            }, 11);
+
+            const double cleanMs = MeasureMs([] { TransformSystem::Update(); }, 11);
+            const double pointerMs = MeasurePointerTree(parents);
+
+            // 叶子先销毁，避免逐个把子节点变回根节点
+            for (size_t i = kNodeCount; i-- > 0;) TransformSystem::Destroy(handles[i]);
+            TransformSystem::Update();
+
+            std::printf("%-30s %7zu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", shape.name, levels, buildMs, rootMs,
+                        rootParallelMs, sparseMs, cleanMs, pointerMs);
+        }
+        std::printf("root: move every root and propagate the whole hierarchy (mt = all hardware threads);\n"
+                    "1%%: rotate 1%% random nodes and propagate their subtrees; ptr: pointer tree, full recursive "
+                    "recompute\n");
+    }
+
+} // namespace bench
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "graphics/ShaderSource.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+    void RunShader() {
+        const std::vector<std::string> sources = {
+            PathResolver::Resolve("shaders/blinn_phong/blinnphong.vert"),
+            PathResolver::Resolve("shaders/blinn_phong/blinnphong.frag"),
+            PathResolver::Resolve("shaders/outline/outline.vert"),
+            PathResolver::Resolve("shaders/outline/outline.frag"),
+            PathResolver::Resolve("shaders/basic.vert"),
+            PathResolver::Resolve("shaders/basic.frag"),
+        };
+
+        size_t includes = 0, bytes = 0;
+        for (const auto& path : sources) {
+            const auto preprocessed = graphics::ShaderSource::Preprocess(path);
+            includes += preprocessed.dependencies.size();
+            bytes += preprocessed.source.size();
+        }
+
+        // 源文件展开（读取全部被包含文件并去除注释）
+        double preprocessMs = MeasureMs([&] {
+            for (const auto& path : sources) graphics::ShaderSource::Preprocess(path);
+        }, 20);
+
+        // 烘焙结果：读取并按源文件与依赖的哈希校验
+        for (const auto& path : sources) graphics::ShaderSource::Cook(path, graphics::ShaderSource::GetCookedPath(path));
+        double cookedMs = MeasureMs([&] {
+            graphics::ShaderSource::ClearCache();
+            for (const auto& path : sources) graphics::ShaderSource::Load(path);
+        }, 20);
+
+        // 内存缓存命中（同一进程内再次创建程序）
+        graphics::ShaderSource::ClearCache();
+        for (const auto& path : sources) graphics::ShaderSource::Load(path);
+        double cachedMs = MeasureMs([&] {
+            for (const auto& path : sources) graphics::ShaderSource::Load(path);
+        }, 20);
+        graphics::ShaderSource::ClearCache();
+
+        std::printf("%zu shader files, %zu includes, %.1f KB preprocessed\n", sources.size(), includes, bytes / 1024.0);
+        std::printf("%-28s %10s\n", "source path", "ms");
+        std::printf("%-28s %10.3f\n", "preprocess from source", preprocessMs);
+        std::printf("%-28s %10.3f\n", "cooked .rglsl (validated)", cookedMs);
+        std::printf("%-28s %10.3f\n", "in-memory cache", cachedMs);
+        std::printf("GL compile/link and program-binary times are logged by Rrender at startup "
+                    "(run once with --no-shader-cache for a cold start, then normally for a warm start)\n");
+    }
+
+} // namespace bench
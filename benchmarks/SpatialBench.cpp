@@ -0,0 +1,179 @@
+#include "Bench.h"
+#include "scene/AabbTree.h"
+#include "scene/Scene.h"
+#include "scene/TransformSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+    using graphics::BoundingBox;
+
+    bool Overlaps(const BoundingBox& a, const BoundingBox& b) {
+        return glm::all(glm::lessThanEqual(a.min, b.max)) && glm::all(glm::lessThanEqual(b.min, a.max));
+    }
+
+    /// 线性遍历的射线求交（对照），返回最近的进入距离
+    float LinearRay(const std::vector<BoundingBox>& boxes, const glm::vec3& origin, const glm::vec3& direction) {
+        const glm::vec3 inverse = 1.0f / direction;
+        float best = 1e30f;
+        for (const auto& box : boxes) {
+            const glm::vec3 t1 = (box.min - origin) * inverse, t2 = (box.max - origin) * inverse;
+            const glm::vec3 tNear = glm::min(t1, t2), tFar = glm::max(t1, t2);
+            const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+            const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, best));
+            if (tEnter <= tExit) best = tEnter;
+        }
+        return best;
+    }
+
+    void RunTreeSize(size_t count) {
+        // 对象密度固定：每个对象约占 10 x 10 x 10 的空间，包围盒半长 0.2 ~ 2
+        const float side = 10.0f * std::cbrt(static_cast<float>(count));
+        std::mt19937 rng(static_cast<unsigned>(count));
+        std::uniform_real_distribution<float> pos(-0.5f * side, 0.5f * side), half(0.2f, 2.0f), step(-0.3f, 0.3f);
+        std::vector<BoundingBox> boxes(count);
+        for (auto& box : boxes) {
+            const glm::vec3 c(pos(rng), pos(rng), pos(rng)), h(half(rng), half(rng), half(rng));
+            box = BoundingBox{c - h, c + h};
+        }
+
+        scene::AabbTree tree;
+        std::vector<int32_t> proxies(count);
+        const double buildMs = MeasureMs([&] {
+            tree.Clear();
+            for (size_t i = 0; i < count; ++i) proxies[i] = tree.CreateProxy(boxes[i], static_cast<uint32_t>(i));
+        }, 1);
+
+        // 每帧 10% 的对象移动一小步（约一半帧会移出放大范围）
+        std::vector<glm::vec3> velocity(count / 10);
+        for (auto& v : velocity) v = glm::vec3(step(rng), step(rng), step(rng));
+        const size_t reinsertsBefore = tree.GetReinsertCount();
+        constexpr int kFrames = 10;
+        const double moveMs = MeasureMs([&] {
+            for (size_t i = 0; i < velocity.size(); ++i) {
+                boxes[i].min += velocity[i];
+                boxes[i].max += velocity[i];
+                tree.MoveProxy(proxies[i], boxes[i]);
+            }
+        }, kFrames);
+        const double reinsertRate =
+            static_cast<double>(tree.GetReinsertCount() - reinsertsBefore) / (kFrames * velocity.size());
+
+        // 查询：局部包围盒 / 球、视距为场景边长 1/4 的视锥、随机射线
+        constexpr int kQueries = 200;
+        std::vector<glm::vec3> centers(kQueries), directions(kQueries);
+        for (int i = 0; i < kQueries; ++i) {
+            centers[i] = glm::vec3(pos(rng), pos(rng), pos(rng));
+            directions[i] = glm::normalize(glm::vec3(step(rng), step(rng), step(rng)) + glm::vec3(1e-3f));
+        }
+        size_t boxHits = 0, sphereHits = 0, frustumHits = 0;
+        const double boxMs = MeasureMs([&] {
+            boxHits = 0;
+            for (const auto& c : centers)
+                tree.QueryBox(BoundingBox{c - glm::vec3(20.0f), c + glm::vec3(20.0f)}, [&](uint32_t) { ++boxHits; return true; });
+        });
+        const double sphereMs = MeasureMs([&] {
+            sphereHits = 0;
+            for (const auto& c : centers)
+                tree.QuerySphere(graphics::BoundingSphere{c, 20.0f}, [&](uint32_t) { ++sphereHits; return true; });
+        });
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 0.25f * side);
+        const double frustumMs = MeasureMs([&] {
+            frustumHits = 0;
+            for (int i = 0; i < kQueries; ++i) {
+                const glm::mat4 view = glm::lookAt(centers[i], centers[i] + directions[i], glm::vec3(0, 1, 0));
+                tree.QueryFrustum(graphics::Frustum::FromMatrix(projection * view), [&](uint32_t) { ++frustumHits; return true; });
+            }
+        });
+        std::vector<float> rayResults(kQueries);
+        const double rayMs = MeasureMs([&] {
+            for (int i = 0; i < kQueries; ++i) {
+                float best = 1e30f;
+                tree.RayCast(centers[i], directions[i], 1e30f, [&](uint32_t index, float, float tMax) {
+                    const BoundingBox& box = boxes[index];
+                    const glm::vec3 inverse = 1.0f / directions[i];
+                    const glm::vec3 t1 = (box.min - centers[i]) * inverse, t2 = (box.max - centers[i]) * inverse;
+                    const glm::vec3 tNear = glm::min(t1, t2), tFar = glm::max(t1, t2);
+                    const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+                    const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+                    if (tEnter > tExit) return tMax;
+                    best = std::min(best, tEnter);
+                    return std::max(tEnter, 1e-30f);
+                });
+                rayResults[i] = best;
+            }
+        });
+
+        // 对照：线性遍历（查询数较少，按单次查询折算）
+        constexpr int kLinearQueries = 10;
+        size_t linearHits = 0;
+        const double linearBoxMs = MeasureMs([&] {
+            linearHits = 0;
+            for (int i = 0; i < kLinearQueries; ++i) {
+                const BoundingBox query{centers[i] - glm::vec3(20.0f), centers[i] + glm::vec3(20.0f)};
+                for (const auto& box : boxes) linearHits += Overlaps(box, query);
+            }
+        }, 3);
+        bool raysMatch = true;
+        const double linearRayMs = MeasureMs([&] {
+            for (int i = 0; i < kLinearQueries; ++i)
+                raysMatch &= std::abs(LinearRay(boxes, centers[i], directions[i]) - rayResults[i]) < 1e-3f;
+        }, 3);
+
+        std::printf("\n%zu objects: build %.1f ms, height %d, area ratio %.1f\n", count, buildMs, tree.GetHeight(),
+                    tree.GetAreaRatio());
+        std::printf("  move 10%%: %.3f ms/frame (%.0f ns/object, %.0f%% reinserted)\n", moveMs,
+                    1e6 * moveMs / velocity.size(), 100.0 * reinsertRate);
+        std::printf("  %-10s %12s %12s %10s\n", "query", "tree us", "linear us", "avg hits");
+        std::printf("  %-10s %12.2f %12.2f %10.1f\n", "box", 1e3 * boxMs / kQueries, 1e3 * linearBoxMs / kLinearQueries,
+                    static_cast<double>(boxHits) / kQueries);
+        std::printf("  %-10s %12.2f %12s %10.1f\n", "sphere", 1e3 * sphereMs / kQueries, "-",
+                    static_cast<double>(sphereHits) / kQueries);
+        std::printf("  %-10s %12.2f %12s %10.1f\n", "frustum", 1e3 * frustumMs / kQueries, "-",
+                    static_cast<double>(frustumHits) / kQueries);
+        std::printf("  %-10s %12.2f %12.2f %10s\n", "ray", 1e3 * rayMs / kQueries, 1e3 * linearRayMs / kLinearQueries,
+                    raysMatch ? "match" : "MISMATCH");
+    }
+
+} // namespace
+
+    void RunSpatial() {
+        for (size_t count : {size_t(10000), size_t(100000), size_t(1000000)}) RunTreeSize(count);
+
+        // Scene 的增量同步：10^5 个实体（无模型，包围盒为一个点），每帧 10% 移动
+        constexpr size_t kEntities = 100000;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> pos(-500.0f, 500.0f), step(-0.3f, 0.3f);
+        scene::Scene world;
+        std::vector<std::shared_ptr<scene::Entity>> entities(kEntities);
+        const double addMs = MeasureMs([&] {
+            for (auto& entity : entities) {
+                entity = std::make_shared<scene::Entity>(nullptr);
+                entity->SetPosition(glm::vec3(pos(rng), pos(rng), pos(rng)));
+                world.AddEntity(entity);
+            }
+        }, 1);
+        scene::TransformSystem::Update();
+        world.Update();
+        const double updateMs = MeasureMs([&] {
+            for (size_t i = 0; i < kEntities; i += 10)
+                entities[i]->SetPosition(entities[i]->GetPosition() + glm::vec3(step(rng), step(rng), step(rng)));
+            scene::TransformSystem::Update();
+            world.Update();
+        }, 11);
+        const double idleMs = MeasureMs([&] {
+            scene::TransformSystem::Update();
+            world.Update();
+        }, 11);
+        world.GetSpatialIndex().Validate();
+        std::printf("\nScene with %zu entities: AddEntity %.1f ms total, Update with 10%% moving %.3f ms, idle %.3f ms\n",
+                    kEntities, addMs, updateMs, idleMs);
+    }
+
+} // namespace bench
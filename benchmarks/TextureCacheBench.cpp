@@ -0,0 +1,111 @@
+#include "Bench.h"
+#include "graphics/ObjParser.h"
+#include "graphics/TextureCache.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+    void RunTextureCache() {
+        graphics::TextureCache::Clear();
+        graphics::TextureCache::ResetStats();
+
+        // 各模型材质引用的纹理路径（每个材质的漫反射/高光/法线各算一次引用）
+        std::vector<std::vector<std::string>> modelReferences;
+        for (const char* relative : ShippedModels()) {
+            const std::string objPath = PathResolver::Resolve(relative);
+            if (!fs::exists(objPath)) continue;
+            const graphics::ObjData obj = graphics::ObjParser::Parse(objPath);
+            const fs::path directory = fs::path(objPath).parent_path();
+            std::vector<std::string> references;
+            for (const auto& mat : obj.materials) {
+                for (const std::string* name : {&mat.diffuseTexname, &mat.specularTexname, &mat.bumpTexname}) {
+                    if (!name->empty()) references.push_back((directory / *name).string());
+                }
+            }
+            modelReferences.push_back(std::move(references));
+        }
+
+        // 旧行为一：每个模型各自按路径缓存
+        size_t references = 0, perModelUploads = 0;
+        for (const auto& model : modelReferences) {
+            references += model.size();
+            perModelUploads += std::set<std::string>(model.begin(), model.end()).size();
+        }
+
+        // 旧行为二：ResourceManager 按文件名（不含扩展名）登记，不同目录的同名文件互相覆盖
+        std::map<std::string, std::set<std::string>> byStem;
+        for (const auto& model : modelReferences) {
+            for (const auto& path : model) byStem[fs::path(path).stem().string()].insert(graphics::TextureCache::GetCanonicalPath(path));
+        }
+        size_t stemCollisions = 0;
+        for (const auto& entry : byStem) stemCollisions += entry.second.size() - 1;
+
+        // 全局缓存：先按模型材质引用，再以另一种写法的路径（ResourceManager 直接加载）访问同一文件
+        double acquireMs = MeasureMs([&] {
+            graphics::TextureCache::Clear();
+            graphics::TextureCache::ResetStats();
+            for (const auto& model : modelReferences) {
+                for (const auto& path : model) {
+                    bool created = false;
+                    graphics::TextureCache::Acquire(path, false, created);
+                }
+            }
+            for (const auto& model : modelReferences) {
+                for (const auto& path : model) {
+                    const fs::path p(path);
+                    bool created = false;
+                    graphics::TextureCache::Acquire((p.parent_path() / "." / p.filename()).string(), false, created);
+                }
+            }
+            graphics::TextureCache::EndFrame();
+        }, 3);
+        // 内容寻址：同一文件复制到其他目录并改名后仍命中
+        bool contentHit = false;
+        if (!modelReferences.empty() && !modelReferences.front().empty()) {
+            const std::string& original = modelReferences.front().front();
+            const fs::path copy = fs::temp_directory_path() / ("texcache_copy" + fs::path(original).extension().string());
+            fs::copy_file(original, copy, fs::copy_options::overwrite_existing);
+            bool created = true;
+            contentHit = graphics::TextureCache::Acquire(copy.string(), false, created) ==
+                             graphics::TextureCache::Find(original, false) && !created;
+            fs::remove(copy);
+        }
+        const auto stats = graphics::TextureCache::GetStats();
+
+        // 命中已发布登记的查找开销（无锁）
+        graphics::TextureCache::EndFrame();
+        std::vector<std::string> paths;
+        for (const auto& model : modelReferences) paths.insert(paths.end(), model.begin(), model.end());
+        constexpr int kRounds = 2000;
+        size_t found = 0;
+        double findMs = MeasureMs([&] {
+            for (int r = 0; r < kRounds; ++r) {
+                for (const auto& path : paths) found += graphics::TextureCache::Find(path, false) != nullptr;
+            }
+        }, 3);
+
+        std::printf("material texture references : %zu\n", references);
+        std::printf("uploads, per-model caches   : %zu\n", perModelUploads);
+        std::printf("stem-keyed name collisions  : %zu\n", stemCollisions);
+        std::printf("global cache lookups        : %zu (path hits %zu, content hits %zu)\n", stats.lookups, stats.pathHits,
+                    stats.contentHits);
+        std::printf("uploads, global cache       : %zu textures for %zu paths (incl. aliases)\n", stats.textures, stats.paths);
+        std::printf("renamed copy shares texture : %s\n", contentHit ? "yes" : "no");
+        std::printf("duplicate uploads avoided   : %zu vs per-model caches, %zu vs uncached references\n",
+                    perModelUploads - stats.textures, references - stats.textures);
+        std::printf("acquire all (incl. hashing) : %.2f ms\n", acquireMs);
+        std::printf("cached Find                 : %.0f ns/lookup (%zu found)\n",
+                    findMs * 1e6 / (static_cast<double>(kRounds) * paths.size()), found / 3 / kRounds);
+
+        graphics::TextureCache::Clear();
+    }
+
+} // namespace bench
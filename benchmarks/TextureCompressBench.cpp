@@ -0,0 +1,88 @@
+#include "Bench.h"
+#include "graphics/BlockCompression.h"
+#include "graphics/Model.h"
+#include "graphics/TextureFile.h"
+#include "utils/PathResolver.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    // RGB 峰值信噪比（dB），BC5 只比较 RG 两个通道
+    double ComputePsnr(const uint8_t* a, const uint8_t* b, size_t pixelCount, int channels) {
+        double sum = 0.0;
+        for (size_t i = 0; i < pixelCount; ++i) {
+            for (int ch = 0; ch < channels; ++ch) {
+                double d = static_cast<double>(a[i * 4 + ch]) - b[i * 4 + ch];
+                sum += d * d;
+            }
+        }
+        double mse = sum / (static_cast<double>(pixelCount) * channels);
+        return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+} // namespace
+
+    void RunTextureCompress() {
+        // 各格式编码吞吐与质量（以 cyborg 漫反射贴图为样本）
+        const std::string samplePath = PathResolver::Resolve("assets/objects/cyborg/cyborg_diffuse.png");
+        if (fs::exists(samplePath)) {
+            graphics::ImageData image = graphics::ImageData::LoadFromFile(samplePath, 4);
+            const double megapixels = image.width * static_cast<double>(image.height) / 1e6;
+            std::printf("%-6s %12s %10s\n", "format", "MPix/s", "PSNR dB");
+            for (auto format : {graphics::TextureFormat::BC1, graphics::TextureFormat::BC3,
+                                graphics::TextureFormat::BC5, graphics::TextureFormat::BC7}) {
+                std::vector<uint8_t> blocks;
+                double ms = MeasureMs([&] {
+                    blocks = graphics::BlockCompressor::Compress(format, image.pixels.get(), image.width, image.height);
+                }, 3);
+                std::vector<uint8_t> decoded = graphics::BlockCompressor::Decompress(format, blocks.data(), image.width, image.height);
+                double psnr = ComputePsnr(image.pixels.get(), decoded.data(), static_cast<size_t>(image.width) * image.height,
+                                          format == graphics::TextureFormat::BC5 ? 2 : 3);
+                std::printf("%-6s %12.1f %10.2f\n", graphics::GetTextureFormatName(format), megapixels / (ms / 1000.0), psnr);
+            }
+            std::printf("\n");
+        }
+
+        // 各模型烘焙后显存（含完整 mip 链）
+        std::printf("%-12s %8s %14s %14s %8s %12s\n", "model", "textures", "raw VRAM MB", "BCn VRAM MB", "saved", "encode MPix/s");
+        const fs::path tempDir = fs::temp_directory_path();
+        for (const char* relative : ShippedModels()) {
+            const std::string objPath = PathResolver::Resolve(relative);
+            if (!fs::exists(objPath)) continue;
+
+            graphics::ModelData data = graphics::Model::LoadData(objPath);
+            size_t textureCount = 0, rawBytes = 0, cookedBytes = 0;
+            double encodeMs = 0.0, megapixels = 0.0;
+            for (const auto& texturePath : data.GetTexturePaths()) {
+                if (!fs::exists(texturePath)) continue;
+                const std::string cookedPath = (tempDir / (fs::path(texturePath).filename().string() + ".bench.rtex")).string();
+                auto stats = graphics::TextureFile::Cook(texturePath, cookedPath,
+                                                         graphics::TextureFile::GetDefaultCookOptions(texturePath));
+                {
+                    graphics::TextureFile file;
+                    if (!file.Open(cookedPath, texturePath) || file.GetFormat() != stats.format)
+                        throw std::runtime_error("cooked texture rejected: " + cookedPath);
+                }
+                fs::remove(cookedPath);
+
+                ++textureCount;
+                rawBytes += stats.uncompressedBytes;
+                cookedBytes += stats.cookedBytes;
+                encodeMs += stats.encodeMs;
+                megapixels += stats.width * static_cast<double>(stats.height) * 4.0 / 3.0 / 1e6;
+            }
+            if (textureCount == 0) continue;
+            std::printf("%-12s %8zu %14.1f %14.1f %7.0f%% %12.1f\n", fs::path(relative).stem().string().c_str(), textureCount,
+                        rawBytes / (1024.0 * 1024.0), cookedBytes / (1024.0 * 1024.0),
+                        100.0 * (1.0 - static_cast<double>(cookedBytes) / rawBytes), megapixels / (encodeMs / 1000.0));
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,123 @@
+#include "Bench.h"
+#include "scene/TransformSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <utility>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+    /// 原 Entity::GetModelMatrix 的写法，作为对照
+    glm::mat4 LegacyModelMatrix(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, position);
+        model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1, 0, 0));
+        model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0, 1, 0));
+        model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0, 0, 1));
+        model = glm::scale(model, scale);
+        return model;
+    }
+
+} // namespace
+
+    void RunTransform() {
+        using scene::TransformSystem;
+        constexpr size_t kCount = 100000;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(-100.0f, 100.0f), angle(-720.0f, 720.0f), scl(0.1f, 4.0f);
+        std::vector<glm::vec3> positions(kCount), rotations(kCount), scales(kCount);
+        std::vector<scene::TransformHandle> handles(kCount);
+        for (size_t i = 0; i < kCount; ++i) {
+            positions[i] = {pos(rng), pos(rng), pos(rng)};
+            rotations[i] = {angle(rng), angle(rng), angle(rng)};
+            scales[i] = {scl(rng), scl(rng), scl(rng)};
+            handles[i] = TransformSystem::Create(positions[i], rotations[i], scales[i]);
+        }
+        TransformSystem::Update();
+
+        // 批量结果与原 glm 写法的最大偏差（相对矩阵元素的最大绝对值）
+        float maxError = 0.0f;
+        for (size_t i = 0; i < kCount; ++i) {
+            const glm::mat4 expected = LegacyModelMatrix(positions[i], rotations[i], scales[i]);
+            const glm::mat4 actual = TransformSystem::GetWorldMatrix(handles[i]);
+            float scale = 1.0f, diff = 0.0f;
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r) {
+                    scale = std::max(scale, std::abs(expected[c][r]));
+                    diff = std::max(diff, std::abs(expected[c][r] - actual[c][r]));
+                }
+            maxError = std::max(maxError, diff / scale);
+        }
+
+        // 每帧修改全部实体：只移动，或同时移动并旋转
+        int frame = 0;
+        auto setAll = [&](bool rotate) {
+            const float t = static_cast<float>(++frame);
+            for (size_t i = 0; i < kCount; ++i) {
+                TransformSystem::SetPosition(handles[i], positions[i] + glm::vec3(0.0f, 0.01f * t, 0.0f));
+                if (rotate) TransformSystem::SetRotation(handles[i], rotations[i] + glm::vec3(0.0f, t, 0.0f));
+            }
+        };
+        // 返回 {设置 + Update 总耗时, 其中 Update 耗时} 的中位数
+        auto measure = [&](bool rotate) {
+            std::vector<double> totals, updates;
+            for (int i = 0; i < 21; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                setAll(rotate);
+                TransformSystem::Update();
+                totals.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                updates.push_back(TransformSystem::GetStats().updateMs);
+            }
+            std::sort(totals.begin(), totals.end());
+            std::sort(updates.begin(), updates.end());
+            return std::make_pair(totals[totals.size() / 2], updates[updates.size() / 2]);
+        };
+        const auto moveSimd = measure(false);
+        const auto rotateSimd = measure(true);
+        TransformSystem::SetSimdEnabled(false);
+        const auto rotateScalar = measure(true);
+        TransformSystem::SetSimdEnabled(true);
+
+        // 随机顺序修改 10% 的实体（脏列表需要排序，加载多为逐个收集）
+        std::vector<size_t> order(kCount);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::shuffle(order.begin(), order.end(), rng);
+        const double sparseMs = MeasureMs([&] {
+            const float t = static_cast<float>(++frame);
+            for (size_t i = 0; i < kCount / 10; ++i)
+                TransformSystem::SetPosition(handles[order[i]], positions[order[i]] + glm::vec3(t));
+            TransformSystem::Update();
+        }, 21);
+
+        // 无修改时的帧开销
+        const double cleanMs = MeasureMs([&] { TransformSystem::Update(); }, 21);
+
+        // 原写法：每个实体每帧两次 GetModelMatrix（描边管线）
+        std::vector<glm::mat4> legacy(kCount);
+        const double legacyMs = MeasureMs([&] {
+            for (size_t i = 0; i < kCount; ++i) {
+                legacy[i] = LegacyModelMatrix(positions[i], rotations[i], scales[i]);
+                legacy[i] = LegacyModelMatrix(positions[i], rotations[i], scales[i]);
+            }
+        }, 21);
+
+        for (auto handle : handles) TransformSystem::Destroy(handle);
+
+        std::printf("%zu transforms, max relative error vs glm::rotate chain %.2e\n", kCount, maxError);
+        std::printf("batch kernel: %u wide\n", TransformSystem::GetSimdWidth());
+        std::printf("%-34s %10s %10s\n", "per frame", "total ms", "Update ms");
+        std::printf("%-34s %10.3f %10.3f\n", "set position", moveSimd.first, moveSimd.second);
+        std::printf("%-34s %10.3f %10.3f\n", "set position + rotation", rotateSimd.first, rotateSimd.second);
+        std::printf("%-34s %10.3f %10.3f\n", "set position + rotation (scalar)", rotateScalar.first, rotateScalar.second);
+        std::printf("%-34s %10.3f\n", "10% random set position", sparseMs);
+        std::printf("%-34s %10.3f\n", "nothing dirty", cleanMs);
+        std::printf("%-34s %10.3f\n", "legacy glm::rotate chain x2", legacyMs);
+    }
+
+} // namespace bench
@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "graphics/MeshOptimizer.h"
+#include "graphics/ObjParser.h"
+#include "utils/PathResolver.h"
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    // 按三角形数加权汇总各子网格的 ACMR/ATVR
+    graphics::VertexCacheStats Analyze(const std::vector<graphics::MeshData>& meshes) {
+        double misses = 0.0, triangles = 0.0, vertices = 0.0;
+        for (const auto& mesh : meshes) {
+            auto stats = graphics::MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+            const double triCount = mesh.indices.size() / 3.0;
+            misses += stats.acmr * triCount;
+            triangles += triCount;
+            vertices += stats.acmr > 0.0f ? stats.acmr * triCount / stats.atvr : 0.0;
+        }
+        graphics::VertexCacheStats total;
+        total.acmr = triangles > 0.0 ? static_cast<float>(misses / triangles) : 0.0f;
+        total.atvr = vertices > 0.0 ? static_cast<float>(misses / vertices) : 0.0f;
+        return total;
+    }
+
+} // namespace
+
+    void RunVertexCache() {
+        std::printf("FIFO cache size %u\n", graphics::MeshOptimizer::kAnalyzeCacheSize);
+        std::printf("%-12s %10s %10s %10s %10s %10s %10s\n", "model", "triangles", "ACMR", "ACMR opt", "ATVR", "ATVR opt", "opt ms");
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+
+            graphics::ObjData obj = graphics::ObjParser::Parse(path);
+            const std::vector<graphics::MeshData> raw = graphics::ObjParser::BuildMeshes(obj);
+            size_t triangles = 0;
+            for (const auto& mesh : raw) triangles += mesh.indices.size() / 3;
+
+            std::vector<graphics::MeshData> optimized;
+            double ms = MeasureMs([&] {
+                optimized = raw;
+                graphics::MeshOptimizer::OptimizeMeshes(optimized, 1);
+            }, 3);
+
+            auto before = Analyze(raw);
+            auto after = Analyze(optimized);
+            std::printf("%-12s %10zu %10.3f %10.3f %10.3f %10.3f %10.1f\n", fs::path(relative).stem().string().c_str(),
+                        triangles, before.acmr, after.acmr, before.atvr, after.atvr, ms);
+        }
+    }
+
+} // namespace bench
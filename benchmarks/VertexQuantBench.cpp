@@ -0,0 +1,85 @@
+#include "Bench.h"
+#include "graphics/ObjParser.h"
+#include "graphics/VertexQuantizer.h"
+#include "utils/PathResolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    struct FormatReport {
+        size_t vertexBytes = 0;
+        graphics::QuantizationError error; ///< 各子网格误差的最大值，RMS 按顶点数加权
+        double ms = 0.0;
+    };
+
+    FormatReport Evaluate(const std::vector<graphics::MeshData>& meshes, graphics::VertexFormat format) {
+        FormatReport report;
+        double sumSquared = 0.0, sumAngle = 0.0;
+        size_t vertexCount = 0;
+        report.ms = MeasureMs([&] {
+            for (const auto& mesh : meshes)
+                graphics::VertexQuantizer::Quantize(mesh.vertices.data(), mesh.vertices.size(), format);
+        }, 3);
+        for (const auto& mesh : meshes) {
+            auto quantized = graphics::VertexQuantizer::Quantize(mesh.vertices.data(), mesh.vertices.size(), format);
+            auto error = graphics::VertexQuantizer::Measure(mesh.vertices.data(), quantized);
+            report.vertexBytes += quantized.data.size();
+            report.error.maxPosition = std::max(report.error.maxPosition, error.maxPosition);
+            report.error.boundsDiagonal = std::max(report.error.boundsDiagonal, error.boundsDiagonal);
+            report.error.maxNormalDeg = std::max(report.error.maxNormalDeg, error.maxNormalDeg);
+            report.error.maxTexCoord = std::max(report.error.maxTexCoord, error.maxTexCoord);
+            sumSquared += static_cast<double>(error.rmsPosition) * error.rmsPosition * mesh.vertices.size();
+            sumAngle += static_cast<double>(error.meanNormalDeg) * mesh.vertices.size();
+            vertexCount += mesh.vertices.size();
+        }
+        if (vertexCount > 0) {
+            report.error.rmsPosition = static_cast<float>(std::sqrt(sumSquared / vertexCount));
+            report.error.meanNormalDeg = static_cast<float>(sumAngle / vertexCount);
+        }
+        return report;
+    }
+
+} // namespace
+
+    void RunVertexQuant() {
+        const struct {
+            const char* name;
+            graphics::VertexFormat format;
+        } formats[] = {
+            {"compact16", graphics::VertexFormat::Compact16},
+            {"compact8", graphics::VertexFormat::Compact8},
+        };
+
+        std::printf("%-12s %-10s %9s %9s %7s %10s %10s %9s %9s %9s %8s\n", "model", "format", "VB KB", "float KB",
+                    "ratio", "pos max", "pos rms", "nrm max", "nrm mean", "uv max", "ms");
+        for (const char* relative : ShippedModels()) {
+            const std::string path = PathResolver::Resolve(relative);
+            if (!fs::exists(path)) continue;
+
+            graphics::ObjData obj = graphics::ObjParser::Parse(path);
+            const std::vector<graphics::MeshData> meshes = graphics::ObjParser::BuildMeshes(obj);
+            size_t floatBytes = 0;
+            for (const auto& mesh : meshes) floatBytes += mesh.vertices.size() * sizeof(graphics::Vertex);
+
+            const std::string model = fs::path(relative).stem().string();
+            for (const auto& format : formats) {
+                FormatReport report = Evaluate(meshes, format.format);
+                // 位置误差以包围盒对角线的比例（ppm）表示
+                const double diagonal = std::max(report.error.boundsDiagonal, 1e-6f);
+                std::printf("%-12s %-10s %9.1f %9.1f %6.2fx %7.2fppm %7.2fppm %8.3fd %8.3fd %9.2e %8.2f\n",
+                            model.c_str(), format.name, report.vertexBytes / 1024.0, floatBytes / 1024.0,
+                            static_cast<double>(floatBytes) / std::max<size_t>(report.vertexBytes, 1),
+                            report.error.maxPosition / diagonal * 1e6, report.error.rmsPosition / diagonal * 1e6,
+                            report.error.maxNormalDeg, report.error.meanNormalDeg, report.error.maxTexCoord, report.ms);
+            }
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "graphics/MeshCache.h"
+#include "graphics/Model.h"
+#include "graphics/ShaderSource.h"
+#include "graphics/TextureFile.h"
+#include "resource/AssetCooker.h"
+#include "utils/PathResolver.h"
+#include "utils/VirtualFileSystem.h"
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+namespace {
+
+    // 模拟启动加载：着色器 + 各模型网格及其全部纹理
+    size_t LoadStartupSet(const std::vector<std::string>& shaders) {
+        size_t bytes = 0;
+        for (const auto& shader : shaders) bytes += graphics::ShaderSource::Load(shader).size();
+        for (const char* relative : ShippedModels()) {
+            const std::string objPath = PathResolver::Resolve(relative);
+            graphics::ModelData data = graphics::Model::LoadData(objPath);
+            for (const auto& mesh : data.meshes) bytes += mesh.vertexCount;
+            // 直接打开烘焙文件（无GL上下文时 TextureSource 会认为压缩格式不受支持）
+            for (const auto& texturePath : data.GetTexturePaths()) {
+                graphics::TextureFile file;
+                if (file.Open(graphics::TextureFile::GetCookedPath(texturePath), texturePath)) {
+                    for (const auto& level : file.GetLevels()) bytes += level.data[level.size - 1];
+                } else {
+                    bytes += graphics::ImageData::LoadFromFile(texturePath).GetByteSize();
+                }
+            }
+        }
+        return bytes;
+    }
+
+} // namespace
+
+    void RunVfs() {
+        const std::vector<std::string> roots = {PathResolver::Resolve("assets"), PathResolver::Resolve("shaders")};
+        const std::string packPath = (fs::temp_directory_path() / "rrender_bench.rpak").string();
+        auto packStats = core::AssetCooker::BuildPack(roots, packPath);
+        std::printf("pack: %zu files, %.1f MB -> %.1f MB\n\n", packStats.fileCount,
+                    packStats.originalBytes / (1024.0 * 1024.0), packStats.storedBytes / (1024.0 * 1024.0));
+
+        std::vector<std::string> shaders;
+        for (const auto& entry : fs::recursive_directory_iterator(PathResolver::Resolve("shaders"))) {
+            core::AssetKind kind;
+            if (entry.is_regular_file() && core::AssetCooker::Classify(entry.path().string(), kind))
+                shaders.push_back(entry.path().string());
+        }
+
+        // 逐个打开包内全部文件并读完（页缓存已预热，反映系统调用与映射开销）
+        utils::PackFile pack(packPath);
+        auto readAll = [&pack]() {
+            size_t sum = 0;
+            for (const auto& entry : pack.GetEntries()) {
+                utils::FileView view = utils::VirtualFileSystem::Open(PathResolver::Resolve(entry.path));
+                for (size_t i = 0; i < view.Size(); i += 4096) sum += static_cast<unsigned char>(view.Data()[i]);
+            }
+            return sum;
+        };
+
+        std::printf("%-16s %12s %12s %10s %10s\n", "workload", "loose ms", "pack ms", "loose ops", "pack ops");
+        auto compare = [&](const char* name, auto&& work) {
+            utils::VirtualFileSystem::UnmountAll();
+            utils::VirtualFileSystem::ResetStats();
+            work();
+            const size_t looseOps = utils::VirtualFileSystem::GetStats().looseReads;
+            double looseMs = MeasureMs([&] { work(); });
+
+            // 资源包模式按发布版配置：不回退松散文件，也不再读源文件校验哈希
+            if (!utils::VirtualFileSystem::Mount(packPath))
+                throw std::runtime_error("failed to mount " + packPath);
+            utils::VirtualFileSystem::SetLooseFilesEnabled(false);
+            utils::VirtualFileSystem::ResetStats();
+            work();
+            auto stats = utils::VirtualFileSystem::GetStats();
+            double packMs = MeasureMs([&] { work(); });
+            utils::VirtualFileSystem::SetLooseFilesEnabled(true);
+            utils::VirtualFileSystem::UnmountAll();
+            std::printf("%-16s %12.2f %12.2f %10zu %10zu\n", name, looseMs, packMs, looseOps, stats.packReads);
+        };
+        compare("read all files", readAll);
+        compare("startup set", [&] { return LoadStartupSet(shaders); });
+
+        // 开发模式（挂载资源包且允许松散文件）：缓存网格应只凭大小与时间确认源文件未变，不读取 OBJ/MTL
+        if (!utils::VirtualFileSystem::Mount(packPath))
+            throw std::runtime_error("failed to mount " + packPath);
+        utils::VirtualFileSystem::ResetStats();
+        double cacheMs = MeasureMs([&] {
+            for (const char* relative : ShippedModels()) {
+                const std::string objPath = PathResolver::Resolve(relative);
+                graphics::MeshCache cache;
+                if (!cache.Open(graphics::MeshCache::GetCachePath(objPath), objPath))
+                    throw std::runtime_error("cache rejected: " + objPath);
+            }
+        });
+        auto stats = utils::VirtualFileSystem::GetStats();
+        utils::VirtualFileSystem::UnmountAll();
+        std::printf("\ncached meshes (pack + loose) %.3f ms, loose reads %zu, decompressed %zu bytes\n",
+                    cacheMs, stats.looseReads, stats.decompressedBytes);
+        if (stats.looseReads != 0 || stats.decompressedBytes != 0)
+            throw std::runtime_error("mesh cache rehashed its sources with the pack mounted");
+
+        fs::remove(packPath);
+    }
+
+} // namespace bench
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+    struct Job;
+    struct RangeTask;
+
+    /**
+     * @brief 一组任务的完成计数：提交时加一，任务执行完减一，归零即全部完成
+     * 可作为 JobSystem::Run 的依赖，归零时放行等待它的任务；归零并经 Wait 返回后可复用
+     */
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_Value{0};
+        std::mutex m_Mutex;            ///< 保护 m_Waiting 与 m_Blocked，并串行化最后一次减一与 Wait 的返回
+        std::vector<Job*> m_Waiting;   ///< 依赖本计数、尚未放行的任务
+        std::condition_variable m_Done;
+        uint32_t m_Blocked = 0;        ///< 阻塞在 m_Done 上的 Wait 数，归零时据此决定是否通知
+    };
+
+    /**
+     * @brief 引擎的任务调度器：每个线程一个 Chase–Lev 双端队列，空闲线程从其他队列窃取任务
+     *
+     * 初始化线程（通常为主线程）本身也是 0 号工作线程，只在 Wait / ParallelFor 中执行任务；
+     * 其余为后台工作线程。GL 调用只能放进主线程队列，由 RunMainThreadJobs 在主线程执行。
+     * 后台任务（文件读取、解码等耗时较长的任务）进入单独的先进先出队列，只由后台线程在无其他任务时执行，
+     * Wait 不会执行它们，避免主线程等待一个短任务时被长任务拖住
+     */
+    class JobSystem {
+    public:
+        using JobFunction = std::function<void()>;
+
+        struct Stats {
+            uint64_t executed = 0;   ///< 已执行的任务数
+            uint64_t stolen = 0;     ///< 其中从其他线程队列窃取的任务数
+            uint64_t sleeps = 0;     ///< 后台线程因无任务而休眠的次数
+        };
+
+        /**
+         * @brief 创建后台工作线程，调用线程成为 0 号工作线程；已初始化时什么也不做
+         * @param workerCount 后台线程数，0 表示 硬件并发数-1；至少 1 个，且不超过硬件并发数
+         */
+        static void Initialize(size_t workerCount = 0);
+
+        /**
+         * @brief 执行完已提交的任务后停止后台线程，并丢弃主线程队列中未执行的任务
+         */
+        static void Shutdown();
+
+        static bool IsInitialized();
+
+        /// 参与执行任务的线程数（后台线程 + 0 号线程），未初始化时为 0
+        static size_t GetThreadCount();
+
+        /**
+         * @brief 提交任务；首次调用时以默认线程数初始化
+         * @param counter    非空时提交时加一、任务完成时减一
+         * @param dependency 非空且未归零时，任务推迟到其归零后才开始排队
+         * 任务抛出的异常被捕获并输出到 std::cerr
+         */
+        static void Run(JobFunction function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+        /// 提交后台任务（可能阻塞在文件读取上的长任务），见类说明
+        static void RunBackground(JobFunction function, JobCounter* counter = nullptr);
+
+        /**
+         * @brief 等待计数归零，期间调用线程执行队列中的（非后台）任务
+         * 短暂让出后仍找不到任务时阻塞，直到计数归零（或周期性醒来再找任务），不与执行剩余任务的线程争抢 CPU
+         */
+        static void Wait(JobCounter& counter);
+
+        /**
+         * @brief 对 [0, count) 分段并行调用 fn(begin, end)，返回前全部完成，首个异常在汇合后重新抛出
+         * 区间按需对半拆分：执行者先把后一半放回自己的队列供其他线程窃取，直到不超过 grain
+         * @param grain 每段最多元素数，0 表示按线程数自动选择（约每线程 8 段）；不小于 count 时在调用线程直接执行
+         */
+        template <typename Fn>
+        static void ParallelFor(size_t count, Fn&& fn, size_t grain = 0) {
+            using Callable = std::remove_reference_t<Fn>;
+            if (count == 0) return;
+            auto invoke = [](void* context, size_t begin, size_t end) { (*static_cast<Callable*>(context))(begin, end); };
+            ParallelForImpl(count, grain, invoke, const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+        }
+
+        /**
+         * @brief 投递到主线程执行的任务（任意线程可调用）
+         */
+        static void PostToMainThread(JobFunction function);
+
+        /**
+         * @brief 在主线程按提交顺序执行已投递的任务，超出预算（毫秒）后留到下次
+         * @return 执行的任务数
+         */
+        static size_t RunMainThreadJobs(double budgetMs);
+
+        /// 丢弃主线程队列中未执行的任务
+        static void ClearMainThreadJobs();
+
+        static Stats GetStats();
+
+    private:
+        using RangeFunction = void (*)(void* context, size_t begin, size_t end);
+
+        static void ParallelForImpl(size_t count, size_t grain, RangeFunction invoke, void* context);
+        static void RunRange(RangeTask& task, size_t begin, size_t end);
+        static void Execute(Job* job);
+        /// 计数减一，归零时放行依赖它的任务
+        static void Finish(JobCounter& counter);
+        static void WorkerLoop(int index);
+    };
+
+} // namespace core
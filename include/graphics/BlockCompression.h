@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace graphics {
+
+    /**
+     * @brief 纹理数据格式，数值写入 .rtex 文件，不可改动已有值
+     */
+    enum class TextureFormat : uint32_t {
+        RGBA8 = 0, ///< 未压缩 8 位 RGBA
+        BC1 = 1,   ///< 不透明 RGB，4bpp
+        BC3 = 2,   ///< RGB + 插值 alpha，8bpp
+        BC5 = 3,   ///< 双通道（法线 XY），8bpp
+        BC7 = 4,   ///< 高质量 RGBA，8bpp
+    };
+
+    const char* GetTextureFormatName(TextureFormat format);
+
+    /// 是否为 4x4 块压缩格式
+    inline bool IsBlockCompressed(TextureFormat format) { return format != TextureFormat::RGBA8; }
+
+    /**
+     * @brief 指定尺寸的单个 mip 级别字节数
+     */
+    size_t GetTextureLevelSize(TextureFormat format, int width, int height);
+
+    /**
+     * @brief CPU 块压缩编码/解码（BC1/BC3/BC5/BC7）
+     * 输入输出像素均为紧密排列的 RGBA8；边缘不足 4 像素的块以边缘像素填充。
+     * BC7 仅使用单子集的 mode 6，解码同样只支持 mode 6。
+     */
+    class BlockCompressor {
+    public:
+        /**
+         * @brief 编码一个级别，块按行优先排列
+         * @param threadCount 1 表示在调用线程串行编码，其他值按块行经 core::JobSystem 并行
+         */
+        static std::vector<uint8_t> Compress(TextureFormat format, const uint8_t* rgba, int width, int height,
+                                             unsigned int threadCount = 0);
+
+        /**
+         * @brief 解码为 RGBA8（用于不支持该压缩格式的GPU及误差统计）
+         * BC5 输出 (R, G, 0, 255)，与硬件采样结果一致
+         */
+        static std::vector<uint8_t> Decompress(TextureFormat format, const uint8_t* blocks, int width, int height);
+
+        /**
+         * @brief 按用途选择压缩格式：法线贴图 BC5，带透明度 BC3，其余 BC1；highQuality 时颜色贴图用 BC7
+         * @param path 纹理路径，文件名含 _ddn / normal 视为法线贴图
+         */
+        static TextureFormat ChooseFormat(const std::string& path, const uint8_t* rgba, int width, int height,
+                                          bool highQuality);
+    };
+
+} // namespace graphics
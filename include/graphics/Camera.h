@@ -2,6 +2,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <tuple>
+#include <utility>
 
 namespace graphics {
 
@@ -58,6 +59,12 @@ public:
      */
     void SetRotation(float yawDegrees, float pitchDegrees);
 
+    /**
+     * @brief 获取欧拉角（度）
+     */
+    float GetYaw() const { return m_Yaw; }
+    float GetPitch() const { return m_Pitch; }
+
     /**
      * @brief 增加相机旋转
      * @param yawDegrees 偏航角增量
@@ -91,12 +98,26 @@ public:
      */
     const glm::vec3& GetRight() const;
 
+    /**
+     * @brief 获取近 / 远平面距离
+     */
+    float GetNear() const { return m_Near; }
+    float GetFar() const { return m_Far; }
+
     /**
      * @brief 获取相机方向向量（前、上、右）
      * @return std::tuple 包含前向量、上向量和右向量
      */
     const std::tuple<glm::vec3, glm::vec3, glm::vec3> GetDirectionVectors() const;
 
+    /**
+     * @brief 屏幕上一点对应的世界空间射线（透视与正交投影均适用）
+     * @param x, y          窗口坐标（像素，原点在左上角，与 InputManager::GetMousePosition 一致）
+     * @param width, height 窗口大小（像素）
+     * @return 近平面上的起点与单位方向
+     */
+    std::pair<glm::vec3, glm::vec3> ScreenPointToRay(float x, float y, float width, float height) const;
+
     /**
      * @brief 更新相机方向向量，调用SetRotation后必须调用
      */
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace graphics {
+
+    /// 轴对齐包围盒
+    struct BoundingBox {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        glm::vec3 GetCenter() const { return 0.5f * (min + max); }
+        glm::vec3 GetExtents() const { return 0.5f * (max - min); }
+
+        /// 由顶点位置计算，count 为 0 时返回原点处的空盒
+        static BoundingBox FromPoints(const glm::vec3* points, size_t count, size_t stride = sizeof(glm::vec3));
+
+        /// 变换后仍包住原盒的最小轴对齐盒：中心直接变换，半长取 |M| × 半长
+        BoundingBox Transform(const glm::mat4& matrix) const;
+    };
+
+    /**
+     * @brief 射线方向的倒数，供平板法求交使用
+     * 分量为 0 时以同号极小值代替：起点恰在平板平面上时 0 * inf 会产生 NaN
+     */
+    inline glm::vec3 InverseRayDirection(const glm::vec3& direction) {
+        glm::vec3 inverse;
+        for (int k = 0; k < 3; ++k)
+            inverse[k] = 1.0f / (std::abs(direction[k]) > 1e-30f ? direction[k] : std::copysign(1e-30f, direction[k]));
+        return inverse;
+    }
+
+    /// 包围球
+    struct BoundingSphere {
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+
+        /// 外接球（中心取包围盒中心）
+        static BoundingSphere FromBox(const BoundingBox& box);
+
+        /// 中心直接变换，半径乘以三个轴中最大的缩放
+        BoundingSphere Transform(const glm::mat4& matrix) const;
+    };
+
+    /**
+     * @brief 视锥的六个平面（左右下上近远），法线朝内且已归一化
+     */
+    struct Frustum {
+        glm::vec4 planes[6];
+
+        /**
+         * @brief Gribb-Hartmann：由矩阵的行组合得到平面
+         * 传入投影 × 视图得到世界空间视锥，再乘模型矩阵则得到该模型空间中的视锥
+         */
+        static Frustum FromMatrix(const glm::mat4& matrix);
+
+        /// 包围盒完全在某个平面外侧时返回 false（保守：角落附近可能误判为相交）
+        static bool IntersectsBox(const glm::vec4* planes, const BoundingBox& box);
+        bool Intersects(const BoundingBox& box) const { return IntersectsBox(planes, box); }
+        bool Intersects(const BoundingSphere& sphere) const;
+    };
+
+    /**
+     * @brief 批量视锥剔除：包围盒以中心 + 半长按分量连续存放，SSE 每次测试 4 个，
+     * 开启 RRENDER_ENABLE_AVX 时 AVX 每次 8 个。统计在调用方按帧清零
+     */
+    class FrustumCuller {
+    public:
+        /// 按分量连续存放的包围盒
+        struct BoxList {
+            std::vector<float> centerX, centerY, centerZ;
+            std::vector<float> extentX, extentY, extentZ;
+
+            size_t Size() const { return centerX.size(); }
+            void Clear();
+            void Reserve(size_t count);
+            void Push(const BoundingBox& box);
+        };
+
+        struct Stats {
+            size_t tested = 0;          ///< 参与剔除的实体
+            size_t visible = 0;
+            size_t culled = 0;
+            size_t meshesTested = 0;    ///< 可见实体中逐子网格测试的网格
+            size_t meshesCulled = 0;
+            double cullMs = 0.0;        ///< 本帧批量测试耗时
+        };
+
+        /**
+         * @brief 测试全部包围盒，把相交的下标按顺序写入 visible（先清空），统计累加到 GetStats()
+         */
+        static void Cull(const Frustum& frustum, const BoxList& boxes, std::vector<uint32_t>& visible);
+
+        /// 关闭时所有实体都视为可见
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// 关闭时逐个标量测试，用于对比与排查
+        static void SetSimdEnabled(bool enabled) { s_SimdEnabled = enabled; }
+        static bool IsSimdEnabled() { return s_SimdEnabled; }
+
+        /// 记录在批量测试之前已被空间索引排除的实体（计入 tested 与 culled）
+        static void CountRejected(size_t count) {
+            s_Stats.tested += count;
+            s_Stats.culled += count;
+        }
+
+        /// 记录逐子网格测试的结果
+        static void CountMeshes(size_t tested, size_t culled) {
+            s_Stats.meshesTested += tested;
+            s_Stats.meshesCulled += culled;
+        }
+
+        static const Stats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = Stats{}; }
+
+    private:
+        static bool s_Enabled;
+        static bool s_SimdEnabled;
+        static Stats s_Stats;
+    };
+
+} // namespace graphics
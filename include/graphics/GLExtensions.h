@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <glad/glad.h>
+#include "graphics/BlockCompression.h"
+
+// GLAD 只生成了 GL 3.3 核心接口，所用扩展的枚举在此补充
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+// GL 4.1 / ARB_get_program_binary
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+// KHR/ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace graphics {
+
+    /**
+     * @brief 运行时查询的 OpenGL 扩展支持情况
+     * Init 需在创建上下文并加载 GLAD 后于GL线程调用一次，之后查询接口可在任意线程使用
+     */
+    class GLExtensions {
+    public:
+        /**
+         * @param loader 与 gladLoadGLLoader 相同的函数加载器，用于加载 GLAD 未包含的扩展函数；为空时相关功能视为不支持
+         */
+        static void Init(GLADloadproc loader = nullptr);
+
+        static bool Has(const std::string& name);
+
+        /**
+         * @brief GPU 是否可直接采样该压缩格式（sRGB 变体需要额外扩展）
+         */
+        static bool IsFormatSupported(TextureFormat format, bool useSRGB);
+
+        /**
+         * @brief 纹理格式对应的 GL 内部格式；BC5 没有 sRGB 变体，始终为线性
+         */
+        static GLenum GetInternalFormat(TextureFormat format, bool useSRGB);
+
+        /// 是否可读取与加载程序二进制（GL 4.1 或 ARB_get_program_binary，且驱动至少提供一种格式）
+        static bool HasProgramBinary() { return s_ProgramBinary; }
+
+        /**
+         * @brief 是否支持 KHR/ARB_parallel_shader_compile
+         * 支持时 Init 已请求驱动使用默认的后台编译线程数，可用 GL_COMPLETION_STATUS_KHR 非阻塞查询
+         */
+        static bool HasParallelShaderCompile() { return s_ParallelShaderCompile; }
+
+        /// 驱动标识（厂商、渲染器、版本），程序二进制只在相同驱动下有效
+        static const std::string& GetDriverId() { return s_DriverId; }
+
+        // 程序二进制接口，仅在 HasProgramBinary() 为 true 时调用
+        static void GetProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary);
+        static void ProgramBinary(GLuint program, GLenum format, const void* binary, GLsizei length);
+        static void ProgramParameteri(GLuint program, GLenum name, GLint value);
+
+    private:
+        static std::unordered_set<std::string> s_Extensions;
+        static bool s_S3TC;
+        static bool s_S3TCsRGB;
+        static bool s_BPTC;
+        static bool s_ProgramBinary;
+        static bool s_ParallelShaderCompile;
+        static std::string s_DriverId;
+    };
+
+} // namespace graphics
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace graphics {
+
+    /**
+     * @brief 可被显存预算驱逐的GPU资源的公共状态：最近一次使用的帧号与驱逐标记
+     * 帧号由 ResourceManager::EndFrame 推进，资源在 Draw/Bind 时记录。只在GL线程访问，
+     * 例外是使用帧号：并行录制渲染命令时可由多个工作线程同时记录
+     */
+    class GpuResource {
+    public:
+        GpuResource() = default;
+        GpuResource(const GpuResource& other)
+            : m_LastUsedFrame(other.GetLastUsedFrame()), m_Evicted(other.m_Evicted) {}
+        GpuResource& operator=(const GpuResource& other) {
+            m_LastUsedFrame.store(other.GetLastUsedFrame(), std::memory_order_relaxed);
+            m_Evicted = other.m_Evicted;
+            return *this;
+        }
+
+        /// 当前帧号（从 1 开始，0 表示从未使用）
+        static uint64_t GetCurrentFrame() { return s_CurrentFrame; }
+        static void AdvanceFrame() { ++s_CurrentFrame; }
+
+        /// 最近一次被绘制或绑定的帧号
+        uint64_t GetLastUsedFrame() const { return m_LastUsedFrame.load(std::memory_order_relaxed); }
+
+        /// 是否已被驱逐（GPU对象已释放，等待再次使用时重新加载）
+        bool IsEvicted() const { return m_Evicted; }
+
+    protected:
+        void Touch() const { m_LastUsedFrame.store(s_CurrentFrame, std::memory_order_relaxed); }
+
+        mutable std::atomic<uint64_t> m_LastUsedFrame{0};
+        bool m_Evicted = false;
+
+    private:
+        inline static uint64_t s_CurrentFrame = 1;
+    };
+
+} // namespace graphics
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace graphics {
+
+    /**
+     * @brief CPU侧解码后的图像像素，可在工作线程中加载，随后交给 Texture 上传
+     */
+    struct ImageData {
+        struct PixelDeleter {
+            void operator()(unsigned char* pixels) const;
+        };
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::unique_ptr<unsigned char, PixelDeleter> pixels;
+
+        bool IsValid() const { return pixels != nullptr; }
+
+        /// 像素数据字节数（8位每通道）
+        size_t GetByteSize() const {
+            return static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
+        }
+
+        /**
+         * @brief 使用 stb_image 解码图片（线程安全），失败时抛出 std::runtime_error
+         * @param desiredChannels 强制输出通道数，0 表示保持文件原有通道数
+         */
+        static ImageData LoadFromFile(const std::string& path, int desiredChannels = 0);
+
+        /**
+         * @brief 分配未初始化的像素缓冲（与 stb 解码结果同样以 free 释放）
+         */
+        static ImageData Allocate(int width, int height, int channels);
+    };
+
+} // namespace graphics
@@ -1,23 +1,106 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
+#include "graphics/Frustum.h"
+#include "graphics/Meshlet.h"
+#include "graphics/TriangleBvh.h"
 
 namespace graphics {
 
+    class CommandBuffer;
+
     struct Vertex {
         glm::vec3 Position;
         glm::vec3 Normal;
         glm::vec2 TexCoords;
     };
 
+    /// 一级细节：索引缓冲中的一段区间，各级共享顶点缓冲
+    struct MeshLod {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;      ///< 相对原始网格的最大几何误差（模型空间距离）
+        uint32_t reserved = 0;
+    };
+
+    /// GPU 顶点缓冲的布局
+    enum class VertexFormat : uint8_t {
+        Float,     ///< 32 字节：float 位置/法线/UV
+        Compact16, ///< 16 字节：unorm16 位置 + snorm16x2 八面体法线 + half2 UV
+        Compact8   ///< 12 字节：unorm16 位置 + snorm8x2 八面体法线 + half2 UV
+    };
+
     class Mesh {
     public:
+        /// 位置反量化参数所在的常量顶点属性（不启用数组，绘制前以 glVertexAttrib4f 设置）
+        static constexpr unsigned int kDequantOffsetLocation = 3;
+        static constexpr unsigned int kDequantScaleLocation = 4;
+
         explicit Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+        /**
+         * @brief 直接由连续内存构造（如内存映射的网格缓存），Float 格式不做中间拷贝
+         * @param format 非 Float 时在上传前量化为紧凑格式
+         */
+        Mesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+             VertexFormat format = VertexFormat::Float);
         ~Mesh();
 
-        void Draw() const;
+        /**
+         * @brief 绘制前写入反量化常量属性：location 3 为位置偏移，location 4 为位置缩放，
+         * 其 w 分量为 1 表示法线是八面体编码。顶点着色器按此统一解码两种布局
+         * @param cullView 非空且网格带有簇时，只以 glMultiDrawElements 绘制剔除后剩余的区间（仅 LOD0）
+         * @param lod      细节级别，超出范围时取最粗一级
+         */
+        void Draw(const MeshletCullView* cullView = nullptr, uint32_t lod = 0) const;
+
+        /**
+         * @brief 与 Draw 相同的选择与剔除，结果录制为一条绘制命令（剔除后没有可见簇时不录制）
+         * 不调用GL函数，可在工作线程调用；统计记在 buffer 中，回放时合并
+         */
+        void Record(CommandBuffer& buffer, const MeshletCullView* cullView = nullptr, uint32_t lod = 0) const;
+
+        /// 拷贝簇划分（簇的索引区间对应本网格的索引缓冲）
+        void SetMeshlets(const Meshlet* meshlets, size_t meshletCount);
+        const std::vector<Meshlet>& GetMeshlets() const { return m_Meshlets; }
+
+        /// 拷贝细节级别划分，为空时整个索引缓冲为唯一级别
+        void SetLods(const MeshLod* lods, size_t lodCount);
+        const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+
+        /// 模型空间包围盒：由顶点数组构造时自动计算，由连续内存构造时由调用方设置（缓存中已有）
+        void SetBounds(const BoundingBox& bounds) { m_Bounds = bounds; }
+        const BoundingBox& GetBounds() const { return m_Bounds; }
+
+        /// 拾取用的三角形层次包围盒（LOD0，模型空间），由 Model::LoadData 在工作线程构建；未设置时为空指针
+        void SetBvh(std::shared_ptr<const TriangleBvh> bvh) { m_Bvh = std::move(bvh); }
+        const TriangleBvh* GetBvh() const { return m_Bvh.get(); }
+
+        VertexFormat GetFormat() const { return m_Format; }
+
+        /// 顶点缓冲与索引缓冲的显存占用（字节）
+        size_t GetGpuBytes() const { return m_GpuBytes; }
+
+        /// 模型上传时使用的顶点格式，默认 Float
+        static void SetDefaultFormat(VertexFormat format) { s_DefaultFormat = format; }
+        static VertexFormat GetDefaultFormat() { return s_DefaultFormat; }
+
+        /// 绘制统计（GL线程累加，调用方按帧清零）
+        struct DrawStats {
+            size_t drawCalls = 0;
+            size_t triangles = 0;
+        };
+        static const DrawStats& GetDrawStats() { return s_DrawStats; }
+        static void ResetDrawStats() { s_DrawStats = DrawStats{}; }
+        /// 记录由命令缓冲回放的绘制
+        static void AddDrawStats(size_t drawCalls, size_t triangles) {
+            s_DrawStats.drawCalls += drawCalls;
+            s_DrawStats.triangles += triangles;
+        }
 
         // 禁拷贝，允许移动
         Mesh(const Mesh&) = delete;
@@ -28,8 +111,23 @@ namespace graphics {
     private:
         unsigned int m_VAO = 0, m_VBO = 0, m_EBO = 0;
         size_t m_IndexCount = 0;
+        size_t m_GpuBytes = 0;
+        VertexFormat m_Format = VertexFormat::Float;
+        glm::vec3 m_DequantOffset = glm::vec3(0.0f);
+        glm::vec3 m_DequantScale = glm::vec3(1.0f);
+        std::vector<Meshlet> m_Meshlets;
+        std::vector<MeshLod> m_Lods;
+        BoundingBox m_Bounds;
+        std::shared_ptr<const TriangleBvh> m_Bvh;
+
+        static VertexFormat s_DefaultFormat;
+        static DrawStats s_DrawStats;
+
+        /// 按细节级别取索引区间，lod 改为实际使用的级别
+        void SelectLod(uint32_t& lod, uint32_t& firstIndex, size_t& indexCount) const;
 
-        void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+        void SetupMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+                       VertexFormat format);
     };
 
 }
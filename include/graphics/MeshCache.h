@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/ObjParser.h"
+#include "utils/VirtualFileSystem.h"
+
+namespace graphics {
+
+    /**
+     * @brief .rmesh 二进制网格缓存，与 OBJ 同目录存放
+     *
+     * 文件布局（小端，所有偏移相对文件头，数据块16字节对齐）：
+     *   RMeshHeader
+     *   RMeshMaterialRecord[materialCount]
+     *   RMeshMeshRecord[meshCount]
+     *   依赖文件名（字符串表偏移）[dependencyCount]
+     *   源文件大小与修改时间[1 + dependencyCount]（OBJ 在前）
+     *   字符串表（uint32长度 + 字节）
+     *   各子网格的 Vertex 数组、uint32 索引数组（LOD0 在前，其后为各级 LOD）、Meshlet 与 MeshLod 数组
+     * 缓存记录OBJ及其MTL的大小、修改时间与内容哈希：大小与时间都未变时直接使用，
+     * 否则比对内容哈希，任一源文件内容变化即视为失效；内容未变时就地改写记录的大小与时间
+     */
+    class MeshCache {
+    public:
+        static constexpr uint32_t kMagic = 0x48534D52;   ///< "RMSH"
+        static constexpr uint32_t kVersion = 5;   ///< 2：子网格经 MeshOptimizer 重排；3：附带网格簇；4：附带 LOD 链；5：记录源文件大小与时间
+
+        /// 映射区中的子网格视图，指针在 MeshCache 存活期间有效
+        struct MeshView {
+            int materialId = -1;
+            const Vertex* vertices = nullptr;
+            uint32_t vertexCount = 0;
+            const unsigned int* indices = nullptr;
+            uint32_t indexCount = 0;
+            const Meshlet* meshlets = nullptr;
+            uint32_t meshletCount = 0;
+            const MeshLod* lods = nullptr;
+            uint32_t lodCount = 0;
+            glm::vec3 boundsMin{0.0f};
+            glm::vec3 boundsMax{0.0f};
+        };
+
+        MeshCache() = default;
+
+        /**
+         * @brief 根据OBJ路径得到缓存路径（同名 .rmesh）
+         */
+        static std::string GetCachePath(const std::string& objPath);
+
+        /**
+         * @brief 计算OBJ及其依赖MTL的内容哈希
+         * @param objPath       OBJ路径
+         * @param dependencies  MTL文件名（相对OBJ所在目录）
+         */
+        static uint64_t HashSources(const std::string& objPath, const std::vector<std::string>& dependencies);
+
+        /**
+         * @brief 只读取缓存记录的依赖MTL文件名（相对OBJ所在目录），供打包时判断哪些文件须保持松散
+         * @return 缓存无效或版本不符时返回 false
+         */
+        static bool ReadDependencies(const std::string& cachePath, std::vector<std::string>& dependencies);
+
+        /**
+         * @brief 写出缓存（先写临时文件再替换），失败时抛出 std::runtime_error
+         */
+        static void Write(const std::string& cachePath,
+                          const std::string& objPath,
+                          const std::vector<MeshData>& meshes,
+                          const std::vector<ObjMaterial>& materials,
+                          const std::vector<std::string>& dependencies);
+
+        /**
+         * @brief 映射并校验缓存
+         * @return 缓存存在、版本一致、各数据区间与索引有效且源文件未变时返回 true，否则调用方重新解析OBJ
+         */
+        bool Open(const std::string& cachePath, const std::string& objPath);
+
+        const std::vector<MeshView>& GetMeshes() const { return m_Meshes; }
+        const std::vector<ObjMaterial>& GetMaterials() const { return m_Materials; }
+
+        /// 整个模型的包围盒
+        const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+        const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+
+    private:
+        utils::FileView m_File;
+        std::vector<MeshView> m_Meshes;
+        std::vector<ObjMaterial> m_Materials;
+        glm::vec3 m_BoundsMin{0.0f};
+        glm::vec3 m_BoundsMax{0.0f};
+    };
+
+} // namespace graphics
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "graphics/ObjParser.h"
+
+namespace graphics {
+
+    /// 顶点后变换缓存模拟结果
+    struct VertexCacheStats {
+        float acmr = 0.0f; ///< 每个三角形的平均缓存未命中数（理想值接近 0.5）
+        float atvr = 0.0f; ///< 未命中数 / 被引用的顶点数（理想值 1.0）
+    };
+
+    /**
+     * @brief 网格构建阶段的索引/顶点重排
+     * 1. Forsyth 线性速度算法重排三角形，提高后变换缓存命中率
+     * 2. 在缓存友好的顺序上切分簇，按视角无关的“朝外程度”排序簇以减少过绘制
+     * 3. 按首次引用顺序重排顶点，提高顶点读取局部性
+     */
+    class MeshOptimizer {
+    public:
+        /// 分析时模拟的 FIFO 缓存大小
+        static constexpr unsigned int kAnalyzeCacheSize = 16;
+
+        /**
+         * @brief 依次执行缓存优化、过绘制优化与顶点重排
+         */
+        static void Optimize(MeshData& mesh);
+
+        /// 经 core::JobSystem 并行优化多个网格，threadCount 为 1 时在调用线程串行
+        static void OptimizeMeshes(std::vector<MeshData>& meshes, unsigned int threadCount = 0);
+
+        /// Forsyth 三角形重排（模拟 32 项 LRU 缓存）
+        static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+        /**
+         * @brief 保持缓存局部性的前提下按簇重排以减少过绘制
+         * @param threshold 允许的 ACMR 放大倍数，越大簇越小、过绘制优化越充分
+         */
+        static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                                     float threshold = 1.05f);
+
+        /// 按索引中首次出现的顺序重排顶点，并移除未被引用的顶点
+        static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        /**
+         * @brief 以 FIFO 缓存模拟统计 ACMR/ATVR
+         */
+        static VertexCacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+                                                   unsigned int cacheSize = kAnalyzeCacheSize);
+    };
+
+} // namespace graphics
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "graphics/ObjParser.h"
+
+namespace graphics {
+
+    /**
+     * @brief 基于二次误差度量（QEM）的半边折叠简化
+     *
+     * 顶点只会折叠到相邻顶点上，不移动也不新增，各级 LOD 共享同一顶点缓冲，只追加索引。
+     * 按位置焊接后分类顶点：
+     *   - UV/法线接缝上的顶点（同一位置有多个顶点）锁定不动，接缝保持原样
+     *   - 边界顶点（开放边，包括与其他材质子网格的交界）只能沿边界边折叠，边界线形状由附加的垂直平面约束
+     *   - 非流形边上的顶点锁定
+     */
+    class MeshSimplifier {
+    public:
+        struct LodOptions {
+            uint32_t levelCount = 4;   ///< 含 LOD0 在内的最多级数
+            float ratio = 0.5f;        ///< 相邻两级的目标三角形比例
+            float maxError = 0.05f;    ///< 允许的最大误差（相对网格包围盒对角线）
+            float minReduction = 0.15f; ///< 一级至少减少的三角形比例，否则停止生成更粗的级别
+        };
+
+        /**
+         * @brief 简化到不超过 targetIndexCount 个索引，或误差达到 maxError（模型空间距离）为止
+         * @param resultError 输出实际最大误差（模型空间距离），可为空
+         */
+        static std::vector<unsigned int> Simplify(const Vertex* vertices, size_t vertexCount,
+                                                  const unsigned int* indices, size_t indexCount,
+                                                  size_t targetIndexCount, float maxError, float* resultError = nullptr);
+
+        /**
+         * @brief 生成 LOD 链：各级由原始网格直接简化，索引追加在 LOD0 之后并各自做缓存优化
+         * 应在 MeshOptimizer 与 MeshletBuilder 之后调用（簇只覆盖 LOD0）
+         */
+        static void GenerateLods(MeshData& mesh, const LodOptions& options);
+
+        /// 经 core::JobSystem 并行为每个子网格生成 LOD 链，threadCount 为 1 时在调用线程串行
+        static void GenerateLods(std::vector<MeshData>& meshes, unsigned int threadCount, const LodOptions& options);
+    };
+
+} // namespace graphics
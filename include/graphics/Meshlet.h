@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace graphics {
+
+    struct Vertex;
+    struct MeshData;
+    class Camera;
+
+    /**
+     * @brief 网格簇：索引缓冲中连续的一段三角形，附带包围球与法线锥
+     * 布局固定（48 字节），直接写入 .rmesh 缓存
+     */
+    struct Meshlet {
+        glm::vec3 center{0.0f};     ///< 包围球（模型空间）
+        float radius = 0.0f;
+        glm::vec3 coneAxis{0.0f};   ///< 三角形法线的平均方向
+        float coneCutoff = 1.0f;    ///< sin(法线偏离轴的最大角)，>= 1 表示法线过于分散、不做背面剔除
+        uint32_t firstIndex = 0;    ///< 在网格索引缓冲中的起始位置
+        uint32_t triangleCount = 0;
+        uint32_t vertexCount = 0;   ///< 引用的不重复顶点数
+        uint32_t reserved = 0;
+    };
+    static_assert(sizeof(Meshlet) == 48, "Meshlet layout changed");
+
+    /**
+     * @brief 变换到模型空间的剔除参数
+     * 平面由 MVP 矩阵直接提取，因此非均匀缩放下包围球测试仍然正确；
+     * 背面判定 dot(p - eye, n) >= 0 在仿射变换下不变，在模型空间计算即可
+     */
+    struct MeshletCullView {
+        glm::vec4 planes[6];         ///< 左右下上近远，法线朝内且已归一化
+        glm::vec3 cameraPosition{0.0f};
+        glm::vec3 viewDirection{0.0f, 0.0f, -1.0f};
+        bool orthographic = false;   ///< 正交投影时以视线方向代替相机位置判定背面
+
+        /**
+         * @param viewProjection 相机的投影矩阵 × 视图矩阵
+         * @param model          模型矩阵
+         */
+        static MeshletCullView Create(const glm::mat4& viewProjection, const glm::mat4& model,
+                                      const glm::vec3& cameraPosition, const glm::vec3& cameraFront,
+                                      bool orthographic = false);
+
+        /// 由相机参数生成
+        static MeshletCullView Create(const Camera& camera, const glm::mat4& model);
+    };
+
+    /**
+     * @brief 构建网格簇：从种子三角形出发，沿（按位置焊接的）邻接关系贪心生长，
+     * 优先加入不增加顶点、离簇中心近且法线接近的三角形，顶点数或三角形数达到上限时开始新簇
+     */
+    class MeshletBuilder {
+    public:
+        static constexpr uint32_t kMaxVertices = 64;
+        static constexpr uint32_t kMaxTriangles = 124;
+
+        /// 生成簇并把三角形按簇重排，使每个簇在索引缓冲中连续
+        static std::vector<Meshlet> Build(const Vertex* vertices, size_t vertexCount, std::vector<unsigned int>& indices);
+
+        /**
+         * @brief 为每个子网格生成簇，随后在簇内重做缓存优化并重排顶点（应在 MeshOptimizer 之后调用）
+         * 各子网格经 core::JobSystem 并行，threadCount 为 1 时在调用线程串行
+         */
+        static void BuildMeshes(std::vector<MeshData>& meshes, unsigned int threadCount = 0);
+    };
+
+    /**
+     * @brief 逐簇 CPU 剔除：视锥外或整体背向相机的簇被丢弃，相邻的可见簇合并为一个绘制区间
+     * 只在GL线程调用
+     */
+    class MeshletCuller {
+    public:
+        struct Stats {
+            size_t meshlets = 0;                ///< 参与剔除的簇
+            size_t visibleMeshlets = 0;
+            size_t triangles = 0;               ///< 提交剔除的三角形
+            size_t frustumCulledTriangles = 0;
+            size_t backfaceCulledTriangles = 0;
+            size_t visibleTriangles = 0;        ///< 实际绘制的三角形
+            size_t drawRanges = 0;              ///< 合并后的绘制区间数
+        };
+
+        /// 合并后的绘制区间，可直接传给 glMultiDrawElements
+        struct DrawList {
+            std::vector<GLsizei> counts;
+            std::vector<const void*> offsets;
+        };
+
+        /**
+         * @brief 剔除一组簇，结果写入 drawList（先清空），统计累加到 GetStats()
+         */
+        static void Cull(const Meshlet* meshlets, size_t meshletCount, const MeshletCullView& view, DrawList& drawList);
+
+        /// 统计累加到调用方的 stats，不访问全局状态，可在多个线程同时调用
+        static void Cull(const Meshlet* meshlets, size_t meshletCount, const MeshletCullView& view, DrawList& drawList,
+                         Stats& stats);
+
+        /// 关闭时网格整体绘制
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// 场景中存在未闭合或双面网格时可单独关闭背面锥剔除
+        static void SetBackfaceCulling(bool enabled) { s_BackfaceCulling = enabled; }
+        static bool IsBackfaceCullingEnabled() { return s_BackfaceCulling; }
+
+        static const Stats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = Stats{}; }
+        /// 合并在其他线程分别累加的统计
+        static void AddStats(const Stats& stats);
+
+    private:
+        static bool s_Enabled;
+        static bool s_BackfaceCulling;
+        static Stats s_Stats;
+    };
+
+} // namespace graphics
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace graphics {
+
+    /// mip 降采样滤波器
+    enum class MipFilter {
+        Box,     ///< 2x2 平均
+        Kaiser,  ///< Kaiser 窗 sinc，半径 3
+        Lanczos, ///< Lanczos3
+    };
+
+    /**
+     * @brief 离线 CPU mip 链生成
+     * 在 float 线性空间中做可分离降采样（SSE，开启 RRENDER_ENABLE_AVX 时纵向使用 AVX），
+     * sRGB 输入先转换到线性空间再滤波，结果转换回 sRGB 编码。
+     */
+    class MipGenerator {
+    public:
+        struct Options {
+            MipFilter filter = MipFilter::Kaiser;
+            bool srgb = false;              ///< RGB 为 sRGB 编码，在线性空间滤波
+            bool normalMap = false;         ///< 每级重新归一化 (RGB*2-1) 法线
+            /**
+             * 保持 alpha 测试覆盖率的通道：-1 关闭，3 为 A 通道，
+             * 0 表示遮罩以灰度存放在 RGB 中（同时缩放 RGB）
+             */
+            int coverageChannel = -1;
+            float alphaCutoff = 0.5f;       ///< alpha 测试阈值
+            bool simd = true;               ///< 关闭时使用标量实现（用于基准对比）
+            unsigned int threadCount = 0;   ///< 1 表示在调用线程串行，其他值按行经 core::JobSystem 并行
+        };
+
+        /**
+         * @brief 生成完整 mip 链（含第0级，直到 1x1），每级为紧密排列的 RGBA8
+         */
+        static std::vector<std::vector<uint8_t>> Generate(const uint8_t* rgba, int width, int height,
+                                                          const Options& options);
+    };
+
+} // namespace graphics
@@ -1,19 +1,50 @@
 ﻿#pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include "graphics/GpuResource.h"
 #include "graphics/Mesh.h"
+#include "graphics/OcclusionCuller.h"
 #include "graphics/Texture.h"
+#include "graphics/ObjParser.h"
+#include "graphics/MeshCache.h"
+#include "graphics/TextureFile.h"
+#include "graphics/TriangleBvh.h"
 
 
 namespace graphics {
 
+    class CommandBuffer;
+
+    /**
+     * @brief 模型的CPU侧数据：子网格、材质以及预解码的纹理像素
+     * 可在工作线程中生成，再交给 Model::Upload 在GL线程创建GPU对象
+     */
+    struct ModelData {
+        std::string path;                           ///< 模型文件路径
+        std::string directory;                      ///< 模型文件所在目录（带结尾分隔符）
+        std::vector<ObjMaterial> materials;
+        std::vector<MeshCache::MeshView> meshes;    ///< 指向 cache 映射区或 ownedMeshes 的视图
+        std::vector<std::shared_ptr<const TriangleBvh>> bvhs; ///< 与 meshes 一一对应的拾取用三角形层次包围盒（LOD0）
+        std::unordered_map<std::string, TextureSource> textures; ///< 纹理完整路径 → 预读取的烘焙文件或像素（可选，只含本次加载在 TextureCache 中新登记的纹理，经 TextureUploader 流式上传）
+        bool fromCache = false;
+
+        MeshCache cache;                            ///< 命中缓存时持有映射
+        std::vector<MeshData> ownedMeshes;          ///< 解析OBJ时持有数据
+
+        /**
+         * @brief 材质引用的全部纹理完整路径（去重，按首次出现顺序）
+         */
+        std::vector<std::string> GetTexturePaths() const;
+    };
+
     /**
      * @brief 组合多个Mesh和纹理，实现OBJ模型的加载与绘制
      */
-    class Model {
+    class Model : public GpuResource {
     public:
         /**
          * @brief 加载模型
@@ -21,6 +52,11 @@ namespace graphics {
          * @param useSRGB 是否以sRGB格式加载纹理
          */
         Model(const std::string& path, bool useSRGB = true);
+
+        /**
+         * @brief 构造空模型，Upload 之前以占位网格绘制
+         */
+        Model() = default;
         ~Model() = default;
 
         Model(const Model&) = delete;
@@ -31,8 +67,75 @@ namespace graphics {
 
         /**
          * @brief 绘制模型（自动绑定所有纹理）
+         * @param cullView 非空时先跳过包围盒在视锥外的子网格，再逐簇剔除视锥外与背向相机的三角形
+         * @param lod      细节级别，各子网格取不超过自身最粗一级
+         */
+        void Draw(const MeshletCullView* cullView = nullptr, uint32_t lod = 0) const;
+
+        /**
+         * @brief 与 Draw 相同的剔除，结果录制为材质与绘制命令（不含着色器与模型矩阵，由调用方录制）
+         * 不调用GL函数，可在工作线程调用；未就绪时录制占位纹理与占位网格
+         */
+        void Record(CommandBuffer& buffer, const MeshletCullView* cullView = nullptr, uint32_t lod = 0) const;
+
+        /// 以占位纹理绘制占位立方体（需在GL上下文线程调用），回放未就绪模型的绘制命令时使用
+        static void DrawPlaceholder();
+
+        /**
+         * @brief 读取网格数据（优先 .rmesh 缓存，缺失或过期时解析OBJ并重建缓存）
+         * 不调用任何GL函数，可在工作线程执行；失败时抛出 std::runtime_error
          */
-        void Draw() const;
+        static ModelData LoadData(const std::string& path);
+
+        /**
+         * @brief 创建GPU网格与纹理（需在GL上下文线程调用）
+         * data.textures 中的纹理交给 TextureUploader 分帧上传，缺少的纹理在此同步加载
+         */
+        void Upload(const ModelData& data, bool useSRGB);
+
+        /// 网格是否已上传
+        bool IsReady() const { return m_Ready; }
+
+        /// 细节级别数（至少为 1）
+        uint32_t GetLodCount() const { return static_cast<uint32_t>(m_LodErrors.size()); }
+
+        /// 某一级相对原始网格的最大误差（取各子网格最大值，模型空间距离）
+        float GetLodError(uint32_t lod) const { return m_LodErrors[std::min<size_t>(lod, m_LodErrors.size() - 1)]; }
+
+        /// 模型空间包围球
+        const glm::vec3& GetBoundsCenter() const { return m_BoundsCenter; }
+        float GetBoundsRadius() const { return m_BoundsRadius; }
+
+        /// 模型空间包围盒（各子网格包围盒的并集），从未上传过时为占位立方体的包围盒
+        const BoundingBox& GetBounds() const { return m_Bounds; }
+        BoundingSphere GetBoundingSphere() const { return BoundingSphere{m_BoundsCenter, m_BoundsRadius}; }
+
+        /// 遮挡体网格（各子网格最粗一级 LOD 合并，模型空间），Upload 前为空，驱逐后保留
+        const OccluderMesh& GetOccluder() const { return m_Occluder; }
+
+        /**
+         * @brief 模型空间射线与全部子网格 LOD0 三角形的最近交点（双面）
+         * @param mesh 输出命中的子网格序号，hit.triangle 为该子网格 LOD0 区间内的三角形序号
+         * @return 未就绪、已驱逐或没有交点时返回 false
+         */
+        bool Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& hit,
+                       uint32_t& mesh) const;
+
+        /// 子网格数（每个至少一次绘制调用）
+        size_t GetMeshCount() const { return m_Meshes.size(); }
+
+        /// 模型文件路径（Upload 后有效），驱逐后据此重新加载
+        const std::string& GetPath() const { return m_Path; }
+
+        /// 全部子网格的显存占用（字节，不含纹理）
+        size_t GetGpuByteSize() const;
+
+        /**
+         * @brief 释放全部子网格的GPU缓冲，之后以占位网格绘制，直到再次 Upload（需在GL上下文线程调用）
+         * LOD 误差与包围球保留；纹理在全局 TextureCache 中，由调用方单独驱逐
+         * @return 未就绪或路径未知时返回 false
+         */
+        bool Evict();
 
     private:
         struct TexturedMesh {
@@ -41,31 +144,31 @@ namespace graphics {
         };
 
         std::vector<TexturedMesh> m_Meshes; ///< 所有子网格及其纹理
+        std::string m_Path; ///< 模型文件路径
         std::string m_Directory; ///< 模型文件所在目录
-
-        // 路径到纹理的缓存，避免重复加载
-        std::unordered_map<std::string, std::shared_ptr<Texture>> m_TextureCache;
-
-        /**
-         * @brief 加载OBJ模型
-         */
-        void LoadModel(const std::string& path, bool useSRGB);
+        bool m_Ready = false;
+        std::vector<float> m_LodErrors = {0.0f};
+        glm::vec3 m_BoundsCenter{0.0f};
+        float m_BoundsRadius = 0.866f;
+        BoundingBox m_Bounds{glm::vec3(-0.5f), glm::vec3(0.5f)};
+        OccluderMesh m_Occluder;
 
         /**
-         * @brief 处理tinyobj的shape和材质，按材质分组生成Mesh
+         * @brief 加载材质引用的全部纹理（漫反射、高光、法线）
          */
-        void ProcessMeshData(const void* attrib,
-                             const void* shape,
-                             const void* materials,
-                             size_t materialCount,
-                             bool useSRGB);
+        std::vector<std::shared_ptr<Texture>> LoadMaterialTextures(int materialId,
+                                                                   const ModelData& data,
+                                                                   bool useSRGB,
+                                                                   std::unordered_map<std::string, std::shared_ptr<Texture>>& loaded);
 
         /**
-         * @brief 加载材质纹理，带缓存
+         * @brief 从全局 TextureCache 取得材质纹理；本次加载预读取了像素时流式上传，新登记且未预读取时同步加载
+         * @param loaded 本次 Upload 已处理的纹理，避免多个材质引用同一文件时重复上传
          */
-        std::shared_ptr<Texture> LoadMaterialTexture(const std::string& baseDir,
+        std::shared_ptr<Texture> LoadMaterialTexture(const ModelData& data,
                                                      const std::string& texPath,
-                                                     bool useSRGB);
+                                                     bool useSRGB,
+                                                     std::unordered_map<std::string, std::shared_ptr<Texture>>& loaded);
     };
 
 } // namespace graphics
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "graphics/Mesh.h"
+#include "graphics/Meshlet.h"
+
+namespace graphics {
+
+    /**
+     * @brief MTL 材质中 Model 使用到的纹理引用
+     */
+    struct ObjMaterial {
+        std::string name;
+        std::string diffuseTexname;   ///< map_Kd
+        std::string specularTexname;  ///< map_Ks
+        std::string bumpTexname;      ///< map_Bump / map_bump / bump
+    };
+
+    /**
+     * @brief 面角点的属性索引（从0开始，-1表示缺失）
+     */
+    struct ObjIndex {
+        int vertex = -1;
+        int normal = -1;
+        int texcoord = -1;
+    };
+
+    /**
+     * @brief 以 o/g 划分的形状，面已三角化
+     */
+    struct ObjShape {
+        std::string name;
+        std::vector<ObjIndex> indices;  ///< 每3个角点构成一个三角形
+        std::vector<int> materialIds;   ///< 每个三角形的材质ID，-1表示无材质
+    };
+
+    /**
+     * @brief OBJ 文件解析结果（顶点属性按文件顺序平铺存储）
+     */
+    struct ObjData {
+        std::vector<float> positions;   ///< xyz
+        std::vector<float> normals;     ///< xyz
+        std::vector<float> texcoords;   ///< uv
+        std::vector<ObjShape> shapes;
+        std::vector<ObjMaterial> materials;
+        std::vector<std::string> materialLibraries; ///< 实际加载的MTL文件（相对OBJ所在目录）
+    };
+
+    /**
+     * @brief 按材质分组并去重后的子网格（CPU侧，可直接交给 Mesh 上传）
+     */
+    struct MeshData {
+        int materialId = -1;
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<Meshlet> meshlets;  ///< 索引缓冲上的簇划分（MeshletBuilder 生成，只覆盖 LOD0）
+        std::vector<MeshLod> lods;      ///< 细节级别（MeshSimplifier 生成），为空时整个索引缓冲即唯一级别
+    };
+
+    /**
+     * @brief 多线程 OBJ/MTL 解析器
+     * 文件通过内存映射读取，按行对齐切块后并行解析，
+     * 顶点去重使用开放寻址的扁平哈希表
+     */
+    class ObjParser {
+    public:
+        /**
+         * @brief 解析OBJ文件及其引用的MTL，失败时抛出 std::runtime_error
+         * @param path        OBJ文件路径
+         * @param threadCount 1 表示在调用线程串行解析，其他值经 core::JobSystem 并行（可在任务中调用）
+         */
+        static ObjData Parse(const std::string& path, unsigned int threadCount = 0);
+
+        /**
+         * @brief 解析MTL文件，文件不存在时返回空列表
+         */
+        static std::vector<ObjMaterial> ParseMtl(const std::string& path);
+
+        /**
+         * @brief 按 shape → 材质ID升序 生成去重后的子网格，顺序与原 tinyobj 路径一致
+         * @param obj         解析结果
+         * @param threadCount 1 表示在调用线程串行生成，其他值经 core::JobSystem 并行
+         */
+        static std::vector<MeshData> BuildMeshes(const ObjData& obj, unsigned int threadCount = 0);
+    };
+
+} // namespace graphics
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/Frustum.h"
+
+namespace graphics {
+
+    /**
+     * @brief 遮挡体网格：只含位置的紧凑三角形列表（模型空间），由最粗一级 LOD 生成
+     */
+    struct OccluderMesh {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+
+        /// 追加一段索引引用的三角形，只复制被引用的顶点；stride 为相邻顶点位置的字节间隔
+        void Append(const glm::vec3* vertexPositions, size_t vertexCount, size_t stride,
+                    const unsigned int* triangleIndices, size_t indexCount);
+
+        size_t GetTriangleCount() const { return indices.size() / 3; }
+        bool IsEmpty() const { return indices.empty(); }
+    };
+
+    /**
+     * @brief 低分辨率 CPU 深度缓冲：光栅化遮挡体，生成最小 / 最大深度层级，测试包围盒是否被完全遮挡
+     *
+     * 深度为 NDC z（-1 为近平面，1 为远平面），清为 1，遮挡体取较近值；只光栅化正面（逆时针）三角形，
+     * 与近平面相交的三角形先裁剪。光栅化按行分带并行，每行 SSE 每次处理 4 个像素。
+     * 测试时把包围盒 8 个角投影到屏幕，取覆盖的像素矩形与最近深度，从矩形不超过 2 x 2 个texel 的层级逐级细化：
+     * 最近深度比某texel的最大深度还远则该区域被遮挡；比最小深度更近则直接判为可见。
+     * 不调用任何GL函数
+     */
+    class OcclusionBuffer {
+    public:
+        /// width 须为 4 的倍数，否则抛出 std::runtime_error
+        explicit OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+        /// 开始新的一帧：清空深度与遮挡体
+        void Begin(const glm::mat4& viewProjection);
+
+        /// 变换并裁剪遮挡体三角形，暂存到 Rasterize()
+        void AddOccluder(const OccluderMesh& mesh, const glm::mat4& model);
+
+        /// 光栅化全部暂存的三角形并生成深度层级；threadCount 不为 1 时按行分带经 JobSystem 并行，0 表示按任务系统线程数分带（三角形较少时单线程）
+        void Rasterize(unsigned int threadCount = 1);
+
+        /**
+         * @brief 世界空间包围盒是否可能可见（保守：与近平面相交时总是可见）
+         * 须在 Rasterize() 之后调用，可并发
+         */
+        bool IsVisible(const BoundingBox& worldBox) const;
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+        /// 逐像素深度（行优先，第 0 行为屏幕底部）
+        const std::vector<float>& GetDepth() const { return m_Depth; }
+        /// 本帧参与光栅化的三角形（裁剪、背面剔除之后）
+        size_t GetTriangleCount() const { return m_Triangles.size(); }
+
+    private:
+        /// 屏幕空间三角形：三条边的边函数（内部为非负）、深度平面与像素包围矩形
+        struct Triangle {
+            float edgeA[3], edgeB[3], edgeC[3];
+            float depthX, depthY, depthC;
+            int32_t minX, maxX, minY, maxY;
+        };
+
+        struct Level {
+            uint32_t width = 0, height = 0;
+            std::vector<float> minDepth, maxDepth;
+        };
+
+        /// 屏幕坐标（像素）与 NDC 深度
+        void SetupTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+        void RasterizeRows(int32_t firstRow, int32_t endRow);
+        void BuildLevels();
+
+        uint32_t m_Width, m_Height;
+        glm::mat4 m_ViewProjection{1.0f};
+        std::vector<float> m_Depth;
+        std::vector<Level> m_Levels;       ///< 第 1 级起（第 0 级即 m_Depth）
+        std::vector<Triangle> m_Triangles;
+        std::vector<glm::vec4> m_Clip;     ///< AddOccluder 的临时缓冲
+    };
+
+    /**
+     * @brief 遮挡剔除的开关与统计（由 Scene::Cull 在视锥剔除之后调用）
+     */
+    class OcclusionCuller {
+    public:
+        struct Stats {
+            size_t occluders = 0;        ///< 本帧光栅化的遮挡体
+            size_t triangles = 0;        ///< 光栅化的三角形（裁剪、背面剔除之后）
+            size_t tested = 0;           ///< 通过视锥测试后参与遮挡测试的实体
+            size_t occluded = 0;
+            size_t drawCallsSaved = 0;   ///< 被遮挡实体的子网格数（每个子网格至少一次绘制调用）
+            double rasterMs = 0.0;       ///< 遮挡体变换、光栅化与生成深度层级
+            double testMs = 0.0;
+        };
+
+        /// 关闭时不光栅化，所有通过视锥测试的实体都提交绘制
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// 关闭时逐像素标量光栅化，用于对比与排查
+        static void SetSimdEnabled(bool enabled) { s_SimdEnabled = enabled; }
+        static bool IsSimdEnabled() { return s_SimdEnabled; }
+
+        /// 光栅化分带所按的线程数，1 为单线程，0 表示任务系统的线程数
+        static void SetThreadCount(unsigned int threads) { s_ThreadCount = threads; }
+        static unsigned int GetThreadCount() { return s_ThreadCount; }
+
+        static void RecordRaster(size_t occluders, size_t triangles, double ms) {
+            s_Stats.occluders += occluders;
+            s_Stats.triangles += triangles;
+            s_Stats.rasterMs += ms;
+        }
+        static void RecordTests(size_t tested, size_t occluded, size_t drawCallsSaved, double ms) {
+            s_Stats.tested += tested;
+            s_Stats.occluded += occluded;
+            s_Stats.drawCallsSaved += drawCallsSaved;
+            s_Stats.testMs += ms;
+        }
+
+        static const Stats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = Stats{}; }
+
+    private:
+        static bool s_Enabled;
+        static bool s_SimdEnabled;
+        static unsigned int s_ThreadCount;
+        static Stats s_Stats;
+    };
+
+} // namespace graphics
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/JobSystem.h"
+#include "graphics/Meshlet.h"
+
+namespace graphics {
+
+    /// 渲染命令类型
+    enum class RenderCommandType : uint16_t {
+        BindPipeline,  ///< 切换着色器程序
+        BindMaterial,  ///< 绑定材质纹理到纹理单元 0..n
+        SetDrawData,   ///< 写入逐次绘制的模型矩阵
+        Draw           ///< 绘制一个网格（整段索引或剔除后的多个区间）
+    };
+
+    /**
+     * @brief 每条命令开头的公共部分
+     * size 含命令本身与其后附带的数据，并按 CommandBuffer::kAlignment 对齐，解码时据此跳到下一条
+     */
+    struct RenderCommandHeader {
+        RenderCommandType type;
+        uint16_t reserved = 0;
+        uint32_t size = 0;
+    };
+
+    struct BindPipelineCommand {
+        static constexpr RenderCommandType kType = RenderCommandType::BindPipeline;
+        RenderCommandHeader header;
+        uint32_t program;
+        int32_t modelLocation;   ///< SetDrawData 写入的 uniform 位置，录制前在GL线程查好
+    };
+
+    struct BindMaterialCommand {
+        static constexpr RenderCommandType kType = RenderCommandType::BindMaterial;
+        static constexpr uint32_t kMaxTextures = 8;
+        RenderCommandHeader header;
+        uint32_t textureCount;
+        uint32_t textures[kMaxTextures];   ///< 纹理对象，0 表示未就绪，回放时绑定占位纹理
+    };
+
+    struct SetDrawDataCommand {
+        static constexpr RenderCommandType kType = RenderCommandType::SetDrawData;
+        RenderCommandHeader header;
+        uint32_t reserved[2];
+        glm::mat4 model;
+    };
+
+    /**
+     * @brief 绘制命令；rangeCount > 0 时其后紧跟 rangeCount 个索引偏移（const void*）与
+     * rangeCount 个索引数（GLsizei），以 glMultiDrawElements 绘制，否则绘制 [firstIndex, firstIndex + indexCount)
+     */
+    struct DrawCommand {
+        static constexpr RenderCommandType kType = RenderCommandType::Draw;
+        RenderCommandHeader header;
+        uint32_t vao;            ///< 0 表示模型未就绪，回放时绘制占位立方体
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t rangeCount;
+        uint32_t triangles;      ///< 本次绘制的三角形数（计入 Mesh::GetDrawStats）
+        uint32_t reserved;
+        float dequantOffset[4];  ///< 写入 Mesh::kDequantOffsetLocation 的常量属性
+        float dequantScale[4];   ///< 写入 Mesh::kDequantScaleLocation 的常量属性
+
+        const void* const* GetOffsets() const {
+            return reinterpret_cast<const void* const*>(reinterpret_cast<const uint8_t*>(this) + sizeof(DrawCommand));
+        }
+        const GLsizei* GetCounts() const {
+            return reinterpret_cast<const GLsizei*>(GetOffsets() + rangeCount);
+        }
+    };
+
+    /**
+     * @brief 在GL线程执行渲染命令，记住已绑定的程序、纹理、VAO、模型矩阵与反量化常量，
+     * 与当前状态相同的绑定直接跳过并计数。执行期间不能穿插其他改变这些状态的GL调用（占位绘制除外，其后自动失效）
+     */
+    class CommandExecutor {
+    public:
+        /// 一类状态的绑定次数：issued 为实际发出的GL调用，skipped 为因与当前状态相同而跳过的
+        struct BindCount {
+            size_t issued = 0;
+            size_t skipped = 0;
+        };
+
+        struct Stats {
+            size_t draws = 0;
+            BindCount programs;
+            BindCount textures;    ///< 按纹理单元计
+            BindCount meshes;      ///< VAO 与反量化常量属性
+            BindCount drawData;    ///< 模型矩阵 uniform
+
+            size_t GetIssued() const { return programs.issued + textures.issued + meshes.issued + drawData.issued; }
+            size_t GetSaved() const { return programs.skipped + textures.skipped + meshes.skipped + drawData.skipped; }
+        };
+
+        /// dryRun 为 true 时只跟踪状态与计数，不调用GL函数（用于没有GL上下文的基准）
+        explicit CommandExecutor(bool dryRun = false) : m_DryRun(dryRun) {}
+
+        void BindPipeline(const BindPipelineCommand& command);
+        void BindMaterial(const BindMaterialCommand& command);
+        void SetDrawData(const SetDrawDataCommand& command);
+        void Draw(const DrawCommand& command);
+
+        /// 按 header.type 分发
+        void Execute(const RenderCommandHeader& header);
+
+        /// 解绑 VAO，统计累加到 GetStats()；之后执行器回到初始状态，可继续使用
+        void Finish();
+
+        const Stats& GetLocalStats() const { return m_Stats; }
+
+        /// 本帧所有执行器 Finish 时累加的统计（调用方按帧清零）
+        static const Stats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = Stats{}; }
+
+    private:
+        /// 已知状态；0 / nullptr 表示未知，下一次必定发出
+        unsigned int m_Program = 0;
+        int m_ModelLocation = -1;
+        const SetDrawDataCommand* m_DrawData = nullptr;
+        unsigned int m_Textures[BindMaterialCommand::kMaxTextures] = {};
+        unsigned int m_ActiveUnit = UINT32_MAX;
+        unsigned int m_VAO = 0;
+        bool m_DequantValid = false;
+        float m_Dequant[8] = {};
+        bool m_DryRun;
+        Stats m_Stats;
+
+        static Stats s_Stats;
+
+        void Invalidate();
+    };
+
+    /**
+     * @brief 线性的渲染命令缓冲：命令为 POD，依次追加在一块连续内存中，与图形 API 无关
+     *
+     * 录制只写内存（不调用GL函数），每个线程各用一个缓冲即可并行录制；
+     * Submit 在GL线程按录制顺序解码并执行。Reset 后内存保留，下一帧复用。
+     * 录制期间的剔除统计先记在缓冲里，Submit 时合并到全局统计
+     */
+    class CommandBuffer {
+    public:
+        static constexpr size_t kAlignment = 16;
+
+        void BindPipeline(unsigned int program, int modelLocation);
+
+        /// textures 中 0 表示未就绪；超过 kMaxTextures 的部分忽略
+        void BindMaterial(const unsigned int* textures, size_t count);
+
+        void SetDrawData(const glm::mat4& model);
+
+        /**
+         * @brief 追加绘制命令，header 与 rangeCount 由此填写
+         * @param ranges 非空时附带其中的绘制区间（多区间绘制）
+         */
+        void Draw(const DrawCommand& command, const MeshletCuller::DrawList* ranges = nullptr);
+
+        /// 清空命令与统计，保留内存
+        void Reset();
+
+        bool IsEmpty() const { return m_Data.empty(); }
+        size_t GetByteSize() const { return m_Data.size(); }
+        size_t GetCommandCount() const { return m_CommandCount; }
+        size_t GetDrawCount() const { return m_DrawCount; }
+
+        /**
+         * @brief 按录制顺序解码，对每条命令调用 fn(const RenderCommandHeader&)，
+         * 由调用方按 header.type 转换为具体命令
+         */
+        template <typename Fn>
+        void ForEach(Fn&& fn) const {
+            for (size_t offset = 0; offset < m_Data.size();) {
+                const auto& header = *reinterpret_cast<const RenderCommandHeader*>(m_Data.data() + offset);
+                fn(header);
+                offset += header.size;
+            }
+        }
+
+        /**
+         * @brief 在GL线程按顺序执行全部命令，并把录制期间的统计合并到全局统计
+         * @param executor 非空时沿用其已知状态，否则使用临时执行器
+         */
+        void Submit(CommandExecutor* executor = nullptr) const;
+
+        /// 只把录制期间的剔除统计合并到全局统计（命令由 RenderQueue 排序后执行时使用）
+        void FlushStats() const;
+
+        /// 录制时的剔除暂存区与统计，由 Mesh::Record / Model::Record 使用
+        MeshletCuller::DrawList& GetCullScratch() { return m_CullScratch; }
+        MeshletCuller::Stats& GetMeshletStats() { return m_MeshletStats; }
+        void CountMeshes(size_t tested, size_t culled) {
+            m_MeshesTested += tested;
+            m_MeshesCulled += culled;
+        }
+
+    private:
+        std::vector<uint8_t> m_Data;   ///< 全局 operator new 的对齐（16 字节）满足 kAlignment
+        size_t m_CommandCount = 0;
+        size_t m_DrawCount = 0;
+
+        MeshletCuller::DrawList m_CullScratch;
+        MeshletCuller::Stats m_MeshletStats;
+        size_t m_MeshesTested = 0;
+        size_t m_MeshesCulled = 0;
+
+        /// 追加一条命令（含 extraBytes 字节的附带数据），返回可写的命令
+        template <typename Command>
+        Command& Append(size_t extraBytes = 0) {
+            static_assert(std::is_trivially_copyable_v<Command>, "渲染命令必须是 POD");
+            const size_t size = (sizeof(Command) + extraBytes + kAlignment - 1) & ~(kAlignment - 1);
+            const size_t offset = m_Data.size();
+            m_Data.resize(offset + size);
+            auto* command = reinterpret_cast<Command*>(m_Data.data() + offset);
+            command->header.type = Command::kType;
+            command->header.reserved = 0;
+            command->header.size = static_cast<uint32_t>(size);
+            ++m_CommandCount;
+            return *command;
+        }
+    };
+
+    /**
+     * @brief 一帧中一个绘制阶段的命令：把对象列表分段，每段录制到各自的 CommandBuffer，
+     * 由 core::JobSystem 并行录制，再在GL线程按段的顺序回放，结果与单线程顺序录制一致
+     */
+    class CommandList {
+    public:
+        /// 每段至少包含的对象数，太小时分段与调度的开销超过录制本身
+        static constexpr size_t kMinSliceSize = 64;
+
+        /**
+         * @brief 清空后并行录制 [0, count)：对每段调用 record(CommandBuffer&, begin, end)
+         * @param sliceSize 每段对象数，0 表示按线程数自动选择（约每线程 4 段，不少于 kMinSliceSize）
+         */
+        template <typename Fn>
+        void Record(size_t count, Fn&& record, size_t sliceSize = 0) {
+            if (sliceSize == 0) {
+                const size_t threads = std::max<size_t>(core::JobSystem::GetThreadCount(), 1);
+                sliceSize = std::max(kMinSliceSize, (count + threads * 4 - 1) / (threads * 4));
+            }
+            const size_t slices = (count + sliceSize - 1) / sliceSize;
+            Prepare(slices);
+            core::JobSystem::ParallelFor(slices, [&](size_t begin, size_t end) {
+                for (size_t slice = begin; slice < end; ++slice) {
+                    record(*m_Buffers[slice], slice * sliceSize, std::min(count, (slice + 1) * sliceSize));
+                }
+            }, 1);
+        }
+
+        /// 在GL线程按段的顺序执行全部命令，executor 为空时使用临时执行器
+        void Submit(CommandExecutor* executor = nullptr) const;
+
+        void Clear() { Prepare(0); }
+
+        /// 本次录制使用的缓冲（按段的顺序）
+        size_t GetBufferCount() const { return m_Used; }
+        const CommandBuffer& GetBuffer(size_t index) const { return *m_Buffers[index]; }
+
+        size_t GetCommandCount() const;
+        size_t GetDrawCount() const;
+        size_t GetByteSize() const;
+
+    private:
+        std::vector<std::unique_ptr<CommandBuffer>> m_Buffers;  ///< 缓冲逐帧复用，数量只增不减
+        size_t m_Used = 0;
+
+        /// 准备 count 个清空的缓冲
+        void Prepare(size_t count);
+    };
+
+} // namespace graphics
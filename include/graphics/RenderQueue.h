@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/RenderCommand.h"
+
+namespace graphics {
+
+    /// 绘制阶段，排序键的最高位：不透明物体先于半透明物体
+    enum class RenderPass : uint8_t {
+        Opaque = 0,       ///< 按状态分组，组内由近到远
+        Transparent = 1   ///< 由远到近，深度优先于状态
+    };
+
+    /**
+     * @brief 64 位排序键，从高到低：
+     * 不透明 pass(4) | program(12) | material(16) | mesh(16) | depth(16)，
+     * 半透明 pass(4) | ~depth(16) | program(12) | material(16) | mesh(16)
+     * 各字段取低位，哈希碰撞只影响分组效果，不影响绘制结果（执行时按实际状态判断是否需要绑定）
+     */
+    struct SortKey {
+        static constexpr uint32_t kDepthMax = 0xFFFF;
+
+        static uint64_t Make(RenderPass pass, uint32_t program, uint32_t material, uint32_t mesh, uint32_t depth);
+
+        /// 材质的纹理组合折叠为 16 位
+        static uint32_t HashMaterial(const BindMaterialCommand& material);
+
+        static RenderPass GetPass(uint64_t key) { return static_cast<RenderPass>(key >> 60); }
+    };
+
+    /**
+     * @brief 每帧从录制好的 CommandList 收集绘制项，按排序键基数排序后执行，减少GL状态切换
+     *
+     * 每个绘制项引用命令缓冲中的一条 Draw 及其之前最近的 BindPipeline / SetDrawData / BindMaterial，
+     * 因此命令列表在 Submit 之前必须保持不变。深度取模型矩阵平移部分沿视线方向的距离，在 [near, far] 内线性量化
+     */
+    class RenderQueue {
+    public:
+        struct Item {
+            uint64_t key;
+            uint32_t index;    ///< m_Draws 中的下标
+        };
+
+        struct Stats {
+            size_t items = 0;
+            size_t sortPasses = 0;   ///< 实际执行的基数排序趟数（字节全部相同的一趟跳过）
+            double buildMs = 0.0;    ///< 收集绘制项与计算排序键
+            double sortMs = 0.0;
+        };
+
+        /// 清空绘制项，保留内存
+        void Clear();
+
+        /**
+         * @brief 收集 list 中全部绘制项（各缓冲并行收集）
+         * @param eye / forward 相机位置与视线方向，nearPlane / farPlane 为量化深度的范围
+         */
+        void Add(const CommandList& list, RenderPass pass, const glm::vec3& eye, const glm::vec3& forward,
+                 float nearPlane, float farPlane);
+
+        /// 按排序键稳定排序，关闭排序时保持录制顺序
+        void Sort();
+
+        /**
+         * @brief 在GL线程按排序后的顺序执行，冗余的绑定由 CommandExecutor 跳过；录制期间的剔除统计一并合并
+         */
+        void Submit(CommandExecutor& executor) const;
+
+        size_t GetItemCount() const { return m_Items.size(); }
+        const std::vector<Item>& GetItems() const { return m_Items; }
+
+        /**
+         * @brief 绘制项引用的命令（排序与执行时只读）
+         */
+        struct Draw {
+            const BindPipelineCommand* pipeline;
+            const SetDrawDataCommand* drawData;
+            const BindMaterialCommand* material;
+            const DrawCommand* draw;
+        };
+        const Draw& GetDraw(const Item& item) const { return m_Draws[item.index]; }
+
+        /**
+         * @brief 按 key 升序的 LSD 基数排序（每趟 8 位，稳定），scratch 为同样大小的暂存区
+         * @return 实际执行的趟数
+         */
+        static size_t RadixSort(std::vector<Item>& items, std::vector<Item>& scratch);
+
+        /// 关闭时按录制顺序执行，用于对比状态切换次数
+        static void SetSortEnabled(bool enabled) { s_SortEnabled = enabled; }
+        static bool IsSortEnabled() { return s_SortEnabled; }
+
+        /// 本帧所有队列累加的统计（调用方按帧清零）
+        static const Stats& GetStats() { return s_Stats; }
+        static void ResetStats() { s_Stats = Stats{}; }
+
+    private:
+        std::vector<Item> m_Items;
+        std::vector<Item> m_Scratch;
+        std::vector<Draw> m_Draws;
+        std::vector<const CommandBuffer*> m_Buffers;   ///< Submit 时合并其剔除统计
+
+        static bool s_SortEnabled;
+        static Stats s_Stats;
+    };
+
+} // namespace graphics
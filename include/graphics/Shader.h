@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <glm/glm.hpp>
@@ -8,15 +9,28 @@ namespace graphics {
 
     /**
      * @brief OpenGL Shader 封装类，符合 RAII 原则，负责加载、编译、绑定、设置 uniform
+     *
+     * 链接结果以程序二进制缓存到磁盘，键为展开后的源码哈希与驱动标识，命中时跳过编译；
+     * 驱动更新后缓存被拒绝，自动回退为编译并覆盖。
      */
     class Shader {
     public:
+        struct Stats {
+            size_t programs = 0;        ///< 创建的程序数
+            size_t binaryHits = 0;      ///< 从程序二进制缓存加载
+            size_t binaryRejected = 0;  ///< 缓存存在但被驱动拒绝
+            size_t compiled = 0;        ///< 从源码编译
+            double cpuMs = 0.0;         ///< 构造与 Finish 的累计耗时（毫秒）
+        };
+
         /**
          * @brief 构造函数，立即加载 shader（推荐）
          * @param vertexPath 顶点着色器路径
          * @param fragmentPath 片段着色器路径
+         * @param deferred 为 true 时只提交编译与链接，不等待结果；使用前必须调用 Finish。
+         *                 先为多个程序提交再统一 Finish，驱动可在后台线程并行编译
          */
-        Shader(const std::string& vertexPath, const std::string& fragmentPath);
+        Shader(const std::string& vertexPath, const std::string& fragmentPath, bool deferred = false);
 
         /**
          * @brief 禁止拷贝构造和赋值
@@ -35,6 +49,16 @@ namespace graphics {
          */
         ~Shader();
 
+        /**
+         * @brief 等待编译与链接完成并检查错误，成功后写入程序二进制缓存；失败时释放程序并抛出 std::runtime_error
+         */
+        void Finish();
+
+        /**
+         * @brief 编译与链接是否已完成（不阻塞；驱动不支持并行编译时总是返回 true）
+         */
+        bool IsCompileComplete() const;
+
         /**
          * @brief 绑定 Shader 程序
          */
@@ -53,19 +77,47 @@ namespace graphics {
         void SetUniform(const std::string& name, const glm::vec4& value);
         void SetUniform(const std::string& name, const glm::mat4& value);
 
+        /**
+         * @brief 查询 uniform 位置（带缓存），不存在时返回 -1
+         * 录制渲染命令前在GL线程查好，命令中只保存位置
+         */
+        int GetUniformLocation(const std::string& name) const;
+
         /**
          * @brief 获取 shader 程序 ID
          */
         unsigned int GetID() const { return m_ID; }
 
+        /// 是否使用程序二进制缓存（默认开启，关闭时可测量冷启动编译耗时）
+        static void SetBinaryCacheEnabled(bool enabled) { s_BinaryCacheEnabled = enabled; }
+        static bool IsBinaryCacheEnabled() { return s_BinaryCacheEnabled; }
+
+        /// 程序二进制缓存目录
+        static std::string GetBinaryCacheDirectory();
+
+        static const Stats& GetStats() { return s_Stats; }
+
     private:
         unsigned int m_ID = 0;
+        unsigned int m_Vertex = 0;      ///< 等待 Finish 的着色器对象
+        unsigned int m_Fragment = 0;
+        bool m_Pending = false;
+        uint64_t m_BinaryKey = 0;
+        std::string m_VertexPath;
+        std::string m_FragmentPath;
         mutable std::unordered_map<std::string, int> m_UniformLocationCache;
 
+        static bool s_BinaryCacheEnabled;
+        static Stats s_Stats;
+
         std::string ReadFile(const std::string& path) const;
         unsigned int CompileShader(unsigned int type, const std::string& source) const;
-        void CheckCompileErrors(unsigned int shader, const std::string& type) const;
-        int GetUniformLocation(const std::string& name) const;
+        void CheckCompileErrors(unsigned int shader, const std::string& type, const std::string& path = "") const;
+
+        /// 从缓存加载程序二进制，成功时 m_ID 为已链接的程序
+        bool LoadBinary();
+        void SaveBinary() const;
+        void Release();
     };
 
 } // namespace graphics
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace graphics {
+
+    /**
+     * @brief GLSL 源码读取、#include 展开与离线烘焙（.rglsl）
+     *
+     * 支持 #include "相对路径"（相对包含它的文件）与 #pragma once。展开处插入 #line 指令：
+     * 被包含文件按首次出现顺序编号为 1..n（主文件为 0），编译错误中的 "编号(行号)" 与源文件一致。
+     * 烘焙结果为展开并去除注释后的源码，末尾记录依赖文件（相对源文件）与全部文件内容的组合哈希，
+     * 源文件或任一依赖变化后自动回退为重新展开。
+     */
+    class ShaderSource {
+    public:
+        static constexpr uint32_t kVersion = 2;
+
+        /// 展开结果
+        struct Preprocessed {
+            std::string source;
+            std::vector<std::string> dependencies; ///< 被包含的文件（完整路径），下标 + 1 即 #line 中的文件编号
+            uint64_t hash = 0;                     ///< 源文件与全部依赖内容的组合哈希
+        };
+
+        /// 源文件对应的烘焙文件路径（源文件名后追加 .rglsl）
+        static std::string GetCookedPath(const std::string& sourcePath);
+
+        /**
+         * @brief 读取源文件，展开 #include 后写出烘焙文件，返回依赖文件列表；失败时抛出 std::runtime_error
+         */
+        static std::vector<std::string> Cook(const std::string& sourcePath, const std::string& cookedPath);
+
+        /**
+         * @brief 读取展开后的着色器源码：先查内存缓存，再查有效的烘焙文件，否则读取源文件并展开
+         * 线程安全；失败时抛出 std::runtime_error
+         */
+        static std::string Load(const std::string& sourcePath);
+
+        /**
+         * @brief 读取源文件并展开全部 #include（不使用任何缓存），循环包含或文件缺失时抛出 std::runtime_error
+         */
+        static Preprocessed Preprocess(const std::string& sourcePath);
+
+        /// 清空内存缓存（着色器文件修改后重新加载前调用）
+        static void ClearCache();
+
+        /// 去除 // 与 /* */ 注释及行尾空白，保留换行
+        static std::string StripComments(const std::string& source);
+
+    private:
+        static std::unordered_map<std::string, std::string> s_Cache; ///< 源文件路径 → 展开结果
+        static std::mutex s_CacheMutex;
+    };
+
+} // namespace graphics
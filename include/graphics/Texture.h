@@ -2,13 +2,16 @@
 
 #include <string>
 #include <glad/glad.h>
+#include "graphics/GpuResource.h"
+#include "graphics/Image.h"
+#include "graphics/TextureFile.h"
 
 namespace graphics {
 
     /**
      * @brief 封装 OpenGL 2D 纹理，RAII 管理，支持 sRGB 格式
      */
-    class Texture {
+    class Texture : public GpuResource {
     public:
         /**
          * @brief 构造并加载纹理
@@ -17,6 +20,16 @@ namespace graphics {
          */
         explicit Texture(const std::string& path, bool useSRGB = false);
 
+        /**
+         * @brief 由已解码的图像构造（需在GL上下文线程调用）
+         */
+        Texture(const ImageData& image, bool useSRGB = false);
+
+        /**
+         * @brief 构造尚未上传的纹理，绑定时使用占位纹理，之后通过 Upload 填充
+         */
+        Texture() = default;
+
         // 禁用拷贝构造和赋值
         Texture(const Texture&) = delete;
         Texture& operator=(const Texture&) = delete;
@@ -28,9 +41,31 @@ namespace graphics {
         /// 析构函数：自动释放OpenGL资源
         ~Texture();
 
-        /// 绑定纹理到指定纹理单元
+        /**
+         * @brief 上传已解码的图像并生成mipmap（需在GL上下文线程调用）
+         */
+        void Upload(const ImageData& image, bool useSRGB);
+
+        /**
+         * @brief 上传烘焙文件的全部 mip 级别，或解码后的像素（需在GL上下文线程调用）
+         */
+        void Upload(const TextureSource& source, bool useSRGB);
+
+        /// 是否已上传到GPU（流式上传完成前为 false）
+        bool IsReady() const { return m_Ready; }
+
+        /// 绑定纹理到指定纹理单元，未就绪时绑定1x1白色占位纹理
         void Bind(unsigned int slot = 0) const;
 
+        /**
+         * @brief 录制绑定命令用：记录本帧使用并返回要绑定的纹理对象，未就绪时返回 0
+         * 不调用GL函数，可在工作线程调用；回放时 0 换成 GetPlaceholderID()
+         */
+        unsigned int GetBindID() const;
+
+        /// 1x1白色占位纹理，首次调用时创建（需在GL上下文线程调用）
+        static unsigned int GetPlaceholderID();
+
         /// 获取OpenGL纹理ID
         unsigned int GetID() const { return m_ID; }
 
@@ -38,11 +73,43 @@ namespace graphics {
         int GetWidth() const { return m_Width; }
         int GetHeight() const { return m_Height; }
 
+        /// 显存占用估算（字节，含 mip 链）
+        size_t GetGpuByteSize() const { return m_GpuBytes; }
+
+        /**
+         * @brief 记录来源文件，驱逐后据此重新加载（由文件构造的纹理自动记录）
+         */
+        void SetSource(const std::string& path, bool useSRGB) { m_SourcePath = path; m_SRGB = useSRGB; }
+        const std::string& GetSourcePath() const { return m_SourcePath; }
+        bool IsSRGB() const { return m_SRGB; }
+
+        /**
+         * @brief 释放GPU存储，之后绑定为占位纹理，直到重新上传（需在GL上下文线程调用）
+         * @return 未就绪或没有来源文件（无法重新加载）时返回 false
+         */
+        bool Evict();
+
     private:
+        friend class TextureUploader;
+
         unsigned int m_ID = 0;
         int m_Width = 0, m_Height = 0, m_Channels = 0;
+        bool m_Ready = false;
+        bool m_HasMipChain = false; ///< 已含完整 mip 链，无需生成
+        size_t m_GpuBytes = 0;
+        std::string m_SourcePath;
+        bool m_SRGB = false;
 
         void LoadFromFile(const std::string& path, bool useSRGB);
+
+        /// 分配不含数据的纹理存储，像素随后由 TextureUploader 分段写入
+        void AllocateStorage(int width, int height, int channels, bool useSRGB);
+
+        /// 按烘焙文件的格式与级别分配存储
+        void AllocateStorage(const TextureFile& file, bool useSRGB);
+
+        /// 全部像素写入后生成mipmap（烘焙纹理已自带）、设置采样参数并标记就绪
+        void FinishUpload();
     };
 
 } // namespace graphics
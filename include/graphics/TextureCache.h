@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "graphics/Texture.h"
+
+namespace graphics {
+
+    /**
+     * @brief 全局纹理缓存，Model 与 ResourceManager 共用
+     * 按规范路径与采样参数（是否 sRGB）查找，调用方用过的路径写法记为别名，再次查找时不必规范化；
+     * 路径首次出现时再按文件内容哈希查找，不同路径下的相同文件共用一份纹理（AcquirePath 的内容登记推迟到工作线程）。
+     * 已发布的表只读，读取方原子地取得指针，命中时查找无需加锁；新登记先放入待发布表（互斥量保护），
+     * 由 EndFrame 每帧合并一次后整体发布，避免每次登记都复制整张表。被替换的表在没有读取方时才释放。
+     * 可在任意线程调用，但返回的纹理只能在GL线程上传。
+     */
+    class TextureCache {
+    public:
+        struct Stats {
+            size_t lookups = 0;      ///< Acquire 调用次数
+            size_t pathHits = 0;     ///< 同一路径命中
+            size_t contentHits = 0;  ///< 路径不同但内容相同，复用已有纹理
+            size_t textures = 0;     ///< 当前不重复的纹理数
+            size_t paths = 0;        ///< 当前登记的路径数（含同一文件的不同写法）
+        };
+
+        /// 查找，已发布的登记无锁命中；本帧新登记的在互斥量下查找；未登记时返回空
+        static std::shared_ptr<Texture> Find(const std::string& path, bool useSRGB);
+
+        /**
+         * @brief 查找或登记纹理；新登记时返回尚未上传的纹理并置 created，由调用方负责上传
+         * 路径未命中时在调用线程读取文件计算内容哈希（不持锁）
+         */
+        static std::shared_ptr<Texture> Acquire(const std::string& path, bool useSRGB, bool& created);
+
+        /**
+         * @brief 同 Acquire 但只按路径查找与登记，不读取文件，供主线程发起的异步加载使用
+         * 新登记的纹理随后在工作线程调用 RegisterContent，之后其他路径下的相同文件才能共用它
+         */
+        static std::shared_ptr<Texture> AcquirePath(const std::string& path, bool useSRGB, bool& created);
+
+        /**
+         * @brief 读取 AcquirePath 新登记纹理的来源文件，按内容哈希登记（可在工作线程调用）
+         * @return 已有相同内容的纹理时保留原登记并返回 false，此纹理仍需自行上传
+         */
+        static bool RegisterContent(const std::shared_ptr<Texture>& texture);
+
+        /// 移除某路径对应纹理的全部登记（加载失败时调用）
+        static void Remove(const std::string& path, bool useSRGB);
+
+        /// 全部不重复的纹理
+        static std::vector<std::shared_ptr<Texture>> GetTextures();
+
+        static Stats GetStats();
+        static void ResetStats();
+
+        /**
+         * @brief 每帧调用一次（主线程）：发布本帧的新登记，释放已无读取方的旧表
+         */
+        static void EndFrame();
+
+        /// 清空缓存（需在GL上下文销毁前、没有其他线程查找时调用）
+        static void Clear();
+
+        /// 规范路径：解析 . 、.. 与符号链接，统一为 '/' 分隔
+        static std::string GetCanonicalPath(const std::string& path);
+
+        /// 文件内容哈希：优先源文件，只有烘焙文件时使用烘焙文件，都不存在时返回 0（只按路径查找）
+        static uint64_t HashContent(const std::string& path);
+
+    private:
+        struct Table {
+            std::unordered_map<std::string, std::shared_ptr<Texture>> byPath; ///< 规范路径或调用方的原始写法 + sRGB 标记
+            std::unordered_map<uint64_t, std::shared_ptr<Texture>> byContent; ///< 内容哈希与 sRGB 标记的组合
+        };
+
+        /// 持有期间读取方计数不为零，其间取得的表不会被释放
+        class ReadScope {
+        public:
+            ReadScope() { s_Readers.fetch_add(1); }
+            ~ReadScope() { s_Readers.fetch_sub(1); }
+            ReadScope(const ReadScope&) = delete;
+            ReadScope& operator=(const ReadScope&) = delete;
+        };
+
+        static std::shared_ptr<Texture> AcquireImpl(const std::string& path, bool useSRGB, bool hashContent, bool& created);
+
+        static std::string MakePathKey(const std::string& canonicalPath, bool useSRGB);
+        static uint64_t MakeContentKey(uint64_t contentHash, bool useSRGB);
+
+        /// 在已发布表与待发布表中查找（需持有 s_WriteMutex）
+        static std::shared_ptr<Texture> FindPathLocked(const std::string& pathKey);
+        static std::shared_ptr<Texture> FindContentLocked(uint64_t contentKey);
+
+        /// 发布新表并把旧表加入待释放列表（需持有 s_WriteMutex）
+        static void PublishLocked(std::unique_ptr<const Table> table);
+        /// 没有读取方时释放待释放的旧表（需持有 s_WriteMutex）
+        static void ReclaimLocked();
+
+        static std::atomic<const Table*> s_Table;         ///< 已发布的表，由 s_Current 持有
+        static std::atomic<size_t> s_Readers;
+        static std::mutex s_WriteMutex;
+        static std::unique_ptr<const Table> s_Current;
+        static Table s_Pending;                           ///< 本帧新登记，EndFrame 时并入
+        static std::vector<std::unique_ptr<const Table>> s_Retired;
+        static std::atomic<size_t> s_Lookups;
+        static std::atomic<size_t> s_PathHits;
+        static std::atomic<size_t> s_ContentHits;
+    };
+
+} // namespace graphics
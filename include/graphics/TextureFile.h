@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "graphics/BlockCompression.h"
+#include "graphics/Image.h"
+#include "graphics/MipGenerator.h"
+#include "utils/VirtualFileSystem.h"
+
+namespace graphics {
+
+    /// 一个 mip 级别的数据视图
+    struct TextureLevel {
+        int width = 0;
+        int height = 0;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief 烘焙纹理文件（.rtex）：块压缩格式 + 预生成的完整 mip 链
+     * 文件布局：头 | 级别表 | 16字节对齐的各级数据。打开时内存映射，级别数据零拷贝。
+     * 头中记录源文件的大小、修改时间与内容哈希，大小与时间都未变时打开不再读取源文件
+     */
+    class TextureFile {
+    public:
+        static constexpr uint32_t kMagic = 0x58455452; // "RTEX"
+        static constexpr uint32_t kVersion = 2;   ///< 2：记录源文件大小与时间
+
+        struct CookOptions {
+            bool highQuality = false;    ///< 颜色贴图使用 BC7
+            bool srgb = false;           ///< 像素为 sRGB 编码（记录在文件中，mip 在线性空间生成）
+            bool normalMap = false;      ///< 每级 mip 重新归一化法线
+            int coverageChannel = -1;    ///< 保持 alpha 测试覆盖率的通道，见 MipGenerator::Options
+            MipFilter mipFilter = MipFilter::Kaiser;
+            unsigned int threadCount = 0;   ///< 传给 MipGenerator 与 BlockCompressor，1 表示串行
+        };
+
+        struct CookStats {
+            TextureFormat format = TextureFormat::RGBA8;
+            int width = 0;
+            int height = 0;
+            size_t uncompressedBytes = 0; ///< 以原通道数未压缩上传并生成 mip 时的显存
+            size_t cookedBytes = 0;       ///< 全部级别压缩后的字节数
+            double mipMs = 0.0;           ///< mip 链生成耗时
+            double encodeMs = 0.0;        ///< 块压缩耗时（不含解码与 mip 生成）
+        };
+
+        /// 源纹理对应的烘焙文件路径（源文件名后追加 .rtex）
+        static std::string GetCookedPath(const std::string& sourcePath);
+
+        /**
+         * @brief 按文件名推断烘焙参数：法线贴图与 *_alpha 遮罩为线性数据，
+         * *_alpha 额外保持覆盖率，specular/refl 等数据贴图为线性，其余按 sRGB 颜色处理
+         */
+        static CookOptions GetDefaultCookOptions(const std::string& sourcePath);
+
+        /**
+         * @brief 写入烘焙文件（先写临时文件再替换）
+         * @param levels 各级数据，尺寸从 width×height 逐级减半
+         * @param sourceStamp 计算 sourceHash 之前取得的源文件大小与修改时间
+         */
+        static void Write(const std::string& cookedPath, TextureFormat format, bool srgb, int width, int height,
+                          const std::vector<std::vector<uint8_t>>& levels, uint64_t sourceHash,
+                          const utils::VirtualFileSystem::FileStamp& sourceStamp);
+
+        /**
+         * @brief 解码源图片、生成 mip 链、块压缩并写入烘焙文件；失败时抛出 std::runtime_error
+         */
+        static CookStats Cook(const std::string& sourcePath, const std::string& cookedPath, const CookOptions& options);
+
+        /// 源文件内容哈希，写入烘焙文件用于失效判断
+        static uint64_t HashSource(const std::string& sourcePath);
+
+        /**
+         * @brief 映射并校验烘焙文件；源文件存在且内容已变化时返回 false
+         * 源文件大小与修改时间同记录一致时不计算哈希；哈希一致时就地改写记录的大小与时间
+         */
+        bool Open(const std::string& cookedPath, const std::string& sourcePath);
+
+        TextureFormat GetFormat() const { return m_Format; }
+        bool IsSRGB() const { return m_SRGB; }
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+        const std::vector<TextureLevel>& GetLevels() const { return m_Levels; }
+
+    private:
+        utils::FileView m_File;
+        TextureFormat m_Format = TextureFormat::RGBA8;
+        bool m_SRGB = false;
+        int m_Width = 0;
+        int m_Height = 0;
+        std::vector<TextureLevel> m_Levels;
+    };
+
+    /**
+     * @brief 纹理的CPU侧数据：可直接上传的烘焙文件，或解码后的像素，二者其一
+     */
+    struct TextureSource {
+        std::shared_ptr<const TextureFile> cooked;
+        std::shared_ptr<const ImageData> image;
+
+        bool IsValid() const { return cooked || (image && image->IsValid()); }
+
+        /**
+         * @brief 优先使用GPU支持其格式的烘焙文件，否则解码源图片（线程安全）
+         * 只有烘焙文件且格式不受支持时，在CPU解压首级。失败时抛出 std::runtime_error
+         */
+        static TextureSource Load(const std::string& path, bool useSRGB);
+    };
+
+} // namespace graphics
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glad/glad.h>
+#include "graphics/Image.h"
+#include "graphics/Texture.h"
+#include "graphics/TextureFile.h"
+
+namespace graphics {
+
+    /**
+     * @brief 基于PBO环形缓冲的纹理流式上传
+     * 像素按行（块压缩格式按4像素高的块行）分段拷入映射的PBO，每帧上传量不超过预算，
+     * 通过 fence 判断PBO是否可复用，GPU未消费完时本帧跳过而不阻塞。
+     * 所有接口需在GL上下文线程调用。
+     */
+    class TextureUploader {
+    public:
+        struct Stats {
+            size_t pendingBytes = 0;      ///< 尚未上传的字节数
+            size_t lastFrameBytes = 0;    ///< 上一帧上传的字节数
+            size_t peakFrameBytes = 0;    ///< 单帧最大上传字节数
+            size_t texturesCompleted = 0; ///< 已完成的纹理数
+            size_t skippedFrames = 0;     ///< 因PBO仍被GPU占用而跳过的帧数
+        };
+
+        /**
+         * @brief 设置每帧上传预算（字节），下次 Update 时按新大小重建PBO环
+         */
+        static void SetFrameBudget(size_t bytesPerFrame);
+        static size_t GetFrameBudget() { return s_FrameBudget; }
+
+        /**
+         * @brief 登记纹理上传：立即分配纹理存储，数据在之后若干帧内分段上传
+         * 完成前纹理绑定为占位纹理；完成后（解码像素需生成mipmap）调用 onComplete
+         */
+        static void Enqueue(std::shared_ptr<Texture> texture,
+                            TextureSource source,
+                            bool useSRGB,
+                            std::function<void()> onComplete = nullptr);
+
+        /**
+         * @brief 在预算内推进上传（每帧调用一次）
+         */
+        static void Update();
+
+        /**
+         * @brief 丢弃未完成的上传并释放PBO（需在GL上下文销毁前调用）
+         */
+        static void Shutdown();
+
+        static const Stats& GetStats() { return s_Stats; }
+
+    private:
+        struct Job {
+            std::shared_ptr<Texture> texture;
+            TextureSource source;                ///< 持有像素或映射，直到上传完成
+            std::function<void()> onComplete;
+            std::vector<TextureLevel> levels;
+            bool compressed = false;
+            GLenum format = GL_RGBA;             ///< 未压缩数据的像素格式，压缩时为内部格式
+            size_t level = 0;                    ///< 当前上传的级别
+            int nextRow = 0;                     ///< 当前级别下一行（块压缩为块行）
+        };
+
+        /// 环中一个PBO及其最近一次使用的 fence
+        struct Slot {
+            GLuint pbo = 0;
+            GLsync fence = nullptr;
+        };
+
+        /// 一次 glTexSubImage2D 的行区间及其在PBO中的偏移
+        struct Band {
+            Job* job;
+            size_t level;
+            int firstRow;
+            int rowCount;
+            size_t offset;
+        };
+
+        static void SubmitBand(const Band& band, const uint8_t* pixels);
+
+        static constexpr size_t kRingSize = 3;
+        static constexpr size_t kMinFrameBudget = 256 * 1024;
+
+        static void CreateRing();
+        static void DestroyRing();
+
+        static std::deque<Job> s_Jobs;
+        static std::vector<Slot> s_Slots;
+        static size_t s_NextSlot;
+        static size_t s_SlotSize;
+        static size_t s_FrameBudget;
+        static Stats s_Stats;
+    };
+
+} // namespace graphics
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/Frustum.h"
+
+namespace graphics {
+
+    /// 射线与三角形的最近交点
+    struct RayHit {
+        float distance = 0.0f;          ///< 射线参数 t，以方向向量的长度为单位
+        uint32_t triangle = 0;          ///< 三角形序号：索引缓冲中第 3 * triangle 个索引起
+        glm::vec2 barycentric{0.0f};    ///< 交点 = (1 - u - v) * v0 + u * v1 + v * v2
+    };
+
+    /**
+     * @brief 三角形层次包围盒：按表面积启发式（SAH）分桶自顶向下构建，节点展平为连续数组
+     *
+     * 内部节点的两个子节点相邻存放，叶子引用按叶子顺序重排后的三角形（存顶点与两条边，求交时不再查索引）。
+     * 不调用任何GL函数，可在工作线程构建；构建后只读，可并发查询
+     */
+    class TriangleBvh {
+    public:
+        /// 32 字节节点：count 为 0 时是内部节点，子节点为 first 与 first + 1；否则为叶子，三角形为 [first, first + count)
+        struct Node {
+            glm::vec3 min;
+            uint32_t first;
+            glm::vec3 max;
+            uint32_t count;
+        };
+
+        static constexpr uint32_t kBinCount = 12;
+        static constexpr uint32_t kMaxLeafTriangles = 4;
+        /// 超过该深度强制生成叶子，查询栈因此有固定上限
+        static constexpr uint32_t kMaxDepth = 48;
+
+        /**
+         * @brief 由索引三角形构建，替换已有内容
+         * @param stride 相邻顶点位置的字节间隔（可直接传交错顶点数组中的位置字段）
+         */
+        void Build(const glm::vec3* positions, size_t vertexCount, size_t stride, const unsigned int* indices,
+                   size_t indexCount);
+
+        /**
+         * @brief 求射线在 (0, maxDistance] 内最近的交点（双面）
+         * direction 无需归一化；没有交点时返回 false，hit 不变
+         */
+        bool Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& hit) const;
+
+        bool IsEmpty() const { return m_Nodes.empty(); }
+        size_t GetNodeCount() const { return m_Nodes.size(); }
+        size_t GetTriangleCount() const { return m_Triangles.size(); }
+        uint32_t GetDepth() const { return m_Depth; }
+        /// 节点与三角形数组占用的字节数
+        size_t GetMemoryBytes() const { return m_Nodes.size() * sizeof(Node) + m_Triangles.size() * sizeof(Triangle); }
+        /// 根节点包围盒，为空时为零点
+        BoundingBox GetBounds() const {
+            return m_Nodes.empty() ? BoundingBox{glm::vec3(0.0f), glm::vec3(0.0f)}
+                                   : BoundingBox{m_Nodes[0].min, m_Nodes[0].max};
+        }
+
+    private:
+        struct Triangle {
+            glm::vec3 v0, edge1, edge2;
+            uint32_t index;    ///< 原始三角形序号
+        };
+
+        std::vector<Node> m_Nodes;
+        std::vector<Triangle> m_Triangles;
+        uint32_t m_Depth = 0;
+    };
+
+} // namespace graphics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/Mesh.h"
+
+namespace graphics {
+
+    /// 量化后的顶点数据及反量化参数
+    struct QuantizedVertices {
+        VertexFormat format = VertexFormat::Float;
+        uint32_t stride = 0;
+        size_t vertexCount = 0;
+        std::vector<uint8_t> data;
+        glm::vec3 offset = glm::vec3(0.0f); ///< 位置反量化：p = q * scale + offset（即包围盒最小点）
+        glm::vec3 scale = glm::vec3(1.0f);  ///< 包围盒尺寸
+    };
+
+    /// 量化误差统计
+    struct QuantizationError {
+        float maxPosition = 0.0f;    ///< 位置最大误差（模型空间单位）
+        float rmsPosition = 0.0f;    ///< 位置均方根误差
+        float boundsDiagonal = 0.0f; ///< 包围盒对角线长度，用于换算相对误差
+        float maxNormalDeg = 0.0f;   ///< 法线最大角度误差（度）
+        float meanNormalDeg = 0.0f;  ///< 法线平均角度误差（度）
+        float maxTexCoord = 0.0f;    ///< UV 最大误差
+    };
+
+    /**
+     * @brief 紧凑顶点格式的编码/解码
+     * 位置相对网格包围盒量化为 unorm16，法线八面体编码为 snorm16x2 或 snorm8x2，UV 存为半精度浮点
+     * 解码规则与 GL 归一化整数转换（unorm: c/65535，snorm: c/32767 或 c/127）一致，供误差统计使用
+     */
+    class VertexQuantizer {
+    public:
+        /// 各格式的顶点步长（字节）
+        static uint32_t GetStride(VertexFormat format);
+
+        /// 按格式编码顶点，Float 格式原样拷贝
+        static QuantizedVertices Quantize(const Vertex* vertices, size_t vertexCount, VertexFormat format);
+
+        /// 按 GL 的属性转换规则还原第 index 个顶点
+        static Vertex Dequantize(const QuantizedVertices& quantized, size_t index);
+
+        /// 统计量化前后的误差
+        static QuantizationError Measure(const Vertex* vertices, const QuantizedVertices& quantized);
+
+        /// 单位向量 → 八面体展开平面上的 [-1,1]^2 坐标
+        static glm::vec2 EncodeOctahedral(const glm::vec3& n);
+
+        /// 八面体坐标 → 单位向量
+        static glm::vec3 DecodeOctahedral(const glm::vec2& e);
+    };
+
+} // namespace graphics
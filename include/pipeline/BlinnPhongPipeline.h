@@ -1,5 +1,7 @@
 #pragma once
 #include "pipeline/RenderPipeline.h"
+#include "graphics/RenderCommand.h"
+#include "graphics/RenderQueue.h"
 #include "graphics/Shader.h"
 #include <memory>
 
@@ -14,6 +16,8 @@ public:
 
 private:
     std::shared_ptr<graphics::Shader> m_Shader;
+    graphics::CommandList m_Commands;            ///< 逐帧复用的命令缓冲
+    graphics::RenderQueue m_Queue;               ///< 按状态排序的绘制项，引用 m_Commands
 };
 
 } // namespace pipeline
@@ -1,5 +1,7 @@
 #pragma once
 #include <memory>
+#include "graphics/RenderCommand.h"
+#include "graphics/RenderQueue.h"
 #include "graphics/Shader.h"
 #include "scene/Scene.h"
 #include "graphics/Camera.h"
@@ -17,6 +19,10 @@ public:
 private:
     std::shared_ptr<graphics::Shader> m_baseShader;
     std::shared_ptr<graphics::Shader> m_outlineShader;
+    graphics::CommandList m_baseCommands;        ///< 逐帧复用的命令缓冲
+    graphics::CommandList m_outlineCommands;
+    graphics::RenderQueue m_baseQueue;           ///< 按状态排序的绘制项，引用对应的命令缓冲
+    graphics::RenderQueue m_outlineQueue;
 };
 
 } // namespace pipeline
@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "utils/PackFile.h"
+
+namespace core {
+
+/// 可烘焙的资源类型
+enum class AssetKind {
+    Mesh,    ///< .obj -> .rmesh
+    Texture, ///< .png/.jpg/.tga/.bmp -> .rtex
+    Shader   ///< .vert/.frag/.geom/.glsl -> .rglsl
+};
+
+/**
+ * @brief 离线资源烘焙：遍历资源目录，把源文件转换为运行时格式，结果与源文件同目录存放
+ *
+ * 依赖数据库记录每个资源的全部输入文件（OBJ 含其 MTL）的大小、修改时间与内容哈希。
+ * 大小和时间都未变化时直接跳过；变化时重新计算哈希，内容相同只刷新记录，否则重新烘焙。
+ * 所有资源经 core::JobSystem 并行烘焙，按输入大小降序分发以平衡负载。
+ */
+class AssetCooker {
+public:
+    struct Options {
+        std::vector<std::string> roots;  ///< 待遍历的目录
+        std::string databasePath;        ///< 依赖数据库路径，空时使用 GetDefaultDatabasePath()
+        bool force = false;              ///< 忽略数据库，全部重新烘焙
+        bool highQuality = false;        ///< 颜色贴图使用 BC7
+        unsigned int threadCount = 0;    ///< 1 表示单线程烘焙；大于 1 且任务系统尚未初始化时按此初始化，0 表示全部硬件线程
+        bool verbose = false;            ///< 逐个输出烘焙结果
+    };
+
+    struct Stats {
+        size_t scanned = 0;     ///< 识别到的资源数
+        size_t cooked = 0;      ///< 本次重新烘焙的资源数
+        size_t upToDate = 0;    ///< 无需烘焙的资源数
+        size_t rehashed = 0;    ///< 时间戳变化但内容未变、只刷新记录的资源数
+        size_t failed = 0;
+        size_t inputBytes = 0;  ///< 重新烘焙资源的输入字节数
+        size_t outputBytes = 0; ///< 重新烘焙资源的输出字节数
+        double totalMs = 0.0;
+    };
+
+    /**
+     * @brief 执行一次烘焙，单个资源失败只计数并输出错误，不中断其余资源
+     */
+    static Stats Run(const Options& options);
+
+    /**
+     * @brief 把运行时需要的文件写入资源包：已烘焙的资源只放烘焙结果，其余可加载的源文件原样放入
+     * 同一目录的文件连续存放（网格在前、纹理在后），与模型加载时的访问顺序一致
+     */
+    static utils::PackFile::WriteStats BuildPack(const std::vector<std::string>& roots, const std::string& packPath);
+
+    /// 项目根目录下的 rrender_cook.db
+    static std::string GetDefaultDatabasePath();
+
+    /// 项目根目录下的 rrender.rpak，运行时存在即挂载
+    static std::string GetDefaultPackPath();
+
+    /// 按扩展名判断资源类型，无法烘焙时返回 false
+    static bool Classify(const std::string& path, AssetKind& kind);
+
+    /// 资源对应的烘焙输出路径
+    static std::string GetOutputPath(const std::string& path, AssetKind kind);
+};
+
+} // namespace core
@@ -2,29 +2,163 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include <unordered_set>
 #include "graphics/Shader.h"
 #include "graphics/Texture.h"
 #include "graphics/Model.h"
+#include "core/JobSystem.h"
 
 namespace core {
 
+/// 异步资源的加载状态
+enum class LoadState {
+    Loading,
+    Ready,
+    Failed
+};
+
+/**
+ * @brief 异步加载资源的句柄
+ * 资源对象立即可用（未就绪时以占位数据绘制），状态在GL线程上传完成后变为 Ready
+ */
+template <typename T>
+class LoadHandle {
+public:
+    LoadHandle() = default;
+    LoadHandle(std::shared_ptr<T> resource, std::shared_ptr<std::atomic<LoadState>> state)
+        : m_Resource(std::move(resource)), m_State(std::move(state)) {}
+
+    const std::shared_ptr<T>& Get() const { return m_Resource; }
+    LoadState GetState() const { return m_State ? m_State->load() : LoadState::Failed; }
+    bool IsReady() const { return GetState() == LoadState::Ready; }
+    explicit operator bool() const { return m_Resource != nullptr; }
+
+private:
+    std::shared_ptr<T> m_Resource;
+    std::shared_ptr<std::atomic<LoadState>> m_State;
+};
+
+/**
+ * @brief 着色器、纹理与模型的加载与登记
+ * 资源按规范路径登记（着色器为两个阶段路径的组合），Get* 接受加载时的路径或文件名（不含扩展名）；
+ * 纹理经全局 graphics::TextureCache 共享，与模型材质引用的纹理是同一份
+ */
 class ResourceManager {
 public:
     static std::shared_ptr<graphics::Shader> LoadShader(const std::string& vertexPath, const std::string& fragmentPath);
     static std::shared_ptr<graphics::Shader> GetShader(const std::string& name);
 
+    /**
+     * @brief 批量加载着色器：先为全部程序提交编译与链接，再逐个等待结果
+     * 驱动并行编译时总耗时接近最慢的一个程序而非各程序之和；加载失败的位置为空
+     * @param programs 顶点着色器与片段着色器路径
+     */
+    static std::vector<std::shared_ptr<graphics::Shader>> LoadShaders(
+        const std::vector<std::pair<std::string, std::string>>& programs);
+
     static std::shared_ptr<graphics::Texture> LoadTexture(const std::string& texturePath);
     static std::shared_ptr<graphics::Texture> GetTexture(const std::string& name);
 
     static std::shared_ptr<graphics::Model> LoadModel(const std::string& modelPath);
     static std::shared_ptr<graphics::Model> GetModel(const std::string& name);
 
+    /**
+     * @brief 以后台任务读取网格并解码纹理，完成后于 Update 中上传GPU
+     * 返回的模型立即登记，可直接放入场景
+     */
+    static LoadHandle<graphics::Model> LoadModelAsync(const std::string& modelPath);
+
+    /**
+     * @brief 批量异步加载模型（如场景文件的模型表）：全部提交后立即返回，已登记的路径直接复用
+     * @return 与 modelPaths 一一对应的模型，上传完成前以占位网格绘制
+     */
+    static std::vector<std::shared_ptr<graphics::Model>> LoadModelsAsync(const std::vector<std::string>& modelPaths);
+
+    /// 模型登记时的规范路径，不是经 ResourceManager 加载的模型返回空字符串
+    static std::string GetModelPath(const std::shared_ptr<graphics::Model>& model);
+
+    /**
+     * @brief 以后台任务解码图片，完成后于 Update 中上传GPU
+     */
+    static LoadHandle<graphics::Texture> LoadTextureAsync(const std::string& texturePath);
+
+    /**
+     * @brief 执行工作线程投递到GL线程的上传任务（每帧在主线程调用）
+     * @param budgetMs 本帧上传时间预算（毫秒），至少执行一个任务
+     */
+    static void Update(double budgetMs = 4.0);
+
+    /**
+     * @brief 阻塞直到所有异步加载及纹理流式上传完成（主线程调用）
+     */
+    static void WaitAll();
+
+    /// 尚未完成的异步加载数
+    static size_t GetPendingCount() { return s_Pending.load(); }
+
+    /// 显存占用与驱逐统计（EndFrame 时更新）
+    struct GpuMemoryStats {
+        size_t budgetBytes = 0;       ///< 0 表示不限制
+        size_t currentBytes = 0;      ///< 纹理与网格合计
+        size_t peakBytes = 0;
+        size_t textureBytes = 0;
+        size_t meshBytes = 0;
+        size_t residentTextures = 0;
+        size_t residentModels = 0;
+        size_t evictedTextures = 0;   ///< 当前处于驱逐状态的纹理
+        size_t evictedModels = 0;
+        size_t evictions = 0;         ///< 累计驱逐次数
+        size_t evictedBytes = 0;      ///< 累计驱逐释放的字节
+        size_t reloads = 0;           ///< 累计重新加载次数
+    };
+
+    /**
+     * @brief 设置显存预算（字节），0 表示不限制
+     * 只驱逐当前帧未使用的资源，因此单帧实际用到的资源超出预算时占用仍会超出
+     */
+    static void SetGpuBudget(size_t bytes) { s_GpuBudget = bytes; }
+    static size_t GetGpuBudget() { return s_GpuBudget; }
+
+    static const GpuMemoryStats& GetGpuMemoryStats() { return s_GpuStats; }
+
+    /**
+     * @brief 每帧渲染结束后调用：统计显存占用，重新加载本帧用到的已驱逐资源，
+     * 超出预算时按最近最少使用的顺序驱逐本帧未使用的纹理与模型网格，然后推进帧号
+     */
+    static void EndFrame();
+
+    /**
+     * @brief 等待后台加载任务结束并释放所有资源（需在GL上下文销毁前调用）
+     */
+    static void Shutdown();
+
 private:
-    static std::string ExtractName(const std::string& path);
+    /// 登记键：规范路径
+    static std::string MakeKey(const std::string& path);
+
+    /// 按登记键查找，找不到时按文件名（不含扩展名）查找
+    template <typename T>
+    static std::shared_ptr<T> FindByName(const std::unordered_map<std::string, std::shared_ptr<T>>& resources,
+                                         const std::string& name);
+
+    /// 在工作线程重新读取被驱逐的模型或纹理，完成后于 Update 中上传
+    static void ReloadModel(const std::shared_ptr<graphics::Model>& model);
+    static void ReloadTexture(const std::shared_ptr<graphics::Texture>& texture);
 
     static std::unordered_map<std::string, std::shared_ptr<graphics::Shader>> m_Shaders;
     static std::unordered_map<std::string, std::shared_ptr<graphics::Texture>> m_Textures;
     static std::unordered_map<std::string, std::shared_ptr<graphics::Model>> m_Models;
+    static std::unordered_map<std::string, std::shared_ptr<std::atomic<LoadState>>> m_LoadStates;
+
+    static JobCounter s_LoadJobs;   ///< 未完成的后台加载任务（JobSystem::RunBackground）
+    static std::atomic<size_t> s_Pending;
+
+    static size_t s_GpuBudget;
+    static GpuMemoryStats s_GpuStats;
+    static std::unordered_set<const graphics::GpuResource*> s_Reloading; ///< 正在重新加载的资源（只在GL线程访问）
 };
 
 } // namespace core
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "graphics/Frustum.h"
+
+namespace scene {
+
+    /**
+     * @brief 动态包围盒树（空间索引）：叶子为对象放大后的包围盒，内部节点包住两个子节点
+     *
+     * 节点存放在连续数组中，空闲节点串成链表复用，代理 ID 即叶子节点下标，销毁前保持不变。
+     * 插入时按表面积启发式沿一条路径下探选择兄弟节点，沿途回溯时做能减少表面积的旋转，
+     * 删除后同样旋转，树在频繁移动后仍保持较好的查询性能。
+     * 叶子包围盒在四周放大 margin，并沿上次移动方向额外延伸，对象在放大范围内移动时不需要改动树；
+     * 移出范围或放大范围明显过大时才删除重插。
+     * 查询为模板，回调内联；回调返回 false 时提前结束。只在主线程修改，查询可并发
+     */
+    class AabbTree {
+    public:
+        static constexpr int32_t kNullNode = -1;
+
+        explicit AabbTree(float margin = 0.1f) : m_Margin(margin) {}
+
+        /// 插入对象，返回代理 ID
+        int32_t CreateProxy(const graphics::BoundingBox& box, uint32_t userData);
+        /**
+         * @brief 批量插入：新对象先按最长轴中位数自顶向下建成子树，再作为一个整体插入，
+         * 比逐个 CreateProxy 快一个数量级，之后的移动与旋转照常维护树的质量
+         * @param proxies 输出 count 个代理 ID
+         */
+        void CreateProxies(const graphics::BoundingBox* boxes, const uint32_t* userData, size_t count, int32_t* proxies);
+        void DestroyProxy(int32_t proxy);
+
+        /**
+         * @brief 更新对象的包围盒，仍在放大范围内时只返回 false；重新插入时返回 true
+         */
+        bool MoveProxy(int32_t proxy, const graphics::BoundingBox& box);
+
+        uint32_t GetUserData(int32_t proxy) const { return m_Nodes[proxy].userData; }
+        /// 放大后的包围盒
+        const graphics::BoundingBox& GetFatBounds(int32_t proxy) const { return m_Nodes[proxy].box; }
+
+        void Clear();
+
+        /// 与包围盒相交的对象，visit(userData) 返回 false 时结束
+        template <typename Visit>
+        void QueryBox(const graphics::BoundingBox& box, Visit&& visit) const;
+
+        template <typename Visit>
+        void QuerySphere(const graphics::BoundingSphere& sphere, Visit&& visit) const;
+
+        /// 与视锥相交的对象；完全在视锥内的子树不再逐个测试
+        template <typename Visit>
+        void QueryFrustum(const graphics::Frustum& frustum, Visit&& visit) const;
+
+        /**
+         * @brief 射线与各对象包围盒求交，按树的遍历顺序（非距离顺序）回调
+         * visit(userData, tEnter, tMax) 返回新的最大距离：返回 tMax 继续，返回更小的值裁剪射线，
+         * 返回值不大于 0 时结束。direction 无需归一化，距离以其长度为单位
+         */
+        template <typename Visit>
+        void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Visit&& visit) const;
+
+        size_t GetProxyCount() const { return m_ProxyCount; }
+        size_t GetNodeCount() const { return m_Nodes.size() - m_FreeCount; }
+        /// 树高（只有一个叶子时为 0，空树为 -1）
+        int32_t GetHeight() const { return m_Root == kNullNode ? -1 : m_Nodes[m_Root].height; }
+        /// 全部内部节点表面积之和与根节点表面积之比，衡量树的质量（越小查询越快）
+        float GetAreaRatio() const;
+        /// 累计重新插入的次数（MoveProxy 移出放大范围）
+        size_t GetReinsertCount() const { return m_Reinserts; }
+
+        /// 检查父子链接、高度与包围盒是否一致，不一致时抛出 std::runtime_error
+        void Validate() const;
+
+    private:
+        struct Node {
+            graphics::BoundingBox box;
+            uint32_t userData = 0;
+            int32_t parent = kNullNode;   ///< 空闲节点中表示下一个空闲节点
+            int32_t child1 = kNullNode;
+            int32_t child2 = kNullNode;
+            int32_t height = 0;           ///< 叶子为 0，空闲节点为 -1
+
+            bool IsLeaf() const { return child1 == kNullNode; }
+        };
+
+        /// 节点相对查询区域的位置
+        enum Overlap { kOutside = 0, kIntersects = 1, kContains = 2 };
+
+        /// 遍历栈：树高较小时用栈上数组
+        static constexpr int32_t kInlineStack = 128;
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+        void InsertLeaf(int32_t leaf);
+        /// 由叶子建子树，返回子树根（会重排 leaves）
+        int32_t BuildSubtree(int32_t* leaves, size_t count);
+        void RemoveLeaf(int32_t leaf);
+        /// 表面积启发式下的最优兄弟节点
+        int32_t FindBestSibling(const graphics::BoundingBox& leafBox);
+        /// 子节点与另一侧的孙节点交换能减少面积时旋转（节点本身位置不变）
+        void Rotate(int32_t node);
+        /// 由两个子节点重算高度与包围盒
+        void Refit(int32_t node);
+
+        static bool Overlaps(const graphics::BoundingBox& a, const graphics::BoundingBox& b);
+        static bool OverlapsSphere(const graphics::BoundingBox& box, const graphics::BoundingSphere& sphere);
+        static Overlap ClassifyFrustum(const graphics::BoundingBox& box, const glm::vec4* planes);
+        /// 射线与包围盒求交，相交时写入进入距离
+        static bool RayHit(const graphics::BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                           float maxDistance, float& enter);
+
+        /**
+         * @brief 深度优先遍历：test(node) 返回 Overlap，kContains 的子树直接报告全部叶子
+         */
+        template <typename Test, typename Visit>
+        void Traverse(Test&& test, Visit&& visit) const;
+
+        std::vector<Node> m_Nodes;
+        int32_t m_Root = kNullNode;
+        int32_t m_FreeList = kNullNode;
+        size_t m_FreeCount = 0;
+        size_t m_ProxyCount = 0;
+        size_t m_Reinserts = 0;
+        float m_Margin;
+    };
+
+    template <typename Test, typename Visit>
+    void AabbTree::Traverse(Test&& test, Visit&& visit) const {
+        if (m_Root == kNullNode) return;
+        // 每弹出一个节点最多压入两个，栈深不超过树高 + 1；包含的子树以取反下标标记
+        int32_t inlineStack[kInlineStack];
+        std::vector<int32_t> heapStack;
+        int32_t* stack = inlineStack;
+        if (m_Nodes[m_Root].height + 2 > kInlineStack) {
+            heapStack.resize(static_cast<size_t>(m_Nodes[m_Root].height) + 2);
+            stack = heapStack.data();
+        }
+        int32_t count = 0;
+        stack[count++] = m_Root;
+        while (count > 0) {
+            int32_t index = stack[--count];
+            const bool contained = index < 0;
+            if (contained) index = ~index;
+            const Node& node = m_Nodes[index];
+            if (!contained) {
+                const Overlap overlap = test(node.box);
+                if (overlap == kOutside) continue;
+                if (overlap == kContains && !node.IsLeaf()) {
+                    stack[count++] = ~node.child1;
+                    stack[count++] = ~node.child2;
+                    continue;
+                }
+            }
+            if (node.IsLeaf()) {
+                if (!visit(node.userData)) return;
+            } else if (contained) {
+                stack[count++] = ~node.child1;
+                stack[count++] = ~node.child2;
+            } else {
+                stack[count++] = node.child1;
+                stack[count++] = node.child2;
+            }
+        }
+    }
+
+    template <typename Visit>
+    void AabbTree::QueryBox(const graphics::BoundingBox& box, Visit&& visit) const {
+        Traverse([&](const graphics::BoundingBox& nodeBox) { return Overlaps(nodeBox, box) ? kIntersects : kOutside; },
+                 visit);
+    }
+
+    template <typename Visit>
+    void AabbTree::QuerySphere(const graphics::BoundingSphere& sphere, Visit&& visit) const {
+        Traverse([&](const graphics::BoundingBox& nodeBox) {
+            return OverlapsSphere(nodeBox, sphere) ? kIntersects : kOutside;
+        }, visit);
+    }
+
+    template <typename Visit>
+    void AabbTree::QueryFrustum(const graphics::Frustum& frustum, Visit&& visit) const {
+        Traverse([&](const graphics::BoundingBox& nodeBox) { return ClassifyFrustum(nodeBox, frustum.planes); }, visit);
+    }
+
+    template <typename Visit>
+    void AabbTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Visit&& visit) const {
+        if (m_Root == kNullNode || maxDistance <= 0.0f) return;
+        const glm::vec3 inverseDirection = graphics::InverseRayDirection(direction);
+        int32_t inlineStack[kInlineStack];
+        std::vector<int32_t> heapStack;
+        int32_t* stack = inlineStack;
+        if (m_Nodes[m_Root].height + 2 > kInlineStack) {
+            heapStack.resize(static_cast<size_t>(m_Nodes[m_Root].height) + 2);
+            stack = heapStack.data();
+        }
+        int32_t count = 0;
+        stack[count++] = m_Root;
+        while (count > 0) {
+            const Node& node = m_Nodes[stack[--count]];
+            float enter;
+            if (!RayHit(node.box, origin, inverseDirection, maxDistance, enter)) continue;
+            if (node.IsLeaf()) {
+                const float result = visit(node.userData, enter, maxDistance);
+                if (result <= 0.0f) return;
+                maxDistance = std::min(maxDistance, result);
+            } else {
+                stack[count++] = node.child1;
+                stack[count++] = node.child2;
+            }
+        }
+    }
+
+} // namespace scene
@@ -4,15 +4,24 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "graphics/Model.h"
+#include "graphics/Camera.h"
+#include "scene/TransformSystem.h"
 
 namespace scene {
 
     /**
      * @brief 场景中一个实体对象，包含模型和变换（位置、旋转、缩放）
+     * 变换存放在 TransformSystem 中，实体只持有句柄，生命周期与实体一致
      */
     class Entity {
     public:
         explicit Entity(std::shared_ptr<graphics::Model> model);
+        /// 接管已创建的变换（如 TransformSystem::CreateBatch 的结果），实体销毁时一并销毁
+        Entity(std::shared_ptr<graphics::Model> model, TransformHandle transform);
+        ~Entity();
+
+        Entity(const Entity&) = delete;
+        Entity& operator=(const Entity&) = delete;
 
         // 设置 / 获取模型
         void SetModel(std::shared_ptr<graphics::Model> model);
@@ -20,28 +29,77 @@ namespace scene {
 
         // 设置 / 获取位置
         void SetPosition(const glm::vec3& position);
-        const glm::vec3& GetPosition() const;
+        glm::vec3 GetPosition() const;
 
         // 设置 / 获取旋转（欧拉角，单位为度）
         void SetRotation(const glm::vec3& rotation);
-        const glm::vec3& GetRotation() const;
+        glm::vec3 GetRotation() const;
 
         // 设置 / 获取缩放
         void SetScale(const glm::vec3& scale);
-        const glm::vec3& GetScale() const;
+        glm::vec3 GetScale() const;
+
+        /**
+         * @brief 挂到父实体下（空指针表示脱离），位置 / 旋转 / 缩放随之解释为相对父实体
+         * 父实体销毁后自动脱离；形成环时抛出 std::runtime_error
+         */
+        void SetParent(const std::shared_ptr<Entity>& parent);
+        std::shared_ptr<Entity> GetParent() const { return m_Parent.lock(); }
 
-        // 获取模型矩阵（最终变换矩阵）
+        // 获取模型矩阵（世界变换矩阵），通常已由 TransformSystem::Update() 批量算好
         glm::mat4 GetModelMatrix() const;
 
-        // 绘制模型
-        void Draw() const;
+        TransformHandle GetTransform() const { return m_Transform; }
+
+        /// 作为遮挡体：可见时把模型的遮挡体网格光栅化到 CPU 深度缓冲，遮住其后的实体
+        void SetOccluder(bool occluder) { m_Occluder = occluder; }
+        bool IsOccluder() const { return m_Occluder; }
+
+        /// 世界空间包围盒（模型包围盒经模型矩阵变换），没有模型时为世界位置处的一个点
+        graphics::BoundingBox GetWorldBounds() const;
+
+        // 绘制模型（使用 UpdateLod 选出的细节级别），cullView 非空时逐簇剔除
+        void Draw(const graphics::MeshletCullView* cullView = nullptr) const;
+
+        /// 把模型的材质与绘制命令录制到 buffer（不含模型矩阵），可在工作线程调用，见 Model::Record
+        void Record(graphics::CommandBuffer& buffer, const graphics::MeshletCullView* cullView = nullptr) const;
+
+        /**
+         * @brief 按投影到屏幕上的几何误差选择细节级别
+         * 选取误差不超过阈值的最粗一级；变粗需要误差低于阈值 × (1 - 滞后比例)，
+         * 变细则在超过阈值时立即进行，误差落在两者之间时保持当前级别，避免来回跳变
+         */
+        void UpdateLod(const graphics::Camera& camera);
+        uint32_t GetLod() const { return m_Lod; }
+
+        /// 参与选择的最多级数
+        static constexpr uint32_t kMaxLods = 8;
+
+        /**
+         * @brief 滞后选择规则本身
+         * @param screenErrors 各级误差投影到屏幕后占屏幕高度的比例（单调递增）
+         */
+        static uint32_t SelectLod(uint32_t current, const float* screenErrors, uint32_t lodCount);
+
+        // LOD 选择参数，阈值为误差占屏幕高度的比例（约 1/1000 即 1080p 下一个像素）
+        static void SetLodEnabled(bool enabled) { s_LodEnabled = enabled; }
+        static bool IsLodEnabled() { return s_LodEnabled; }
+        static void SetLodThreshold(float threshold) { s_LodThreshold = threshold; }
+        static float GetLodThreshold() { return s_LodThreshold; }
+        static void SetLodHysteresis(float hysteresis) { s_LodHysteresis = hysteresis; }
+        static float GetLodHysteresis() { return s_LodHysteresis; }
 
     private:
         std::shared_ptr<graphics::Model> m_Model;
 
-        glm::vec3 m_Position{0.0f};
-        glm::vec3 m_Rotation{0.0f};  // pitch, yaw, roll
-        glm::vec3 m_Scale{1.0f};
+        TransformHandle m_Transform;  // 旋转为 pitch, yaw, roll
+        std::weak_ptr<Entity> m_Parent;
+        uint32_t m_Lod = 0;
+        bool m_Occluder = false;
+
+        static bool s_LodEnabled;
+        static float s_LodThreshold;
+        static float s_LodHysteresis;
     };
 
 } // namespace scene
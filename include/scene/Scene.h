@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <iosfwd>
+#include <string>
 #include <vector>
 #include <memory>
+#include "scene/AabbTree.h"
 #include "scene/Entity.h"
+#include "graphics/Frustum.h"
 #include "graphics/Light.h"
+#include "graphics/OcclusionCuller.h"
 
 namespace scene {
 
@@ -18,21 +24,136 @@ public:
     Scene(Scene&&) noexcept = default;
     Scene& operator=(Scene&&) noexcept = default;
 
-    // 添加实体
+    // 添加实体（同时插入空间索引）
     void AddEntity(const std::shared_ptr<Entity>& entity);
     void RemoveEntity(const std::shared_ptr<Entity>& entity);
+    /// 批量添加：空间索引为新实体一次性建子树后整体插入
+    void AddEntities(const std::vector<std::shared_ptr<Entity>>& entities);
 
     // 添加光源
     void AddLight(const std::shared_ptr<graphics::Light>& light);
     void RemoveLight(const std::shared_ptr<graphics::Light>& light);
 
+    /**
+     * @brief 把光源挂到实体上：位置与方向按实体的世界矩阵从局部值变换得到
+     * 实体销毁或光源被移除后挂接自动解除
+     */
+    void AttachLight(const std::shared_ptr<graphics::Light>& light, const std::shared_ptr<Entity>& entity,
+                     const glm::vec3& localPosition = glm::vec3(0.0f),
+                     const glm::vec3& localDirection = glm::vec3(0.0f, 0.0f, -1.0f));
+    void DetachLight(const std::shared_ptr<graphics::Light>& light);
+
+    /**
+     * @brief 每帧渲染前、TransformSystem::Update() 之后调用：把本帧移动过的实体同步到空间索引，再同步挂接的光源
+     * 变换系统是全局的，移动列表每次 Update 都会清空，因此由调用方每帧只更新一次，各场景共用同一份结果
+     */
+    void Update();
+
+    /**
+     * @brief 实体的包围盒因变换以外的原因变化（更换模型等）时调用，同步到空间索引
+     * 模型加载完成时的变化由 Update() 自动处理
+     */
+    void RefreshBounds(const std::shared_ptr<Entity>& entity);
+
+    /**
+     * @brief 视锥剔除：先用空间索引排除整棵视锥外的子树，剩余实体的世界包围盒再批量测试；
+     * 开启遮挡剔除时再把可见的遮挡体光栅化到 CPU 深度缓冲，去掉被完全遮住的实体
+     * 每帧调用一次，结果在下一次 Cull() 前有效，供本帧各个绘制阶段共用；没有模型的实体不参与。
+     * 结果按空间索引的遍历顺序排列
+     */
+    const std::vector<std::shared_ptr<Entity>>& Cull(const graphics::Camera& camera);
+    const std::vector<std::shared_ptr<Entity>>& GetVisibleEntities() const { return m_Visible; }
+
+    // 空间查询：世界包围盒与给定区域相交的实体，结果写入 result（先清空）
+    void QueryBox(const graphics::BoundingBox& box, std::vector<std::shared_ptr<Entity>>& result) const;
+    void QuerySphere(const graphics::BoundingSphere& sphere, std::vector<std::shared_ptr<Entity>>& result) const;
+    void QueryFrustum(const graphics::Frustum& frustum, std::vector<std::shared_ptr<Entity>>& result) const;
+
+    /**
+     * @brief 射线与实体世界包围盒求交，返回最近的实体（没有时为空），distance 输出进入距离
+     * direction 无需归一化，距离以其长度为单位
+     */
+    std::shared_ptr<Entity> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+                                    float maxDistance = 1e30f, float* distance = nullptr) const;
+
+    /// 射线拾取的结果，entity 为空表示没有命中
+    struct PickResult {
+        std::shared_ptr<Entity> entity;
+        uint32_t mesh = 0;                  ///< 子网格序号
+        uint32_t triangle = 0;              ///< 子网格 LOD0 区间内的三角形序号
+        glm::vec2 barycentric{0.0f};        ///< 交点 = (1 - u - v) * v0 + u * v1 + v * v2
+        float distance = 0.0f;              ///< 以 direction 的长度为单位
+        glm::vec3 position{0.0f};           ///< 世界空间交点
+    };
+
+    /**
+     * @brief 射线与实体三角形求交，返回最近的命中
+     * 先由空间索引按世界包围盒筛选实体，再把射线变换到模型空间，在各子网格的三角形层次包围盒中求交；
+     * 模型未就绪的实体不参与。direction 无需归一化
+     */
+    PickResult Pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 1e30f) const;
+
+    const AabbTree& GetSpatialIndex() const { return m_Tree; }
+    /// 上一次 Cull() 的遮挡深度缓冲（调试显示用）
+    const graphics::OcclusionBuffer& GetOcclusionBuffer() const { return m_Occlusion; }
+
+    /**
+     * @brief 保存为 .rscene 二进制场景
+     *
+     * 文件布局（小端，数据块 16 字节对齐，偏移相对文件头）：
+     *   RSceneHeader（含相机）| 模型表（字符串表偏移）| 实体的位置 / 旋转 / 缩放数组（各为 vec3[实体数]）|
+     *   模型序号与父实体序号数组（uint32，0xFFFFFFFF 表示无）| 标记数组（uint8）| 光源记录 | 光源挂接记录 | 字符串表
+     * 位置 / 旋转 / 缩放为相对父实体的局部值；模型以相对项目根目录的路径引用，父实体不在本场景中时按根节点保存其世界变换。
+     * 先写临时文件再替换，失败时抛出 std::runtime_error
+     * @param camera 非空时一并保存位置、朝向与投影类型
+     */
+    void Save(const std::string& path, const graphics::Camera* camera = nullptr) const;
+
+    /**
+     * @brief 载入 .rscene 场景并追加到本场景，返回载入的实体数
+     * 变换由各数组一次性批量创建，实体对象各自分配（释放后即销毁其变换）；
+     * 模型表经 ResourceManager 批量异步加载，完成前以占位网格绘制。格式或版本不符时抛出 std::runtime_error
+     * @param camera 非空且文件中有相机时一并恢复
+     */
+    size_t Load(const std::string& path, graphics::Camera* camera = nullptr);
+
+    /// 把 .rscene 文件逐行导出为文本（浮点数按可还原精度输出），用于比较差异
+    static void ExportText(const std::string& path, std::ostream& out);
+
     // 获取所有实体和光源
     const std::vector<std::shared_ptr<Entity>>& GetEntities() const;
     const std::vector<std::shared_ptr<graphics::Light>>& GetLights() const;
 
 private:
+    /// 从 m_Visible 中去掉被遮挡体完全遮住的实体
+    void CullOccluded(const glm::mat4& viewProjection);
+
     std::vector<std::shared_ptr<Entity>> m_Entities;
     std::vector<std::shared_ptr<graphics::Light>> m_Lights;
+
+    struct LightAttachment {
+        std::shared_ptr<graphics::Light> light;
+        std::weak_ptr<Entity> entity;
+        glm::vec3 localPosition;
+        glm::vec3 localDirection;
+    };
+    std::vector<LightAttachment> m_LightAttachments;
+
+    // 空间索引：叶子的用户数据为实体的变换槽位
+    struct SpatialProxy {
+        std::shared_ptr<Entity> entity;
+        int32_t proxy = AabbTree::kNullNode;
+    };
+    AabbTree m_Tree;
+    std::vector<SpatialProxy> m_Proxies;             ///< 按变换槽位
+    std::vector<std::shared_ptr<Entity>> m_Pending;  ///< 模型尚未加载完成，包围盒仍会变化
+
+    // 剔除用的临时缓冲，跨帧复用
+    std::vector<std::shared_ptr<Entity>> m_Visible;
+    std::vector<uint32_t> m_Candidates;   ///< 参与测试的实体变换槽位
+    graphics::FrustumCuller::BoxList m_Boxes;
+    std::vector<uint32_t> m_VisibleIndices;
+    graphics::OcclusionBuffer m_Occlusion;
 };
 
 } // namespace scene
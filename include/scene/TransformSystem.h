@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace scene {
+
+    /**
+     * @brief 变换句柄：槽位下标 + 代数，槽位被回收后旧句柄自动失效
+     */
+    struct TransformHandle {
+        static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+        uint32_t index = kInvalidIndex;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != kInvalidIndex; }
+        bool operator==(const TransformHandle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const TransformHandle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief 数据导向的变换存储与层级：位置 / 旋转 / 缩放 / 世界矩阵按分量存放在连续数组中（SoA）
+     *
+     * 句柄经槽位表映射到紧密数组下标，销毁时用末尾元素填补空位，数组始终连续。
+     * 存在父子关系时，层级变化后的下一次 Update() 把节点按广度优先重排（父节点总在子节点之前，
+     * 同层节点连续、同一父节点的子节点相邻），世界矩阵 = 父节点世界矩阵 × 局部矩阵，
+     * 只沿本帧有变化的子树逐层传播，同层节点互不依赖，层内分块并行。
+     * 修改位置、旋转或缩放只标记脏，Update() 一次性处理：只改了位置的只重写平移列，
+     * 旋转或缩放变化的用 SIMD 批量重算（SSE 每批 4 个，开启 RRENDER_ENABLE_AVX 时 AVX2 每批 8 个）；
+     * 读取尚未更新的矩阵时沿父节点链单独重算。
+     * 矩阵与 Entity 原先的 translate × rotateX × rotateY × rotateZ × scale 一致，旋转为欧拉角（度）。
+     * 只在主线程调用
+     */
+    class TransformSystem {
+    public:
+        struct Stats {
+            size_t transforms = 0;     ///< 当前存活的变换
+            size_t updated = 0;        ///< 上次 Update() 重算的矩阵
+            size_t totalUpdated = 0;   ///< 累计重算的矩阵
+            size_t propagated = 0;     ///< 上次 Update() 由父节点传播重算的子节点
+            size_t levels = 0;         ///< 层级深度（无父子关系时为 1）
+            size_t rebuilds = 0;       ///< 因层级变化重排的次数
+            double updateMs = 0.0;     ///< 上次 Update() 耗时
+        };
+
+        static TransformHandle Create(const glm::vec3& position = glm::vec3(0.0f),
+                                      const glm::vec3& rotation = glm::vec3(0.0f),
+                                      const glm::vec3& scale = glm::vec3(1.0f));
+        /**
+         * @brief 批量创建 count 个根节点变换，各数组只增长一次（用于场景文件载入）
+         * @param handles 输出 count 个句柄
+         */
+        static void CreateBatch(size_t count, const glm::vec3* positions, const glm::vec3* rotations,
+                                const glm::vec3* scales, TransformHandle* handles);
+        /// 销毁变换，无效或已销毁的句柄被忽略；子节点脱离成为根节点并保留局部变换
+        static void Destroy(TransformHandle handle);
+        static bool IsAlive(TransformHandle handle);
+
+        // 设置 / 获取分量（句柄无效时抛出 std::runtime_error）
+        static void SetPosition(TransformHandle handle, const glm::vec3& position);
+        static glm::vec3 GetPosition(TransformHandle handle);
+        static void SetRotation(TransformHandle handle, const glm::vec3& rotation);
+        static glm::vec3 GetRotation(TransformHandle handle);
+        static void SetScale(TransformHandle handle, const glm::vec3& scale);
+        static glm::vec3 GetScale(TransformHandle handle);
+
+        /**
+         * @brief 设置父节点（无效句柄表示脱离成为根节点），位置 / 旋转 / 缩放随之解释为相对父节点
+         * 形成环时抛出 std::runtime_error
+         */
+        static void SetParent(TransformHandle child, TransformHandle parent);
+        /// 父节点，根节点返回无效句柄
+        static TransformHandle GetParent(TransformHandle handle);
+        static size_t GetChildCount(TransformHandle handle);
+
+        /**
+         * @brief 世界矩阵；自身或祖先在上次 Update() 后有修改时，只从最上面的脏节点起沿父节点链重算
+         * 不修改存储，没有并发的 Create() / Destroy() / Set*() / Update() 时可在任意线程调用
+         */
+        static glm::mat4 GetWorldMatrix(TransformHandle handle);
+
+        /// 批量重算所有脏矩阵（每帧渲染前调用一次）
+        static void Update();
+
+        /// 上次 Update() 中世界矩阵有变化的变换（含由父节点传播的子节点），供空间索引等增量更新
+        static const std::vector<TransformHandle>& GetMoved() { return s_Storage.moved; }
+
+        /// 关闭时 Update() 逐个标量重算，用于对比与排查
+        static void SetSimdEnabled(bool enabled) { s_SimdEnabled = enabled; }
+        static bool IsSimdEnabled() { return s_SimdEnabled; }
+        /// 批量重算每批处理的矩阵数（8 / 4，无 SIMD 时为 1）
+        static uint32_t GetSimdWidth();
+
+        /// 批量重算与层级传播的并行方式：1 为单线程（默认），其他值经 JobSystem 分发（线程数由 JobSystem 决定）
+        static void SetThreadCount(unsigned int threads) { s_ThreadCount = threads; }
+        static unsigned int GetThreadCount() { return s_ThreadCount; }
+
+        static size_t GetCount() { return s_Storage.slots.size(); }
+        static const Stats& GetStats() { return s_Stats; }
+
+        /// 由欧拉角（度）、平移与缩放计算矩阵的标量参考实现
+        static glm::mat4 ComposeMatrix(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale);
+
+        /**
+         * @brief ComposeMatrix 的逆：把矩阵分解为平移、欧拉角（度）与缩放
+         * 矩阵含切变（父节点非均匀缩放且子节点有旋转）时只能近似
+         */
+        static void DecomposeMatrix(const glm::mat4& matrix, glm::vec3& position, glm::vec3& rotation, glm::vec3& scale);
+
+    private:
+        /// 紧密数组（按分量拆开以便 SIMD 直接加载）与句柄映射
+        struct Storage {
+            std::vector<float> positionX, positionY, positionZ;
+            std::vector<float> rotationX, rotationY, rotationZ;
+            std::vector<float> scaleX, scaleY, scaleZ;
+            std::vector<glm::mat4> world;
+            std::vector<glm::mat4> local;          ///< 局部矩阵，只对子节点有效
+            std::vector<uint8_t> dirty;            ///< 脏标记位，0 表示矩阵是最新的
+            std::vector<uint32_t> parentSlot;      ///< 父节点槽位（层级关系以此为准）
+            std::vector<uint32_t> slots;           ///< 紧密下标 → 槽位
+            std::vector<uint32_t> denseIndex;      ///< 槽位 → 紧密下标
+            std::vector<uint32_t> generations;     ///< 槽位当前代数
+            std::vector<uint32_t> childCount;      ///< 槽位的直接子节点数
+            std::vector<uint32_t> firstChild;      ///< 子节点链表（按槽位，不随重排移动）
+            std::vector<uint32_t> nextSibling;
+            std::vector<uint32_t> prevSibling;
+            std::vector<uint32_t> freeSlots;
+
+            std::vector<uint32_t> parent;          ///< 父节点紧密下标，重排时生成
+            std::vector<uint32_t> levels;          ///< 各层起始紧密下标，末尾为总数
+            size_t linkCount = 0;                  ///< 有父节点的变换数，为 0 时跳过重排与传播
+            bool orderDirty = false;
+
+            std::vector<uint32_t> dirtyList;       ///< 可能为脏的紧密下标（可能含过期项，Update 时过滤）
+            std::vector<uint32_t> batch;           ///< Update 的临时缓冲：脏根节点
+            std::vector<uint32_t> childBatch;      ///< 脏子节点
+            std::vector<uint8_t> changed;          ///< 本次 Update 世界矩阵是否变化
+            std::vector<TransformHandle> moved;    ///< 上次 Update 世界矩阵变化的变换
+        };
+
+        static uint32_t Resolve(TransformHandle handle);
+        static void MarkDirty(uint32_t dense, uint8_t flags);
+        static void Link(uint32_t slot, uint32_t parent);
+        static void Unlink(uint32_t slot, uint32_t parent);
+        static glm::mat4 ComputeLocal(uint32_t dense);
+        static void ComputeBatch(const uint32_t* batch, size_t count, glm::mat4* out);
+        /// 批量较大且允许并行时按 SIMD 宽度对齐分段，经 JobSystem 并行重算
+        static void ComputeBatchParallel(const std::vector<uint32_t>& batch, glm::mat4* out);
+        /// 按广度优先重排全部数组并生成 parent / levels
+        static void Rebuild();
+
+        static Storage s_Storage;
+        static Stats s_Stats;
+        static bool s_SimdEnabled;
+        static unsigned int s_ThreadCount;
+    };
+
+} // namespace scene
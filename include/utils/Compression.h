@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * @brief LZ77 字节流压缩（LZ4 块格式：token + 字面量 + 16位偏移 + 匹配长度）
+     * 解压只需顺序拷贝，适合资源包中的文本类文件
+     */
+    std::vector<uint8_t> LzCompress(const void* data, size_t size);
+
+    /// 解压后最多为压缩数据的倍数：每个长度扩展字节至多表示 255 字节，用于在分配前校验记录的大小
+    constexpr uint64_t kLzMaxExpansion = 255;
+
+    /**
+     * @brief 解压到大小已知的缓冲区，数据损坏或长度不符时返回 false
+     */
+    bool LzDecompress(const void* data, size_t size, void* output, size_t outputSize);
+
+} // namespace utils
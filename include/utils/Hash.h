@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace utils {
+
+    /**
+     * @brief 64位非加密内容哈希，按8字节块混合，用于缓存校验与内容寻址
+     * @param data  数据首地址
+     * @param size  字节数
+     * @param seed  初始种子，可用于串联多段数据
+     */
+    inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) {
+        constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+
+        uint64_t h = seed ^ (static_cast<uint64_t>(size) * kMul);
+        auto mix = [](uint64_t x) {
+            x ^= x >> 31;
+            x *= 0xBF58476D1CE4E5B9ull;
+            x ^= x >> 29;
+            return x;
+        };
+
+        // 四路并行累加，减少乘法依赖链
+        uint64_t lanes[4] = {h, h + kMul, h ^ 0xD6E8FEB86659FD93ull, h - kMul};
+        while (size >= 32) {
+            for (int i = 0; i < 4; ++i) {
+                uint64_t word;
+                std::memcpy(&word, p + i * 8, 8);
+                lanes[i] = (lanes[i] ^ mix(word)) * kMul;
+                lanes[i] ^= lanes[i] >> 27;
+            }
+            p += 32;
+            size -= 32;
+        }
+        h = lanes[0] ^ (lanes[1] * 31) ^ (lanes[2] * 131) ^ (lanes[3] * 1031);
+
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            h = (h ^ mix(word)) * kMul;
+            p += 8;
+            size -= 8;
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, p, size);
+        h = (h ^ mix(tail ^ (static_cast<uint64_t>(size) << 56))) * kMul;
+
+        return mix(h ^ (h >> 32));
+    }
+
+    inline uint64_t HashString(const std::string& str, uint64_t seed = 0) {
+        return HashBytes(str.data(), str.size(), seed);
+    }
+
+    /// 哈希组合，顺序相关
+    inline uint64_t HashCombine(uint64_t seed, uint64_t value) {
+        return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+    }
+
+} // namespace utils
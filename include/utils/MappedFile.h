@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace utils {
+
+    /**
+     * @brief 只读内存映射文件，RAII 管理映射生命周期
+     * Windows 使用 CreateFileMapping，其余平台使用 mmap
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @brief 打开并映射整个文件，失败时抛出 std::runtime_error
+         * @param path 文件路径
+         */
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        // 禁拷贝，允许移动
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /// 映射区域首地址（空文件时为 nullptr）
+        const char* Data() const { return m_Data; }
+
+        /// 文件字节数
+        size_t Size() const { return m_Size; }
+
+        bool IsOpen() const { return m_Opened; }
+
+    private:
+        const char* m_Data = nullptr;
+        size_t m_Size = 0;
+        bool m_Opened = false;
+
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+
+        void Close();
+    };
+
+} // namespace utils
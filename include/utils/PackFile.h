@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/MappedFile.h"
+
+namespace utils {
+
+    /**
+     * @brief 只读文件内容视图
+     * 数据可能位于资源包映射区、松散文件的映射区或解压缓冲中，视图持有其所有者，拷贝开销很小
+     */
+    class FileView {
+    public:
+        FileView() = default;
+        FileView(const char* data, size_t size, std::shared_ptr<const void> owner)
+            : m_Data(data), m_Size(size), m_Owner(std::move(owner)) {}
+
+        const char* Data() const { return m_Data; }
+        size_t Size() const { return m_Size; }
+        bool IsValid() const { return m_Owner != nullptr; }
+
+    private:
+        const char* m_Data = nullptr;
+        size_t m_Size = 0;
+        std::shared_ptr<const void> m_Owner;
+    };
+
+    /**
+     * @brief 资源包（.rpak）：整个文件一次映射，按路径哈希二分查找条目
+     *
+     * 文件布局：PackHeader | 16字节对齐的各文件数据（按写入顺序连续存放）|
+     *          PackEntryRecord[entryCount]（按路径哈希排序）| 路径字符串表
+     * 未压缩条目直接返回映射区视图（零拷贝），压缩条目在读取时解压。
+     */
+    class PackFile {
+    public:
+        static constexpr uint32_t kMagic = 0x4B415052; // "RPAK"
+        static constexpr uint32_t kVersion = 1;
+
+        enum class Compression : uint32_t {
+            None = 0,
+            Lz = 1
+        };
+
+        struct Entry {
+            uint64_t pathHash = 0;
+            uint64_t offset = 0;
+            uint64_t storedSize = 0;
+            uint64_t size = 0;
+            Compression compression = Compression::None;
+            std::string path;
+        };
+
+        /// 写入资源包的一个文件
+        struct Input {
+            std::string key;       ///< 包内路径（相对项目根目录，'/' 分隔）
+            std::string path;      ///< 磁盘路径
+            bool compress = false; ///< 压缩后更小时才压缩存放
+        };
+
+        struct WriteStats {
+            size_t fileCount = 0;
+            size_t originalBytes = 0;
+            size_t storedBytes = 0;
+        };
+
+        /**
+         * @brief 按 inputs 顺序写出资源包（先写临时文件再替换），失败时抛出 std::runtime_error
+         */
+        static WriteStats Write(const std::string& packPath, const std::vector<Input>& inputs);
+
+        /**
+         * @brief 映射并解析资源包，格式错误时抛出 std::runtime_error
+         */
+        explicit PackFile(const std::string& packPath);
+
+        /// 查找条目，不存在时返回 nullptr
+        const Entry* Find(const std::string& key) const;
+
+        /**
+         * @brief 读取条目内容，self 为持有本资源包的指针（视图借此保持映射存活）
+         */
+        static FileView Read(const std::shared_ptr<const PackFile>& self, const Entry& entry);
+
+        const std::vector<Entry>& GetEntries() const { return m_Entries; }
+        const std::string& GetPath() const { return m_Path; }
+
+        /// 映射时资源包文件的修改时间（file_time_type 的计数），包被替换后已映射的内容不变
+        int64_t GetModifiedTime() const { return m_ModifiedTime; }
+
+    private:
+        std::string m_Path;
+        int64_t m_ModifiedTime = 0;
+        MappedFile m_File;
+        std::vector<Entry> m_Entries; ///< 按 pathHash 排序
+    };
+
+} // namespace utils
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/PackFile.h"
+
+namespace utils {
+
+    /**
+     * @brief 虚拟文件系统：先在已挂载的资源包中查找，找不到时回退到松散文件
+     * 路径可以是 PathResolver::Resolve 得到的完整路径，包内按相对项目根目录的路径查找。
+     * 挂载/卸载之间以互斥锁串行化，Open/Exists 可在任意线程调用。
+     */
+    class VirtualFileSystem {
+    public:
+        struct Stats {
+            size_t packReads = 0;        ///< 从资源包读取的次数
+            size_t looseReads = 0;       ///< 回退到松散文件的次数
+            size_t decompressedBytes = 0;
+        };
+
+        /// 文件大小与修改时间，缓存据此判断源文件是否可能变化（包内文件取资源包的修改时间）
+        struct FileStamp {
+            uint64_t size = 0;
+            int64_t mtime = 0;
+
+            bool operator==(const FileStamp& other) const { return size == other.size && mtime == other.mtime; }
+            bool operator!=(const FileStamp& other) const { return !(*this == other); }
+        };
+
+        /**
+         * @brief 挂载资源包，后挂载的优先；文件不存在时返回 false，格式错误时抛出 std::runtime_error
+         */
+        static bool Mount(const std::string& packPath);
+        static void UnmountAll();
+
+        /**
+         * @brief 是否允许回退到松散文件（默认允许）
+         * 发布版只读资源包时关闭，烘焙结果不再与磁盘上的源文件比对哈希
+         */
+        static void SetLooseFilesEnabled(bool enabled) { s_LooseFilesEnabled = enabled; }
+
+        /// 文件是否存在于资源包或磁盘
+        static bool Exists(const std::string& path);
+
+        /// 取得文件的大小与修改时间（查找顺序同 Open），文件不存在时返回 false
+        static bool GetStamp(const std::string& path, FileStamp& stamp);
+
+        /**
+         * @brief 就地改写磁盘上松散文件的一段字节，供缓存更新其记录的源文件时间戳
+         * @return 路径由资源包提供、不允许松散文件或写入失败时返回 false
+         */
+        static bool PatchLooseFile(const std::string& path, uint64_t offset, const void* data, size_t size);
+
+        /**
+         * @brief 打开文件，资源包中未压缩的条目为零拷贝视图；失败时抛出 std::runtime_error
+         */
+        static FileView Open(const std::string& path);
+
+        /// 包内路径：相对项目根目录、'/' 分隔的规范路径
+        static std::string GetKey(const std::string& path);
+
+        static Stats GetStats();
+        static void ResetStats();
+
+    private:
+        static std::shared_ptr<const std::vector<std::shared_ptr<const PackFile>>> GetMounts();
+
+        static std::shared_ptr<const std::vector<std::shared_ptr<const PackFile>>> s_Mounts;
+        static std::mutex s_MountMutex;     ///< 串行化 Mount/UnmountAll 的读-改-写
+        static std::atomic<bool> s_LooseFilesEnabled;
+        static std::atomic<size_t> s_PackReads;
+        static std::atomic<size_t> s_LooseReads;
+        static std::atomic<size_t> s_DecompressedBytes;
+    };
+
+} // namespace utils
@@ -2,6 +2,8 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in vec4 aDequantOffset;
+layout (location = 4) in vec4 aDequantScale;
 
 uniform mat4 u_View;
 uniform mat4 u_Projection;
@@ -9,7 +11,10 @@ uniform mat4 u_Model;
 
 out vec2 TexCoord;
 
+#include "common/dequantize.glsl"
+
 void main() {
-    gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 1.0);
+    vec3 position = DequantizePosition(aPos, aDequantOffset, aDequantScale);
+    gl_Position = u_Projection * u_View * u_Model * vec4(position, 1.0);
     TexCoord = aTexCoord;
 }
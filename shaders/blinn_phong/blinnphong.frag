@@ -1,24 +1,7 @@
-// GLSL 统一光源类型定义
-struct Light {
-    int type;           // 0=directional, 1=point, 2=spot
+#version 330 core
 
-    vec3 position;      // 点光、聚光用
-    vec3 direction;     // 方向光、聚光用
+#include "../common/lights.glsl"
 
-    vec3 color;
-    float intensity;
-
-    // 衰减参数，仅点光和聚光有效
-    float constant;
-    float linear;
-    float quadratic;
-
-    // 聚光灯专用角度
-    float innerCutOff;
-    float outerCutOff;
-};
-
-#define MAX_LIGHTS 4
 uniform int u_LightCount;
 uniform Light u_Lights[MAX_LIGHTS];
 
@@ -4,6 +4,10 @@ layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 layout(location = 2) in vec2 a_TexCoords;
 
+// 逐网格常量属性，见 dequantize.glsl
+layout(location = 3) in vec4 a_DequantOffset;
+layout(location = 4) in vec4 a_DequantScale;
+
 uniform mat4 u_Model;
 uniform mat4 u_View;
 uniform mat4 u_Projection;
@@ -12,11 +16,15 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
+#include "../common/dequantize.glsl"
+
 void main() {
-    FragPos = vec3(u_Model * vec4(a_Position, 1.0));
-    Normal = mat3(transpose(inverse(u_Model))) * a_Normal;
+    vec3 position = DequantizePosition(a_Position, a_DequantOffset, a_DequantScale);
+    vec3 normal = DequantizeNormal(a_Normal, a_DequantScale);
+
+    FragPos = vec3(u_Model * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(u_Model))) * normal;
     TexCoords = a_TexCoords;
 
     gl_Position = u_Projection * u_View * vec4(FragPos, 1.0);
 }
-    
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+// 紧凑顶点格式的反量化：位置为包围盒内的 [0,1] 坐标，scale.w = 1 表示法线为八面体编码
+// offset/scale 来自逐网格常量属性（location 3/4）
+
+vec3 DequantizePosition(vec3 position, vec4 offset, vec4 scale) {
+    return position * scale.xyz + offset.xyz;
+}
+
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
+vec3 DequantizeNormal(vec3 normal, vec4 scale) {
+    return scale.w > 0.5 ? DecodeOctahedral(normal.xy) : normal;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// GLSL 统一光源类型定义，与 graphics::Light 的 uniform 上传对应
+struct Light {
+    int type;           // 0=directional, 1=point, 2=spot
+
+    vec3 position;      // 点光、聚光用
+    vec3 direction;     // 方向光、聚光用
+
+    vec3 color;
+    float intensity;
+
+    // 衰减参数，仅点光和聚光有效
+    float constant;
+    float linear;
+    float quadratic;
+
+    // 聚光灯专用角度
+    float innerCutOff;
+    float outerCutOff;
+};
+
+#define MAX_LIGHTS 4
@@ -1,10 +1,15 @@
 #version 330 core
 layout(location = 0) in vec3 aPos;
+layout(location = 3) in vec4 aDequantOffset;
+layout(location = 4) in vec4 aDequantScale;
 
 uniform mat4 u_Model;
 uniform mat4 u_View;
 uniform mat4 u_Projection;
 
+#include "../common/dequantize.glsl"
+
 void main() {
-    gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 1.0);
+    vec3 position = DequantizePosition(aPos, aDequantOffset, aDequantScale);
+    gl_Position = u_Projection * u_View * u_Model * vec4(position, 1.0);
 }
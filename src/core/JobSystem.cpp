@@ -0,0 +1,502 @@
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+namespace core {
+
+    /// ParallelFor 的一次调用，各区间任务共用
+    struct RangeTask {
+        RangeTask(void (*invoke)(void*, size_t, size_t), void* context, size_t grain)
+            : invoke(invoke), context(context), grain(grain) {}
+
+        void (*invoke)(void*, size_t, size_t);
+        void* context;
+        size_t grain;
+        JobCounter counter;
+        std::exception_ptr error;
+        std::mutex errorMutex;
+    };
+
+    struct Job {
+        JobSystem::JobFunction function;
+        RangeTask* range = nullptr;    ///< 非空时为区间任务，执行 [begin, end)
+        size_t begin = 0;
+        size_t end = 0;
+        JobCounter* counter = nullptr;
+        bool background = false;
+    };
+
+namespace {
+
+    constexpr size_t kInitialDequeCapacity = 1024;
+    constexpr size_t kSplitsPerThread = 8;
+    constexpr int kSpinCount = 64;        ///< 找不到任务时休眠前的让出次数
+    /// Wait 阻塞后的最长休眠：归零时会被立即唤醒，超时只用于重新查找期间新入队的任务
+    constexpr auto kWaitSleep = std::chrono::milliseconds(1);
+
+    /**
+     * @brief Chase–Lev 双端队列（Lê 等人 2013 年的 C11 内存序版本）
+     * 只有所属线程 Push / Pop（后进先出，缓存友好），其他线程从另一端 Steal（先进先出，窃取较早拆出的大块任务）
+     */
+    class WorkStealingDeque {
+    public:
+        WorkStealingDeque() {
+            m_Arrays.push_back(std::make_unique<Array>(kInitialDequeCapacity));
+            m_Array.store(m_Arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        void Push(Job* job) {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_Top.load(std::memory_order_acquire);
+            Array* array = m_Array.load(std::memory_order_relaxed);
+            if (bottom - top > static_cast<int64_t>(array->mask)) array = Grow(array, top, bottom);
+            array->Put(bottom, job);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        Job* Pop() {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Array* array = m_Array.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+            if (top > bottom) {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            Job* job = array->Get(bottom);
+            if (top == bottom) {
+                // 只剩最后一个，与窃取者竞争
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* Steal() {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+            if (top >= bottom) return nullptr;
+            Job* job = m_Array.load(std::memory_order_acquire)->Get(top);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+
+    private:
+        struct Array {
+            explicit Array(size_t capacity) : mask(capacity - 1), items(new std::atomic<Job*>[capacity]) {}
+            Job* Get(int64_t i) const { return items[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+            void Put(int64_t i, Job* job) { items[static_cast<size_t>(i) & mask].store(job, std::memory_order_relaxed); }
+
+            size_t mask;
+            std::unique_ptr<std::atomic<Job*>[]> items;
+        };
+
+        // 扩容后旧数组保留到析构：窃取者可能仍在读取
+        Array* Grow(Array* array, int64_t top, int64_t bottom) {
+            m_Arrays.push_back(std::make_unique<Array>(2 * (array->mask + 1)));
+            Array* grown = m_Arrays.back().get();
+            for (int64_t i = top; i < bottom; ++i) grown->Put(i, array->Get(i));
+            m_Array.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+        alignas(64) std::atomic<int64_t> m_Top{0};
+        alignas(64) std::atomic<int64_t> m_Bottom{0};
+        std::atomic<Array*> m_Array{nullptr};
+        std::vector<std::unique_ptr<Array>> m_Arrays;
+    };
+
+    struct alignas(64) Worker {
+        WorkStealingDeque deque;
+        std::atomic<uint64_t> executed{0};   ///< 只由所属线程写入
+        std::atomic<uint64_t> stolen{0};
+    };
+
+    /// 调度器全局状态；析构时停止仍在运行的工作线程
+    struct State {
+        ~State();
+
+        std::mutex lifecycleMutex;
+        std::atomic<bool> initialized{false};
+        std::atomic<uint64_t> generation{0};           ///< 每次 Shutdown 加一，使旧的线程编号失效
+        std::vector<std::unique_ptr<Worker>> workers;  ///< [0] 为初始化线程
+        std::vector<std::thread> threads;
+
+        // 非工作线程提交的任务与后台任务
+        std::mutex queueMutex;
+        std::deque<Job*> shared;
+        std::deque<Job*> background;
+        std::atomic<size_t> sharedCount{0};
+        std::atomic<size_t> backgroundCount{0};
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<uint32_t> sleeping{0};
+        size_t wakeTokens = 0;
+        bool stopping = false;
+
+        // 非工作线程执行任务的统计
+        std::atomic<uint64_t> externalExecuted{0};
+        std::atomic<uint64_t> externalStolen{0};
+        std::atomic<uint64_t> sleeps{0};
+
+        std::mutex mainThreadMutex;
+        std::deque<JobSystem::JobFunction> mainThreadJobs;
+    };
+
+    State s_State;
+
+    thread_local int t_WorkerIndex = -1;
+    thread_local uint64_t t_Generation = 0;
+    thread_local uint32_t t_Random = 0x9E3779B9u;
+
+    /// 当前线程的工作线程编号，非工作线程为 -1
+    int CurrentWorker() {
+        return t_Generation == s_State.generation && t_WorkerIndex >= 0 ? t_WorkerIndex : -1;
+    }
+
+    uint32_t NextRandom() {
+        // xorshift32
+        t_Random ^= t_Random << 13;
+        t_Random ^= t_Random >> 17;
+        t_Random ^= t_Random << 5;
+        return t_Random;
+    }
+
+    /// 有线程休眠时唤醒一个（与休眠前的再次检查构成 Dekker 式握手，不会丢失唤醒）
+    void WakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (s_State.sleeping.load(std::memory_order_relaxed) == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(s_State.sleepMutex);
+            s_State.wakeTokens = std::min(s_State.wakeTokens + 1, s_State.threads.size());
+        }
+        s_State.wake.notify_one();
+    }
+
+    void Schedule(Job* job) {
+        const int index = CurrentWorker();
+        if (job->background || index < 0) {
+            std::lock_guard<std::mutex> lock(s_State.queueMutex);
+            if (job->background) {
+                s_State.background.push_back(job);
+                s_State.backgroundCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                s_State.shared.push_back(job);
+                s_State.sharedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            s_State.workers[index]->deque.Push(job);
+        }
+        WakeOne();
+    }
+
+    Job* PopQueue(std::deque<Job*>& queue, std::atomic<size_t>& count) {
+        if (count.load(std::memory_order_relaxed) == 0) return nullptr;
+        std::lock_guard<std::mutex> lock(s_State.queueMutex);
+        if (queue.empty()) return nullptr;
+        Job* job = queue.front();
+        queue.pop_front();
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    void CountSteal(int index) {
+        if (index >= 0) s_State.workers[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+        else s_State.externalStolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// 依次查找：自己的队列 → 共享队列 → 从随机位置开始窃取 → 后台队列（仅 allowBackground）
+    Job* FindJob(int index, bool allowBackground) {
+        if (index >= 0) {
+            if (Job* job = s_State.workers[index]->deque.Pop()) return job;
+        }
+        if (Job* job = PopQueue(s_State.shared, s_State.sharedCount)) return job;
+        const size_t count = s_State.workers.size();
+        if (count > 0) {
+            const size_t start = NextRandom() % count;
+            for (size_t i = 0; i < count; ++i) {
+                const size_t victim = (start + i) % count;
+                if (static_cast<int>(victim) == index) continue;
+                if (Job* job = s_State.workers[victim]->deque.Steal()) {
+                    CountSteal(index);
+                    return job;
+                }
+            }
+        }
+        if (allowBackground) return PopQueue(s_State.background, s_State.backgroundCount);
+        return nullptr;
+    }
+
+    void StopWorkers();
+
+    State::~State() { StopWorkers(); }
+
+} // namespace
+
+    void JobSystem::Initialize(size_t workerCount) {
+        std::lock_guard<std::mutex> lock(s_State.lifecycleMutex);
+        if (s_State.initialized.load(std::memory_order_relaxed)) return;
+        const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+        if (workerCount == 0) workerCount = hw > 1 ? hw - 1 : 1; // 给主线程留一个核心
+        // 多于硬件线程的工作线程只会互相争抢时间片
+        workerCount = std::min(workerCount, hw);
+
+        s_State.workers.clear();
+        for (size_t i = 0; i <= workerCount; ++i) s_State.workers.push_back(std::make_unique<Worker>());
+        t_WorkerIndex = 0;
+        t_Generation = s_State.generation;
+        s_State.stopping = false;
+        s_State.threads.reserve(workerCount);
+        for (size_t i = 1; i <= workerCount; ++i)
+            s_State.threads.emplace_back([i]() { WorkerLoop(static_cast<int>(i)); });
+        s_State.initialized.store(true, std::memory_order_release);
+    }
+
+namespace {
+
+    void StopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(s_State.sleepMutex);
+            s_State.stopping = true;
+        }
+        s_State.wake.notify_all();
+        for (auto& thread : s_State.threads) thread.join();
+        s_State.threads.clear();
+    }
+
+} // namespace
+
+    void JobSystem::Shutdown() {
+        std::lock_guard<std::mutex> lock(s_State.lifecycleMutex);
+        if (s_State.initialized.load(std::memory_order_relaxed)) {
+            // 工作线程找不到任何任务时才退出；退出后 0 号队列中若还有任务（调用方未等待），在这里执行完
+            StopWorkers();
+            const int index = CurrentWorker();
+            while (Job* job = FindJob(index, true)) Execute(job);
+            s_State.workers.clear();
+            s_State.initialized.store(false, std::memory_order_release);
+            ++s_State.generation;
+        }
+        ClearMainThreadJobs();
+    }
+
+    bool JobSystem::IsInitialized() {
+        return s_State.initialized.load(std::memory_order_acquire);
+    }
+
+    size_t JobSystem::GetThreadCount() {
+        return IsInitialized() ? s_State.workers.size() : 0;
+    }
+
+    void JobSystem::Run(JobFunction function, JobCounter* counter, JobCounter* dependency) {
+        if (!IsInitialized()) Initialize();
+        Job* job = new Job;
+        job->function = std::move(function);
+        job->counter = counter;
+        if (counter) counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+        if (dependency) {
+            std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+            if (dependency->m_Value.load(std::memory_order_acquire) != 0) {
+                dependency->m_Waiting.push_back(job);
+                return;
+            }
+        }
+        Schedule(job);
+    }
+
+    void JobSystem::RunBackground(JobFunction function, JobCounter* counter) {
+        if (!IsInitialized()) Initialize();
+        Job* job = new Job;
+        job->function = std::move(function);
+        job->counter = counter;
+        job->background = true;
+        if (counter) counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+        Schedule(job);
+    }
+
+    void JobSystem::Wait(JobCounter& counter) {
+        const int index = CurrentWorker();
+        int idle = 0;
+        while (!counter.IsDone()) {
+            if (Job* job = FindJob(index, false)) {
+                Execute(job);
+                idle = 0;
+            } else if (++idle <= kSpinCount) {
+                std::this_thread::yield();
+            } else {
+                // 剩余任务都在其他线程上执行：阻塞而不是继续让出，把 CPU 留给它们
+                std::unique_lock<std::mutex> lock(counter.m_Mutex);
+                ++counter.m_Blocked;
+                counter.m_Done.wait_for(lock, kWaitSleep, [&counter]() { return counter.IsDone(); });
+                --counter.m_Blocked;
+                idle = 0;
+            }
+        }
+        // 最后一次减一在锁内完成，拿到锁后计数不再被访问，调用方可以销毁它
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+    }
+
+    void JobSystem::ParallelForImpl(size_t count, size_t grain, RangeFunction invoke, void* context) {
+        // 整段不超过粒度时直接执行，调用方要求串行时不必启动工作线程
+        if (grain >= count) {
+            invoke(context, 0, count);
+            return;
+        }
+        if (!IsInitialized()) Initialize();
+        const size_t threads = GetThreadCount();
+        if (grain == 0) grain = std::max<size_t>(1, count / (threads * kSplitsPerThread));
+        if (count <= grain || threads <= 1) {
+            invoke(context, 0, count);
+            return;
+        }
+
+        RangeTask task(invoke, context, grain);
+        task.counter.m_Value.store(1, std::memory_order_relaxed);
+        RunRange(task, 0, count);
+        Finish(task.counter);
+        Wait(task.counter);
+        if (task.error) std::rethrow_exception(task.error);
+    }
+
+    void JobSystem::RunRange(RangeTask& task, size_t begin, size_t end) {
+        // 区间大于粒度时把后一半放回队列供窃取，自己继续处理前一半
+        while (end - begin > task.grain) {
+            const size_t middle = begin + (end - begin) / 2;
+            Job* half = new Job;
+            half->range = &task;
+            half->begin = middle;
+            half->end = end;
+            half->counter = &task.counter;
+            task.counter.m_Value.fetch_add(1, std::memory_order_relaxed);
+            Schedule(half);
+            end = middle;
+        }
+        try {
+            task.invoke(task.context, begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(task.errorMutex);
+            if (!task.error) task.error = std::current_exception();
+        }
+    }
+
+    void JobSystem::Execute(Job* job) {
+        if (job->range) {
+            RunRange(*job->range, job->begin, job->end);
+        } else {
+            try {
+                job->function();
+            } catch (const std::exception& e) {
+                std::cerr << "[JobSystem] Job failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "[JobSystem] Job failed with an unknown exception" << std::endl;
+            }
+        }
+        JobCounter* counter = job->counter;
+        delete job;
+
+        const int index = CurrentWorker();
+        if (index >= 0) s_State.workers[index]->executed.fetch_add(1, std::memory_order_relaxed);
+        else s_State.externalExecuted.fetch_add(1, std::memory_order_relaxed);
+        if (counter) Finish(*counter);
+    }
+
+    void JobSystem::Finish(JobCounter& counter) {
+        std::vector<Job*> released;
+        {
+            std::lock_guard<std::mutex> lock(counter.m_Mutex);
+            if (counter.m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                released.swap(counter.m_Waiting);
+                // 在锁内通知：Wait 返回后调用方可能立即销毁计数
+                if (counter.m_Blocked > 0) counter.m_Done.notify_all();
+            }
+        }
+        for (Job* job : released) Schedule(job);
+    }
+
+    void JobSystem::WorkerLoop(int index) {
+        t_WorkerIndex = index;
+        t_Generation = s_State.generation;
+        t_Random = 0x9E3779B9u * static_cast<uint32_t>(index + 1);
+        for (;;) {
+            Job* job = FindJob(index, true);
+            for (int spin = 0; !job && spin < kSpinCount; ++spin) {
+                std::this_thread::yield();
+                job = FindJob(index, true);
+            }
+            if (!job) {
+                // 先登记为休眠再检查一次队列，提交者在入队后检查休眠数，两者至少有一方看到对方
+                s_State.sleeping.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                job = FindJob(index, true);
+                if (!job) {
+                    std::unique_lock<std::mutex> lock(s_State.sleepMutex);
+                    if (s_State.stopping) {
+                        s_State.sleeping.fetch_sub(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    s_State.sleeps.fetch_add(1, std::memory_order_relaxed);
+                    s_State.wake.wait(lock, []() { return s_State.wakeTokens > 0 || s_State.stopping; });
+                    if (s_State.wakeTokens > 0) --s_State.wakeTokens;
+                }
+                s_State.sleeping.fetch_sub(1, std::memory_order_relaxed);
+                if (!job) continue;
+            }
+            Execute(job);
+        }
+    }
+
+    void JobSystem::PostToMainThread(JobFunction function) {
+        std::lock_guard<std::mutex> lock(s_State.mainThreadMutex);
+        s_State.mainThreadJobs.push_back(std::move(function));
+    }
+
+    size_t JobSystem::RunMainThreadJobs(double budgetMs) {
+        const auto start = std::chrono::steady_clock::now();
+        size_t executed = 0;
+        while (true) {
+            JobFunction function;
+            {
+                std::lock_guard<std::mutex> lock(s_State.mainThreadMutex);
+                if (s_State.mainThreadJobs.empty()) break;
+                function = std::move(s_State.mainThreadJobs.front());
+                s_State.mainThreadJobs.pop_front();
+            }
+            function();
+            ++executed;
+
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetMs) break;
+        }
+        return executed;
+    }
+
+    void JobSystem::ClearMainThreadJobs() {
+        std::lock_guard<std::mutex> lock(s_State.mainThreadMutex);
+        s_State.mainThreadJobs.clear();
+    }
+
+    JobSystem::Stats JobSystem::GetStats() {
+        Stats stats;
+        stats.executed = s_State.externalExecuted.load(std::memory_order_relaxed);
+        stats.stolen = s_State.externalStolen.load(std::memory_order_relaxed);
+        stats.sleeps = s_State.sleeps.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(s_State.lifecycleMutex);
+        for (const auto& worker : s_State.workers) {
+            stats.executed += worker->executed.load(std::memory_order_relaxed);
+            stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+} // namespace core
@@ -0,0 +1,584 @@
+#include "graphics/BlockCompression.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace graphics {
+
+namespace {
+
+    using Block = uint8_t[16][4];
+
+    // 读取 (bx, by) 处的 4x4 块，越界部分钳制到边缘像素
+    void LoadBlock(const uint8_t* rgba, int width, int height, int bx, int by, Block& out) {
+        for (int y = 0; y < 4; ++y) {
+            int sy = std::min(by * 4 + y, height - 1);
+            for (int x = 0; x < 4; ++x) {
+                int sx = std::min(bx * 4 + x, width - 1);
+                std::memcpy(out[y * 4 + x], rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+            }
+        }
+    }
+
+    void StoreBlock(const Block& block, uint8_t* rgba, int width, int height, int bx, int by) {
+        for (int y = 0; y < 4; ++y) {
+            int dy = by * 4 + y;
+            if (dy >= height) break;
+            for (int x = 0; x < 4; ++x) {
+                int dx = bx * 4 + x;
+                if (dx >= width) break;
+                std::memcpy(rgba + (static_cast<size_t>(dy) * width + dx) * 4, block[y * 4 + x], 4);
+            }
+        }
+    }
+
+    /**
+     * @brief 幂迭代求 channels 维颜色的主轴，返回均值与单位方向
+     */
+    template <int Channels>
+    void PrincipalAxis(const float (&px)[16][4], float (&mean)[4], float (&axis)[4]) {
+        for (int c = 0; c < 4; ++c) mean[c] = axis[c] = 0.0f;
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < Channels; ++c) mean[c] += px[i][c];
+        for (int c = 0; c < Channels; ++c) mean[c] /= 16.0f;
+
+        float cov[4][4] = {};
+        for (int i = 0; i < 16; ++i) {
+            float d[4];
+            for (int c = 0; c < Channels; ++c) d[c] = px[i][c] - mean[c];
+            for (int a = 0; a < Channels; ++a)
+                for (int b = a; b < Channels; ++b) cov[a][b] += d[a] * d[b];
+        }
+        for (int a = 0; a < Channels; ++a)
+            for (int b = 0; b < a; ++b) cov[a][b] = cov[b][a];
+
+        // 初始方向取对角线，避免与主轴正交
+        for (int c = 0; c < Channels; ++c) axis[c] = 1.0f;
+        for (int iter = 0; iter < 8; ++iter) {
+            float next[4] = {};
+            for (int a = 0; a < Channels; ++a)
+                for (int b = 0; b < Channels; ++b) next[a] += cov[a][b] * axis[b];
+            float len = 0.0f;
+            for (int c = 0; c < Channels; ++c) len += next[c] * next[c];
+            if (len < 1e-12f) break;
+            len = 1.0f / std::sqrt(len);
+            for (int c = 0; c < Channels; ++c) axis[c] = next[c] * len;
+        }
+    }
+
+    /**
+     * @brief 给定每个像素的插值权重 t（0 对应 e0，1 对应 e1），最小二乘求解两个端点
+     */
+    template <int Channels>
+    bool SolveEndpoints(const float (&px)[16][4], const float (&t)[16], float (&e0)[4], float (&e1)[4]) {
+        float a = 0.0f, b = 0.0f, c = 0.0f;
+        float r0[4] = {}, r1[4] = {};
+        for (int i = 0; i < 16; ++i) {
+            float s = 1.0f - t[i];
+            a += s * s;
+            b += s * t[i];
+            c += t[i] * t[i];
+            for (int ch = 0; ch < Channels; ++ch) {
+                r0[ch] += s * px[i][ch];
+                r1[ch] += t[i] * px[i][ch];
+            }
+        }
+        float det = a * c - b * b;
+        if (std::fabs(det) < 1e-6f) return false;
+        float inv = 1.0f / det;
+        for (int ch = 0; ch < Channels; ++ch) {
+            e0[ch] = std::min(255.0f, std::max(0.0f, (c * r0[ch] - b * r1[ch]) * inv));
+            e1[ch] = std::min(255.0f, std::max(0.0f, (a * r1[ch] - b * r0[ch]) * inv));
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------
+    // BC1
+    // ---------------------------------------------------------------
+
+    uint16_t Pack565(const float (&c)[4]) {
+        int r = static_cast<int>(std::min(31.0f, std::max(0.0f, c[0] * 31.0f / 255.0f + 0.5f)));
+        int g = static_cast<int>(std::min(63.0f, std::max(0.0f, c[1] * 63.0f / 255.0f + 0.5f)));
+        int b = static_cast<int>(std::min(31.0f, std::max(0.0f, c[2] * 31.0f / 255.0f + 0.5f)));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void Unpack565(uint16_t v, int (&out)[3]) {
+        int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+    }
+
+    // 4色模式调色板：索引 0/1 为端点，2/3 为 1/3、2/3 插值
+    void BC1Palette(uint16_t c0, uint16_t c1, int (&palette)[4][3]) {
+        Unpack565(c0, palette[0]);
+        Unpack565(c1, palette[1]);
+        for (int ch = 0; ch < 3; ++ch) {
+            palette[2][ch] = (2 * palette[0][ch] + palette[1][ch]) / 3;
+            palette[3][ch] = (palette[0][ch] + 2 * palette[1][ch]) / 3;
+        }
+    }
+
+    uint32_t BC1Indices(const float (&px)[16][4], const int (&palette)[4][3], float* error) {
+        uint32_t indices = 0;
+        float total = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            float bestErr = 1e30f;
+            for (int p = 0; p < 4; ++p) {
+                float err = 0.0f;
+                for (int ch = 0; ch < 3; ++ch) {
+                    float d = px[i][ch] - palette[p][ch];
+                    err += d * d;
+                }
+                if (err < bestErr) {
+                    bestErr = err;
+                    best = p;
+                }
+            }
+            total += bestErr;
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+        if (error) *error = total;
+        return indices;
+    }
+
+    void EncodeBC1(const Block& block, uint8_t* out) {
+        float px[16][4];
+        for (int i = 0; i < 16; ++i)
+            for (int ch = 0; ch < 4; ++ch) px[i][ch] = block[i][ch];
+
+        float mean[4], axis[4];
+        PrincipalAxis<3>(px, mean, axis);
+        float minProj = 1e30f, maxProj = -1e30f;
+        for (int i = 0; i < 16; ++i) {
+            float proj = 0.0f;
+            for (int ch = 0; ch < 3; ++ch) proj += (px[i][ch] - mean[ch]) * axis[ch];
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+        float e0[4], e1[4];
+        for (int ch = 0; ch < 3; ++ch) {
+            e0[ch] = std::min(255.0f, std::max(0.0f, mean[ch] + axis[ch] * maxProj));
+            e1[ch] = std::min(255.0f, std::max(0.0f, mean[ch] + axis[ch] * minProj));
+        }
+
+        uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+        int palette[4][3];
+        BC1Palette(c0, c1, palette);
+        float bestErr;
+        uint32_t indices = BC1Indices(px, palette, &bestErr);
+
+        // 按当前索引最小二乘细化端点，误差下降才采用
+        static const float kWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+        for (int iter = 0; iter < 2 && c0 != c1; ++iter) {
+            float t[16];
+            for (int i = 0; i < 16; ++i) t[i] = kWeights[(indices >> (i * 2)) & 3];
+            if (!SolveEndpoints<3>(px, t, e0, e1)) break;
+            uint16_t n0 = Pack565(e0), n1 = Pack565(e1);
+            BC1Palette(n0, n1, palette);
+            float err;
+            uint32_t nIndices = BC1Indices(px, palette, &err);
+            if (err >= bestErr) break;
+            bestErr = err;
+            c0 = n0;
+            c1 = n1;
+            indices = nIndices;
+        }
+
+        // 保证 c0 > c1 以使用4色模式
+        if (c0 < c1) {
+            std::swap(c0, c1);
+            indices ^= 0x55555555u; // 0<->1, 2<->3
+        } else if (c0 == c1) {
+            indices = 0;
+        }
+
+        out[0] = static_cast<uint8_t>(c0 & 0xFF);
+        out[1] = static_cast<uint8_t>(c0 >> 8);
+        out[2] = static_cast<uint8_t>(c1 & 0xFF);
+        out[3] = static_cast<uint8_t>(c1 >> 8);
+        std::memcpy(out + 4, &indices, 4);
+    }
+
+    void DecodeBC1(const uint8_t* in, Block& block) {
+        uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+        uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+        uint32_t indices;
+        std::memcpy(&indices, in + 4, 4);
+
+        int palette[4][3];
+        BC1Palette(c0, c1, palette);
+        int alpha[4] = {255, 255, 255, 255};
+        if (c0 <= c1) {
+            // 3色模式：索引 2 为中点，索引 3 为透明黑
+            for (int ch = 0; ch < 3; ++ch) {
+                palette[2][ch] = (palette[0][ch] + palette[1][ch]) / 2;
+                palette[3][ch] = 0;
+            }
+            alpha[3] = 0;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int idx = (indices >> (i * 2)) & 3;
+            for (int ch = 0; ch < 3; ++ch) block[i][ch] = static_cast<uint8_t>(palette[idx][ch]);
+            block[i][3] = static_cast<uint8_t>(alpha[idx]);
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // BC4（BC3 的 alpha 与 BC5 的每个通道）
+    // ---------------------------------------------------------------
+
+    void BC4Palette(int a0, int a1, int (&palette)[8]) {
+        palette[0] = a0;
+        palette[1] = a1;
+        if (a0 > a1) {
+            for (int i = 2; i < 8; ++i) palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        } else {
+            for (int i = 2; i < 6; ++i) palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    void EncodeBC4(const Block& block, int channel, uint8_t* out) {
+        int mn = 255, mx = 0;
+        for (int i = 0; i < 16; ++i) {
+            mn = std::min<int>(mn, block[i][channel]);
+            mx = std::max<int>(mx, block[i][channel]);
+        }
+
+        int palette[8];
+        BC4Palette(mx, mn, palette);
+        uint64_t indices = 0;
+        if (mx != mn) {
+            for (int i = 0; i < 16; ++i) {
+                int v = block[i][channel];
+                int best = 0, bestErr = 1 << 30;
+                for (int p = 0; p < 8; ++p) {
+                    int err = std::abs(v - palette[p]);
+                    if (err < bestErr) {
+                        bestErr = err;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (i * 3);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(mx);
+        out[1] = static_cast<uint8_t>(mn);
+        for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+
+    void DecodeBC4(const uint8_t* in, int channel, Block& block) {
+        int palette[8];
+        BC4Palette(in[0], in[1], palette);
+        uint64_t indices = 0;
+        for (int i = 0; i < 6; ++i) indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+        for (int i = 0; i < 16; ++i) block[i][channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+    }
+
+    // ---------------------------------------------------------------
+    // BC7 mode 6：单子集，RGBA 7777 端点 + 每端点1位 p-bit，4位索引
+    // ---------------------------------------------------------------
+
+    const int kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    class BitWriter {
+    public:
+        void Write(uint32_t value, int bits) {
+            for (int i = 0; i < bits; ++i, ++m_Pos) {
+                if (value & (1u << i)) m_Data[m_Pos >> 3] |= static_cast<uint8_t>(1u << (m_Pos & 7));
+            }
+        }
+        void CopyTo(uint8_t* out) const { std::memcpy(out, m_Data, 16); }
+
+    private:
+        uint8_t m_Data[16] = {};
+        int m_Pos = 0;
+    };
+
+    class BitReader {
+    public:
+        explicit BitReader(const uint8_t* data) : m_Data(data) {}
+        uint32_t Read(int bits) {
+            uint32_t value = 0;
+            for (int i = 0; i < bits; ++i, ++m_Pos) {
+                value |= static_cast<uint32_t>((m_Data[m_Pos >> 3] >> (m_Pos & 7)) & 1) << i;
+            }
+            return value;
+        }
+
+    private:
+        const uint8_t* m_Data;
+        int m_Pos = 0;
+    };
+
+    // 为端点选择误差更小的 p-bit，返回量化后的 7 位分量
+    void QuantizeBC7Endpoint(const float (&e)[4], int (&q)[4], int& pbit) {
+        float bestErr = 1e30f;
+        for (int p = 0; p < 2; ++p) {
+            int cand[4];
+            float err = 0.0f;
+            for (int ch = 0; ch < 4; ++ch) {
+                cand[ch] = std::min(127, std::max(0, static_cast<int>(std::floor((e[ch] - p) * 0.5f + 0.5f))));
+                float d = static_cast<float>(cand[ch] * 2 + p) - e[ch];
+                err += d * d;
+            }
+            if (err < bestErr) {
+                bestErr = err;
+                pbit = p;
+                std::memcpy(q, cand, sizeof(cand));
+            }
+        }
+    }
+
+    float BC7Indices(const float (&px)[16][4], const int (&v0)[4], const int (&v1)[4], int (&indices)[16]) {
+        int palette[16][4];
+        for (int w = 0; w < 16; ++w)
+            for (int ch = 0; ch < 4; ++ch)
+                palette[w][ch] = ((64 - kBC7Weights4[w]) * v0[ch] + kBC7Weights4[w] * v1[ch] + 32) >> 6;
+
+        float total = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            float bestErr = 1e30f;
+            for (int w = 0; w < 16; ++w) {
+                float err = 0.0f;
+                for (int ch = 0; ch < 4; ++ch) {
+                    float d = px[i][ch] - palette[w][ch];
+                    err += d * d;
+                }
+                if (err < bestErr) {
+                    bestErr = err;
+                    indices[i] = w;
+                }
+            }
+            total += bestErr;
+        }
+        return total;
+    }
+
+    void EncodeBC7(const Block& block, uint8_t* out) {
+        float px[16][4];
+        for (int i = 0; i < 16; ++i)
+            for (int ch = 0; ch < 4; ++ch) px[i][ch] = block[i][ch];
+
+        float mean[4], axis[4];
+        PrincipalAxis<4>(px, mean, axis);
+        float minProj = 1e30f, maxProj = -1e30f;
+        for (int i = 0; i < 16; ++i) {
+            float proj = 0.0f;
+            for (int ch = 0; ch < 4; ++ch) proj += (px[i][ch] - mean[ch]) * axis[ch];
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+        float e0[4], e1[4];
+        for (int ch = 0; ch < 4; ++ch) {
+            e0[ch] = std::min(255.0f, std::max(0.0f, mean[ch] + axis[ch] * minProj));
+            e1[ch] = std::min(255.0f, std::max(0.0f, mean[ch] + axis[ch] * maxProj));
+        }
+
+        int q0[4], q1[4], p0 = 0, p1 = 0, indices[16];
+        auto quantize = [&](int (&a)[4], int (&b)[4], int& pa, int& pb, int (&idx)[16]) {
+            QuantizeBC7Endpoint(e0, a, pa);
+            QuantizeBC7Endpoint(e1, b, pb);
+            int v0[4], v1[4];
+            for (int ch = 0; ch < 4; ++ch) {
+                v0[ch] = a[ch] * 2 + pa;
+                v1[ch] = b[ch] * 2 + pb;
+            }
+            return BC7Indices(px, v0, v1, idx);
+        };
+        float bestErr = quantize(q0, q1, p0, p1, indices);
+
+        for (int iter = 0; iter < 2; ++iter) {
+            float t[16];
+            for (int i = 0; i < 16; ++i) t[i] = kBC7Weights4[indices[i]] / 64.0f;
+            if (!SolveEndpoints<4>(px, t, e0, e1)) break;
+            int n0[4], n1[4], np0 = 0, np1 = 0, nIndices[16];
+            float err = quantize(n0, n1, np0, np1, nIndices);
+            if (err >= bestErr) break;
+            bestErr = err;
+            std::memcpy(q0, n0, sizeof(q0));
+            std::memcpy(q1, n1, sizeof(q1));
+            p0 = np0;
+            p1 = np1;
+            std::memcpy(indices, nIndices, sizeof(indices));
+        }
+
+        // 锚点（首个像素）索引最高位隐含为0，必要时交换端点
+        if (indices[0] & 8) {
+            std::swap(q0, q1);
+            std::swap(p0, p1);
+            for (int& idx : indices) idx = 15 - idx;
+        }
+
+        BitWriter writer;
+        writer.Write(1u << 6, 7);
+        for (int ch = 0; ch < 4; ++ch) {
+            writer.Write(static_cast<uint32_t>(q0[ch]), 7);
+            writer.Write(static_cast<uint32_t>(q1[ch]), 7);
+        }
+        writer.Write(static_cast<uint32_t>(p0), 1);
+        writer.Write(static_cast<uint32_t>(p1), 1);
+        writer.Write(static_cast<uint32_t>(indices[0]), 3);
+        for (int i = 1; i < 16; ++i) writer.Write(static_cast<uint32_t>(indices[i]), 4);
+        writer.CopyTo(out);
+    }
+
+    void DecodeBC7(const uint8_t* in, Block& block) {
+        BitReader reader(in);
+        if (reader.Read(7) != (1u << 6)) {
+            // 非 mode 6 块（本编码器不会生成），输出洋红以便发现
+            for (int i = 0; i < 16; ++i) {
+                block[i][0] = 255;
+                block[i][1] = 0;
+                block[i][2] = 255;
+                block[i][3] = 255;
+            }
+            return;
+        }
+        int q[2][4];
+        for (int ch = 0; ch < 4; ++ch) {
+            q[0][ch] = static_cast<int>(reader.Read(7));
+            q[1][ch] = static_cast<int>(reader.Read(7));
+        }
+        int p0 = static_cast<int>(reader.Read(1));
+        int p1 = static_cast<int>(reader.Read(1));
+        int v0[4], v1[4];
+        for (int ch = 0; ch < 4; ++ch) {
+            v0[ch] = q[0][ch] * 2 + p0;
+            v1[ch] = q[1][ch] * 2 + p1;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int w = kBC7Weights4[reader.Read(i == 0 ? 3 : 4)];
+            for (int ch = 0; ch < 4; ++ch)
+                block[i][ch] = static_cast<uint8_t>(((64 - w) * v0[ch] + w * v1[ch] + 32) >> 6);
+        }
+    }
+
+    size_t GetBlockBytes(TextureFormat format) {
+        return format == TextureFormat::BC1 ? 8 : 16;
+    }
+
+} // namespace
+
+    const char* GetTextureFormatName(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::RGBA8: return "RGBA8";
+            case TextureFormat::BC1: return "BC1";
+            case TextureFormat::BC3: return "BC3";
+            case TextureFormat::BC5: return "BC5";
+            case TextureFormat::BC7: return "BC7";
+        }
+        return "Unknown";
+    }
+
+    size_t GetTextureLevelSize(TextureFormat format, int width, int height) {
+        if (!IsBlockCompressed(format))
+            return static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        size_t blocksX = (static_cast<size_t>(width) + 3) / 4;
+        size_t blocksY = (static_cast<size_t>(height) + 3) / 4;
+        return blocksX * blocksY * GetBlockBytes(format);
+    }
+
+    std::vector<uint8_t> BlockCompressor::Compress(TextureFormat format, const uint8_t* rgba, int width, int height,
+                                                   unsigned int threadCount) {
+        if (width <= 0 || height <= 0)
+            throw std::runtime_error("Cannot compress an empty image");
+        if (!IsBlockCompressed(format))
+            return std::vector<uint8_t>(rgba, rgba + GetTextureLevelSize(format, width, height));
+
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        const size_t blockBytes = GetBlockBytes(format);
+        std::vector<uint8_t> out(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+        // 按块行并行，各行写入互不重叠
+        const auto encodeRow = [&](size_t by) {
+            Block block;
+            uint8_t* dst = out.data() + by * blocksX * blockBytes;
+            for (int bx = 0; bx < blocksX; ++bx, dst += blockBytes) {
+                LoadBlock(rgba, width, height, bx, static_cast<int>(by), block);
+                switch (format) {
+                    case TextureFormat::BC1: EncodeBC1(block, dst); break;
+                    case TextureFormat::BC3:
+                        EncodeBC4(block, 3, dst);
+                        EncodeBC1(block, dst + 8);
+                        break;
+                    case TextureFormat::BC5:
+                        EncodeBC4(block, 0, dst);
+                        EncodeBC4(block, 1, dst + 8);
+                        break;
+                    case TextureFormat::BC7: EncodeBC7(block, dst); break;
+                    default: break;
+                }
+            }
+        };
+        const size_t rows = static_cast<size_t>(blocksY);
+        core::JobSystem::ParallelFor(rows, [&encodeRow](size_t begin, size_t end) {
+            for (size_t by = begin; by < end; ++by) encodeRow(by);
+        }, threadCount == 1 ? rows : 0);
+        return out;
+    }
+
+    std::vector<uint8_t> BlockCompressor::Decompress(TextureFormat format, const uint8_t* blocks, int width, int height) {
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        if (!IsBlockCompressed(format)) {
+            std::memcpy(rgba.data(), blocks, rgba.size());
+            return rgba;
+        }
+
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        const size_t blockBytes = GetBlockBytes(format);
+        const uint8_t* src = blocks;
+        for (int by = 0; by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx, src += blockBytes) {
+                Block block;
+                switch (format) {
+                    case TextureFormat::BC1: DecodeBC1(src, block); break;
+                    case TextureFormat::BC3:
+                        DecodeBC1(src + 8, block);
+                        DecodeBC4(src, 3, block);
+                        break;
+                    case TextureFormat::BC5:
+                        DecodeBC4(src, 0, block);
+                        DecodeBC4(src + 8, 1, block);
+                        for (auto& p : block) {
+                            p[2] = 0;
+                            p[3] = 255;
+                        }
+                        break;
+                    case TextureFormat::BC7: DecodeBC7(src, block); break;
+                    default: break;
+                }
+                StoreBlock(block, rgba.data(), width, height, bx, by);
+            }
+        }
+        return rgba;
+    }
+
+    TextureFormat BlockCompressor::ChooseFormat(const std::string& path, const uint8_t* rgba, int width, int height,
+                                                bool highQuality) {
+        std::string name = std::filesystem::path(path).stem().string();
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (name.find("_ddn") != std::string::npos || name.find("normal") != std::string::npos)
+            return TextureFormat::BC5;
+
+        bool hasAlpha = false;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount && !hasAlpha; ++i) hasAlpha = rgba[i * 4 + 3] != 255;
+
+        if (highQuality) return TextureFormat::BC7;
+        return hasAlpha ? TextureFormat::BC3 : TextureFormat::BC1;
+    }
+
+} // namespace graphics
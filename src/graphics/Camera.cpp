@@ -70,6 +70,16 @@ namespace graphics {
         return std::make_tuple(m_Front, m_Up, m_Right);
     }
     
+    // 反投影近、远平面上的对应点，两点连线即为射线
+    std::pair<glm::vec3, glm::vec3> Camera::ScreenPointToRay(float x, float y, float width, float height) const {
+        const glm::vec2 ndc(2.0f * x / width - 1.0f, 1.0f - 2.0f * y / height);
+        const glm::mat4 inverse = glm::inverse(GetProjectionMatrix() * GetViewMatrix());
+        const glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0f, 1.0f);
+        const glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+        const glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+        return {origin, glm::normalize(glm::vec3(farPoint) / farPoint.w - origin)};
+    }
+
     void Camera::UpdateDirection() {
         // 根据欧拉角计算前向、右向和上向量
         glm::vec3 front;
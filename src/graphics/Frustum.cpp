@@ -0,0 +1,216 @@
+#include "graphics/Frustum.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RRENDER_FRUSTUM_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace graphics {
+
+    bool FrustumCuller::s_Enabled = true;
+    bool FrustumCuller::s_SimdEnabled = true;
+    FrustumCuller::Stats FrustumCuller::s_Stats;
+
+namespace {
+
+    glm::vec4 NormalizePlane(const glm::vec4& plane) {
+        const float length = glm::length(glm::vec3(plane));
+        return length > 0.0f ? plane / length : plane;
+    }
+
+    /// 平面参数按分量广播，|n| 预先算好
+    struct PlaneConstants {
+        float nx[6], ny[6], nz[6], d[6];
+        float ax[6], ay[6], az[6];
+
+        explicit PlaneConstants(const Frustum& frustum) {
+            for (int p = 0; p < 6; ++p) {
+                const glm::vec4& plane = frustum.planes[p];
+                nx[p] = plane.x;
+                ny[p] = plane.y;
+                nz[p] = plane.z;
+                d[p] = plane.w;
+                ax[p] = std::abs(plane.x);
+                ay[p] = std::abs(plane.y);
+                az[p] = std::abs(plane.z);
+            }
+        }
+    };
+
+    // 中心到平面的有符号距离 + 半长在法线上的投影 < 0 即整个盒在平面外侧
+    bool TestScalar(const PlaneConstants& k, float cx, float cy, float cz, float ex, float ey, float ez) {
+        for (int p = 0; p < 6; ++p) {
+            const float distance = k.nx[p] * cx + k.ny[p] * cy + k.nz[p] * cz + k.d[p];
+            const float radius = k.ax[p] * ex + k.ay[p] * ey + k.az[p] * ez;
+            if (distance + radius < 0.0f) return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+    BoundingBox BoundingBox::FromPoints(const glm::vec3* points, size_t count, size_t stride) {
+        BoundingBox box;
+        if (count == 0) return box;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(points);
+        box.min = box.max = *points;
+        for (size_t i = 1; i < count; ++i) {
+            const glm::vec3& p = *reinterpret_cast<const glm::vec3*>(bytes + i * stride);
+            box.min = glm::min(box.min, p);
+            box.max = glm::max(box.max, p);
+        }
+        return box;
+    }
+
+    BoundingBox BoundingBox::Transform(const glm::mat4& matrix) const {
+        const glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+        const glm::vec3 extents = GetExtents();
+        const glm::vec3 worldExtents = glm::abs(glm::vec3(matrix[0])) * extents.x +
+                                       glm::abs(glm::vec3(matrix[1])) * extents.y +
+                                       glm::abs(glm::vec3(matrix[2])) * extents.z;
+        return BoundingBox{center - worldExtents, center + worldExtents};
+    }
+
+    BoundingSphere BoundingSphere::FromBox(const BoundingBox& box) {
+        return BoundingSphere{box.GetCenter(), glm::length(box.GetExtents())};
+    }
+
+    BoundingSphere BoundingSphere::Transform(const glm::mat4& matrix) const {
+        const float scaleSquared = std::max(glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                            std::max(glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                                     glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))));
+        return BoundingSphere{glm::vec3(matrix * glm::vec4(center, 1.0f)), radius * std::sqrt(scaleSquared)};
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4& matrix) {
+        Frustum frustum;
+        const glm::mat4 m = glm::transpose(matrix);
+        frustum.planes[0] = NormalizePlane(m[3] + m[0]);
+        frustum.planes[1] = NormalizePlane(m[3] - m[0]);
+        frustum.planes[2] = NormalizePlane(m[3] + m[1]);
+        frustum.planes[3] = NormalizePlane(m[3] - m[1]);
+        frustum.planes[4] = NormalizePlane(m[3] + m[2]);
+        frustum.planes[5] = NormalizePlane(m[3] - m[2]);
+        return frustum;
+    }
+
+    bool Frustum::IntersectsBox(const glm::vec4* planes, const BoundingBox& box) {
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extents = box.GetExtents();
+        for (int p = 0; p < 6; ++p) {
+            const glm::vec3 normal(planes[p]);
+            if (glm::dot(normal, center) + planes[p].w + glm::dot(glm::abs(normal), extents) < 0.0f) return false;
+        }
+        return true;
+    }
+
+    bool Frustum::Intersects(const BoundingSphere& sphere) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) return false;
+        }
+        return true;
+    }
+
+    void FrustumCuller::BoxList::Clear() {
+        centerX.clear();
+        centerY.clear();
+        centerZ.clear();
+        extentX.clear();
+        extentY.clear();
+        extentZ.clear();
+    }
+
+    void FrustumCuller::BoxList::Reserve(size_t count) {
+        centerX.reserve(count);
+        centerY.reserve(count);
+        centerZ.reserve(count);
+        extentX.reserve(count);
+        extentY.reserve(count);
+        extentZ.reserve(count);
+    }
+
+    void FrustumCuller::BoxList::Push(const BoundingBox& box) {
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extents = box.GetExtents();
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerZ.push_back(center.z);
+        extentX.push_back(extents.x);
+        extentY.push_back(extents.y);
+        extentZ.push_back(extents.z);
+    }
+
+    void FrustumCuller::Cull(const Frustum& frustum, const BoxList& boxes, std::vector<uint32_t>& visible) {
+        const auto start = std::chrono::steady_clock::now();
+        const PlaneConstants k(frustum);
+        const size_t count = boxes.Size();
+        visible.clear();
+        visible.reserve(count);
+        size_t i = 0;
+
+#ifdef RRENDER_FRUSTUM_SSE
+        if (s_SimdEnabled) {
+#ifdef __AVX__
+            for (; i + 8 <= count; i += 8) {
+                const __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]);
+                const __m256 cy = _mm256_loadu_ps(&boxes.centerY[i]);
+                const __m256 cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+                const __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]);
+                const __m256 ey = _mm256_loadu_ps(&boxes.extentY[i]);
+                const __m256 ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+                __m256 outside = _mm256_setzero_ps();
+                for (int p = 0; p < 6; ++p) {
+                    __m256 distance = _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(k.nx[p])), _mm256_set1_ps(k.d[p]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(cy, _mm256_set1_ps(k.ny[p])));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(cz, _mm256_set1_ps(k.nz[p])));
+                    __m256 radius = _mm256_mul_ps(ex, _mm256_set1_ps(k.ax[p]));
+                    radius = _mm256_add_ps(radius, _mm256_mul_ps(ey, _mm256_set1_ps(k.ay[p])));
+                    radius = _mm256_add_ps(radius, _mm256_mul_ps(ez, _mm256_set1_ps(k.az[p])));
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+                }
+                const int mask = ~_mm256_movemask_ps(outside) & 0xFF;
+                for (int lane = 0; lane < 8; ++lane) {
+                    if (mask & (1 << lane)) visible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+#endif
+            for (; i + 4 <= count; i += 4) {
+                const __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+                const __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+                const __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+                const __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+                const __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+                const __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+                __m128 outside = _mm_setzero_ps();
+                for (int p = 0; p < 6; ++p) {
+                    __m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(k.nx[p])), _mm_set1_ps(k.d[p]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(cy, _mm_set1_ps(k.ny[p])));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(k.nz[p])));
+                    __m128 radius = _mm_mul_ps(ex, _mm_set1_ps(k.ax[p]));
+                    radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(k.ay[p])));
+                    radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(k.az[p])));
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+                const int mask = ~_mm_movemask_ps(outside) & 0xF;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (mask & (1 << lane)) visible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (TestScalar(k, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i], boxes.extentX[i], boxes.extentY[i],
+                           boxes.extentZ[i]))
+                visible.push_back(static_cast<uint32_t>(i));
+        }
+
+        s_Stats.tested += count;
+        s_Stats.visible += visible.size();
+        s_Stats.culled += count - visible.size();
+        s_Stats.cullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace graphics
@@ -0,0 +1,122 @@
+#include "graphics/GLExtensions.h"
+#include <iostream>
+
+namespace graphics {
+
+namespace {
+
+    // GLAD 只含 3.3 核心接口，扩展函数在 Init 中按名称加载
+    using GetProgramBinaryFn = void (APIENTRYP)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+    using ProgramBinaryFn = void (APIENTRYP)(GLuint, GLenum, const void*, GLsizei);
+    using ProgramParameteriFn = void (APIENTRYP)(GLuint, GLenum, GLint);
+    using MaxShaderCompilerThreadsFn = void (APIENTRYP)(GLuint);
+
+    GetProgramBinaryFn s_GetProgramBinaryFn = nullptr;
+    ProgramBinaryFn s_ProgramBinaryFn = nullptr;
+    ProgramParameteriFn s_ProgramParameteriFn = nullptr;
+
+    template <typename Fn>
+    Fn LoadFunction(GLADloadproc loader, const char* name) {
+        return loader ? reinterpret_cast<Fn>(loader(name)) : nullptr;
+    }
+
+    std::string GetString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+} // namespace
+
+    std::unordered_set<std::string> GLExtensions::s_Extensions;
+    bool GLExtensions::s_S3TC = false;
+    bool GLExtensions::s_S3TCsRGB = false;
+    bool GLExtensions::s_BPTC = false;
+    bool GLExtensions::s_ProgramBinary = false;
+    bool GLExtensions::s_ParallelShaderCompile = false;
+    std::string GLExtensions::s_DriverId;
+
+    void GLExtensions::Init(GLADloadproc loader) {
+        s_Extensions.clear();
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const GLubyte* name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+            if (name) s_Extensions.insert(reinterpret_cast<const char*>(name));
+        }
+
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+        s_S3TC = Has("GL_EXT_texture_compression_s3tc");
+        s_S3TCsRGB = s_S3TC && (Has("GL_EXT_texture_sRGB") || Has("GL_EXT_texture_compression_s3tc_srgb"));
+        // BPTC 自 GL 4.2 起为核心功能
+        s_BPTC = Has("GL_ARB_texture_compression_bptc") || major > 4 || (major == 4 && minor >= 2);
+
+        s_DriverId = GetString(GL_VENDOR) + "|" + GetString(GL_RENDERER) + "|" + GetString(GL_VERSION);
+
+        // 程序二进制自 GL 4.1 起为核心功能
+        s_ProgramBinary = false;
+        if (Has("GL_ARB_get_program_binary") || major > 4 || (major == 4 && minor >= 1)) {
+            s_GetProgramBinaryFn = LoadFunction<GetProgramBinaryFn>(loader, "glGetProgramBinary");
+            s_ProgramBinaryFn = LoadFunction<ProgramBinaryFn>(loader, "glProgramBinary");
+            s_ProgramParameteriFn = LoadFunction<ProgramParameteriFn>(loader, "glProgramParameteri");
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            s_ProgramBinary = s_GetProgramBinaryFn && s_ProgramBinaryFn && s_ProgramParameteriFn && formats > 0;
+        }
+
+        MaxShaderCompilerThreadsFn maxThreads = nullptr;
+        if (Has("GL_KHR_parallel_shader_compile"))
+            maxThreads = LoadFunction<MaxShaderCompilerThreadsFn>(loader, "glMaxShaderCompilerThreadsKHR");
+        else if (Has("GL_ARB_parallel_shader_compile"))
+            maxThreads = LoadFunction<MaxShaderCompilerThreadsFn>(loader, "glMaxShaderCompilerThreadsARB");
+        s_ParallelShaderCompile = maxThreads != nullptr;
+        // 0xFFFFFFFF：由驱动决定线程数
+        if (maxThreads) maxThreads(0xFFFFFFFFu);
+
+        std::cout << "[GLExtensions] " << s_Extensions.size() << " extensions, S3TC " << (s_S3TC ? "yes" : "no")
+                  << ", S3TC sRGB " << (s_S3TCsRGB ? "yes" : "no") << ", BPTC " << (s_BPTC ? "yes" : "no")
+                  << ", program binary " << (s_ProgramBinary ? "yes" : "no") << ", parallel compile "
+                  << (s_ParallelShaderCompile ? "yes" : "no") << std::endl;
+    }
+
+    bool GLExtensions::Has(const std::string& name) {
+        return s_Extensions.count(name) != 0;
+    }
+
+    bool GLExtensions::IsFormatSupported(TextureFormat format, bool useSRGB) {
+        switch (format) {
+            case TextureFormat::RGBA8: return true;
+            case TextureFormat::BC1:
+            case TextureFormat::BC3: return useSRGB ? s_S3TCsRGB : s_S3TC;
+            case TextureFormat::BC5: return true; // RGTC 自 GL 3.0 起为核心功能
+            case TextureFormat::BC7: return s_BPTC;
+        }
+        return false;
+    }
+
+    GLenum GLExtensions::GetInternalFormat(TextureFormat format, bool useSRGB) {
+        switch (format) {
+            case TextureFormat::RGBA8: return useSRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+            case TextureFormat::BC1: return useSRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureFormat::BC3: return useSRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+            case TextureFormat::BC7: return useSRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        }
+        return GL_RGBA8;
+    }
+
+    void GLExtensions::GetProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary) {
+        s_GetProgramBinaryFn(program, bufferSize, length, format, binary);
+    }
+
+    void GLExtensions::ProgramBinary(GLuint program, GLenum format, const void* binary, GLsizei length) {
+        s_ProgramBinaryFn(program, format, binary, length);
+    }
+
+    void GLExtensions::ProgramParameteri(GLuint program, GLenum name, GLint value) {
+        s_ProgramParameteriFn(program, name, value);
+    }
+
+} // namespace graphics
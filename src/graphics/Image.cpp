@@ -0,0 +1,39 @@
+#include "graphics/Image.h"
+#include "utils/VirtualFileSystem.h"
+#include <stb_image.h>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+namespace graphics {
+
+    void ImageData::PixelDeleter::operator()(unsigned char* pixels) const {
+        stbi_image_free(pixels);
+    }
+
+    ImageData ImageData::LoadFromFile(const std::string& path, int desiredChannels) {
+        ImageData image;
+        // 经虚拟文件系统读取（资源包或松散文件），在内存中解码
+        utils::FileView file = utils::VirtualFileSystem::Open(path);
+        unsigned char* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.Data()), static_cast<int>(file.Size()),
+                                                    &image.width, &image.height, &image.channels, desiredChannels);
+        if (!data)
+            throw std::runtime_error("Failed to load texture: " + path);
+        if (desiredChannels != 0) image.channels = desiredChannels;
+        image.pixels.reset(data);
+        return image;
+    }
+
+    ImageData ImageData::Allocate(int width, int height, int channels) {
+        ImageData image;
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        // stbi_image_free 默认即 free
+        image.pixels.reset(static_cast<unsigned char*>(std::malloc(image.GetByteSize())));
+        if (!image.pixels)
+            throw std::bad_alloc();
+        return image;
+    }
+
+} // namespace graphics
@@ -1,9 +1,22 @@
 #include "graphics/Mesh.h"
+#include "graphics/RenderCommand.h"
+#include "graphics/VertexQuantizer.h"
+#include <algorithm>
 
 namespace graphics {
 
+    VertexFormat Mesh::s_DefaultFormat = VertexFormat::Float;
+    Mesh::DrawStats Mesh::s_DrawStats;
+
     Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-        SetupMesh(vertices, indices);
+        SetupMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), VertexFormat::Float);
+        if (!vertices.empty())
+            m_Bounds = BoundingBox::FromPoints(&vertices[0].Position, vertices.size(), sizeof(Vertex));
+    }
+
+    Mesh::Mesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+               VertexFormat format) {
+        SetupMesh(vertices, vertexCount, indices, indexCount, format);
     }
 
     Mesh::~Mesh() {
@@ -17,6 +30,14 @@ namespace graphics {
         m_VBO = other.m_VBO;
         m_EBO = other.m_EBO;
         m_IndexCount = other.m_IndexCount;
+        m_GpuBytes = other.m_GpuBytes;
+        m_Format = other.m_Format;
+        m_DequantOffset = other.m_DequantOffset;
+        m_DequantScale = other.m_DequantScale;
+        m_Meshlets = std::move(other.m_Meshlets);
+        m_Lods = std::move(other.m_Lods);
+        m_Bounds = other.m_Bounds;
+        m_Bvh = std::move(other.m_Bvh);
         other.m_VAO = other.m_VBO = other.m_EBO = 0;
     }
 
@@ -26,13 +47,23 @@ namespace graphics {
             m_VBO = other.m_VBO;
             m_EBO = other.m_EBO;
             m_IndexCount = other.m_IndexCount;
+            m_GpuBytes = other.m_GpuBytes;
+            m_Format = other.m_Format;
+            m_DequantOffset = other.m_DequantOffset;
+            m_DequantScale = other.m_DequantScale;
+            m_Meshlets = std::move(other.m_Meshlets);
+            m_Lods = std::move(other.m_Lods);
+            m_Bounds = other.m_Bounds;
+            m_Bvh = std::move(other.m_Bvh);
             other.m_VAO = other.m_VBO = other.m_EBO = 0;
         }
         return *this;
     }
 
-    void Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-        m_IndexCount = indices.size();
+    void Mesh::SetupMesh(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount,
+                         VertexFormat format) {
+        m_IndexCount = indexCount;
+        m_Format = format;
 
         glGenVertexArrays(1, &m_VAO);
         glGenBuffers(1, &m_VBO);
@@ -41,30 +72,126 @@ namespace graphics {
         glBindVertexArray(m_VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        if (format == VertexFormat::Float) {
+            glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+            m_GpuBytes = vertexCount * sizeof(Vertex);
+        } else {
+            QuantizedVertices quantized = VertexQuantizer::Quantize(vertices, vertexCount, format);
+            glBufferData(GL_ARRAY_BUFFER, quantized.data.size(), quantized.data.data(), GL_STATIC_DRAW);
+            m_GpuBytes = quantized.data.size();
+            m_DequantOffset = quantized.offset;
+            m_DequantScale = quantized.scale;
+        }
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+        m_GpuBytes += indexCount * sizeof(unsigned int);
 
-        // layout (location = 0) : Position
+        const GLsizei stride = static_cast<GLsizei>(VertexQuantizer::GetStride(format));
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-
-        // layout (location = 1) : Normal
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-
-        // layout (location = 2) : TexCoords
         glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+        switch (format) {
+        case VertexFormat::Float:
+            // layout (location = 0) : Position
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+            // layout (location = 1) : Normal
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, Normal));
+            // layout (location = 2) : TexCoords
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, TexCoords));
+            break;
+        case VertexFormat::Compact16:
+            // 位置 unorm16x3 → [0,1]，法线 snorm16x2 → [-1,1]，UV half2
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)0);
+            glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void*)8);
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)12);
+            break;
+        case VertexFormat::Compact8:
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)0);
+            glVertexAttribPointer(1, 2, GL_BYTE, GL_TRUE, stride, (void*)6);
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)8);
+            break;
+        }
 
         glBindVertexArray(0);
     }
 
-    void Mesh::Draw() const {
+    void Mesh::SetMeshlets(const Meshlet* meshlets, size_t meshletCount) {
+        m_Meshlets.assign(meshlets, meshlets + meshletCount);
+    }
+
+    void Mesh::SetLods(const MeshLod* lods, size_t lodCount) {
+        m_Lods.assign(lods, lods + lodCount);
+    }
+
+    void Mesh::SelectLod(uint32_t& lod, uint32_t& firstIndex, size_t& indexCount) const {
+        // 未生成 LOD 时整个索引缓冲即 LOD0
+        firstIndex = 0;
+        indexCount = m_IndexCount;
+        if (!m_Lods.empty()) {
+            lod = std::min<uint32_t>(lod, static_cast<uint32_t>(m_Lods.size() - 1));
+            firstIndex = m_Lods[lod].firstIndex;
+            indexCount = m_Lods[lod].indexCount;
+        } else {
+            lod = 0;
+        }
+    }
+
+    void Mesh::Draw(const MeshletCullView* cullView, uint32_t lod) const {
+        // 常量属性不属于VAO状态，每次绘制前写入
+        const float octahedral = m_Format == VertexFormat::Float ? 0.0f : 1.0f;
+        glVertexAttrib4f(kDequantOffsetLocation, m_DequantOffset.x, m_DequantOffset.y, m_DequantOffset.z, 0.0f);
+        glVertexAttrib4f(kDequantScaleLocation, m_DequantScale.x, m_DequantScale.y, m_DequantScale.z, octahedral);
+
+        uint32_t firstIndex;
+        size_t indexCount;
+        SelectLod(lod, firstIndex, indexCount);
+
         glBindVertexArray(m_VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_IndexCount), GL_UNSIGNED_INT, 0);
+        if (lod == 0 && cullView && !m_Meshlets.empty() && MeshletCuller::IsEnabled()) {
+            // 只在GL线程绘制，剔除结果复用同一份缓冲
+            static MeshletCuller::DrawList drawList;
+            const size_t visibleBefore = MeshletCuller::GetStats().visibleTriangles;
+            MeshletCuller::Cull(m_Meshlets.data(), m_Meshlets.size(), *cullView, drawList);
+            if (!drawList.counts.empty()) {
+                glMultiDrawElements(GL_TRIANGLES, drawList.counts.data(), GL_UNSIGNED_INT, drawList.offsets.data(),
+                                    static_cast<GLsizei>(drawList.counts.size()));
+                s_DrawStats.drawCalls++;
+                s_DrawStats.triangles += MeshletCuller::GetStats().visibleTriangles - visibleBefore;
+            }
+        } else {
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT,
+                           reinterpret_cast<const void*>(static_cast<uintptr_t>(firstIndex) * sizeof(unsigned int)));
+            s_DrawStats.drawCalls++;
+            s_DrawStats.triangles += indexCount / 3;
+        }
         glBindVertexArray(0);
     }
 
+    void Mesh::Record(CommandBuffer& buffer, const MeshletCullView* cullView, uint32_t lod) const {
+        DrawCommand command{};
+        command.vao = m_VAO;
+        size_t indexCount;
+        SelectLod(lod, command.firstIndex, indexCount);
+        command.indexCount = static_cast<uint32_t>(indexCount);
+        command.triangles = static_cast<uint32_t>(indexCount / 3);
+        const float octahedral = m_Format == VertexFormat::Float ? 0.0f : 1.0f;
+        const float offset[4] = {m_DequantOffset.x, m_DequantOffset.y, m_DequantOffset.z, 0.0f};
+        const float scale[4] = {m_DequantScale.x, m_DequantScale.y, m_DequantScale.z, octahedral};
+        std::copy(std::begin(offset), std::end(offset), command.dequantOffset);
+        std::copy(std::begin(scale), std::end(scale), command.dequantScale);
+
+        if (lod == 0 && cullView && !m_Meshlets.empty() && MeshletCuller::IsEnabled()) {
+            MeshletCuller::DrawList& drawList = buffer.GetCullScratch();
+            MeshletCuller::Stats& stats = buffer.GetMeshletStats();
+            const size_t visibleBefore = stats.visibleTriangles;
+            MeshletCuller::Cull(m_Meshlets.data(), m_Meshlets.size(), *cullView, drawList, stats);
+            if (drawList.counts.empty()) return;
+            command.triangles = static_cast<uint32_t>(stats.visibleTriangles - visibleBefore);
+            buffer.Draw(command, &drawList);
+        } else {
+            buffer.Draw(command);
+        }
+    }
+
 }
@@ -0,0 +1,404 @@
+#include "graphics/MeshCache.h"
+#include "utils/Hash.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace graphics {
+
+namespace {
+
+    struct RMeshHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexStride;      ///< sizeof(Vertex)，布局变化时缓存自动失效
+        uint32_t meshCount;
+        uint32_t materialCount;
+        uint32_t dependencyCount;
+        uint64_t sourceHash;
+        float boundsMin[3];
+        float boundsMax[3];
+        uint64_t stringTableOffset;
+        uint64_t stringTableSize;
+    };
+
+    /// 字符串字段为字符串表内偏移
+    struct RMeshMaterialRecord {
+        uint32_t name;
+        uint32_t diffuse;
+        uint32_t specular;
+        uint32_t bump;
+    };
+
+    struct RMeshMeshRecord {
+        int32_t materialId;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t meshletCount;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t meshletOffset;
+        uint64_t lodOffset;
+        uint32_t lodCount;
+        uint32_t reserved;
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    /// 源文件（OBJ 及各 MTL）写入缓存时的大小与修改时间，文件不存在时为全 0
+    struct RMeshSourceRecord {
+        uint64_t size;
+        int64_t mtime;
+    };
+
+    static_assert(sizeof(RMeshHeader) == 72, "RMeshHeader layout changed");
+    static_assert(sizeof(RMeshMaterialRecord) == 16, "RMeshMaterialRecord layout changed");
+    static_assert(sizeof(RMeshMeshRecord) == 80, "RMeshMeshRecord layout changed");
+    static_assert(sizeof(RMeshSourceRecord) == 16, "RMeshSourceRecord layout changed");
+
+    constexpr size_t kBlobAlignment = 16;
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    class StringTableWriter {
+    public:
+        uint32_t Add(const std::string& str) {
+            uint32_t offset = static_cast<uint32_t>(m_Data.size());
+            uint32_t length = static_cast<uint32_t>(str.size());
+            m_Data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            m_Data.append(str);
+            return offset;
+        }
+        const std::string& Data() const { return m_Data; }
+
+    private:
+        std::string m_Data;
+    };
+
+    bool ReadString(const char* table, uint64_t tableSize, uint32_t offset, std::string& out) {
+        uint32_t length = 0;
+        if (static_cast<uint64_t>(offset) + sizeof(length) > tableSize) return false;
+        std::memcpy(&length, table + offset, sizeof(length));
+        if (static_cast<uint64_t>(offset) + sizeof(length) + length > tableSize) return false;
+        out.assign(table + offset + sizeof(length), length);
+        return true;
+    }
+
+    /**
+     * @brief 校验子网格的索引都小于顶点数，LOD 与网格簇区间都落在其索引数组内
+     * 没有 LOD 链时整个索引数组即 LOD0；有 LOD 链时 LOD0 不能为空。网格簇只引用 LOD0 的索引
+     */
+    bool ValidateRanges(const RMeshMeshRecord& record, const unsigned int* indices, const Meshlet* meshlets,
+                        const MeshLod* lods) {
+        unsigned int maxIndex = 0;
+        for (uint32_t i = 0; i < record.indexCount; ++i) maxIndex = std::max(maxIndex, indices[i]);
+        if (record.indexCount > 0 && maxIndex >= record.vertexCount) return false;
+        if (record.lodCount > 0 && record.indexCount > 0 && lods[0].indexCount == 0) return false;
+        for (uint32_t i = 0; i < record.lodCount; ++i) {
+            if (static_cast<uint64_t>(lods[i].firstIndex) + lods[i].indexCount > record.indexCount) return false;
+        }
+        const uint64_t baseCount = record.lodCount > 0 ? lods[0].firstIndex + static_cast<uint64_t>(lods[0].indexCount)
+                                                       : record.indexCount;
+        for (uint32_t i = 0; i < record.meshletCount; ++i) {
+            if (meshlets[i].firstIndex + static_cast<uint64_t>(meshlets[i].triangleCount) * 3 > baseCount) return false;
+        }
+        return true;
+    }
+
+    /// 校验文件头与各记录区、字符串表的范围
+    bool ReadHeader(const char* base, size_t size, RMeshHeader& header) {
+        if (size < sizeof(header)) return false;
+        std::memcpy(&header, base, sizeof(header));
+        if (header.magic != MeshCache::kMagic || header.version != MeshCache::kVersion ||
+            header.vertexStride != sizeof(Vertex))
+            return false;
+
+        const size_t recordsEnd = sizeof(RMeshHeader)
+                                + static_cast<size_t>(header.materialCount) * sizeof(RMeshMaterialRecord)
+                                + static_cast<size_t>(header.meshCount) * sizeof(RMeshMeshRecord)
+                                + static_cast<size_t>(header.dependencyCount) * sizeof(uint32_t)
+                                + (static_cast<size_t>(header.dependencyCount) + 1) * sizeof(RMeshSourceRecord);
+        return recordsEnd <= size && header.stringTableOffset >= recordsEnd &&
+               header.stringTableOffset <= size && header.stringTableSize <= size - header.stringTableOffset;
+    }
+
+    /// OBJ 在前，其后为各依赖，与 HashSources 的顺序一致
+    std::vector<RMeshSourceRecord> StampSources(const std::string& objPath, const std::vector<std::string>& dependencies) {
+        std::vector<RMeshSourceRecord> records;
+        auto stampFile = [&records](const std::string& path) {
+            utils::VirtualFileSystem::FileStamp stamp;
+            if (!utils::VirtualFileSystem::GetStamp(path, stamp)) stamp = {};
+            records.push_back({stamp.size, stamp.mtime});
+        };
+        stampFile(objPath);
+        const fs::path baseDir = fs::path(objPath).parent_path();
+        for (const auto& dependency : dependencies) {
+            stampFile((baseDir / dependency).string());
+        }
+        return records;
+    }
+
+    template <typename T>
+    void AppendPod(std::string& blob, const T& value) {
+        blob.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+} // namespace
+
+    std::string MeshCache::GetCachePath(const std::string& objPath) {
+        return fs::path(objPath).replace_extension(".rmesh").string();
+    }
+
+    uint64_t MeshCache::HashSources(const std::string& objPath, const std::vector<std::string>& dependencies) {
+        uint64_t hash = 0;
+        auto hashFile = [&hash](const std::string& path) {
+            if (!utils::VirtualFileSystem::Exists(path)) {
+                // 缺失的依赖也参与哈希，依赖出现后缓存随之失效
+                hash = utils::HashCombine(hash, utils::HashString(path));
+                return;
+            }
+            utils::FileView file = utils::VirtualFileSystem::Open(path);
+            hash = utils::HashCombine(hash, utils::HashBytes(file.Data(), file.Size()));
+        };
+
+        hashFile(objPath);
+        const fs::path baseDir = fs::path(objPath).parent_path();
+        for (const auto& dependency : dependencies) {
+            hashFile((baseDir / dependency).string());
+        }
+        return hash;
+    }
+
+    bool MeshCache::ReadDependencies(const std::string& cachePath, std::vector<std::string>& dependencies) {
+        dependencies.clear();
+        if (!utils::VirtualFileSystem::Exists(cachePath)) return false;
+
+        utils::FileView file = utils::VirtualFileSystem::Open(cachePath);
+        RMeshHeader header{};
+        if (!ReadHeader(file.Data(), file.Size(), header)) return false;
+
+        const char* strings = file.Data() + header.stringTableOffset;
+        const char* cursor = file.Data() + sizeof(RMeshHeader)
+                           + static_cast<size_t>(header.materialCount) * sizeof(RMeshMaterialRecord)
+                           + static_cast<size_t>(header.meshCount) * sizeof(RMeshMeshRecord);
+        dependencies.resize(header.dependencyCount);
+        for (auto& dependency : dependencies) {
+            uint32_t offset;
+            std::memcpy(&offset, cursor, sizeof(offset));
+            cursor += sizeof(offset);
+            if (!ReadString(strings, header.stringTableSize, offset, dependency)) {
+                dependencies.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MeshCache::Write(const std::string& cachePath,
+                          const std::string& objPath,
+                          const std::vector<MeshData>& meshes,
+                          const std::vector<ObjMaterial>& materials,
+                          const std::vector<std::string>& dependencies) {
+        StringTableWriter strings;
+        std::vector<RMeshMaterialRecord> materialRecords;
+        for (const auto& mat : materials) {
+            materialRecords.push_back({strings.Add(mat.name), strings.Add(mat.diffuseTexname),
+                                       strings.Add(mat.specularTexname), strings.Add(mat.bumpTexname)});
+        }
+        std::vector<uint32_t> dependencyRecords;
+        for (const auto& dependency : dependencies) dependencyRecords.push_back(strings.Add(dependency));
+
+        RMeshHeader header{};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.vertexStride = sizeof(Vertex);
+        header.meshCount = static_cast<uint32_t>(meshes.size());
+        header.materialCount = static_cast<uint32_t>(materials.size());
+        header.dependencyCount = static_cast<uint32_t>(dependencies.size());
+        // 先取大小与时间再计算哈希：两者之间源文件被修改时，下次打开因时间不符重新比对哈希
+        const std::vector<RMeshSourceRecord> sourceRecords = StampSources(objPath, dependencies);
+        header.sourceHash = HashSources(objPath, dependencies);
+
+        // 先计算各段偏移
+        size_t offset = sizeof(RMeshHeader)
+                      + materialRecords.size() * sizeof(RMeshMaterialRecord)
+                      + meshes.size() * sizeof(RMeshMeshRecord)
+                      + dependencyRecords.size() * sizeof(uint32_t)
+                      + sourceRecords.size() * sizeof(RMeshSourceRecord);
+        header.stringTableOffset = offset;
+        header.stringTableSize = strings.Data().size();
+        offset += strings.Data().size();
+
+        glm::vec3 modelMin(std::numeric_limits<float>::max());
+        glm::vec3 modelMax(std::numeric_limits<float>::lowest());
+        std::vector<RMeshMeshRecord> meshRecords;
+        for (const auto& mesh : meshes) {
+            RMeshMeshRecord record{};
+            record.materialId = mesh.materialId;
+            record.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+            record.indexCount = static_cast<uint32_t>(mesh.indices.size());
+            offset = AlignUp(offset, kBlobAlignment);
+            record.vertexOffset = offset;
+            offset += mesh.vertices.size() * sizeof(Vertex);
+            offset = AlignUp(offset, kBlobAlignment);
+            record.indexOffset = offset;
+            offset += mesh.indices.size() * sizeof(unsigned int);
+            record.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+            offset = AlignUp(offset, kBlobAlignment);
+            record.meshletOffset = offset;
+            offset += mesh.meshlets.size() * sizeof(Meshlet);
+            record.lodCount = static_cast<uint32_t>(mesh.lods.size());
+            record.lodOffset = offset;
+            offset += mesh.lods.size() * sizeof(MeshLod);
+
+            glm::vec3 bmin(std::numeric_limits<float>::max());
+            glm::vec3 bmax(std::numeric_limits<float>::lowest());
+            for (const auto& v : mesh.vertices) {
+                bmin = glm::min(bmin, v.Position);
+                bmax = glm::max(bmax, v.Position);
+            }
+            if (mesh.vertices.empty()) bmin = bmax = glm::vec3(0.0f);
+            modelMin = glm::min(modelMin, bmin);
+            modelMax = glm::max(modelMax, bmax);
+            std::memcpy(record.boundsMin, &bmin.x, sizeof(record.boundsMin));
+            std::memcpy(record.boundsMax, &bmax.x, sizeof(record.boundsMax));
+            meshRecords.push_back(record);
+        }
+        if (meshes.empty()) modelMin = modelMax = glm::vec3(0.0f);
+        std::memcpy(header.boundsMin, &modelMin.x, sizeof(header.boundsMin));
+        std::memcpy(header.boundsMax, &modelMax.x, sizeof(header.boundsMax));
+
+        // 组装完整文件内容
+        std::string blob;
+        blob.reserve(offset);
+        AppendPod(blob, header);
+        for (const auto& record : materialRecords) AppendPod(blob, record);
+        for (const auto& record : meshRecords) AppendPod(blob, record);
+        for (uint32_t record : dependencyRecords) AppendPod(blob, record);
+        for (const auto& record : sourceRecords) AppendPod(blob, record);
+        blob += strings.Data();
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            blob.resize(meshRecords[i].vertexOffset, '\0');
+            blob.append(reinterpret_cast<const char*>(meshes[i].vertices.data()), meshes[i].vertices.size() * sizeof(Vertex));
+            blob.resize(meshRecords[i].indexOffset, '\0');
+            blob.append(reinterpret_cast<const char*>(meshes[i].indices.data()), meshes[i].indices.size() * sizeof(unsigned int));
+            blob.resize(meshRecords[i].meshletOffset, '\0');
+            blob.append(reinterpret_cast<const char*>(meshes[i].meshlets.data()), meshes[i].meshlets.size() * sizeof(Meshlet));
+            blob.append(reinterpret_cast<const char*>(meshes[i].lods.data()), meshes[i].lods.size() * sizeof(MeshLod));
+        }
+
+        const std::string tempPath = cachePath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Failed to create mesh cache: " + tempPath);
+            file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            if (!file)
+                throw std::runtime_error("Failed to write mesh cache: " + tempPath);
+        }
+        std::error_code ec;
+        fs::rename(tempPath, cachePath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Failed to replace mesh cache: " + cachePath);
+        }
+    }
+
+    bool MeshCache::Open(const std::string& cachePath, const std::string& objPath) {
+        m_Meshes.clear();
+        m_Materials.clear();
+        if (!utils::VirtualFileSystem::Exists(cachePath)) return false;
+
+        m_File = utils::VirtualFileSystem::Open(cachePath);
+        const char* base = m_File.Data();
+        const size_t size = m_File.Size();
+
+        RMeshHeader header{};
+        if (!ReadHeader(base, size, header)) return false;
+
+        const char* strings = base + header.stringTableOffset;
+        const char* cursor = base + sizeof(RMeshHeader);
+
+        std::vector<ObjMaterial> materials(header.materialCount);
+        for (auto& mat : materials) {
+            RMeshMaterialRecord record;
+            std::memcpy(&record, cursor, sizeof(record));
+            cursor += sizeof(record);
+            if (!ReadString(strings, header.stringTableSize, record.name, mat.name) ||
+                !ReadString(strings, header.stringTableSize, record.diffuse, mat.diffuseTexname) ||
+                !ReadString(strings, header.stringTableSize, record.specular, mat.specularTexname) ||
+                !ReadString(strings, header.stringTableSize, record.bump, mat.bumpTexname))
+                return false;
+        }
+
+        std::vector<MeshView> meshes(header.meshCount);
+        for (auto& view : meshes) {
+            RMeshMeshRecord record;
+            std::memcpy(&record, cursor, sizeof(record));
+            cursor += sizeof(record);
+
+            const uint64_t vertexBytes = static_cast<uint64_t>(record.vertexCount) * sizeof(Vertex);
+            const uint64_t indexBytes = static_cast<uint64_t>(record.indexCount) * sizeof(unsigned int);
+            const uint64_t meshletBytes = static_cast<uint64_t>(record.meshletCount) * sizeof(Meshlet);
+            const uint64_t lodBytes = static_cast<uint64_t>(record.lodCount) * sizeof(MeshLod);
+            if (record.vertexOffset % alignof(Vertex) != 0 || record.indexOffset % alignof(unsigned int) != 0 ||
+                record.meshletOffset % alignof(Meshlet) != 0 || record.lodOffset % alignof(MeshLod) != 0 ||
+                record.vertexOffset > size || vertexBytes > size - record.vertexOffset ||
+                record.indexOffset > size || indexBytes > size - record.indexOffset ||
+                record.meshletOffset > size || meshletBytes > size - record.meshletOffset ||
+                record.lodOffset > size || lodBytes > size - record.lodOffset)
+                return false;
+            if (!ValidateRanges(record, reinterpret_cast<const unsigned int*>(base + record.indexOffset),
+                                reinterpret_cast<const Meshlet*>(base + record.meshletOffset),
+                                reinterpret_cast<const MeshLod*>(base + record.lodOffset)))
+                return false;
+
+            view.materialId = record.materialId;
+            view.vertices = reinterpret_cast<const Vertex*>(base + record.vertexOffset);
+            view.vertexCount = record.vertexCount;
+            view.indices = reinterpret_cast<const unsigned int*>(base + record.indexOffset);
+            view.indexCount = record.indexCount;
+            view.meshlets = reinterpret_cast<const Meshlet*>(base + record.meshletOffset);
+            view.meshletCount = record.meshletCount;
+            view.lods = reinterpret_cast<const MeshLod*>(base + record.lodOffset);
+            view.lodCount = record.lodCount;
+            view.boundsMin = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+            view.boundsMax = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+        }
+
+        std::vector<std::string> dependencies(header.dependencyCount);
+        for (auto& dependency : dependencies) {
+            uint32_t offset;
+            std::memcpy(&offset, cursor, sizeof(offset));
+            cursor += sizeof(offset);
+            if (!ReadString(strings, header.stringTableSize, offset, dependency)) return false;
+        }
+
+        // 源OBJ不存在时（仅随发布包提供缓存）直接信任缓存；
+        // 各源文件大小与修改时间都未变时不必读取源文件，否则再比对内容哈希（只改了时间的仍可使用）
+        if (utils::VirtualFileSystem::Exists(objPath)) {
+            const std::vector<RMeshSourceRecord> current = StampSources(objPath, dependencies);
+            const size_t stampBytes = current.size() * sizeof(RMeshSourceRecord);
+            if (std::memcmp(current.data(), cursor, stampBytes) != 0) {
+                if (HashSources(objPath, dependencies) != header.sourceHash) return false;
+                // 内容未变：改写记录的大小与时间，下次打开不必再计算哈希（失败时仅下次仍需比对）
+                utils::VirtualFileSystem::PatchLooseFile(cachePath, static_cast<uint64_t>(cursor - base),
+                                                         current.data(), stampBytes);
+            }
+        }
+
+        m_Meshes = std::move(meshes);
+        m_Materials = std::move(materials);
+        m_BoundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+        m_BoundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+        return true;
+    }
+
+} // namespace graphics
@@ -0,0 +1,299 @@
+#include "graphics/MeshOptimizer.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace graphics {
+
+namespace {
+
+    // Forsyth 评分参数（原文推荐值）
+    constexpr int kCacheSize = 32;
+    constexpr int kMaxValence = 64;
+    constexpr float kLastTriScore = 0.75f;
+    constexpr float kCacheDecayPower = 1.5f;
+    constexpr float kValenceBoostScale = 2.0f;
+    constexpr float kValenceBoostPower = 0.5f;
+
+    struct ScoreTable {
+        float cache[kCacheSize];
+        float valence[kMaxValence];
+
+        ScoreTable() {
+            for (int i = 0; i < kCacheSize; ++i) {
+                // 最近一个三角形的三个顶点得分固定，避免偏向刚用过的边
+                cache[i] = i < 3 ? kLastTriScore
+                                 : std::pow(1.0f - static_cast<float>(i - 3) / (kCacheSize - 3), kCacheDecayPower);
+            }
+            valence[0] = 0.0f;
+            for (int i = 1; i < kMaxValence; ++i)
+                valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+    };
+
+    const ScoreTable& GetScoreTable() {
+        static const ScoreTable table;
+        return table;
+    }
+
+    inline float VertexScore(int cachePosition, unsigned int remaining) {
+        if (remaining == 0) return -1.0f;
+        const ScoreTable& table = GetScoreTable();
+        float score = cachePosition >= 0 ? table.cache[cachePosition] : 0.0f;
+        return score + table.valence[std::min<unsigned int>(remaining, kMaxValence - 1)];
+    }
+
+    /// FIFO 缓存模拟，用时间戳判断是否仍在缓存中
+    class FifoCache {
+    public:
+        FifoCache(size_t vertexCount, unsigned int size) : m_Timestamps(vertexCount, 0), m_Time(size), m_Size(size) {}
+
+        /// 返回三角形的未命中数
+        unsigned int Access(const unsigned int* tri) {
+            unsigned int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (m_Time - m_Timestamps[tri[k]] >= m_Size) {
+                    m_Timestamps[tri[k]] = ++m_Time;
+                    ++misses;
+                }
+            }
+            return misses;
+        }
+
+        /// 清空缓存
+        void Flush() { m_Time += m_Size; }
+
+    private:
+        std::vector<uint64_t> m_Timestamps;
+        uint64_t m_Time = 0;
+        uint64_t m_Size;
+    };
+
+} // namespace
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+        const size_t triCount = indices.size() / 3;
+        if (triCount == 0) return;
+
+        // 顶点 -> 三角形邻接表，前 remaining[v] 项为尚未输出的三角形
+        std::vector<unsigned int> remaining(vertexCount, 0);
+        for (unsigned int v : indices) ++remaining[v];
+        std::vector<size_t> adjacencyOffset(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+        std::vector<unsigned int> adjacency(indices.size());
+        {
+            std::vector<size_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = VertexScore(-1, remaining[v]);
+
+        std::vector<float> triScore(triCount);
+        std::vector<char> emitted(triCount, 0);
+        for (size_t t = 0; t < triCount; ++t)
+            triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        unsigned int cache[kCacheSize + 3];
+        int cacheCount = 0;
+
+        size_t best = std::max_element(triScore.begin(), triScore.end()) - triScore.begin();
+        size_t scanCursor = 0;
+        for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount) {
+            if (best == SIZE_MAX) {
+                // 缓存内已无可用三角形：顺序找下一个未输出的三角形
+                while (emitted[scanCursor]) ++scanCursor;
+                best = scanCursor;
+            }
+
+            const unsigned int* tri = &indices[best * 3];
+            output.insert(output.end(), tri, tri + 3);
+            emitted[best] = 1;
+
+            // 从三个顶点的未输出列表中移除该三角形
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int v = tri[k];
+                unsigned int* list = &adjacency[adjacencyOffset[v]];
+                unsigned int* last = list + remaining[v] - 1;
+                std::swap(*std::find(list, last + 1, static_cast<unsigned int>(best)), *last);
+                --remaining[v];
+            }
+
+            // 新三角形的顶点移到 LRU 缓存最前
+            unsigned int newCache[kCacheSize + 3];
+            int newCount = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (std::find(newCache, newCache + newCount, tri[k]) == newCache + newCount) newCache[newCount++] = tri[k];
+            }
+            for (int i = 0; i < cacheCount; ++i) {
+                const unsigned int v = cache[i];
+                if (v != tri[0] && v != tri[1] && v != tri[2]) newCache[newCount++] = v;
+            }
+
+            // 更新缓存内（及刚被挤出）顶点的得分
+            for (int i = 0; i < newCount; ++i) {
+                const unsigned int v = newCache[i];
+                cachePosition[v] = i < kCacheSize ? i : -1;
+                vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+            }
+
+            // 只在受影响的三角形中选下一个
+            best = SIZE_MAX;
+            float bestScore = 0.0f;
+            for (int i = 0; i < newCount; ++i) {
+                const unsigned int v = newCache[i];
+                const unsigned int* list = &adjacency[adjacencyOffset[v]];
+                for (unsigned int j = 0; j < remaining[v]; ++j) {
+                    const unsigned int t = list[j];
+                    const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                    triScore[t] = score;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+            }
+
+            cacheCount = std::min(newCount, kCacheSize);
+            std::copy(newCache, newCache + cacheCount, cache);
+        }
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                                         float threshold) {
+        const size_t triCount = indices.size() / 3;
+        if (triCount < 2) return;
+
+        // 1. 硬边界：三个顶点全部未命中的位置（缓存优化后的自然断点）
+        std::vector<size_t> hardClusters;
+        {
+            FifoCache cache(vertices.size(), kAnalyzeCacheSize);
+            for (size_t t = 0; t < triCount; ++t) {
+                if (cache.Access(&indices[t * 3]) == 3) hardClusters.push_back(t);
+            }
+        }
+        if (hardClusters.empty() || hardClusters.front() != 0) hardClusters.insert(hardClusters.begin(), 0);
+        hardClusters.push_back(triCount);
+
+        // 2. 软边界：子簇的 ACMR 不超过所在硬簇 ACMR 的 threshold 倍时即可切分
+        std::vector<size_t> clusters;
+        FifoCache cache(vertices.size(), kAnalyzeCacheSize);
+        for (size_t c = 0; c + 1 < hardClusters.size(); ++c) {
+            const size_t start = hardClusters[c], end = hardClusters[c + 1];
+            cache.Flush();
+            size_t totalMisses = 0;
+            for (size_t t = start; t < end; ++t) totalMisses += cache.Access(&indices[t * 3]);
+            const float limit = threshold * static_cast<float>(totalMisses) / static_cast<float>(end - start);
+
+            cache.Flush();
+            clusters.push_back(start);
+            size_t subStart = start, subMisses = 0;
+            for (size_t t = start; t < end; ++t) {
+                subMisses += cache.Access(&indices[t * 3]);
+                if (t + 1 < end && static_cast<float>(subMisses) / static_cast<float>(t + 1 - subStart) <= limit) {
+                    // 子簇从冷缓存开始计算，保证切分后每个子簇自身的 ACMR 仍在阈值内
+                    clusters.push_back(t + 1);
+                    cache.Flush();
+                    subStart = t + 1;
+                    subMisses = 0;
+                }
+            }
+        }
+        clusters.push_back(triCount);
+
+        // 3. 簇排序键：簇中心相对网格中心沿簇平均法线的距离，越朝外越先绘制
+        glm::dvec3 meshCenter(0.0);
+        double meshArea = 0.0;
+        std::vector<glm::vec3> clusterCenter(clusters.size() - 1), clusterNormal(clusters.size() - 1);
+        for (size_t c = 0; c + 1 < clusters.size(); ++c) {
+            glm::dvec3 center(0.0), normal(0.0);
+            double area = 0.0;
+            for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+                const glm::vec3& a = vertices[indices[t * 3]].Position;
+                const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+                const glm::vec3& d = vertices[indices[t * 3 + 2]].Position;
+                const glm::vec3 cross = glm::cross(b - a, d - a);
+                const double triArea = glm::length(cross) * 0.5;
+                center += glm::dvec3((a + b + d) / 3.0f) * triArea;
+                normal += glm::dvec3(cross);
+                area += triArea;
+            }
+            meshCenter += center;
+            meshArea += area;
+            clusterCenter[c] = area > 0.0 ? glm::vec3(center / area) : vertices[indices[clusters[c] * 3]].Position;
+            const double length = glm::length(normal);
+            clusterNormal[c] = length > 0.0 ? glm::vec3(normal / length) : glm::vec3(0.0f);
+        }
+        const glm::vec3 center = meshArea > 0.0 ? glm::vec3(meshCenter / meshArea) : glm::vec3(0.0f);
+
+        std::vector<float> sortKey(clusterCenter.size());
+        for (size_t c = 0; c < sortKey.size(); ++c) sortKey[c] = glm::dot(clusterCenter[c] - center, clusterNormal[c]);
+        std::vector<size_t> order(sortKey.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&sortKey](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        for (size_t c : order)
+            output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+        constexpr unsigned int kUnmapped = ~0u;
+        std::vector<unsigned int> remap(vertices.size(), kUnmapped);
+        std::vector<Vertex> reordered;
+        reordered.reserve(vertices.size());
+        for (unsigned int& index : indices) {
+            if (remap[index] == kUnmapped) {
+                remap[index] = static_cast<unsigned int>(reordered.size());
+                reordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        vertices.swap(reordered);
+    }
+
+    void MeshOptimizer::Optimize(MeshData& mesh) {
+        OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+        OptimizeOverdraw(mesh.indices, mesh.vertices);
+        OptimizeVertexFetch(mesh.vertices, mesh.indices);
+    }
+
+    void MeshOptimizer::OptimizeMeshes(std::vector<MeshData>& meshes, unsigned int threadCount) {
+        const size_t count = meshes.size();
+        core::JobSystem::ParallelFor(count, [&meshes](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) Optimize(meshes[i]);
+        }, threadCount == 1 ? count : 1);
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+                                                        unsigned int cacheSize) {
+        VertexCacheStats stats;
+        const size_t triCount = indexCount / 3;
+        if (triCount == 0) return stats;
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<char> referenced(vertexCount, 0);
+        size_t misses = 0, uniqueVertices = 0;
+        for (size_t t = 0; t < triCount; ++t) {
+            misses += cache.Access(indices + t * 3);
+            for (int k = 0; k < 3; ++k) {
+                if (!referenced[indices[t * 3 + k]]) {
+                    referenced[indices[t * 3 + k]] = 1;
+                    ++uniqueVertices;
+                }
+            }
+        }
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(triCount);
+        stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+        return stats;
+    }
+
+} // namespace graphics
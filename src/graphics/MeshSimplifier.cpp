@@ -0,0 +1,331 @@
+#include "graphics/MeshSimplifier.h"
+#include "graphics/MeshOptimizer.h"
+#include "core/JobSystem.h"
+#include "utils/Hash.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace graphics {
+
+namespace {
+
+    // 边界约束平面相对三角形平面的权重
+    constexpr double kBorderWeight = 10.0;
+
+    // 折叠后三角形法线与原法线夹角余弦的下限，低于此值视为翻转
+    constexpr float kMinNormalDot = 0.25f;
+
+    enum class VertexKind : uint8_t {
+        Manifold, ///< 内部顶点，可向任意邻点折叠
+        Border,   ///< 开放边上的顶点，只能沿边界折叠
+        Locked    ///< 接缝或非流形顶点，不可移动
+    };
+
+    /// 对称 4x4 矩阵形式的二次误差，w 为累计权重（面积）
+    struct Quadric {
+        double a2 = 0, ab = 0, ac = 0, ad = 0;
+        double b2 = 0, bc = 0, bd = 0;
+        double c2 = 0, cd = 0;
+        double d2 = 0;
+        double w = 0;
+
+        static Quadric FromPlane(const glm::dvec3& n, double d, double weight) {
+            Quadric q;
+            q.a2 = n.x * n.x * weight; q.ab = n.x * n.y * weight; q.ac = n.x * n.z * weight; q.ad = n.x * d * weight;
+            q.b2 = n.y * n.y * weight; q.bc = n.y * n.z * weight; q.bd = n.y * d * weight;
+            q.c2 = n.z * n.z * weight; q.cd = n.z * d * weight;
+            q.d2 = d * d * weight;
+            q.w = weight;
+            return q;
+        }
+
+        void Add(const Quadric& o) {
+            a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+            b2 += o.b2; bc += o.bc; bd += o.bd;
+            c2 += o.c2; cd += o.cd;
+            d2 += o.d2;
+            w += o.w;
+        }
+
+        /// 到各平面的加权平均平方距离
+        double Error(const glm::vec3& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            const double e = a2 * x * x + b2 * y * y + c2 * z * z + 2.0 * (ab * x * y + ac * x * z + bc * y * z) +
+                             2.0 * (ad * x + bd * y + cd * z) + d2;
+            return w > 0.0 ? std::max(e, 0.0) / w : 0.0;
+        }
+    };
+
+    struct PositionKey {
+        glm::vec3 position;
+        bool operator==(const PositionKey& other) const { return position == other.position; }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            return static_cast<size_t>(utils::HashBytes(&key.position, sizeof(key.position)));
+        }
+    };
+
+    uint64_t EdgeKey(unsigned int a, unsigned int b) {
+        if (a > b) std::swap(a, b);
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    struct Collapse {
+        unsigned int from; ///< 位置编号
+        unsigned int to;
+        double error;
+    };
+
+} // namespace
+
+    std::vector<unsigned int> MeshSimplifier::Simplify(const Vertex* vertices, size_t vertexCount,
+                                                       const unsigned int* indices, size_t indexCount,
+                                                       size_t targetIndexCount, float maxError, float* resultError) {
+        std::vector<unsigned int> result(indices, indices + indexCount);
+        if (resultError) *resultError = 0.0f;
+        if (vertexCount == 0 || indexCount <= targetIndexCount) return result;
+
+        // 位置焊接：position[v] 为同一位置第一个顶点的编号
+        std::vector<unsigned int> position(vertexCount);
+        std::vector<unsigned int> wedgeCount(vertexCount, 0);
+        {
+            std::unordered_map<PositionKey, unsigned int, PositionKeyHash> firstByPosition;
+            firstByPosition.reserve(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                position[v] = firstByPosition.emplace(PositionKey{vertices[v].Position}, static_cast<unsigned int>(v))
+                                  .first->second;
+            }
+            std::vector<char> counted(vertexCount, 0);
+            for (size_t i = 0; i < indexCount; ++i) {
+                const unsigned int v = indices[i];
+                if (!counted[v]) {
+                    counted[v] = 1;
+                    ++wedgeCount[position[v]];
+                }
+            }
+        }
+
+        // 每个位置的误差二次型：三角形平面按面积加权
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i + 2 < indexCount; i += 3) {
+            const glm::dvec3 a(vertices[indices[i]].Position);
+            const glm::dvec3 b(vertices[indices[i + 1]].Position);
+            const glm::dvec3 c(vertices[indices[i + 2]].Position);
+            const glm::dvec3 n = glm::cross(b - a, c - a);
+            const double length = glm::length(n);
+            if (length <= 0.0) continue;
+            const glm::dvec3 unit = n / length;
+            const Quadric q = Quadric::FromPlane(unit, -glm::dot(unit, a), 0.5 * length);
+            for (int k = 0; k < 3; ++k) quadrics[position[indices[i + k]]].Add(q);
+        }
+
+        std::vector<VertexKind> kind(vertexCount);
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        std::vector<uint32_t> adjacencyOffset(vertexCount + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<char> touched(vertexCount);
+        std::vector<unsigned int> collapseTo(vertexCount);
+        std::vector<unsigned int> wedgeRemap(vertexCount);
+        std::vector<Collapse> candidates;
+        double maxErrorSquared = static_cast<double>(maxError) * maxError;
+        double worstError = 0.0;
+        bool bordersQuadricsAdded = false;
+
+        while (result.size() > targetIndexCount) {
+            const size_t triangleCount = result.size() / 3;
+
+            // 统计每条（焊接后的）边被多少个三角形使用，1 为边界，>2 为非流形
+            edgeUse.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int a = position[result[i + k]], b = position[result[i + (k + 1) % 3]];
+                    ++edgeUse[EdgeKey(a, b)];
+                }
+            }
+            std::fill(kind.begin(), kind.end(), VertexKind::Manifold);
+            for (size_t p = 0; p < vertexCount; ++p) {
+                if (wedgeCount[p] > 1) kind[p] = VertexKind::Locked;
+            }
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int a = position[result[i + k]], b = position[result[i + (k + 1) % 3]];
+                    const uint32_t use = edgeUse[EdgeKey(a, b)];
+                    for (unsigned int p : {a, b}) {
+                        if (use > 2) kind[p] = VertexKind::Locked;
+                        else if (use == 1 && kind[p] == VertexKind::Manifold) kind[p] = VertexKind::Border;
+                    }
+                    // 边界边加入垂直于三角形的约束平面（只在首轮加入一次）
+                    if (use == 1 && !bordersQuadricsAdded) {
+                        const glm::dvec3 pa(vertices[a].Position), pb(vertices[b].Position);
+                        const glm::dvec3 pc(vertices[result[i + (k + 2) % 3]].Position);
+                        const glm::dvec3 edge = pb - pa;
+                        const glm::dvec3 normal = glm::cross(edge, pc - pa);
+                        const glm::dvec3 perpendicular = glm::cross(edge, normal);
+                        const double length = glm::length(perpendicular);
+                        if (length > 0.0) {
+                            const glm::dvec3 unit = perpendicular / length;
+                            const Quadric q = Quadric::FromPlane(unit, -glm::dot(unit, pa),
+                                                                 kBorderWeight * glm::dot(edge, edge));
+                            quadrics[a].Add(q);
+                            quadrics[b].Add(q);
+                        }
+                    }
+                }
+            }
+            bordersQuadricsAdded = true;
+
+            // 位置 → 三角形邻接
+            std::fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0);
+            for (unsigned int index : result) ++adjacencyOffset[position[index] + 1];
+            for (size_t p = 0; p < vertexCount; ++p) adjacencyOffset[p + 1] += adjacencyOffset[p];
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i)
+                    adjacency[fill[position[result[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+
+            // 收集所有合法的半边折叠并按误差排序
+            candidates.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int a = position[result[i + k]], b = position[result[i + (k + 1) % 3]];
+                    const bool borderEdge = edgeUse[EdgeKey(a, b)] == 1;
+                    for (int dir = 0; dir < 2; ++dir) {
+                        const unsigned int from = dir == 0 ? a : b, to = dir == 0 ? b : a;
+                        if (kind[from] == VertexKind::Locked) continue;
+                        if (kind[from] == VertexKind::Border && !borderEdge) continue;
+                        Quadric q = quadrics[from];
+                        q.Add(quadrics[to]);
+                        candidates.push_back({from, to, q.Error(vertices[to].Position)});
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const Collapse& l, const Collapse& r) { return l.error < r.error; });
+
+            // 同一轮内被修改过的顶点及其一环邻域不再参与折叠，保证翻转检测基于最新拓扑
+            std::fill(touched.begin(), touched.end(), 0);
+            for (size_t p = 0; p < vertexCount; ++p) collapseTo[p] = static_cast<unsigned int>(p);
+            size_t remainingTriangles = triangleCount;
+            const size_t targetTriangles = targetIndexCount / 3;
+            size_t collapses = 0;
+            for (const Collapse& c : candidates) {
+                if (remainingTriangles <= targetTriangles) break;
+                if (c.error > maxErrorSquared) break;
+                if (touched[c.from] || touched[c.to]) continue;
+
+                // 翻转检测：from 周围不含 to 的三角形在折叠前后法线方向不能大幅改变
+                const glm::vec3& target = vertices[c.to].Position;
+                bool flips = false;
+                size_t removed = 0;
+                for (uint32_t a = adjacencyOffset[c.from]; a < adjacencyOffset[c.from + 1] && !flips; ++a) {
+                    const unsigned int* tri = result.data() + adjacency[a] * 3;
+                    glm::vec3 p[3];
+                    bool containsTo = false;
+                    int fromSlot = 0;
+                    for (int k = 0; k < 3; ++k) {
+                        const unsigned int pos = position[tri[k]];
+                        containsTo = containsTo || pos == c.to;
+                        if (pos == c.from) fromSlot = k;
+                        p[k] = vertices[tri[k]].Position;
+                    }
+                    if (containsTo) {
+                        ++removed;
+                        continue;
+                    }
+                    const glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    p[fromSlot] = target;
+                    const glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    const float lengths = glm::length(before) * glm::length(after);
+                    flips = lengths <= 0.0f || glm::dot(before, after) < kMinNormalDot * lengths;
+                }
+                if (flips) continue;
+
+                collapseTo[c.from] = c.to;
+                quadrics[c.to].Add(quadrics[c.from]);
+                worstError = std::max(worstError, c.error);
+                remainingTriangles -= std::min(removed, remainingTriangles);
+                ++collapses;
+                for (unsigned int p : {c.from, c.to}) {
+                    for (uint32_t a = adjacencyOffset[p]; a < adjacencyOffset[p + 1]; ++a) {
+                        const unsigned int* tri = result.data() + adjacency[a] * 3;
+                        for (int k = 0; k < 3; ++k) touched[position[tri[k]]] = 1;
+                    }
+                }
+            }
+            if (collapses == 0) break;
+
+            // 被折叠位置只有一个顶点（非接缝），映射到共享边的三角形中目标位置所用的顶点
+            for (size_t v = 0; v < vertexCount; ++v) wedgeRemap[v] = static_cast<unsigned int>(v);
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int from = result[i + k];
+                    const unsigned int to = collapseTo[position[from]];
+                    if (to == position[from]) continue;
+                    for (int j = 0; j < 3; ++j) {
+                        if (position[result[i + j]] == to) wedgeRemap[from] = result[i + j];
+                    }
+                }
+            }
+
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3) {
+                const unsigned int a = wedgeRemap[result[i]], b = wedgeRemap[result[i + 1]], c = wedgeRemap[result[i + 2]];
+                if (position[a] == position[b] || position[b] == position[c] || position[a] == position[c]) continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (resultError) *resultError = static_cast<float>(std::sqrt(worstError));
+        return result;
+    }
+
+    void MeshSimplifier::GenerateLods(MeshData& mesh, const LodOptions& options) {
+        mesh.lods.clear();
+        if (mesh.vertices.empty() || mesh.indices.empty()) return;
+
+        const uint32_t baseCount = static_cast<uint32_t>(mesh.indices.size());
+        mesh.lods.push_back({0, baseCount, 0.0f, 0});
+
+        glm::vec3 boundsMin(mesh.vertices[0].Position), boundsMax(boundsMin);
+        for (const auto& v : mesh.vertices) {
+            boundsMin = glm::min(boundsMin, v.Position);
+            boundsMax = glm::max(boundsMax, v.Position);
+        }
+        const float maxError = options.maxError * glm::length(boundsMax - boundsMin);
+
+        // 各级都从 LOD0 简化，误差始终相对原始网格
+        const std::vector<unsigned int> base(mesh.indices.begin(), mesh.indices.end());
+        float target = static_cast<float>(baseCount);
+        for (uint32_t level = 1; level < options.levelCount; ++level) {
+            target *= options.ratio;
+            const size_t targetIndexCount = static_cast<size_t>(target / 3.0f) * 3;
+            float error = 0.0f;
+            std::vector<unsigned int> lod = Simplify(mesh.vertices.data(), mesh.vertices.size(), base.data(),
+                                                     base.size(), targetIndexCount, maxError, &error);
+            const MeshLod& previous = mesh.lods.back();
+            if (lod.empty() || lod.size() > previous.indexCount * (1.0f - options.minReduction)) break;
+
+            MeshOptimizer::OptimizeVertexCache(lod, mesh.vertices.size());
+            mesh.lods.push_back({static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(lod.size()),
+                                 std::max(error, previous.error), 0});
+            mesh.indices.insert(mesh.indices.end(), lod.begin(), lod.end());
+        }
+    }
+
+    void MeshSimplifier::GenerateLods(std::vector<MeshData>& meshes, unsigned int threadCount,
+                                      const LodOptions& options) {
+        const size_t count = meshes.size();
+        core::JobSystem::ParallelFor(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) GenerateLods(meshes[i], options);
+        }, threadCount == 1 ? count : 1);
+    }
+
+} // namespace graphics
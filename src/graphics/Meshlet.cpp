@@ -0,0 +1,357 @@
+#include "graphics/Meshlet.h"
+#include "graphics/Camera.h"
+#include "graphics/Frustum.h"
+#include "graphics/ObjParser.h"
+#include "graphics/MeshOptimizer.h"
+#include "core/JobSystem.h"
+#include "utils/Hash.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+namespace graphics {
+
+namespace {
+
+    // 选取三角形时法线偏差相对距离的权重，越大簇越平、背面剔除率越高，但簇越不紧凑
+    constexpr float kConeWeight = 0.5f;
+
+    // 法线锥最小夹角余弦低于此值时（张角约 84° 以上）几乎不可能整体背向，不再生成锥
+    constexpr float kMinConeDot = 0.1f;
+
+    // 根据簇内三角形计算包围球与法线锥
+    void FinishMeshlet(Meshlet& meshlet, const Vertex* vertices, const unsigned int* indices,
+                       const std::vector<unsigned int>& meshletVertices) {
+        glm::vec3 boundsMin(vertices[meshletVertices[0]].Position);
+        glm::vec3 boundsMax(boundsMin);
+        for (unsigned int v : meshletVertices) {
+            boundsMin = glm::min(boundsMin, vertices[v].Position);
+            boundsMax = glm::max(boundsMax, vertices[v].Position);
+        }
+        meshlet.center = 0.5f * (boundsMin + boundsMax);
+        float radiusSquared = 0.0f;
+        for (unsigned int v : meshletVertices) {
+            const glm::vec3 d = vertices[v].Position - meshlet.center;
+            radiusSquared = std::max(radiusSquared, glm::dot(d, d));
+        }
+        meshlet.radius = std::sqrt(radiusSquared);
+
+        // 逆时针为正面，面法线 = (b - a) × (c - a)
+        const unsigned int* tri = indices + meshlet.firstIndex;
+        glm::vec3 normals[MeshletBuilder::kMaxTriangles];
+        uint32_t normalCount = 0;
+        glm::vec3 axis(0.0f);
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t, tri += 3) {
+            const glm::vec3& a = vertices[tri[0]].Position;
+            const glm::vec3 n = glm::cross(vertices[tri[1]].Position - a, vertices[tri[2]].Position - a);
+            const float length = glm::length(n);
+            if (length <= 0.0f) continue; // 退化三角形不可见，不影响锥
+            normals[normalCount] = n / length;
+            axis += normals[normalCount++];
+        }
+
+        meshlet.coneAxis = glm::vec3(0.0f);
+        meshlet.coneCutoff = 1.0f;
+        const float axisLength = glm::length(axis);
+        if (normalCount == 0 || axisLength <= 0.0f) return;
+        axis /= axisLength;
+        float minDot = 1.0f;
+        for (uint32_t i = 0; i < normalCount; ++i) minDot = std::min(minDot, glm::dot(axis, normals[i]));
+        if (minDot <= kMinConeDot) return;
+        meshlet.coneAxis = axis;
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    struct PositionKey {
+        glm::vec3 position;
+        bool operator==(const PositionKey& other) const { return position == other.position; }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            return static_cast<size_t>(utils::HashBytes(&key.position, sizeof(key.position)));
+        }
+    };
+
+} // namespace
+
+    bool MeshletCuller::s_Enabled = true;
+    bool MeshletCuller::s_BackfaceCulling = true;
+    MeshletCuller::Stats MeshletCuller::s_Stats;
+
+    MeshletCullView MeshletCullView::Create(const glm::mat4& viewProjection, const glm::mat4& model,
+                                            const glm::vec3& cameraPosition, const glm::vec3& cameraFront,
+                                            bool orthographic) {
+        MeshletCullView view;
+        // 由 MVP 直接提取模型空间中的裁剪平面
+        const Frustum frustum = Frustum::FromMatrix(viewProjection * model);
+        std::copy(std::begin(frustum.planes), std::end(frustum.planes), view.planes);
+
+        const glm::mat4 inverseModel = glm::inverse(model);
+        view.cameraPosition = glm::vec3(inverseModel * glm::vec4(cameraPosition, 1.0f));
+        // 方向变换到模型空间后与模型空间法线的点积符号和世界空间一致
+        const glm::vec3 direction = glm::vec3(inverseModel * glm::vec4(cameraFront, 0.0f));
+        view.viewDirection = glm::length(direction) > 0.0f ? glm::normalize(direction) : direction;
+        view.orthographic = orthographic;
+        return view;
+    }
+
+    MeshletCullView MeshletCullView::Create(const Camera& camera, const glm::mat4& model) {
+        return Create(camera.GetProjectionMatrix() * camera.GetViewMatrix(), model, camera.GetPosition(),
+                      camera.GetFront(), camera.GetProjectionType() == Camera::ProjectionType::Orthographic);
+    }
+
+    std::vector<Meshlet> MeshletBuilder::Build(const Vertex* vertices, size_t vertexCount,
+                                               std::vector<unsigned int>& indices) {
+        std::vector<Meshlet> meshlets;
+        const size_t triangleCount = indices.size() / 3;
+        if (vertexCount == 0 || triangleCount == 0) return meshlets;
+
+        // 按位置焊接顶点建立邻接：UV 接缝处拆分的顶点也视为相连
+        std::vector<unsigned int> weld(vertexCount);
+        {
+            std::unordered_map<PositionKey, unsigned int, PositionKeyHash> firstByPosition;
+            firstByPosition.reserve(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                weld[v] = firstByPosition.emplace(PositionKey{vertices[v].Position}, static_cast<unsigned int>(v))
+                              .first->second;
+            }
+        }
+        std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+        for (unsigned int index : indices) ++adjacencyOffset[weld[index] + 1];
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffset[v + 1] += adjacencyOffset[v];
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) adjacency[fill[weld[indices[i]]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        // 三角形质心与单位法线
+        std::vector<glm::vec3> centroids(triangleCount), normals(triangleCount);
+        double totalArea = 0.0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const glm::vec3& a = vertices[indices[t * 3]].Position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3& c = vertices[indices[t * 3 + 2]].Position;
+            centroids[t] = (a + b + c) / 3.0f;
+            const glm::vec3 n = glm::cross(b - a, c - a);
+            const float length = glm::length(n);
+            normals[t] = length > 0.0f ? n / length : glm::vec3(0.0f);
+            totalArea += 0.5 * length;
+        }
+        // 满簇的期望半径，用于把距离归一化到与法线偏差相近的量级
+        const float expectedRadius = std::max(
+            static_cast<float>(std::sqrt(totalArea / triangleCount * kMaxTriangles / glm::pi<double>())), 1e-6f);
+
+        std::vector<unsigned int> sorted;
+        sorted.reserve(indices.size());
+        std::vector<char> used(triangleCount, 0);
+        std::vector<uint32_t> owner(vertexCount, UINT32_MAX);
+        std::vector<unsigned int> meshletVertices;
+        std::vector<uint32_t> candidates;
+        size_t scanCursor = 0;
+
+        Meshlet current;
+        uint32_t currentId = 0;
+        glm::vec3 centroidSum(0.0f), normalSum(0.0f);
+
+        auto newVertexCount = [&](uint32_t t) {
+            const unsigned int* tri = indices.data() + t * 3;
+            uint32_t count = 0;
+            for (int k = 0; k < 3; ++k) {
+                const bool repeated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+                if (owner[tri[k]] != currentId && !repeated) ++count;
+            }
+            return count;
+        };
+
+        auto finish = [&] {
+            FinishMeshlet(current, vertices, sorted.data(), meshletVertices);
+            meshlets.push_back(current);
+            current = Meshlet{};
+            current.firstIndex = static_cast<uint32_t>(sorted.size());
+            meshletVertices.clear();
+            centroidSum = normalSum = glm::vec3(0.0f);
+            ++currentId;
+        };
+
+        for (size_t emitted = 0; emitted < triangleCount; ++emitted) {
+            // 在与当前簇相邻的三角形中选代价最小者：新增顶点数优先，其次是离簇中心的距离与法线偏差
+            uint32_t best = UINT32_MAX;
+            float bestCost = std::numeric_limits<float>::max();
+            const glm::vec3 center = current.triangleCount > 0 ? centroidSum / static_cast<float>(current.triangleCount)
+                                                               : glm::vec3(0.0f);
+            const float axisLength = glm::length(normalSum);
+            const glm::vec3 axis = axisLength > 0.0f ? normalSum / axisLength : glm::vec3(0.0f);
+            size_t write = 0;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                const uint32_t t = candidates[i];
+                if (used[t]) continue;
+                candidates[write++] = t;
+                const uint32_t extra = newVertexCount(t);
+                if (current.vertexCount + extra > kMaxVertices) continue;
+                const float distance = glm::length(centroids[t] - center) / expectedRadius;
+                const float spread = 1.0f - glm::dot(normals[t], axis);
+                const float cost = static_cast<float>(extra) + (1.0f - kConeWeight) * distance + kConeWeight * spread;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = t;
+                }
+            }
+            candidates.resize(write);
+
+            if (best == UINT32_MAX) {
+                // 当前簇无可加入的邻接三角形：结束当前簇，优先从剩余边界中选离上一簇最近的作为新种子
+                if (current.triangleCount > 0) {
+                    const glm::vec3 previousCenter = center;
+                    finish();
+                    float bestDistance = std::numeric_limits<float>::max();
+                    for (uint32_t t : candidates) {
+                        const float distance = glm::length(centroids[t] - previousCenter);
+                        if (distance < bestDistance) {
+                            bestDistance = distance;
+                            best = t;
+                        }
+                    }
+                }
+                if (best == UINT32_MAX) {
+                    while (used[scanCursor]) ++scanCursor;
+                    best = static_cast<uint32_t>(scanCursor);
+                }
+                candidates.clear();
+            } else if (current.triangleCount + 1 > kMaxTriangles) {
+                // 三角形数已满：best 与上一簇相邻，直接作为新簇的种子
+                finish();
+                candidates.clear();
+            }
+
+            used[best] = 1;
+            const unsigned int* tri = indices.data() + best * 3;
+            for (int k = 0; k < 3; ++k) {
+                sorted.push_back(tri[k]);
+                if (owner[tri[k]] != currentId) {
+                    owner[tri[k]] = currentId;
+                    meshletVertices.push_back(tri[k]);
+                    ++current.vertexCount;
+                }
+                const unsigned int w = weld[tri[k]];
+                for (uint32_t a = adjacencyOffset[w]; a < adjacencyOffset[w + 1]; ++a) {
+                    if (!used[adjacency[a]]) candidates.push_back(adjacency[a]);
+                }
+            }
+            ++current.triangleCount;
+            centroidSum += centroids[best];
+            normalSum += normals[best];
+        }
+        FinishMeshlet(current, vertices, sorted.data(), meshletVertices);
+        meshlets.push_back(current);
+
+        indices.swap(sorted);
+        return meshlets;
+    }
+
+    void MeshletBuilder::BuildMeshes(std::vector<MeshData>& meshes, unsigned int threadCount) {
+        const auto build = [&meshes](size_t i) {
+            MeshData& mesh = meshes[i];
+            mesh.meshlets = Build(mesh.vertices.data(), mesh.vertices.size(), mesh.indices);
+
+            // 簇内重新做缓存优化（局部索引），再按新的三角形顺序重排顶点
+            std::vector<unsigned int> local;
+            std::vector<unsigned int> globalOf;
+            std::unordered_map<unsigned int, unsigned int> localOf;
+            for (const auto& meshlet : mesh.meshlets) {
+                unsigned int* first = mesh.indices.data() + meshlet.firstIndex;
+                const size_t count = meshlet.triangleCount * 3;
+                local.assign(first, first + count);
+                globalOf.clear();
+                localOf.clear();
+                for (auto& index : local) {
+                    auto it = localOf.emplace(index, static_cast<unsigned int>(globalOf.size())).first;
+                    if (it->second == globalOf.size()) globalOf.push_back(index);
+                    index = it->second;
+                }
+                MeshOptimizer::OptimizeVertexCache(local, globalOf.size());
+                for (size_t k = 0; k < count; ++k) first[k] = globalOf[local[k]];
+            }
+            MeshOptimizer::OptimizeVertexFetch(mesh.vertices, mesh.indices);
+        };
+        const size_t meshCount = meshes.size();
+        core::JobSystem::ParallelFor(meshCount, [&build](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) build(i);
+        }, threadCount == 1 ? meshCount : 1);
+    }
+
+    void MeshletCuller::Cull(const Meshlet* meshlets, size_t meshletCount, const MeshletCullView& view,
+                             DrawList& drawList) {
+        Cull(meshlets, meshletCount, view, drawList, s_Stats);
+    }
+
+    void MeshletCuller::Cull(const Meshlet* meshlets, size_t meshletCount, const MeshletCullView& view,
+                             DrawList& drawList, Stats& stats) {
+        drawList.counts.clear();
+        drawList.offsets.clear();
+
+        // 上一个可见簇的索引末尾，用于合并连续区间
+        uint32_t rangeEnd = UINT32_MAX;
+        for (size_t i = 0; i < meshletCount; ++i) {
+            const Meshlet& meshlet = meshlets[i];
+            stats.meshlets++;
+            stats.triangles += meshlet.triangleCount;
+
+            bool inside = true;
+            for (const auto& plane : view.planes) {
+                if (glm::dot(glm::vec3(plane), meshlet.center) + plane.w < -meshlet.radius) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (!inside) {
+                stats.frustumCulledTriangles += meshlet.triangleCount;
+                continue;
+            }
+
+            if (s_BackfaceCulling && meshlet.coneCutoff < 1.0f) {
+                bool backfacing;
+                if (view.orthographic) {
+                    backfacing = glm::dot(view.viewDirection, meshlet.coneAxis) >= meshlet.coneCutoff;
+                } else {
+                    // 包围球内任意一点看向簇的方向都落在锥的背面一侧
+                    const glm::vec3 toCenter = meshlet.center - view.cameraPosition;
+                    backfacing = glm::dot(toCenter, meshlet.coneAxis) >=
+                                 meshlet.coneCutoff * glm::length(toCenter) + meshlet.radius;
+                }
+                if (backfacing) {
+                    stats.backfaceCulledTriangles += meshlet.triangleCount;
+                    continue;
+                }
+            }
+
+            stats.visibleMeshlets++;
+            stats.visibleTriangles += meshlet.triangleCount;
+            const GLsizei indexCount = static_cast<GLsizei>(meshlet.triangleCount * 3);
+            if (meshlet.firstIndex == rangeEnd) {
+                drawList.counts.back() += indexCount;
+            } else {
+                drawList.counts.push_back(indexCount);
+                drawList.offsets.push_back(
+                    reinterpret_cast<const void*>(static_cast<uintptr_t>(meshlet.firstIndex) * sizeof(unsigned int)));
+            }
+            rangeEnd = meshlet.firstIndex + meshlet.triangleCount * 3;
+        }
+        stats.drawRanges += drawList.counts.size();
+    }
+
+    void MeshletCuller::AddStats(const Stats& stats) {
+        s_Stats.meshlets += stats.meshlets;
+        s_Stats.visibleMeshlets += stats.visibleMeshlets;
+        s_Stats.triangles += stats.triangles;
+        s_Stats.frustumCulledTriangles += stats.frustumCulledTriangles;
+        s_Stats.backfaceCulledTriangles += stats.backfaceCulledTriangles;
+        s_Stats.visibleTriangles += stats.visibleTriangles;
+        s_Stats.drawRanges += stats.drawRanges;
+    }
+
+} // namespace graphics
@@ -0,0 +1,320 @@
+#include "graphics/MipGenerator.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RRENDER_MIP_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace graphics {
+
+namespace {
+
+    constexpr float kPi = 3.14159265358979f;
+
+    /// RGBA float 图像，通道交错存放
+    struct FloatImage {
+        int width = 0;
+        int height = 0;
+        std::vector<float> data;
+    };
+
+    /// 每个输出像素的采样源索引与权重，按 maxTaps 对齐存放
+    struct Taps {
+        int maxTaps = 0;
+        std::vector<int> indices;
+        std::vector<float> weights;
+    };
+
+    const float* GetSrgbToLinearTable() {
+        static const auto table = [] {
+            std::vector<float> t(256);
+            for (int i = 0; i < 256; ++i) {
+                float c = i / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table.data();
+    }
+
+    // 线性值按12位量化查表转回 sRGB 8位
+    constexpr int kLinearSteps = 4096;
+    const uint8_t* GetLinearToSrgbTable() {
+        static const auto table = [] {
+            std::vector<uint8_t> t(kLinearSteps);
+            for (int i = 0; i < kLinearSteps; ++i) {
+                float c = i / static_cast<float>(kLinearSteps - 1);
+                float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                t[i] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, s * 255.0f + 0.5f)));
+            }
+            return t;
+        }();
+        return table.data();
+    }
+
+    inline uint8_t ToUnorm8(float v) {
+        return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, v * 255.0f + 0.5f)));
+    }
+
+    inline float Sinc(float x) {
+        if (std::fabs(x) < 1e-6f) return 1.0f;
+        x *= kPi;
+        return std::sin(x) / x;
+    }
+
+    // 第一类零阶修正贝塞尔函数（级数展开）
+    float BesselI0(float x) {
+        float sum = 1.0f, term = 1.0f;
+        for (int k = 1; k < 20; ++k) {
+            term *= (x * 0.5f / k) * (x * 0.5f / k);
+            sum += term;
+            if (term < sum * 1e-8f) break;
+        }
+        return sum;
+    }
+
+    float GetSupport(MipFilter filter) {
+        return filter == MipFilter::Box ? 0.5f : 3.0f;
+    }
+
+    float EvaluateKernel(MipFilter filter, float x) {
+        const float ax = std::fabs(x);
+        switch (filter) {
+            case MipFilter::Box: return ax <= 0.5f ? 1.0f : 0.0f;
+            case MipFilter::Lanczos: return ax < 3.0f ? Sinc(x) * Sinc(x / 3.0f) : 0.0f;
+            case MipFilter::Kaiser: {
+                if (ax >= 3.0f) return 0.0f;
+                constexpr float kAlpha = 4.0f;
+                float t = x / 3.0f;
+                return Sinc(x) * BesselI0(kAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kAlpha);
+            }
+        }
+        return 0.0f;
+    }
+
+    // 计算 srcSize -> dstSize 的一维重采样权重，越界按边缘钳制
+    Taps BuildTaps(int srcSize, int dstSize, MipFilter filter) {
+        const float scale = static_cast<float>(srcSize) / dstSize;
+        const float radius = GetSupport(filter) * scale;
+
+        Taps taps;
+        taps.maxTaps = static_cast<int>(std::ceil(radius * 2.0f)) + 2;
+        taps.indices.assign(static_cast<size_t>(dstSize) * taps.maxTaps, 0);
+        taps.weights.assign(static_cast<size_t>(dstSize) * taps.maxTaps, 0.0f);
+
+        for (int i = 0; i < dstSize; ++i) {
+            const float center = (i + 0.5f) * scale;
+            const int lo = static_cast<int>(std::floor(center - radius));
+            const int hi = static_cast<int>(std::ceil(center + radius));
+            int* idx = &taps.indices[static_cast<size_t>(i) * taps.maxTaps];
+            float* w = &taps.weights[static_cast<size_t>(i) * taps.maxTaps];
+
+            int count = 0;
+            float sum = 0.0f;
+            for (int j = lo; j <= hi && count < taps.maxTaps; ++j) {
+                float weight = EvaluateKernel(filter, (j + 0.5f - center) / scale);
+                if (weight == 0.0f) continue;
+                idx[count] = std::min(std::max(j, 0), srcSize - 1);
+                w[count] = weight;
+                sum += weight;
+                ++count;
+            }
+            if (count == 0 || std::fabs(sum) < 1e-6f) {
+                idx[0] = std::min(static_cast<int>(center), srcSize - 1);
+                w[0] = 1.0f;
+                count = 1;
+                sum = 1.0f;
+            }
+            for (int t = 0; t < count; ++t) w[t] /= sum;
+            // 余下槽位权重为0，索引重复最后一个以保证访问合法
+            for (int t = count; t < taps.maxTaps; ++t) idx[t] = idx[count - 1];
+        }
+        return taps;
+    }
+
+    // 横向：src(w×h) -> dst(dstW×h)，每个像素4通道一次处理
+    void ResampleRow(const float* src, float* dst, int dstWidth, const Taps& taps, bool simd) {
+        for (int x = 0; x < dstWidth; ++x) {
+            const int* idx = &taps.indices[static_cast<size_t>(x) * taps.maxTaps];
+            const float* w = &taps.weights[static_cast<size_t>(x) * taps.maxTaps];
+#ifdef RRENDER_MIP_SSE
+            if (simd) {
+                __m128 acc = _mm_setzero_ps();
+                for (int t = 0; t < taps.maxTaps; ++t)
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + idx[t] * 4), _mm_set1_ps(w[t])));
+                _mm_storeu_ps(dst + x * 4, acc);
+                continue;
+            }
+#endif
+            float acc[4] = {};
+            for (int t = 0; t < taps.maxTaps; ++t)
+                for (int ch = 0; ch < 4; ++ch) acc[ch] += src[idx[t] * 4 + ch] * w[t];
+            std::memcpy(dst + x * 4, acc, sizeof(acc));
+        }
+    }
+
+    // 纵向：同一输出行的所有像素共享权重，整行按连续 float 数组加权求和
+    void ResampleColumn(const FloatImage& src, float* dst, const int* idx, const float* w, int tapCount, bool simd) {
+        const size_t rowFloats = static_cast<size_t>(src.width) * 4;
+        size_t i = 0;
+#ifdef RRENDER_MIP_SSE
+        if (simd) {
+#ifdef __AVX__
+            for (; i + 8 <= rowFloats; i += 8) {
+                __m256 acc = _mm256_setzero_ps();
+                for (int t = 0; t < tapCount; ++t) {
+                    const float* row = src.data.data() + static_cast<size_t>(idx[t]) * rowFloats;
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(row + i), _mm256_set1_ps(w[t])));
+                }
+                _mm256_storeu_ps(dst + i, acc);
+            }
+#endif
+            for (; i + 4 <= rowFloats; i += 4) {
+                __m128 acc = _mm_setzero_ps();
+                for (int t = 0; t < tapCount; ++t) {
+                    const float* row = src.data.data() + static_cast<size_t>(idx[t]) * rowFloats;
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(row + i), _mm_set1_ps(w[t])));
+                }
+                _mm_storeu_ps(dst + i, acc);
+            }
+        }
+#endif
+        for (; i < rowFloats; ++i) {
+            float acc = 0.0f;
+            for (int t = 0; t < tapCount; ++t) acc += src.data[static_cast<size_t>(idx[t]) * rowFloats + i] * w[t];
+            dst[i] = acc;
+        }
+    }
+
+    FloatImage Downsample(const FloatImage& src, const MipGenerator::Options& options) {
+        FloatImage dst;
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+
+        const Taps horizontal = BuildTaps(src.width, dst.width, options.filter);
+        const Taps vertical = BuildTaps(src.height, dst.height, options.filter);
+
+        FloatImage temp;
+        temp.width = dst.width;
+        temp.height = src.height;
+        temp.data.resize(static_cast<size_t>(temp.width) * temp.height * 4);
+        // 按行经任务系统并行，threadCount 为 1 时整段在调用线程执行
+        const bool serial = options.threadCount == 1;
+        core::JobSystem::ParallelFor(static_cast<size_t>(src.height), [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                ResampleRow(src.data.data() + y * src.width * 4, temp.data.data() + y * temp.width * 4,
+                            dst.width, horizontal, options.simd);
+            }
+        }, serial ? static_cast<size_t>(src.height) : 0);
+
+        dst.data.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+        core::JobSystem::ParallelFor(static_cast<size_t>(dst.height), [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                ResampleColumn(temp, dst.data.data() + y * dst.width * 4,
+                               &vertical.indices[y * vertical.maxTaps], &vertical.weights[y * vertical.maxTaps],
+                               vertical.maxTaps, options.simd);
+            }
+        }, serial ? static_cast<size_t>(dst.height) : 0);
+        return dst;
+    }
+
+    float ComputeCoverage(const FloatImage& image, int channel, float cutoff, float scale) {
+        const size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+        size_t covered = 0;
+        for (size_t i = 0; i < pixelCount; ++i) {
+            if (image.data[i * 4 + channel] * scale > cutoff) ++covered;
+        }
+        return static_cast<float>(covered) / pixelCount;
+    }
+
+    // 二分查找使本级覆盖率与第0级一致的缩放系数
+    float FindCoverageScale(const FloatImage& image, int channel, float cutoff, float targetCoverage) {
+        float lo = 0.0f, hi = 4.0f;
+        for (int iter = 0; iter < 12; ++iter) {
+            float mid = 0.5f * (lo + hi);
+            if (ComputeCoverage(image, channel, cutoff, mid) < targetCoverage) lo = mid;
+            else hi = mid;
+        }
+        return 0.5f * (lo + hi);
+    }
+
+    std::vector<uint8_t> ToRgba8(const FloatImage& image, const MipGenerator::Options& options, float coverageScale) {
+        const size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+        const uint8_t* toSrgb = GetLinearToSrgbTable();
+        std::vector<uint8_t> out(pixelCount * 4);
+        for (size_t i = 0; i < pixelCount; ++i) {
+            float px[4];
+            std::memcpy(px, &image.data[i * 4], sizeof(px));
+
+            if (options.normalMap) {
+                float n[3] = {px[0] * 2.0f - 1.0f, px[1] * 2.0f - 1.0f, px[2] * 2.0f - 1.0f};
+                float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (len > 1e-6f) {
+                    for (int ch = 0; ch < 3; ++ch) px[ch] = n[ch] / len * 0.5f + 0.5f;
+                }
+            }
+            if (options.coverageChannel == 3) {
+                px[3] *= coverageScale;
+            } else if (options.coverageChannel == 0) {
+                for (int ch = 0; ch < 3; ++ch) px[ch] *= coverageScale;
+            }
+
+            for (int ch = 0; ch < 3; ++ch) {
+                if (options.srgb) {
+                    float v = std::min(1.0f, std::max(0.0f, px[ch]));
+                    out[i * 4 + ch] = toSrgb[static_cast<int>(v * (kLinearSteps - 1) + 0.5f)];
+                } else {
+                    out[i * 4 + ch] = ToUnorm8(px[ch]);
+                }
+            }
+            out[i * 4 + 3] = ToUnorm8(px[3]);
+        }
+        return out;
+    }
+
+} // namespace
+
+    std::vector<std::vector<uint8_t>> MipGenerator::Generate(const uint8_t* rgba, int width, int height,
+                                                             const Options& options) {
+        if (width <= 0 || height <= 0)
+            throw std::runtime_error("Cannot generate mips for an empty image");
+        if (options.coverageChannel != -1 && options.coverageChannel != 0 && options.coverageChannel != 3)
+            throw std::runtime_error("Unsupported alpha coverage channel");
+
+        std::vector<std::vector<uint8_t>> levels;
+        levels.emplace_back(rgba, rgba + static_cast<size_t>(width) * height * 4);
+
+        // 第0级转为线性 float
+        FloatImage current;
+        current.width = width;
+        current.height = height;
+        current.data.resize(static_cast<size_t>(width) * height * 4);
+        const float* toLinear = GetSrgbToLinearTable();
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; ++i) {
+            for (int ch = 0; ch < 3; ++ch)
+                current.data[i * 4 + ch] = options.srgb ? toLinear[rgba[i * 4 + ch]] : rgba[i * 4 + ch] / 255.0f;
+            current.data[i * 4 + 3] = rgba[i * 4 + 3] / 255.0f;
+        }
+
+        float targetCoverage = 0.0f;
+        if (options.coverageChannel >= 0)
+            targetCoverage = ComputeCoverage(current, options.coverageChannel, options.alphaCutoff, 1.0f);
+
+        // 每级由上一级（未做覆盖率缩放的）线性数据降采样，避免误差累积
+        while (current.width > 1 || current.height > 1) {
+            current = Downsample(current, options);
+            float scale = 1.0f;
+            if (options.coverageChannel >= 0)
+                scale = FindCoverageScale(current, options.coverageChannel, options.alphaCutoff, targetCoverage);
+            levels.push_back(ToRgba8(current, options, scale));
+        }
+        return levels;
+    }
+
+} // namespace graphics
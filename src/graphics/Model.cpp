@@ -1,169 +1,352 @@
 ﻿#include "graphics/Model.h"
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
+#include "graphics/MeshOptimizer.h"
+#include "graphics/Meshlet.h"
+#include "graphics/MeshSimplifier.h"
+#include "graphics/RenderCommand.h"
+#include "graphics/TextureCache.h"
+#include "graphics/TextureUploader.h"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace graphics {
 
-    // 构造函数：加载模型
+namespace {
+
+    // 模型未就绪时绘制的占位立方体（边长1），首次使用时创建
+    const Mesh& GetPlaceholderMesh() {
+        // 有意不释放：避免在GL上下文销毁后的静态析构阶段调用GL
+        static const Mesh* placeholder = [] {
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            const glm::vec3 normals[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+            for (const auto& n : normals) {
+                // 面内两个切向量
+                glm::vec3 u = glm::vec3(n.y, n.z, n.x);
+                glm::vec3 v = glm::cross(n, u);
+                unsigned int base = static_cast<unsigned int>(vertices.size());
+                const glm::vec2 corners[4] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+                for (const auto& c : corners) {
+                    vertices.push_back({0.5f * (n + c.x * u + c.y * v), n, 0.5f * (c + 1.0f)});
+                }
+                indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+            }
+            return new Mesh(vertices, indices);
+        }();
+        return *placeholder;
+    }
+
+} // namespace
+
+    // 构造函数：同步加载模型
     Model::Model(const std::string& path, bool useSRGB) {
-        LoadModel(path, useSRGB);
+        ModelData data = LoadData(path);
+        Upload(data, useSRGB);
     }
 
     // 绘制所有子网格及其纹理
-    void Model::Draw() const {
+    void Model::Draw(const MeshletCullView* cullView, uint32_t lod) const {
+        Touch();
+        if (!m_Ready) {
+            // 资源尚未就绪，使用占位网格与占位纹理
+            DrawPlaceholder();
+            return;
+        }
+
+        // 多个子网格时逐个测试包围盒（实体整体已通过视锥测试，单个子网格无需重复）
+        const bool testMeshes = cullView && m_Meshes.size() > 1 && FrustumCuller::IsEnabled();
+        size_t culled = 0;
         for (const auto& texturedMesh : m_Meshes) {
+            if (testMeshes && !Frustum::IntersectsBox(cullView->planes, texturedMesh.mesh.GetBounds())) {
+                ++culled;
+                continue;
+            }
             // 绑定所有纹理到不同的纹理单元
             for (size_t i = 0; i < texturedMesh.textures.size(); ++i) {
                 texturedMesh.textures[i]->Bind(static_cast<unsigned int>(i));
             }
             // 绘制网格
-            texturedMesh.mesh.Draw();
+            texturedMesh.mesh.Draw(cullView, lod);
         }
+        if (testMeshes) FrustumCuller::CountMeshes(m_Meshes.size(), culled);
     }
 
-    // 加载OBJ模型，解析shapes和materials
-    void Model::LoadModel(const std::string& path, bool useSRGB) {
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn, err;
+    void Model::DrawPlaceholder() {
+        Texture placeholderTexture;
+        placeholderTexture.Bind(0);
+        GetPlaceholderMesh().Draw();
+    }
 
-        // 获取模型文件所在目录
-        std::string baseDir = std::filesystem::path(path).parent_path().string();
-        if (!baseDir.empty())
-            baseDir += std::filesystem::path::preferred_separator;
+    // 与 Draw 逐项对应，GL调用换成命令
+    void Model::Record(CommandBuffer& buffer, const MeshletCullView* cullView, uint32_t lod) const {
+        Touch();
+        if (!m_Ready) {
+            // 占位网格在回放时于GL线程创建
+            buffer.Draw(DrawCommand{});
+            return;
+        }
 
+        const bool testMeshes = cullView && m_Meshes.size() > 1 && FrustumCuller::IsEnabled();
+        size_t culled = 0;
+        unsigned int textures[BindMaterialCommand::kMaxTextures];
+        for (const auto& texturedMesh : m_Meshes) {
+            if (testMeshes && !Frustum::IntersectsBox(cullView->planes, texturedMesh.mesh.GetBounds())) {
+                ++culled;
+                continue;
+            }
+            const size_t textureCount = std::min<size_t>(texturedMesh.textures.size(), BindMaterialCommand::kMaxTextures);
+            for (size_t i = 0; i < textureCount; ++i) {
+                textures[i] = texturedMesh.textures[i]->GetBindID();
+            }
+            buffer.BindMaterial(textures, textureCount);
+            texturedMesh.mesh.Record(buffer, cullView, lod);
+        }
+        if (testMeshes) buffer.CountMeshes(m_Meshes.size(), culled);
+    }
 
-        // 加载OBJ文件
-        bool success = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-                                        path.c_str(), baseDir.c_str());
+    // 各子网格的层次包围盒依次以当前最近距离为上限求交
+    bool Model::Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& hit,
+                          uint32_t& mesh) const {
+        bool found = false;
+        for (size_t i = 0; i < m_Meshes.size(); ++i) {
+            const TriangleBvh* bvh = m_Meshes[i].mesh.GetBvh();
+            if (!bvh || !bvh->Intersect(origin, direction, maxDistance, hit)) continue;
+            maxDistance = hit.distance;
+            mesh = static_cast<uint32_t>(i);
+            found = true;
+        }
+        return found;
+    }
 
-        if (!warn.empty()) std::cout << "[ModelLoader Warning] " << warn << std::endl;
-        if (!err.empty()) std::cerr << "[ModelLoader Error] " << err << std::endl;
-        if (!success) throw std::runtime_error("Failed to load model: " + path);
+    size_t Model::GetGpuByteSize() const {
+        size_t bytes = 0;
+        for (const auto& texturedMesh : m_Meshes) bytes += texturedMesh.mesh.GetGpuBytes();
+        return bytes;
+    }
 
-        m_Directory = baseDir;
+    // 释放网格：重新 Upload 时纹理命中全局缓存，被驱逐的纹理在下次绑定时另行重新加载
+    bool Model::Evict() {
+        if (!m_Ready || m_Path.empty())
+            return false;
+        m_Meshes.clear();
+        m_Ready = false;
+        m_Evicted = true;
+        return true;
+    }
 
-        // 处理每个shape
-        for (const auto& shape : shapes) {
-            ProcessMeshData(&attrib, &shape, materials.data(), materials.size(), useSRGB);
+    std::vector<std::string> ModelData::GetTexturePaths() const {
+        std::vector<std::string> paths;
+        auto add = [&](const std::string& texname) {
+            if (texname.empty()) return;
+            std::string fullPath = (std::filesystem::path(directory) / texname).string();
+            if (std::find(paths.begin(), paths.end(), fullPath) == paths.end())
+                paths.push_back(std::move(fullPath));
+        };
+        for (const auto& mesh : meshes) {
+            if (mesh.materialId < 0 || mesh.materialId >= static_cast<int>(materials.size())) continue;
+            const auto& mat = materials[mesh.materialId];
+            add(mat.diffuseTexname);
+            add(mat.specularTexname);
+            add(mat.bumpTexname);
         }
+        return paths;
     }
 
-    // 处理单个shape，按材质分组生成Mesh
-    void Model::ProcessMeshData(const void* attribPtr,
-                                const void* shapePtr,
-                                const void* materialsPtr,
-                                size_t materialCount,
-                                bool useSRGB) {
-        const tinyobj::attrib_t* attrib = static_cast<const tinyobj::attrib_t*>(attribPtr);
-        const tinyobj::shape_t* shape = static_cast<const tinyobj::shape_t*>(shapePtr);
-        const tinyobj::material_t* materials = static_cast<const tinyobj::material_t*>(materialsPtr);
-
-        // 1. 按材质分组，每组独立顶点和索引
-        std::map<int, std::vector<Vertex>> matID_to_vertices;
-        std::map<int, std::vector<unsigned int>> matID_to_indices;
-        std::map<int, std::map<std::tuple<int, int, int>, unsigned int>> matID_to_vertexCache;
-
-        size_t index_offset = 0;
-        for (size_t f = 0; f < shape->mesh.num_face_vertices.size(); ++f) {
-            int fv = shape->mesh.num_face_vertices[f];
-            int matID = shape->mesh.material_ids.empty() ? -1 : shape->mesh.material_ids[f];
-
-            for (size_t v = 0; v < fv; ++v) {
-                tinyobj::index_t idx = shape->mesh.indices[index_offset + v];
-                auto key = std::make_tuple(idx.vertex_index, idx.normal_index, idx.texcoord_index);
-
-                unsigned int vertIndex;
-                auto& vertexCache = matID_to_vertexCache[matID];
-                auto& vertices = matID_to_vertices[matID];
-                // 顶点去重：属性三元组唯一
-                if (vertexCache.find(key) != vertexCache.end()) {
-                    vertIndex = vertexCache[key];
-                } else {
-                    Vertex vertex{};
-                    vertex.Position = {
-                        attrib->vertices[3 * idx.vertex_index + 0],
-                        attrib->vertices[3 * idx.vertex_index + 1],
-                        attrib->vertices[3 * idx.vertex_index + 2]
-                    };
-                    if (idx.normal_index >= 0) {
-                        vertex.Normal = {
-                            attrib->normals[3 * idx.normal_index + 0],
-                            attrib->normals[3 * idx.normal_index + 1],
-                            attrib->normals[3 * idx.normal_index + 2]
-                        };
-                    }
-                    if (idx.texcoord_index >= 0) {
-                        vertex.TexCoords = {
-                            attrib->texcoords[2 * idx.texcoord_index + 0],
-                            attrib->texcoords[2 * idx.texcoord_index + 1]
-                        };
-                    }
-                    vertIndex = static_cast<unsigned int>(vertices.size());
-                    vertices.push_back(vertex);
-                    vertexCache[key] = vertIndex;
-                }
-                matID_to_indices[matID].push_back(vertIndex);
+    // 读取网格数据：优先使用 .rmesh 缓存，缓存缺失或过期时解析OBJ并重建缓存
+    ModelData Model::LoadData(const std::string& path) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        ModelData data;
+        data.path = path;
+        // 获取模型文件所在目录
+        data.directory = std::filesystem::path(path).parent_path().string();
+        if (!data.directory.empty())
+            data.directory += std::filesystem::path::preferred_separator;
+
+        const std::string cachePath = MeshCache::GetCachePath(path);
+        try {
+            data.fromCache = data.cache.Open(cachePath, path);
+        } catch (const std::exception& e) {
+            std::cout << "[ModelLoader Warning] Ignoring mesh cache: " << e.what() << std::endl;
+        }
+
+        if (data.fromCache) {
+            data.materials = data.cache.GetMaterials();
+            data.meshes = data.cache.GetMeshes();
+        } else {
+            ObjData obj;
+            try {
+                obj = ObjParser::Parse(path);
+            } catch (const std::exception& e) {
+                std::cerr << "[ModelLoader Error] " << e.what() << std::endl;
+                throw std::runtime_error("Failed to load model: " + path);
             }
-            index_offset += fv;
-        }
-
-        // 2. 为每种材质生成 mesh 和纹理
-        for (const auto& [matID, indices] : matID_to_indices) {
-            std::vector<std::shared_ptr<Texture>> textures;
-            if (matID >= 0 && matID < static_cast<int>(materialCount)) {
-                const auto& mat = materials[matID];
-                // 加载漫反射纹理
-                if (!mat.diffuse_texname.empty()) {
-                    if (auto tex = LoadMaterialTexture(m_Directory, mat.diffuse_texname, useSRGB)) {
-                        textures.push_back(tex);
-                    }
-                }
-                // 加载高光纹理
-                if (!mat.specular_texname.empty()) {
-                    if (auto tex = LoadMaterialTexture(m_Directory, mat.specular_texname, useSRGB)) {
-                        textures.push_back(tex);
-                    }
-                }
-                // 加载法线/凹凸纹理
-                if (!mat.bump_texname.empty()) {
-                    if (auto tex = LoadMaterialTexture(m_Directory, mat.bump_texname, useSRGB)) {
-                        textures.push_back(tex);
+            data.ownedMeshes = ObjParser::BuildMeshes(obj);
+            MeshOptimizer::OptimizeMeshes(data.ownedMeshes);
+            MeshletBuilder::BuildMeshes(data.ownedMeshes);
+            MeshSimplifier::GenerateLods(data.ownedMeshes, 0, {});
+            data.materials = std::move(obj.materials);
+
+            try {
+                MeshCache::Write(cachePath, path, data.ownedMeshes, data.materials, obj.materialLibraries);
+            } catch (const std::exception& e) {
+                std::cout << "[ModelLoader Warning] " << e.what() << std::endl;
+            }
+
+            for (const auto& mesh : data.ownedMeshes) {
+                MeshCache::MeshView view;
+                view.materialId = mesh.materialId;
+                view.vertices = mesh.vertices.data();
+                view.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+                view.indices = mesh.indices.data();
+                view.indexCount = static_cast<uint32_t>(mesh.indices.size());
+                view.meshlets = mesh.meshlets.data();
+                view.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+                view.lods = mesh.lods.data();
+                view.lodCount = static_cast<uint32_t>(mesh.lods.size());
+                if (!mesh.vertices.empty()) {
+                    view.boundsMin = view.boundsMax = mesh.vertices[0].Position;
+                    for (const auto& v : mesh.vertices) {
+                        view.boundsMin = glm::min(view.boundsMin, v.Position);
+                        view.boundsMax = glm::max(view.boundsMax, v.Position);
                     }
                 }
+                data.meshes.push_back(view);
+            }
+        }
+
+        // 拾取用的层次包围盒只覆盖 LOD0，不写入缓存，每次加载时构建
+        data.bvhs.reserve(data.meshes.size());
+        for (const auto& view : data.meshes) {
+            auto bvh = std::make_shared<TriangleBvh>();
+            const uint32_t first = view.lodCount > 0 ? view.lods[0].firstIndex : 0;
+            const uint32_t count = view.lodCount > 0 ? view.lods[0].indexCount : view.indexCount;
+            if (view.vertexCount > 0)
+                bvh->Build(&view.vertices[0].Position, view.vertexCount, sizeof(Vertex), view.indices + first, count);
+            data.bvhs.push_back(std::move(bvh));
+        }
+
+        auto endTime = std::chrono::steady_clock::now();
+        std::cout << "[ModelLoader] " << std::filesystem::path(path).filename().string()
+                  << ": " << data.meshes.size() << " meshes from " << (data.fromCache ? "cache" : "OBJ") << ", "
+                  << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+        return data;
+    }
+
+    // 创建GPU网格与纹理，映射区或解析结果中的顶点/索引直接交给 Mesh 上传（紧凑格式时先量化）
+    void Model::Upload(const ModelData& data, bool useSRGB) {
+        m_Meshes.clear();
+        m_Path = data.path;
+        m_Directory = data.directory;
+        const VertexFormat format = Mesh::GetDefaultFormat();
+        std::unordered_map<std::string, std::shared_ptr<Texture>> loadedTextures;
+        for (size_t i = 0; i < data.meshes.size(); ++i) {
+            const auto& view = data.meshes[i];
+            m_Meshes.emplace_back(TexturedMesh{
+                Mesh(view.vertices, view.vertexCount, view.indices, view.indexCount, format),
+                LoadMaterialTextures(view.materialId, data, useSRGB, loadedTextures)});
+            m_Meshes.back().mesh.SetMeshlets(view.meshlets, view.meshletCount);
+            m_Meshes.back().mesh.SetLods(view.lods, view.lodCount);
+            m_Meshes.back().mesh.SetBounds(BoundingBox{view.boundsMin, view.boundsMax});
+            if (i < data.bvhs.size()) m_Meshes.back().mesh.SetBvh(data.bvhs[i]);
+        }
+
+        // 模型级 LOD 误差取各子网格同一级的最大值；子网格级数不足时沿用其最粗一级
+        m_LodErrors.assign(1, 0.0f);
+        glm::vec3 boundsMin(std::numeric_limits<float>::max()), boundsMax(std::numeric_limits<float>::lowest());
+        for (const auto& view : data.meshes) {
+            if (view.lodCount > m_LodErrors.size()) m_LodErrors.resize(view.lodCount, 0.0f);
+            boundsMin = glm::min(boundsMin, view.boundsMin);
+            boundsMax = glm::max(boundsMax, view.boundsMax);
+        }
+        for (const auto& view : data.meshes) {
+            for (size_t lod = 0; lod < m_LodErrors.size() && view.lodCount > 0; ++lod) {
+                const float error = view.lods[std::min<size_t>(lod, view.lodCount - 1)].error;
+                m_LodErrors[lod] = std::max(m_LodErrors[lod], error);
             }
-            // 生成子网格
-            m_Meshes.emplace_back(TexturedMesh{Mesh(matID_to_vertices[matID], indices), textures});
         }
+        // 遮挡体取最粗一级：三角形少，简化误差相对模型很小
+        m_Occluder = OccluderMesh{};
+        for (const auto& view : data.meshes) {
+            if (view.vertexCount == 0) continue;
+            const uint32_t first = view.lodCount > 0 ? view.lods[view.lodCount - 1].firstIndex : 0;
+            const uint32_t count = view.lodCount > 0 ? view.lods[view.lodCount - 1].indexCount : view.indexCount;
+            m_Occluder.Append(&view.vertices[0].Position, view.vertexCount, sizeof(Vertex), view.indices + first, count);
+        }
+        if (data.meshes.empty()) boundsMin = boundsMax = glm::vec3(0.0f);
+        m_BoundsCenter = 0.5f * (boundsMin + boundsMax);
+        m_BoundsRadius = 0.5f * glm::length(boundsMax - boundsMin);
+        m_Bounds = BoundingBox{boundsMin, boundsMax};
+        m_Ready = true;
+        m_Evicted = false;
     }
 
-    // 路径到纹理的缓存，避免重复加载
-    std::unordered_map<std::string, std::shared_ptr<Texture>> m_TextureCache;
+    // 按 漫反射/高光/法线 顺序加载材质引用的纹理
+    std::vector<std::shared_ptr<Texture>> Model::LoadMaterialTextures(int materialId,
+                                                                     const ModelData& data,
+                                                                     bool useSRGB,
+                                                                     std::unordered_map<std::string, std::shared_ptr<Texture>>& loaded) {
+        std::vector<std::shared_ptr<Texture>> textures;
+        if (materialId < 0 || materialId >= static_cast<int>(data.materials.size()))
+            return textures;
 
-    // 加载材质纹理，带缓存
-    std::shared_ptr<Texture> Model::LoadMaterialTexture(const std::string& baseDir,
+        const auto& mat = data.materials[materialId];
+        // 加载漫反射纹理
+        if (!mat.diffuseTexname.empty()) {
+            if (auto tex = LoadMaterialTexture(data, mat.diffuseTexname, useSRGB, loaded)) {
+                textures.push_back(tex);
+            }
+        }
+        // 加载高光纹理
+        if (!mat.specularTexname.empty()) {
+            if (auto tex = LoadMaterialTexture(data, mat.specularTexname, useSRGB, loaded)) {
+                textures.push_back(tex);
+            }
+        }
+        // 加载法线/凹凸纹理
+        if (!mat.bumpTexname.empty()) {
+            if (auto tex = LoadMaterialTexture(data, mat.bumpTexname, useSRGB, loaded)) {
+                textures.push_back(tex);
+            }
+        }
+        return textures;
+    }
+
+    // 从全局缓存取得材质纹理
+    std::shared_ptr<Texture> Model::LoadMaterialTexture(const ModelData& data,
                                                         const std::string& texPath,
-                                                        bool useSRGB) {
-        std::filesystem::path fullPath = std::filesystem::path(baseDir) / texPath;
+                                                        bool useSRGB,
+                                                        std::unordered_map<std::string, std::shared_ptr<Texture>>& loaded) {
+        std::filesystem::path fullPath = std::filesystem::path(data.directory) / texPath;
         std::string fullPathStr = fullPath.string();
 
-        auto it = m_TextureCache.find(fullPathStr);
-        if (it != m_TextureCache.end()) {
+        auto it = loaded.find(fullPathStr);
+        if (it != loaded.end()) {
             return it->second;
         }
 
-        try {
-            auto tex = std::make_shared<Texture>(fullPathStr, useSRGB);
-            m_TextureCache[fullPathStr] = tex;
-            return tex;
-        } catch (const std::exception& e) {
-            std::cerr << "Failed to load texture: " << fullPathStr << "\nReason: " << e.what() << std::endl;
-            return nullptr;
+        bool created = false;
+        std::shared_ptr<Texture> tex = TextureCache::Acquire(fullPathStr, useSRGB, created);
+        auto source = data.textures.find(fullPathStr);
+        const bool owned = source != data.textures.end();
+        if (owned && source->second.IsValid()) {
+            // 本次加载登记并预读取：分帧流式上传，完成前绑定占位纹理
+            TextureUploader::Enqueue(tex, source->second, useSRGB);
+        } else if (created || owned) {
+            // 新登记但未预读取（或预读取失败）：同步加载
+            try {
+                tex->Upload(TextureSource::Load(fullPathStr, useSRGB), useSRGB);
+            } catch (const std::exception& e) {
+                TextureCache::Remove(fullPathStr, useSRGB);
+                std::cerr << "Failed to load texture: " << fullPathStr << "\nReason: " << e.what() << std::endl;
+                tex = nullptr;
+            }
         }
+        // 其余情况已由其他模型或 ResourceManager 加载，可能仍在上传中
+        loaded[fullPathStr] = tex;
+        return tex;
     }
 
 } // namespace graphics
@@ -0,0 +1,627 @@
+#include "graphics/ObjParser.h"
+#include "core/JobSystem.h"
+#include "utils/VirtualFileSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace graphics {
+
+namespace {
+
+    constexpr size_t kMinChunkSize = 256 * 1024; ///< 小于该大小的文件不再切块
+
+    // ---------------------------------------------------------------
+    // 字符与数值解析
+
+    inline bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    inline bool IsDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+    inline const char* SkipSpace(const char* p, const char* end) {
+        while (p < end && IsSpace(*p)) ++p;
+        return p;
+    }
+
+    inline bool StartsWithToken(const char* p, const char* end, const char* token, size_t len) {
+        return static_cast<size_t>(end - p) > len && std::memcmp(p, token, len) == 0 && IsSpace(p[len]);
+    }
+
+    // 去掉首尾空白后的行内容
+    std::string TrimmedRest(const char* p, const char* end) {
+        p = SkipSpace(p, end);
+        while (end > p && IsSpace(end[-1])) --end;
+        return std::string(p, end);
+    }
+
+    constexpr double kPow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    /**
+     * 快速浮点解析：十进制尾数累积到 uint64，指数在 ±22 内时一次乘除即可得到结果。
+     * 非常规写法（nan/inf 等）回退到 strtof。解析失败时返回 nullptr。
+     */
+    const char* ParseFloat(const char* p, const char* end, float& out) {
+        const char* start = p;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any = false;
+
+        while (p < end && IsDigit(*p)) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa) ++digits;
+            } else {
+                ++exponent;
+            }
+            ++p;
+            any = true;
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && IsDigit(*p)) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa) ++digits;
+                    --exponent;
+                }
+                ++p;
+                any = true;
+            }
+        }
+
+        if (!any) {
+            // 回退路径：拷贝到以0结尾的缓冲区，避免 strtof 越过映射区域
+            char buffer[64];
+            size_t len = 0;
+            for (const char* q = start; q < end && !IsSpace(*q) && *q != '\n' && len + 1 < sizeof(buffer); ++q)
+                buffer[len++] = *q;
+            buffer[len] = '\0';
+            char* parsedEnd = nullptr;
+            out = std::strtof(buffer, &parsedEnd);
+            if (parsedEnd == buffer) return nullptr;
+            return start + (parsedEnd - buffer);
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* expStart = p++;
+            bool expNegative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                expNegative = (*p == '-');
+                ++p;
+            }
+            if (p < end && IsDigit(*p)) {
+                int e = 0;
+                while (p < end && IsDigit(*p)) {
+                    if (e < 10000) e = e * 10 + (*p - '0');
+                    ++p;
+                }
+                exponent += expNegative ? -e : e;
+            } else {
+                p = expStart; // 不完整的指数部分不属于该数值
+            }
+        }
+
+        double value = static_cast<double>(mantissa);
+        if (mantissa != 0 && exponent != 0) {
+            if (exponent < 0 && exponent >= -22) value /= kPow10[-exponent];
+            else if (exponent > 0 && exponent <= 22) value *= kPow10[exponent];
+            else value *= std::pow(10.0, exponent);
+        }
+        out = static_cast<float>(negative ? -value : value);
+        return p;
+    }
+
+    const char* ParseInt(const char* p, const char* end, int& out) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (p >= end || !IsDigit(*p)) return nullptr;
+        int value = 0;
+        while (p < end && IsDigit(*p)) {
+            value = value * 10 + (*p - '0');
+            ++p;
+        }
+        out = negative ? -value : value;
+        return p;
+    }
+
+    // ---------------------------------------------------------------
+    // 分块解析
+
+    /// 与面顺序相关的指令，记录其发生时块内的三角形序号
+    struct ObjEvent {
+        enum class Type { Shape, Material, MaterialLib };
+        Type type;
+        size_t triangle;
+        std::string value;
+    };
+
+    /// 负数（相对）索引需要在得知前面块的顶点数后再修正
+    struct RelativeFixup {
+        size_t corner;
+        uint8_t component; ///< 0=v 1=vt 2=vn
+    };
+
+    struct ChunkResult {
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> texcoords;
+        std::vector<ObjIndex> corners;        ///< 三角化后的角点
+        std::vector<ObjEvent> events;
+        std::vector<RelativeFixup> relative;
+        std::vector<size_t> quads;            ///< 四边形拆分出的首个三角形序号，稍后按最短对角线重拆
+        size_t positionBase = 0, normalBase = 0, texcoordBase = 0;
+    };
+
+    // 解析索引：正数为1基绝对索引，负数为相对当前块已读数量的偏移
+    inline bool ResolveIndex(int raw, size_t localCount, int& out, bool& relative) {
+        if (raw > 0) {
+            out = raw - 1;
+            relative = false;
+            return true;
+        }
+        if (raw < 0) {
+            out = static_cast<int>(localCount) + raw;
+            relative = true;
+            return true;
+        }
+        return false;
+    }
+
+    void ParseChunk(const char* p, const char* end, ChunkResult& chunk, const std::string& path) {
+        std::vector<ObjIndex> polygon;
+        std::vector<uint8_t> polygonRelative;
+
+        while (p < end) {
+            p = SkipSpace(p, end);
+            if (p >= end) break;
+
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!lineEnd) lineEnd = end;
+
+            const char c = *p;
+            if (c == 'v' && p + 1 < lineEnd) {
+                const char c1 = p[1];
+                if (IsSpace(c1) || c1 == 'n') {
+                    auto& target = IsSpace(c1) ? chunk.positions : chunk.normals;
+                    const char* q = p + (IsSpace(c1) ? 1 : 2);
+                    for (int i = 0; i < 3; ++i) {
+                        float value = 0.0f;
+                        q = SkipSpace(q, lineEnd);
+                        if (q < lineEnd) {
+                            const char* next = ParseFloat(q, lineEnd, value);
+                            if (!next) throw std::runtime_error("Invalid number in OBJ file: " + path);
+                            q = next;
+                        }
+                        target.push_back(value);
+                    }
+                } else if (c1 == 't') {
+                    const char* q = p + 2;
+                    for (int i = 0; i < 2; ++i) {
+                        float value = 0.0f;
+                        q = SkipSpace(q, lineEnd);
+                        if (q < lineEnd) {
+                            const char* next = ParseFloat(q, lineEnd, value);
+                            if (!next) throw std::runtime_error("Invalid number in OBJ file: " + path);
+                            q = next;
+                        }
+                        chunk.texcoords.push_back(value);
+                    }
+                }
+            } else if (c == 'f' && p + 1 < lineEnd && IsSpace(p[1])) {
+                polygon.clear();
+                polygonRelative.clear();
+                const char* q = p + 1;
+                while (true) {
+                    q = SkipSpace(q, lineEnd);
+                    if (q >= lineEnd || *q == '#') break;
+
+                    ObjIndex idx;
+                    uint8_t relMask = 0;
+                    bool relative = false;
+                    int raw = 0;
+
+                    q = ParseInt(q, lineEnd, raw);
+                    if (!q || !ResolveIndex(raw, chunk.positions.size() / 3, idx.vertex, relative))
+                        throw std::runtime_error("Invalid face index in OBJ file: " + path);
+                    if (relative) relMask |= 1;
+
+                    if (q < lineEnd && *q == '/') {
+                        ++q;
+                        if (q < lineEnd && *q != '/') {
+                            q = ParseInt(q, lineEnd, raw);
+                            if (!q || !ResolveIndex(raw, chunk.texcoords.size() / 2, idx.texcoord, relative))
+                                throw std::runtime_error("Invalid texcoord index in OBJ file: " + path);
+                            if (relative) relMask |= 2;
+                        }
+                        if (q < lineEnd && *q == '/') {
+                            ++q;
+                            q = ParseInt(q, lineEnd, raw);
+                            if (!q || !ResolveIndex(raw, chunk.normals.size() / 3, idx.normal, relative))
+                                throw std::runtime_error("Invalid normal index in OBJ file: " + path);
+                            if (relative) relMask |= 4;
+                        }
+                    }
+                    polygon.push_back(idx);
+                    polygonRelative.push_back(relMask);
+                }
+
+                // 少于3个顶点的面直接忽略（与 tinyobj 一致）
+                if (polygon.size() >= 3) {
+                    auto emit = [&](size_t i) {
+                        size_t corner = chunk.corners.size();
+                        chunk.corners.push_back(polygon[i]);
+                        for (uint8_t component = 0; component < 3; ++component) {
+                            if (polygonRelative[i] & (1u << component))
+                                chunk.relative.push_back({corner, component});
+                        }
+                    };
+                    if (polygon.size() == 4)
+                        chunk.quads.push_back(chunk.corners.size() / 3);
+                    // 先按扇形三角化，四边形在顶点合并后再按对角线长度调整
+                    for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                        emit(0);
+                        emit(i);
+                        emit(i + 1);
+                    }
+                }
+            } else if ((c == 'o' || c == 'g') && p + 1 < lineEnd && IsSpace(p[1])) {
+                chunk.events.push_back({ObjEvent::Type::Shape, chunk.corners.size() / 3, TrimmedRest(p + 1, lineEnd)});
+            } else if (StartsWithToken(p, lineEnd, "usemtl", 6)) {
+                chunk.events.push_back({ObjEvent::Type::Material, chunk.corners.size() / 3, TrimmedRest(p + 6, lineEnd)});
+            } else if (StartsWithToken(p, lineEnd, "mtllib", 6)) {
+                chunk.events.push_back({ObjEvent::Type::MaterialLib, chunk.corners.size() / 3, TrimmedRest(p + 6, lineEnd)});
+            }
+
+            p = lineEnd + 1;
+        }
+    }
+
+    // 修正相对索引、校验范围，并对四边形按最短对角线重新拆分
+    void FinalizeChunk(ChunkResult& chunk, const ObjData& data, const std::string& path) {
+        for (const auto& fix : chunk.relative) {
+            ObjIndex& idx = chunk.corners[fix.corner];
+            switch (fix.component) {
+                case 0: idx.vertex += static_cast<int>(chunk.positionBase); break;
+                case 1: idx.texcoord += static_cast<int>(chunk.texcoordBase); break;
+                default: idx.normal += static_cast<int>(chunk.normalBase); break;
+            }
+        }
+
+        const int positionCount = static_cast<int>(data.positions.size() / 3);
+        const int normalCount = static_cast<int>(data.normals.size() / 3);
+        const int texcoordCount = static_cast<int>(data.texcoords.size() / 2);
+        for (const auto& idx : chunk.corners) {
+            if (idx.vertex < 0 || idx.vertex >= positionCount ||
+                idx.normal >= normalCount || idx.texcoord >= texcoordCount ||
+                (idx.normal < -1) || (idx.texcoord < -1)) {
+                throw std::runtime_error("Face index out of range in OBJ file: " + path);
+            }
+        }
+
+        const float* v = data.positions.data();
+        for (size_t tri : chunk.quads) {
+            ObjIndex* t = &chunk.corners[tri * 3];
+            const ObjIndex i0 = t[0], i1 = t[1], i2 = t[2], i3 = t[5];
+            auto dist2 = [v](int a, int b) {
+                float dx = v[3 * b] - v[3 * a], dy = v[3 * b + 1] - v[3 * a + 1], dz = v[3 * b + 2] - v[3 * a + 2];
+                return dx * dx + dy * dy + dz * dz;
+            };
+            if (!(dist2(i0.vertex, i2.vertex) < dist2(i1.vertex, i3.vertex))) {
+                // [0, 1, 3], [1, 2, 3]
+                t[0] = i0; t[1] = i1; t[2] = i3;
+                t[3] = i1; t[4] = i2; t[5] = i3;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------
+    // 顶点去重用扁平哈希表（开放寻址 + 线性探测）
+
+    class VertexHashTable {
+    public:
+        void Reset(size_t expected) {
+            size_t capacity = 16;
+            while (capacity < expected * 2) capacity <<= 1;
+            m_Mask = capacity - 1;
+            m_Keys.resize(capacity);
+            m_Values.assign(capacity, kEmpty);
+        }
+
+        /// 查找键，不存在时插入 value；返回表中对应的值
+        uint32_t FindOrInsert(const ObjIndex& key, uint32_t value, bool& inserted) {
+            size_t slot = Hash(key) & m_Mask;
+            while (true) {
+                uint32_t existing = m_Values[slot];
+                if (existing == kEmpty) {
+                    m_Keys[slot] = key;
+                    m_Values[slot] = value;
+                    inserted = true;
+                    return value;
+                }
+                const ObjIndex& k = m_Keys[slot];
+                if (k.vertex == key.vertex && k.normal == key.normal && k.texcoord == key.texcoord) {
+                    inserted = false;
+                    return existing;
+                }
+                slot = (slot + 1) & m_Mask;
+            }
+        }
+
+    private:
+        static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+        static size_t Hash(const ObjIndex& key) {
+            uint64_t h = static_cast<uint32_t>(key.vertex);
+            h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(key.normal);
+            h = h * 0x9E3779B97F4A7C15ull ^ static_cast<uint32_t>(key.texcoord);
+            h ^= h >> 32;
+            h *= 0xD6E8FEB86659FD93ull;
+            h ^= h >> 32;
+            return static_cast<size_t>(h);
+        }
+
+        std::vector<ObjIndex> m_Keys;
+        std::vector<uint32_t> m_Values;
+        size_t m_Mask = 0;
+    };
+
+    void BuildShapeMeshes(const ObjData& obj, const ObjShape& shape, std::vector<MeshData>& out) {
+        const size_t triangleCount = shape.materialIds.size();
+        const size_t groupCount = obj.materials.size() + 1; // 第0组对应材质 -1
+
+        // 按材质做稳定的计数排序，保持组内三角形的原始顺序
+        std::vector<uint32_t> groupStart(groupCount + 1, 0);
+        for (int matID : shape.materialIds) ++groupStart[static_cast<size_t>(matID + 1) + 1];
+        for (size_t g = 0; g < groupCount; ++g) groupStart[g + 1] += groupStart[g];
+
+        std::vector<uint32_t> order(triangleCount);
+        {
+            std::vector<uint32_t> cursor(groupStart.begin(), groupStart.end() - 1);
+            for (size_t tri = 0; tri < triangleCount; ++tri)
+                order[cursor[static_cast<size_t>(shape.materialIds[tri] + 1)]++] = static_cast<uint32_t>(tri);
+        }
+
+        VertexHashTable table;
+        for (size_t g = 0; g < groupCount; ++g) {
+            const uint32_t begin = groupStart[g], end = groupStart[g + 1];
+            if (begin == end) continue;
+
+            MeshData mesh;
+            mesh.materialId = static_cast<int>(g) - 1;
+            mesh.indices.reserve(static_cast<size_t>(end - begin) * 3);
+            table.Reset(static_cast<size_t>(end - begin) * 3);
+
+            for (uint32_t i = begin; i < end; ++i) {
+                const ObjIndex* tri = &shape.indices[static_cast<size_t>(order[i]) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    const ObjIndex& idx = tri[c];
+                    bool inserted = false;
+                    uint32_t vertIndex = table.FindOrInsert(idx, static_cast<uint32_t>(mesh.vertices.size()), inserted);
+                    if (inserted) {
+                        Vertex vertex{};
+                        const float* pos = &obj.positions[3 * static_cast<size_t>(idx.vertex)];
+                        vertex.Position = {pos[0], pos[1], pos[2]};
+                        if (idx.normal >= 0) {
+                            const float* n = &obj.normals[3 * static_cast<size_t>(idx.normal)];
+                            vertex.Normal = {n[0], n[1], n[2]};
+                        }
+                        if (idx.texcoord >= 0) {
+                            const float* uv = &obj.texcoords[2 * static_cast<size_t>(idx.texcoord)];
+                            vertex.TexCoords = {uv[0], uv[1]};
+                        }
+                        mesh.vertices.push_back(vertex);
+                    }
+                    mesh.indices.push_back(vertIndex);
+                }
+            }
+            out.push_back(std::move(mesh));
+        }
+    }
+
+} // namespace
+
+    std::vector<ObjMaterial> ObjParser::ParseMtl(const std::string& path) {
+        std::vector<ObjMaterial> materials;
+        if (!utils::VirtualFileSystem::Exists(path)) return materials;
+
+        utils::FileView file = utils::VirtualFileSystem::Open(path);
+        const char* p = file.Data();
+        const char* end = p + file.Size();
+
+        // 纹理指令可能带有 -bm 等选项，文件名取最后一个字段
+        auto textureName = [](const char* q, const char* lineEnd) {
+            std::string rest = TrimmedRest(q, lineEnd);
+            size_t split = rest.find_last_of(" \t");
+            return split == std::string::npos ? rest : rest.substr(split + 1);
+        };
+
+        while (p && p < end) {
+            p = SkipSpace(p, end);
+            if (p >= end) break;
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!lineEnd) lineEnd = end;
+
+            if (StartsWithToken(p, lineEnd, "newmtl", 6)) {
+                materials.emplace_back();
+                materials.back().name = TrimmedRest(p + 6, lineEnd);
+            } else if (!materials.empty()) {
+                ObjMaterial& mat = materials.back();
+                if (StartsWithToken(p, lineEnd, "map_Kd", 6)) {
+                    mat.diffuseTexname = textureName(p + 6, lineEnd);
+                } else if (StartsWithToken(p, lineEnd, "map_Ks", 6)) {
+                    mat.specularTexname = textureName(p + 6, lineEnd);
+                } else if (StartsWithToken(p, lineEnd, "map_Bump", 8) || StartsWithToken(p, lineEnd, "map_bump", 8)) {
+                    mat.bumpTexname = textureName(p + 8, lineEnd);
+                } else if (StartsWithToken(p, lineEnd, "bump", 4)) {
+                    mat.bumpTexname = textureName(p + 4, lineEnd);
+                }
+            }
+            p = lineEnd + 1;
+        }
+        return materials;
+    }
+
+    ObjData ObjParser::Parse(const std::string& path, unsigned int threadCount) {
+        utils::FileView file = utils::VirtualFileSystem::Open(path);
+        // 块经任务系统分发（加载任务中嵌套调用也不会额外创建线程）；threadCount 为 1 时在调用线程串行
+        if (threadCount != 1) core::JobSystem::Initialize();
+        const size_t threads = threadCount == 1 ? 1 : std::max<size_t>(1, core::JobSystem::GetThreadCount());
+        const char* data = file.Data();
+        const size_t size = file.Size();
+
+        // 1. 按行对齐切块
+        size_t chunkCount = std::max<size_t>(1, std::min<size_t>(size / kMinChunkSize, threads * 2));
+        std::vector<const char*> bounds{data};
+        for (size_t i = 1; i < chunkCount; ++i) {
+            const char* p = std::max(bounds.back(), data + size * i / chunkCount);
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(data + size - p)));
+            if (!nl) break;
+            bounds.push_back(nl + 1);
+        }
+        bounds.push_back(data + size);
+        chunkCount = bounds.size() - 1;
+        // threadCount 为 1 时整段作为一个区间，在调用线程执行（任务系统已由他处启动时也不分发）
+        const size_t grain = threadCount == 1 ? chunkCount : 1;
+
+        // 2. 并行解析各块
+        std::vector<ChunkResult> chunks(chunkCount);
+        core::JobSystem::ParallelFor(chunkCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (bounds[i] < bounds[i + 1])
+                    ParseChunk(bounds[i], bounds[i + 1], chunks[i], path);
+            }
+        }, grain);
+
+        // 3. 前缀和得到各块顶点属性的全局起始位置，并行拷贝合并
+        ObjData obj;
+        size_t positionTotal = 0, normalTotal = 0, texcoordTotal = 0;
+        for (auto& chunk : chunks) {
+            chunk.positionBase = positionTotal / 3;
+            chunk.normalBase = normalTotal / 3;
+            chunk.texcoordBase = texcoordTotal / 2;
+            positionTotal += chunk.positions.size();
+            normalTotal += chunk.normals.size();
+            texcoordTotal += chunk.texcoords.size();
+        }
+        obj.positions.resize(positionTotal);
+        obj.normals.resize(normalTotal);
+        obj.texcoords.resize(texcoordTotal);
+
+        core::JobSystem::ParallelFor(chunkCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ChunkResult& chunk = chunks[i];
+                std::copy(chunk.positions.begin(), chunk.positions.end(), obj.positions.begin() + chunk.positionBase * 3);
+                std::copy(chunk.normals.begin(), chunk.normals.end(), obj.normals.begin() + chunk.normalBase * 3);
+                std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), obj.texcoords.begin() + chunk.texcoordBase * 2);
+                chunk.positions = {};
+                chunk.normals = {};
+                chunk.texcoords = {};
+            }
+        }, grain);
+        core::JobSystem::ParallelFor(chunkCount, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) FinalizeChunk(chunks[i], obj, path);
+        }, grain);
+
+        // 4. 顺序处理 o/g/usemtl/mtllib 指令，组装各 shape
+        const std::filesystem::path baseDir = std::filesystem::path(path).parent_path();
+        std::unordered_map<std::string, int> materialMap;
+        ObjShape shape;
+        int material = -1;
+
+        auto appendTriangles = [&](const ChunkResult& chunk, size_t begin, size_t end) {
+            if (begin >= end) return;
+            shape.indices.insert(shape.indices.end(), chunk.corners.begin() + begin * 3, chunk.corners.begin() + end * 3);
+            shape.materialIds.insert(shape.materialIds.end(), end - begin, material);
+        };
+
+        for (const auto& chunk : chunks) {
+            size_t cursor = 0;
+            for (const auto& event : chunk.events) {
+                appendTriangles(chunk, cursor, event.triangle);
+                cursor = event.triangle;
+
+                switch (event.type) {
+                    case ObjEvent::Type::Shape:
+                        if (!shape.indices.empty()) obj.shapes.push_back(std::move(shape));
+                        shape = ObjShape{};
+                        shape.name = event.value;
+                        break;
+                    case ObjEvent::Type::Material: {
+                        auto it = materialMap.find(event.value);
+                        if (it != materialMap.end()) {
+                            material = it->second;
+                        } else {
+                            material = -1;
+                            std::cout << "[ObjParser Warning] material [ '" << event.value << "' ] not found in .mtl" << std::endl;
+                        }
+                        break;
+                    }
+                    case ObjEvent::Type::MaterialLib: {
+                        // mtllib 可列出多个文件，取第一个可以读取的
+                        size_t begin = 0;
+                        bool loaded = false;
+                        while (!loaded && begin < event.value.size()) {
+                            size_t split = event.value.find_first_of(" \t", begin);
+                            std::string name = event.value.substr(begin, split == std::string::npos ? std::string::npos : split - begin);
+                            begin = split == std::string::npos ? event.value.size() : split + 1;
+                            if (name.empty()) continue;
+
+                            auto mtlPath = (baseDir / name).string();
+                            if (!utils::VirtualFileSystem::Exists(mtlPath)) continue;
+                            for (auto& mat : ParseMtl(mtlPath)) {
+                                materialMap.emplace(mat.name, static_cast<int>(obj.materials.size()));
+                                obj.materials.push_back(std::move(mat));
+                            }
+                            obj.materialLibraries.push_back(name);
+                            loaded = true;
+                        }
+                        if (!loaded)
+                            std::cout << "[ObjParser Warning] Failed to load material file(s): " << event.value << std::endl;
+                        break;
+                    }
+                }
+            }
+            appendTriangles(chunk, cursor, chunk.corners.size() / 3);
+        }
+        if (!shape.indices.empty()) obj.shapes.push_back(std::move(shape));
+
+        return obj;
+    }
+
+    std::vector<MeshData> ObjParser::BuildMeshes(const ObjData& obj, unsigned int threadCount) {
+        std::vector<std::vector<MeshData>> perShape(obj.shapes.size());
+        const size_t count = obj.shapes.size();
+        core::JobSystem::ParallelFor(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) BuildShapeMeshes(obj, obj.shapes[i], perShape[i]);
+        }, threadCount == 1 ? count : 1);
+
+        std::vector<MeshData> meshes;
+        for (auto& list : perShape) {
+            for (auto& mesh : list) meshes.push_back(std::move(mesh));
+        }
+        return meshes;
+    }
+
+} // namespace graphics
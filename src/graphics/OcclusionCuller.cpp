@@ -0,0 +1,310 @@
+#include "graphics/OcclusionCuller.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RRENDER_OCCLUSION_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace graphics {
+
+    bool OcclusionCuller::s_Enabled = true;
+    bool OcclusionCuller::s_SimdEnabled = true;
+    unsigned int OcclusionCuller::s_ThreadCount = 0;
+    OcclusionCuller::Stats OcclusionCuller::s_Stats;
+
+namespace {
+
+    /// 每个线程分到的行带数，带多于线程便于负载均衡
+    constexpr unsigned int kBandsPerThread = 4;
+    /// 三角形少于此数时单线程光栅化：每个行带都要分发任务并遍历全部三角形做行范围筛选，批量小时这部分开销高于并行收益
+    constexpr size_t kParallelTriangles = 2048;
+
+    /// 裁剪空间顶点在近平面（z = -w）内侧的距离
+    float NearDistance(const glm::vec4& v) { return v.z + v.w; }
+
+} // namespace
+
+    void OccluderMesh::Append(const glm::vec3* vertexPositions, size_t vertexCount, size_t stride,
+                              const unsigned int* triangleIndices, size_t indexCount) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(vertexPositions);
+        std::unordered_map<unsigned int, uint32_t> remap;
+        remap.reserve(indexCount);
+        indices.reserve(indices.size() + indexCount);
+        for (size_t i = 0; i + 2 < indexCount; i += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                const unsigned int index = triangleIndices[i + k];
+                if (index >= vertexCount) throw std::runtime_error("[OccluderMesh] Index out of range");
+                auto it = remap.find(index);
+                if (it == remap.end()) {
+                    it = remap.emplace(index, static_cast<uint32_t>(positions.size())).first;
+                    positions.push_back(*reinterpret_cast<const glm::vec3*>(bytes + index * stride));
+                }
+                indices.push_back(it->second);
+            }
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) : m_Width(width), m_Height(height) {
+        if (width == 0 || height == 0 || width % 4 != 0) {
+            throw std::runtime_error("[OcclusionBuffer] Width must be a positive multiple of 4");
+        }
+        m_Depth.assign(static_cast<size_t>(width) * height, 1.0f);
+        uint32_t w = width, h = height;
+        while (w > 1 || h > 1) {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+            Level level;
+            level.width = w;
+            level.height = h;
+            level.minDepth.assign(static_cast<size_t>(w) * h, 1.0f);
+            level.maxDepth.assign(static_cast<size_t>(w) * h, 1.0f);
+            m_Levels.push_back(std::move(level));
+        }
+    }
+
+    void OcclusionBuffer::Begin(const glm::mat4& viewProjection) {
+        m_ViewProjection = viewProjection;
+        m_Triangles.clear();
+        std::fill(m_Depth.begin(), m_Depth.end(), 1.0f);
+    }
+
+    void OcclusionBuffer::AddOccluder(const OccluderMesh& mesh, const glm::mat4& model) {
+        const glm::mat4 mvp = m_ViewProjection * model;
+        m_Clip.resize(mesh.positions.size());
+        for (size_t i = 0; i < mesh.positions.size(); ++i) m_Clip[i] = mvp * glm::vec4(mesh.positions[i], 1.0f);
+
+        const glm::vec2 scale(0.5f * static_cast<float>(m_Width), 0.5f * static_cast<float>(m_Height));
+        auto toScreen = [&](const glm::vec4& v) {
+            const float invW = 1.0f / v.w;
+            return glm::vec3((v.x * invW + 1.0f) * scale.x, (v.y * invW + 1.0f) * scale.y, v.z * invW);
+        };
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const glm::vec4 v[3] = {m_Clip[mesh.indices[i]], m_Clip[mesh.indices[i + 1]], m_Clip[mesh.indices[i + 2]]};
+            // 三个顶点都在同一裁剪平面外侧时整个丢弃
+            if ((v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w) ||
+                (v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w) ||
+                (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w) ||
+                (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w) ||
+                (v[0].z > v[0].w && v[1].z > v[1].w && v[2].z > v[2].w)) {
+                continue;
+            }
+
+            const float d[3] = {NearDistance(v[0]), NearDistance(v[1]), NearDistance(v[2])};
+            const int inside = (d[0] >= 0.0f) + (d[1] >= 0.0f) + (d[2] >= 0.0f);
+            if (inside == 0) continue;
+            if (inside == 3) {
+                SetupTriangle(toScreen(v[0]), toScreen(v[1]), toScreen(v[2]));
+                continue;
+            }
+
+            // 与近平面相交：保留内侧部分（三角形或四边形），按原顶点顺序输出以保持朝向
+            glm::vec4 polygon[4];
+            int count = 0;
+            for (int k = 0; k < 3; ++k) {
+                const int next = (k + 1) % 3;
+                if (d[k] >= 0.0f) polygon[count++] = v[k];
+                if ((d[k] >= 0.0f) != (d[next] >= 0.0f)) {
+                    const float t = d[k] / (d[k] - d[next]);
+                    polygon[count++] = v[k] + t * (v[next] - v[k]);
+                }
+            }
+            const glm::vec3 s0 = toScreen(polygon[0]);
+            for (int k = 1; k + 1 < count; ++k) SetupTriangle(s0, toScreen(polygon[k]), toScreen(polygon[k + 1]));
+        }
+    }
+
+    void OcclusionBuffer::SetupTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+        // 屏幕 y 向上，逆时针三角形面积为正；背面与退化三角形丢弃
+        const float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+        if (!(area > 0.0f)) return;
+
+        // 覆盖像素中心 (x + 0.5, y + 0.5) 的范围
+        Triangle tri;
+        tri.minX = std::max(0, static_cast<int32_t>(std::ceil(std::min({a.x, b.x, c.x}) - 0.5f)));
+        tri.maxX = std::min(static_cast<int32_t>(m_Width) - 1, static_cast<int32_t>(std::floor(std::max({a.x, b.x, c.x}) - 0.5f)));
+        tri.minY = std::max(0, static_cast<int32_t>(std::ceil(std::min({a.y, b.y, c.y}) - 0.5f)));
+        tri.maxY = std::min(static_cast<int32_t>(m_Height) - 1, static_cast<int32_t>(std::floor(std::max({a.y, b.y, c.y}) - 0.5f)));
+        if (tri.minX > tri.maxX || tri.minY > tri.maxY) return;
+
+        // 边 i 从顶点 i 指向顶点 i + 1：E(x, y) = A x + B y + C，内部非负
+        const glm::vec3 v[3] = {a, b, c};
+        for (int i = 0; i < 3; ++i) {
+            const glm::vec3& p = v[i];
+            const glm::vec3& q = v[(i + 1) % 3];
+            tri.edgeA[i] = p.y - q.y;
+            tri.edgeB[i] = q.x - p.x;
+            tri.edgeC[i] = -(tri.edgeA[i] * p.x + tri.edgeB[i] * p.y);
+        }
+        // NDC 深度在屏幕空间线性
+        tri.depthX = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+        tri.depthY = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+        tri.depthC = a.z - tri.depthX * a.x - tri.depthY * a.y;
+        m_Triangles.push_back(tri);
+    }
+
+    void OcclusionBuffer::Rasterize(unsigned int threadCount) {
+        if (m_Triangles.size() < kParallelTriangles || threadCount == 1) {
+            RasterizeRows(0, static_cast<int32_t>(m_Height));
+            BuildLevels();
+            return;
+        }
+        // 按行分带，各带只写自己的行；带由 JobSystem 分发，0 表示按任务系统的线程数分带
+        const size_t threads = threadCount > 0 ? threadCount : std::max<size_t>(1, core::JobSystem::GetThreadCount());
+        const uint32_t bands = static_cast<uint32_t>(std::min<size_t>(m_Height, threads * kBandsPerThread));
+        core::JobSystem::ParallelFor(bands, [&](size_t begin, size_t end) {
+            for (size_t band = begin; band < end; ++band) {
+                const auto firstRow = static_cast<int32_t>(band * m_Height / bands);
+                const auto endRow = static_cast<int32_t>((band + 1) * m_Height / bands);
+                RasterizeRows(firstRow, endRow);
+            }
+        }, 1);
+        BuildLevels();
+    }
+
+    void OcclusionBuffer::RasterizeRows(int32_t firstRow, int32_t endRow) {
+        const bool simd = OcclusionCuller::IsSimdEnabled();
+        for (const Triangle& tri : m_Triangles) {
+            const int32_t y0 = std::max(tri.minY, firstRow);
+            const int32_t y1 = std::min(tri.maxY, endRow - 1);
+            if (y0 > y1) continue;
+
+#ifdef RRENDER_OCCLUSION_SSE
+            if (simd) {
+                // 行首对齐到 4 个像素，各量在行首按像素中心求值后每次前进 4 个像素
+                const int32_t x0 = tri.minX & ~3;
+                const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+                const __m128 px0 = _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)), laneOffset);
+                __m128 edgeA[3], edgeStep[3];
+                for (int i = 0; i < 3; ++i) {
+                    edgeA[i] = _mm_set1_ps(tri.edgeA[i]);
+                    edgeStep[i] = _mm_set1_ps(4.0f * tri.edgeA[i]);
+                }
+                const __m128 depthStep = _mm_set1_ps(4.0f * tri.depthX);
+                const __m128 zero = _mm_setzero_ps();
+                for (int32_t y = y0; y <= y1; ++y) {
+                    const float py = static_cast<float>(y) + 0.5f;
+                    __m128 edge[3];
+                    for (int i = 0; i < 3; ++i) {
+                        edge[i] = _mm_add_ps(_mm_mul_ps(edgeA[i], px0), _mm_set1_ps(tri.edgeB[i] * py + tri.edgeC[i]));
+                    }
+                    __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.depthX), px0),
+                                              _mm_set1_ps(tri.depthY * py + tri.depthC));
+                    float* row = m_Depth.data() + static_cast<size_t>(y) * m_Width;
+                    for (int32_t x = x0; x <= tri.maxX; x += 4) {
+                        const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge[0], zero), _mm_cmpge_ps(edge[1], zero)),
+                                                         _mm_cmpge_ps(edge[2], zero));
+                        if (_mm_movemask_ps(inside)) {
+                            const __m128 old = _mm_loadu_ps(row + x);
+                            const __m128 nearer = _mm_min_ps(old, depth);
+                            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+                        }
+                        for (int i = 0; i < 3; ++i) edge[i] = _mm_add_ps(edge[i], edgeStep[i]);
+                        depth = _mm_add_ps(depth, depthStep);
+                    }
+                }
+                continue;
+            }
+#endif
+            for (int32_t y = y0; y <= y1; ++y) {
+                const float py = static_cast<float>(y) + 0.5f;
+                float* row = m_Depth.data() + static_cast<size_t>(y) * m_Width;
+                for (int32_t x = tri.minX; x <= tri.maxX; ++x) {
+                    const float px = static_cast<float>(x) + 0.5f;
+                    bool inside = true;
+                    for (int i = 0; i < 3; ++i) inside &= tri.edgeA[i] * px + tri.edgeB[i] * py + tri.edgeC[i] >= 0.0f;
+                    if (!inside) continue;
+                    row[x] = std::min(row[x], tri.depthX * px + tri.depthY * py + tri.depthC);
+                }
+            }
+        }
+    }
+
+    void OcclusionBuffer::BuildLevels() {
+        const float* srcMin = m_Depth.data();
+        const float* srcMax = m_Depth.data();
+        uint32_t srcWidth = m_Width, srcHeight = m_Height;
+        for (Level& level : m_Levels) {
+            for (uint32_t y = 0; y < level.height; ++y) {
+                const uint32_t sy0 = 2 * y, sy1 = std::min(2 * y + 1, srcHeight - 1);
+                for (uint32_t x = 0; x < level.width; ++x) {
+                    const uint32_t sx0 = 2 * x, sx1 = std::min(2 * x + 1, srcWidth - 1);
+                    const size_t i00 = sy0 * srcWidth + sx0, i01 = sy0 * srcWidth + sx1;
+                    const size_t i10 = sy1 * srcWidth + sx0, i11 = sy1 * srcWidth + sx1;
+                    const size_t dst = static_cast<size_t>(y) * level.width + x;
+                    level.minDepth[dst] = std::min(std::min(srcMin[i00], srcMin[i01]), std::min(srcMin[i10], srcMin[i11]));
+                    level.maxDepth[dst] = std::max(std::max(srcMax[i00], srcMax[i01]), std::max(srcMax[i10], srcMax[i11]));
+                }
+            }
+            srcMin = level.minDepth.data();
+            srcMax = level.maxDepth.data();
+            srcWidth = level.width;
+            srcHeight = level.height;
+        }
+    }
+
+    bool OcclusionBuffer::IsVisible(const BoundingBox& worldBox) const {
+        // 8 个角投影到屏幕；任一角在近平面外侧时无法得到可靠的屏幕矩形，保守地判为可见
+        glm::vec2 ndcMin(1e30f), ndcMax(-1e30f);
+        float nearest = 1e30f;
+        for (int i = 0; i < 8; ++i) {
+            const glm::vec3 corner((i & 1) ? worldBox.max.x : worldBox.min.x, (i & 2) ? worldBox.max.y : worldBox.min.y,
+                                   (i & 4) ? worldBox.max.z : worldBox.min.z);
+            const glm::vec4 clip = m_ViewProjection * glm::vec4(corner, 1.0f);
+            if (NearDistance(clip) <= 0.0f || clip.w <= 0.0f) return true;
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+            ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+            nearest = std::min(nearest, ndc.z);
+        }
+
+        // 与矩形有交集的全部像素
+        const auto toPixel = [](float ndc, uint32_t size) {
+            return static_cast<int32_t>(std::floor((ndc + 1.0f) * 0.5f * static_cast<float>(size)));
+        };
+        const int32_t x0 = std::max(0, toPixel(ndcMin.x, m_Width));
+        const int32_t x1 = std::min(static_cast<int32_t>(m_Width) - 1, toPixel(ndcMax.x, m_Width));
+        const int32_t y0 = std::max(0, toPixel(ndcMin.y, m_Height));
+        const int32_t y1 = std::min(static_cast<int32_t>(m_Height) - 1, toPixel(ndcMax.y, m_Height));
+        if (x0 > x1 || y0 > y1) return false;   // 完全在屏幕外
+
+        // 从矩形最多覆盖 2 x 2 个texel 的层级开始
+        uint32_t start = 0;
+        while (start < m_Levels.size() && ((x1 >> start) - (x0 >> start) > 1 || (y1 >> start) - (y0 >> start) > 1)) ++start;
+
+        struct Texel {
+            uint32_t level;
+            int32_t x, y;
+        };
+        // 每弹出一个最多压入 4 个，栈深不超过 4 + 3 × 层数
+        Texel stack[4 + 3 * 32];
+        int count = 0;
+        for (int32_t y = y0 >> start; y <= (y1 >> start); ++y)
+            for (int32_t x = x0 >> start; x <= (x1 >> start); ++x) stack[count++] = {start, x, y};
+
+        while (count > 0) {
+            const Texel texel = stack[--count];
+            if (texel.level == 0) {
+                if (nearest <= m_Depth[static_cast<size_t>(texel.y) * m_Width + texel.x]) return true;
+                continue;
+            }
+            const Level& level = m_Levels[texel.level - 1];
+            const size_t index = static_cast<size_t>(texel.y) * level.width + texel.x;
+            if (nearest > level.maxDepth[index]) continue;   // 该区域所有像素的遮挡体都更近
+            if (nearest <= level.minDepth[index]) return true;
+            // 细化到下一级中与矩形相交的子texel
+            const uint32_t child = texel.level - 1;
+            const int32_t cx0 = std::max(2 * texel.x, x0 >> child), cx1 = std::min(2 * texel.x + 1, x1 >> child);
+            const int32_t cy0 = std::max(2 * texel.y, y0 >> child), cy1 = std::min(2 * texel.y + 1, y1 >> child);
+            for (int32_t y = cy0; y <= cy1; ++y)
+                for (int32_t x = cx0; x <= cx1; ++x) stack[count++] = {child, x, y};
+        }
+        return false;
+    }
+
+} // namespace graphics
@@ -0,0 +1,226 @@
+#include "graphics/RenderCommand.h"
+#include "graphics/Frustum.h"
+#include "graphics/Mesh.h"
+#include "graphics/Model.h"
+#include "graphics/Texture.h"
+#include <cstring>
+
+namespace graphics {
+
+    CommandExecutor::Stats CommandExecutor::s_Stats;
+
+    void CommandExecutor::BindPipeline(const BindPipelineCommand& command) {
+        if (command.program == m_Program) {
+            m_Stats.programs.skipped++;
+        } else {
+            if (!m_DryRun) glUseProgram(command.program);
+            m_Program = command.program;
+            m_Stats.programs.issued++;
+            // uniform 属于程序状态，换程序后模型矩阵需要重新写入
+            m_DrawData = nullptr;
+        }
+        if (command.modelLocation != m_ModelLocation) {
+            m_ModelLocation = command.modelLocation;
+            m_DrawData = nullptr;
+        }
+    }
+
+    void CommandExecutor::BindMaterial(const BindMaterialCommand& command) {
+        for (uint32_t i = 0; i < command.textureCount; ++i) {
+            unsigned int texture = command.textures[i];
+            if (texture == 0) texture = m_DryRun ? UINT32_MAX : Texture::GetPlaceholderID();
+            if (texture == m_Textures[i]) {
+                m_Stats.textures.skipped++;
+                continue;
+            }
+            if (m_ActiveUnit != i) {
+                if (!m_DryRun) glActiveTexture(GL_TEXTURE0 + i);
+                m_ActiveUnit = i;
+            }
+            if (!m_DryRun) glBindTexture(GL_TEXTURE_2D, texture);
+            m_Textures[i] = texture;
+            m_Stats.textures.issued++;
+        }
+    }
+
+    void CommandExecutor::SetDrawData(const SetDrawDataCommand& command) {
+        // 同一份命令（同一实体的多个子网格）只写一次
+        if (&command == m_DrawData) {
+            m_Stats.drawData.skipped++;
+            return;
+        }
+        if (!m_DryRun) glUniformMatrix4fv(m_ModelLocation, 1, GL_FALSE, &command.model[0][0]);
+        m_DrawData = &command;
+        m_Stats.drawData.issued++;
+    }
+
+    void CommandExecutor::Draw(const DrawCommand& command) {
+        m_Stats.draws++;
+        if (command.vao == 0) {
+            if (!m_DryRun) Model::DrawPlaceholder();
+            // 占位绘制自行绑定了纹理与 VAO
+            Invalidate();
+            return;
+        }
+
+        // 常量属性不属于VAO状态，与上一次相同时不必重写
+        const bool sameDequant = m_DequantValid &&
+                                 std::memcmp(m_Dequant, command.dequantOffset, sizeof(float) * 4) == 0 &&
+                                 std::memcmp(m_Dequant + 4, command.dequantScale, sizeof(float) * 4) == 0;
+        const bool sameVao = command.vao == m_VAO;
+        if (!sameDequant) {
+            if (!m_DryRun) {
+                glVertexAttrib4fv(Mesh::kDequantOffsetLocation, command.dequantOffset);
+                glVertexAttrib4fv(Mesh::kDequantScaleLocation, command.dequantScale);
+            }
+            std::memcpy(m_Dequant, command.dequantOffset, sizeof(float) * 4);
+            std::memcpy(m_Dequant + 4, command.dequantScale, sizeof(float) * 4);
+            m_DequantValid = true;
+        }
+        if (!sameVao) {
+            if (!m_DryRun) glBindVertexArray(command.vao);
+            m_VAO = command.vao;
+        }
+        if (sameDequant && sameVao) m_Stats.meshes.skipped++;
+        else m_Stats.meshes.issued++;
+
+        if (!m_DryRun) {
+            if (command.rangeCount > 0) {
+                glMultiDrawElements(GL_TRIANGLES, command.GetCounts(), GL_UNSIGNED_INT, command.GetOffsets(),
+                                    static_cast<GLsizei>(command.rangeCount));
+            } else {
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(command.indexCount), GL_UNSIGNED_INT,
+                               reinterpret_cast<const void*>(static_cast<uintptr_t>(command.firstIndex) *
+                                                             sizeof(unsigned int)));
+            }
+        }
+        Mesh::AddDrawStats(1, command.triangles);
+    }
+
+    void CommandExecutor::Execute(const RenderCommandHeader& header) {
+        switch (header.type) {
+            case RenderCommandType::BindPipeline: BindPipeline(reinterpret_cast<const BindPipelineCommand&>(header)); break;
+            case RenderCommandType::BindMaterial: BindMaterial(reinterpret_cast<const BindMaterialCommand&>(header)); break;
+            case RenderCommandType::SetDrawData: SetDrawData(reinterpret_cast<const SetDrawDataCommand&>(header)); break;
+            case RenderCommandType::Draw: Draw(reinterpret_cast<const DrawCommand&>(header)); break;
+        }
+    }
+
+    void CommandExecutor::Finish() {
+        if (m_VAO != 0 && !m_DryRun) glBindVertexArray(0);
+
+        const auto accumulate = [](BindCount& total, const BindCount& local) {
+            total.issued += local.issued;
+            total.skipped += local.skipped;
+        };
+        s_Stats.draws += m_Stats.draws;
+        accumulate(s_Stats.programs, m_Stats.programs);
+        accumulate(s_Stats.textures, m_Stats.textures);
+        accumulate(s_Stats.meshes, m_Stats.meshes);
+        accumulate(s_Stats.drawData, m_Stats.drawData);
+        m_Stats = Stats{};
+        m_Program = 0;
+        m_ModelLocation = -1;
+        Invalidate();
+    }
+
+    void CommandExecutor::Invalidate() {
+        m_DrawData = nullptr;
+        std::fill(std::begin(m_Textures), std::end(m_Textures), 0u);
+        m_ActiveUnit = UINT32_MAX;
+        m_VAO = 0;
+        m_DequantValid = false;
+    }
+
+    void CommandBuffer::BindPipeline(unsigned int program, int modelLocation) {
+        auto& command = Append<BindPipelineCommand>();
+        command.program = program;
+        command.modelLocation = modelLocation;
+    }
+
+    void CommandBuffer::BindMaterial(const unsigned int* textures, size_t count) {
+        auto& command = Append<BindMaterialCommand>();
+        command.textureCount = static_cast<uint32_t>(std::min<size_t>(count, BindMaterialCommand::kMaxTextures));
+        std::memcpy(command.textures, textures, command.textureCount * sizeof(uint32_t));
+    }
+
+    void CommandBuffer::SetDrawData(const glm::mat4& model) {
+        Append<SetDrawDataCommand>().model = model;
+    }
+
+    void CommandBuffer::Draw(const DrawCommand& command, const MeshletCuller::DrawList* ranges) {
+        const size_t rangeCount = ranges ? ranges->counts.size() : 0;
+        auto& draw = Append<DrawCommand>(rangeCount * (sizeof(const void*) + sizeof(GLsizei)));
+        const RenderCommandHeader header = draw.header;
+        draw = command;
+        draw.header = header;
+        draw.rangeCount = static_cast<uint32_t>(rangeCount);
+        if (rangeCount > 0) {
+            // 偏移在前，保证 8 字节对齐
+            uint8_t* extra = reinterpret_cast<uint8_t*>(&draw) + sizeof(DrawCommand);
+            std::memcpy(extra, ranges->offsets.data(), rangeCount * sizeof(const void*));
+            std::memcpy(extra + rangeCount * sizeof(const void*), ranges->counts.data(), rangeCount * sizeof(GLsizei));
+        }
+        ++m_DrawCount;
+    }
+
+    void CommandBuffer::Reset() {
+        m_Data.clear();
+        m_CommandCount = 0;
+        m_DrawCount = 0;
+        m_MeshletStats = MeshletCuller::Stats{};
+        m_MeshesTested = 0;
+        m_MeshesCulled = 0;
+    }
+
+    void CommandBuffer::Submit(CommandExecutor* executor) const {
+        CommandExecutor local;
+        CommandExecutor& target = executor ? *executor : local;
+        ForEach([&](const RenderCommandHeader& header) { target.Execute(header); });
+        if (!executor) local.Finish();
+        FlushStats();
+    }
+
+    void CommandBuffer::FlushStats() const {
+        MeshletCuller::AddStats(m_MeshletStats);
+        if (m_MeshesTested > 0) FrustumCuller::CountMeshes(m_MeshesTested, m_MeshesCulled);
+    }
+
+    void CommandList::Submit(CommandExecutor* executor) const {
+        CommandExecutor local;
+        CommandExecutor& target = executor ? *executor : local;
+        for (size_t i = 0; i < m_Used; ++i) {
+            m_Buffers[i]->Submit(&target);
+        }
+        if (!executor) local.Finish();
+    }
+
+    size_t CommandList::GetCommandCount() const {
+        size_t count = 0;
+        for (size_t i = 0; i < m_Used; ++i) count += m_Buffers[i]->GetCommandCount();
+        return count;
+    }
+
+    size_t CommandList::GetDrawCount() const {
+        size_t count = 0;
+        for (size_t i = 0; i < m_Used; ++i) count += m_Buffers[i]->GetDrawCount();
+        return count;
+    }
+
+    size_t CommandList::GetByteSize() const {
+        size_t bytes = 0;
+        for (size_t i = 0; i < m_Used; ++i) bytes += m_Buffers[i]->GetByteSize();
+        return bytes;
+    }
+
+    void CommandList::Prepare(size_t count) {
+        while (m_Buffers.size() < count) {
+            m_Buffers.push_back(std::make_unique<CommandBuffer>());
+        }
+        for (size_t i = 0; i < std::max(count, m_Used); ++i) {
+            m_Buffers[i]->Reset();
+        }
+        m_Used = count;
+    }
+
+} // namespace graphics
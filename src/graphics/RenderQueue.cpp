@@ -0,0 +1,161 @@
+#include "graphics/RenderQueue.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+namespace graphics {
+
+    bool RenderQueue::s_SortEnabled = true;
+    RenderQueue::Stats RenderQueue::s_Stats;
+
+    uint64_t SortKey::Make(RenderPass pass, uint32_t program, uint32_t material, uint32_t mesh, uint32_t depth) {
+        const uint64_t p = static_cast<uint64_t>(pass) & 0xF;
+        const uint64_t prog = program & 0xFFF;
+        const uint64_t mat = material & 0xFFFF;
+        const uint64_t m = mesh & 0xFFFF;
+        const uint64_t d = std::min(depth, kDepthMax);
+        if (pass == RenderPass::Transparent) {
+            return p << 60 | (kDepthMax - d) << 44 | prog << 32 | mat << 16 | m;
+        }
+        return p << 60 | prog << 48 | mat << 32 | m << 16 | d;
+    }
+
+    uint32_t SortKey::HashMaterial(const BindMaterialCommand& material) {
+        // FNV-1a 后折叠到 16 位
+        uint32_t hash = 2166136261u;
+        for (uint32_t i = 0; i < material.textureCount; ++i) {
+            hash = (hash ^ material.textures[i]) * 16777619u;
+        }
+        return (hash ^ hash >> 16) & 0xFFFF;
+    }
+
+    void RenderQueue::Clear() {
+        m_Items.clear();
+        m_Draws.clear();
+        m_Buffers.clear();
+    }
+
+    void RenderQueue::Add(const CommandList& list, RenderPass pass, const glm::vec3& eye, const glm::vec3& forward,
+                          float nearPlane, float farPlane) {
+        const auto start = std::chrono::steady_clock::now();
+
+        // 各缓冲的绘制项写入预先划分好的区间，结果与顺序收集一致
+        const size_t bufferCount = list.GetBufferCount();
+        std::vector<size_t> bases(bufferCount + 1, m_Items.size());
+        for (size_t b = 0; b < bufferCount; ++b) {
+            bases[b + 1] = bases[b] + list.GetBuffer(b).GetDrawCount();
+            m_Buffers.push_back(&list.GetBuffer(b));
+        }
+        m_Items.resize(bases.back());
+        m_Draws.resize(bases.back());
+
+        const float depthScale = static_cast<float>(SortKey::kDepthMax) / std::max(farPlane - nearPlane, 1e-6f);
+        core::JobSystem::ParallelFor(bufferCount, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                size_t index = bases[b];
+                Draw current{};
+                uint32_t depth = 0;
+                list.GetBuffer(b).ForEach([&](const RenderCommandHeader& header) {
+                    switch (header.type) {
+                        case RenderCommandType::BindPipeline:
+                            current.pipeline = &reinterpret_cast<const BindPipelineCommand&>(header);
+                            break;
+                        case RenderCommandType::BindMaterial:
+                            current.material = &reinterpret_cast<const BindMaterialCommand&>(header);
+                            break;
+                        case RenderCommandType::SetDrawData: {
+                            // 新的实体：材质从头开始（未就绪模型只有绘制命令）
+                            current.drawData = &reinterpret_cast<const SetDrawDataCommand&>(header);
+                            current.material = nullptr;
+                            const glm::vec3 position(current.drawData->model[3]);
+                            const float distance = glm::dot(position - eye, forward) - nearPlane;
+                            depth = static_cast<uint32_t>(std::clamp(distance * depthScale, 0.0f,
+                                                                     static_cast<float>(SortKey::kDepthMax)));
+                            break;
+                        }
+                        case RenderCommandType::Draw: {
+                            current.draw = &reinterpret_cast<const DrawCommand&>(header);
+                            m_Draws[index] = current;
+                            const uint32_t program = current.pipeline ? current.pipeline->program : 0;
+                            const uint32_t material = current.material ? SortKey::HashMaterial(*current.material) : 0;
+                            m_Items[index] = Item{SortKey::Make(pass, program, material, current.draw->vao, depth),
+                                                  static_cast<uint32_t>(index)};
+                            ++index;
+                            break;
+                        }
+                    }
+                });
+            }
+        }, 1);
+
+        s_Stats.items += bases.back() - bases.front();
+        s_Stats.buildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void RenderQueue::Sort() {
+        if (!s_SortEnabled) return;
+        const auto start = std::chrono::steady_clock::now();
+        s_Stats.sortPasses += RadixSort(m_Items, m_Scratch);
+        s_Stats.sortMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    size_t RenderQueue::RadixSort(std::vector<Item>& items, std::vector<Item>& scratch) {
+        constexpr size_t kPasses = 8;
+        const size_t count = items.size();
+        if (count < 2) return 0;
+
+        // 一次遍历统计全部 8 个字节的直方图
+        std::vector<uint32_t> histograms(kPasses * 256, 0);
+        for (const Item& item : items) {
+            for (size_t pass = 0; pass < kPasses; ++pass) {
+                histograms[pass * 256 + (item.key >> (pass * 8) & 0xFF)]++;
+            }
+        }
+
+        scratch.resize(count);
+        Item* source = items.data();
+        Item* target = scratch.data();
+        size_t executed = 0;
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            uint32_t* histogram = &histograms[pass * 256];
+            // 该字节全部相同时这一趟不改变顺序
+            const uint8_t first = static_cast<uint8_t>(source[0].key >> (pass * 8));
+            if (histogram[first] == count) continue;
+
+            uint32_t offset = 0;
+            for (size_t bucket = 0; bucket < 256; ++bucket) {
+                const uint32_t size = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += size;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                const Item& item = source[i];
+                target[histogram[item.key >> (pass * 8) & 0xFF]++] = item;
+            }
+            std::swap(source, target);
+            ++executed;
+        }
+        if (source != items.data()) items.swap(scratch);
+        return executed;
+    }
+
+    void RenderQueue::Submit(CommandExecutor& executor) const {
+        const BindPipelineCommand* pipeline = nullptr;
+        for (const Item& item : m_Items) {
+            const Draw& draw = m_Draws[item.index];
+            // 各段开头都录有同样的 BindPipeline，排序后交错出现，只在内容变化时交给执行器
+            if (draw.pipeline && (!pipeline || draw.pipeline->program != pipeline->program ||
+                                  draw.pipeline->modelLocation != pipeline->modelLocation)) {
+                executor.BindPipeline(*draw.pipeline);
+                pipeline = draw.pipeline;
+            }
+            if (draw.drawData) executor.SetDrawData(*draw.drawData);
+            if (draw.material) executor.BindMaterial(*draw.material);
+            executor.Draw(*draw.draw);
+        }
+        for (const CommandBuffer* buffer : m_Buffers) {
+            buffer->FlushStats();
+        }
+    }
+
+} // namespace graphics
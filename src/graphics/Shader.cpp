@@ -1,54 +1,238 @@
 #include "graphics/Shader.h"
+#include "graphics/GLExtensions.h"
+#include "graphics/ShaderSource.h"
+#include "utils/Hash.h"
+#include "utils/PathResolver.h"
 #include <glad/glad.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 namespace graphics {
 
-    // 构造函数：加载并编译着色器
-    Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
+namespace {
+
+    /// 程序二进制缓存文件头，其后为 size 字节的驱动私有数据
+    struct ProgramBinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;       ///< 源码哈希与驱动标识的组合
+        uint32_t format;    ///< glGetProgramBinary 返回的格式
+        uint32_t size;
+    };
+
+    constexpr char kBinaryMagic[4] = {'R', 'P', 'R', 'G'};
+    constexpr uint32_t kBinaryVersion = 1;
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::string GetBinaryPath(uint64_t key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.rprog", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(Shader::GetBinaryCacheDirectory()) / name).string();
+    }
+
+} // namespace
+
+    bool Shader::s_BinaryCacheEnabled = true;
+    Shader::Stats Shader::s_Stats;
+
+    std::string Shader::GetBinaryCacheDirectory() {
+        return PathResolver::Resolve("cache/shaders");
+    }
+
+    // 构造函数：加载着色器，二进制缓存未命中时提交编译与链接
+    Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, bool deferred)
+        : m_VertexPath(vertexPath), m_FragmentPath(fragmentPath) {
+        const auto start = std::chrono::steady_clock::now();
         std::string vertexCode = ReadFile(vertexPath);
         std::string fragmentCode = ReadFile(fragmentPath);
+        ++s_Stats.programs;
 
-        unsigned int vertex = CompileShader(GL_VERTEX_SHADER, vertexCode);
-        unsigned int fragment = CompileShader(GL_FRAGMENT_SHADER, fragmentCode);
+        m_BinaryKey = utils::HashCombine(utils::HashString(vertexCode), utils::HashString(fragmentCode));
+        m_BinaryKey = utils::HashCombine(m_BinaryKey, utils::HashString(GLExtensions::GetDriverId(), kBinaryVersion));
+        if (LoadBinary()) {
+            s_Stats.cpuMs += ElapsedMs(start);
+            return;
+        }
+
+        // 只提交，不查询状态：查询会阻塞到编译完成，使多个程序无法并行
+        m_Vertex = CompileShader(GL_VERTEX_SHADER, vertexCode);
+        m_Fragment = CompileShader(GL_FRAGMENT_SHADER, fragmentCode);
 
         // 创建程序对象并链接
         m_ID = glCreateProgram();
-        glAttachShader(m_ID, vertex);
-        glAttachShader(m_ID, fragment);
+        if (s_BinaryCacheEnabled && GLExtensions::HasProgramBinary())
+            GLExtensions::ProgramParameteri(m_ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glAttachShader(m_ID, m_Vertex);
+        glAttachShader(m_ID, m_Fragment);
         glLinkProgram(m_ID);
-        CheckCompileErrors(m_ID, "PROGRAM");
+        m_Pending = true;
+        ++s_Stats.compiled;
+        s_Stats.cpuMs += ElapsedMs(start);
+
+        if (!deferred) Finish();
+    }
+
+    void Shader::Finish() {
+        if (!m_Pending) return;
+        const auto start = std::chrono::steady_clock::now();
+        m_Pending = false;
+
+        int linked = 0;
+        glGetProgramiv(m_ID, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // 优先报告编译错误，便于定位源文件
+            try {
+                CheckCompileErrors(m_Vertex, "VERTEX", m_VertexPath);
+                CheckCompileErrors(m_Fragment, "FRAGMENT", m_FragmentPath);
+                CheckCompileErrors(m_ID, "PROGRAM");
+            } catch (const std::exception&) {
+                Release();
+                throw;
+            }
+        }
 
         // 删除已链接的着色器对象
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        glDetachShader(m_ID, m_Vertex);
+        glDetachShader(m_ID, m_Fragment);
+        glDeleteShader(m_Vertex);
+        glDeleteShader(m_Fragment);
+        m_Vertex = m_Fragment = 0;
+
+        SaveBinary();
+        s_Stats.cpuMs += ElapsedMs(start);
+    }
+
+    bool Shader::IsCompileComplete() const {
+        if (!m_Pending || !GLExtensions::HasParallelShaderCompile()) return true;
+        int complete = 0;
+        glGetProgramiv(m_ID, GL_COMPLETION_STATUS_KHR, &complete);
+        return complete != 0;
+    }
+
+    void Shader::Release() {
+        if (m_Vertex != 0) glDeleteShader(m_Vertex);
+        if (m_Fragment != 0) glDeleteShader(m_Fragment);
+        if (m_ID != 0) glDeleteProgram(m_ID);
+        m_Vertex = m_Fragment = m_ID = 0;
+        m_Pending = false;
+    }
+
+    bool Shader::LoadBinary() {
+        if (!s_BinaryCacheEnabled || !GLExtensions::HasProgramBinary()) return false;
+        const std::string path = GetBinaryPath(m_BinaryKey);
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        ProgramBinaryHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(header.magic, kBinaryMagic, 4) != 0 || header.version != kBinaryVersion ||
+            header.key != m_BinaryKey || header.size == 0)
+            return false;
+        std::vector<char> binary(header.size);
+        file.read(binary.data(), binary.size());
+        if (!file) return false;
+
+        m_ID = glCreateProgram();
+        GLExtensions::ProgramBinary(m_ID, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+        int linked = 0;
+        glGetProgramiv(m_ID, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // 驱动更新等原因导致二进制不再可用，删除后重新编译
+            glDeleteProgram(m_ID);
+            m_ID = 0;
+            ++s_Stats.binaryRejected;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return false;
+        }
+        ++s_Stats.binaryHits;
+        return true;
+    }
+
+    void Shader::SaveBinary() const {
+        if (!s_BinaryCacheEnabled || !GLExtensions::HasProgramBinary()) return;
+        int length = 0;
+        glGetProgramiv(m_ID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+
+        ProgramBinaryHeader header{};
+        std::memcpy(header.magic, kBinaryMagic, 4);
+        header.version = kBinaryVersion;
+        header.key = m_BinaryKey;
+        std::vector<char> binary(static_cast<size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        GLExtensions::GetProgramBinary(m_ID, length, &written, &format, binary.data());
+        if (written <= 0) return;
+        header.format = format;
+        header.size = static_cast<uint32_t>(written);
+
+        // 写入临时文件后替换，避免并发启动读到不完整的文件
+        const std::string path = GetBinaryPath(m_BinaryKey);
+        const std::string tempPath = path + ".tmp";
+        std::error_code ec;
+        std::filesystem::create_directories(GetBinaryCacheDirectory(), ec);
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), written);
+            if (!file) {
+                std::cout << "[Shader Warning] Failed to write program binary: " << tempPath << std::endl;
+                return;
+            }
+        }
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            std::cout << "[Shader Warning] Failed to replace program binary: " << path << std::endl;
+        }
     }
 
     // 移动构造函数
     Shader::Shader(Shader&& other) noexcept {
         m_ID = other.m_ID;
+        m_Vertex = other.m_Vertex;
+        m_Fragment = other.m_Fragment;
+        m_Pending = other.m_Pending;
+        m_BinaryKey = other.m_BinaryKey;
+        m_VertexPath = std::move(other.m_VertexPath);
+        m_FragmentPath = std::move(other.m_FragmentPath);
         m_UniformLocationCache = std::move(other.m_UniformLocationCache);
-        other.m_ID = 0;
+        other.m_ID = other.m_Vertex = other.m_Fragment = 0;
+        other.m_Pending = false;
     }
 
     // 移动赋值运算符
     Shader& Shader::operator=(Shader&& other) noexcept {
         if (this != &other) {
-            glDeleteProgram(m_ID);
+            Release();
             m_ID = other.m_ID;
+            m_Vertex = other.m_Vertex;
+            m_Fragment = other.m_Fragment;
+            m_Pending = other.m_Pending;
+            m_BinaryKey = other.m_BinaryKey;
+            m_VertexPath = std::move(other.m_VertexPath);
+            m_FragmentPath = std::move(other.m_FragmentPath);
             m_UniformLocationCache = std::move(other.m_UniformLocationCache);
-            other.m_ID = 0;
+            other.m_ID = other.m_Vertex = other.m_Fragment = 0;
+            other.m_Pending = false;
         }
         return *this;
     }
 
     // 析构函数：释放OpenGL程序对象
     Shader::~Shader() {
-        if (m_ID != 0) {
-            glDeleteProgram(m_ID);
-        }
+        Release();
     }
 
     // 绑定着色器程序
@@ -91,30 +275,22 @@ namespace graphics {
         glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &value[0][0]);
     }
 
-    // 读取文件内容为字符串
+    // 读取文件内容为字符串（存在有效的烘焙文件时优先使用）
     std::string Shader::ReadFile(const std::string& path) const {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open shader file: " + path);
-        }
-
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        return ShaderSource::Load(path);
     }
 
-    // 编译单个着色器
+    // 提交单个着色器的编译，结果在 Finish 中检查
     unsigned int Shader::CompileShader(unsigned int type, const std::string& source) const {
         unsigned int id = glCreateShader(type);
         const char* src = source.c_str();
         glShaderSource(id, 1, &src, nullptr);
         glCompileShader(id);
-        CheckCompileErrors(id, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
         return id;
     }
 
     // 检查着色器编译或程序链接错误
-    void Shader::CheckCompileErrors(unsigned int shader, const std::string& type) const {
+    void Shader::CheckCompileErrors(unsigned int shader, const std::string& type, const std::string& path) const {
         int success;
         char infoLog[1024];
 
@@ -129,7 +305,14 @@ namespace graphics {
             glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
             if (!success) {
                 glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-                std::cerr << "[SHADER::COMPILE::" << type << "] " << infoLog << std::endl;
+                std::cerr << "[SHADER::COMPILE::" << type << "] " << path << "\n" << infoLog << std::endl;
+                // 错误信息中的 "编号(行号)"：0 为主文件，其余为被包含的文件
+                try {
+                    const auto dependencies = ShaderSource::Preprocess(path).dependencies;
+                    for (size_t i = 0; i < dependencies.size(); ++i)
+                        std::cerr << "  source " << i + 1 << ": " << dependencies[i] << std::endl;
+                } catch (const std::exception&) {
+                }
                 throw std::runtime_error("Shader compilation failed.");
             }
         }
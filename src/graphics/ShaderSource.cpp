@@ -0,0 +1,236 @@
+#include "graphics/ShaderSource.h"
+#include "utils/Hash.h"
+#include "utils/VirtualFileSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace graphics {
+
+namespace {
+
+    constexpr const char* kTrailerPrefix = "// rglsl ";
+    constexpr const char* kDependencyPrefix = "// rglsl-dep ";
+
+    std::string ReadText(const std::string& path) {
+        if (!utils::VirtualFileSystem::Exists(path))
+            throw std::runtime_error("Failed to open shader file: " + path);
+        utils::FileView file = utils::VirtualFileSystem::Open(path);
+        return std::string(file.Data(), file.Size());
+    }
+
+    // 末行：版本号 + 全部文件内容的组合哈希（十六进制），放在末尾以免影响行号
+    std::string MakeTrailer(uint64_t sourceHash) {
+        char line[64];
+        std::snprintf(line, sizeof(line), "%s%u %016llx\n", kTrailerPrefix, ShaderSource::kVersion,
+                      static_cast<unsigned long long>(sourceHash));
+        return line;
+    }
+
+    // 源文件与依赖的组合哈希；缺失的依赖以路径参与哈希，依赖出现后烘焙结果随之失效
+    uint64_t HashSources(const std::string& source, const std::vector<std::string>& dependencies) {
+        uint64_t hash = utils::HashString(source);
+        for (const auto& dependency : dependencies) {
+            if (utils::VirtualFileSystem::Exists(dependency))
+                hash = utils::HashCombine(hash, utils::HashString(ReadText(dependency)));
+            else
+                hash = utils::HashCombine(hash, utils::HashString(dependency));
+        }
+        return hash;
+    }
+
+    /// 行首（允许空白）为 #name 时返回 true，rest 为指令名之后的内容
+    bool MatchDirective(const std::string& line, const char* name, std::string& rest) {
+        size_t i = line.find_first_not_of(" \t");
+        if (i == std::string::npos || line[i] != '#') return false;
+        i = line.find_first_not_of(" \t", i + 1);
+        const size_t length = std::strlen(name);
+        if (i == std::string::npos || line.compare(i, length, name) != 0) return false;
+        rest = line.substr(i + length);
+        return rest.empty() || rest[0] == ' ' || rest[0] == '\t';
+    }
+
+    struct ExpandState {
+        std::vector<std::string> dependencies;
+        std::vector<std::string> stack;         ///< 正在展开的文件，用于检测循环包含
+        std::unordered_set<std::string> once;   ///< 已展开且含 #pragma once 的文件
+        std::string out;
+    };
+
+    void Expand(const std::string& path, int fileIndex, const std::string& text, ExpandState& state) {
+        if (std::find(state.stack.begin(), state.stack.end(), path) != state.stack.end())
+            throw std::runtime_error("Recursive shader include: " + path);
+        state.stack.push_back(path);
+
+        const std::string stripped = ShaderSource::StripComments(text);
+        const fs::path directory = fs::path(path).parent_path();
+        size_t lineNumber = 0;
+        for (size_t start = 0; start < stripped.size();) {
+            size_t end = stripped.find('\n', start);
+            if (end == std::string::npos) end = stripped.size();
+            const std::string line = stripped.substr(start, end - start);
+            start = end + 1;
+            ++lineNumber;
+
+            std::string rest;
+            if (MatchDirective(line, "pragma", rest) && rest.find("once") != std::string::npos) {
+                state.once.insert(path);
+                state.out += '\n';
+                continue;
+            }
+            if (!MatchDirective(line, "include", rest)) {
+                state.out += line;
+                state.out += '\n';
+                continue;
+            }
+
+            const size_t open = rest.find('"');
+            const size_t close = open == std::string::npos ? std::string::npos : rest.find('"', open + 1);
+            if (close == std::string::npos)
+                throw std::runtime_error("Malformed #include in " + path + ":" + std::to_string(lineNumber));
+            const std::string includePath = (directory / rest.substr(open + 1, close - open - 1)).lexically_normal().string();
+            if (state.once.count(includePath)) {
+                state.out += '\n';
+                continue;
+            }
+
+            auto it = std::find(state.dependencies.begin(), state.dependencies.end(), includePath);
+            const size_t includeIndex = static_cast<size_t>(it - state.dependencies.begin()) + 1;
+            if (it == state.dependencies.end()) state.dependencies.push_back(includePath);
+
+            // 被包含文件从第 1 行开始编号，结束后恢复为包含处的下一行
+            state.out += "#line 1 " + std::to_string(includeIndex) + "\n";
+            Expand(includePath, static_cast<int>(includeIndex), ReadText(includePath), state);
+            state.out += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+        }
+        state.stack.pop_back();
+    }
+
+} // namespace
+
+    std::unordered_map<std::string, std::string> ShaderSource::s_Cache;
+    std::mutex ShaderSource::s_CacheMutex;
+
+    std::string ShaderSource::GetCookedPath(const std::string& sourcePath) {
+        return sourcePath + ".rglsl";
+    }
+
+    std::string ShaderSource::StripComments(const std::string& source) {
+        std::string out;
+        out.reserve(source.size());
+        size_t i = 0;
+        while (i < source.size()) {
+            if (source.compare(i, 2, "//") == 0) {
+                while (i < source.size() && source[i] != '\n') ++i;
+            } else if (source.compare(i, 2, "/*") == 0) {
+                size_t end = source.find("*/", i + 2);
+                end = end == std::string::npos ? source.size() : end + 2;
+                // 块注释中的换行保留，行号不变
+                for (; i < end; ++i) {
+                    if (source[i] == '\n') out += '\n';
+                }
+            } else if (source[i] == '\n' || source[i] == '\r') {
+                while (!out.empty() && (out.back() == ' ' || out.back() == '\t')) out.pop_back();
+                if (source[i] == '\n') out += '\n';
+                ++i;
+            } else {
+                out += source[i++];
+            }
+        }
+        return out;
+    }
+
+    ShaderSource::Preprocessed ShaderSource::Preprocess(const std::string& sourcePath) {
+        const std::string source = ReadText(sourcePath);
+        ExpandState state;
+        Expand(fs::path(sourcePath).lexically_normal().string(), 0, source, state);
+
+        Preprocessed result;
+        result.source = std::move(state.out);
+        result.dependencies = std::move(state.dependencies);
+        result.hash = HashSources(source, result.dependencies);
+        return result;
+    }
+
+    std::vector<std::string> ShaderSource::Cook(const std::string& sourcePath, const std::string& cookedPath) {
+        const Preprocessed preprocessed = Preprocess(sourcePath);
+        const fs::path directory = fs::path(sourcePath).lexically_normal().parent_path();
+        const std::string tempPath = cookedPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Failed to create shader file: " + tempPath);
+            file << preprocessed.source;
+            // 依赖以相对源文件的路径记录，烘焙结果随目录移动仍然有效
+            for (const auto& dependency : preprocessed.dependencies)
+                file << kDependencyPrefix << fs::path(dependency).lexically_relative(directory).generic_string() << '\n';
+            file << MakeTrailer(preprocessed.hash);
+            if (!file)
+                throw std::runtime_error("Failed to write shader file: " + tempPath);
+        }
+        std::error_code ec;
+        fs::rename(tempPath, cookedPath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Failed to replace shader file: " + cookedPath);
+        }
+        return preprocessed.dependencies;
+    }
+
+    std::string ShaderSource::Load(const std::string& sourcePath) {
+        {
+            std::lock_guard<std::mutex> lock(s_CacheMutex);
+            auto it = s_Cache.find(sourcePath);
+            if (it != s_Cache.end()) return it->second;
+        }
+
+        std::string result;
+        const std::string cookedPath = GetCookedPath(sourcePath);
+        if (utils::VirtualFileSystem::Exists(cookedPath)) {
+            std::string cooked = ReadText(cookedPath);
+            const size_t trailerStart = cooked.rfind(kTrailerPrefix);
+            if (trailerStart != std::string::npos && (trailerStart == 0 || cooked[trailerStart - 1] == '\n')) {
+                // 依赖行位于正文与末行之间
+                size_t bodyEnd = trailerStart;
+                std::vector<std::string> dependencies;
+                const fs::path directory = fs::path(sourcePath).lexically_normal().parent_path();
+                for (size_t pos = cooked.find(kDependencyPrefix); pos != std::string::npos && pos < trailerStart;
+                     pos = cooked.find(kDependencyPrefix, pos + 1)) {
+                    if (pos > 0 && cooked[pos - 1] != '\n') continue;
+                    bodyEnd = std::min(bodyEnd, pos);
+                    const size_t nameStart = pos + std::strlen(kDependencyPrefix);
+                    const size_t nameEnd = cooked.find('\n', nameStart);
+                    dependencies.push_back((directory / cooked.substr(nameStart, nameEnd - nameStart)).lexically_normal().string());
+                }
+
+                // 源文件不存在时（仅随发布包提供烘焙结果）直接信任
+                bool valid = true;
+                if (utils::VirtualFileSystem::Exists(sourcePath)) {
+                    const uint64_t hash = HashSources(ReadText(sourcePath), dependencies);
+                    valid = cooked.compare(trailerStart, std::string::npos, MakeTrailer(hash)) == 0;
+                }
+                if (valid) {
+                    cooked.resize(bodyEnd);
+                    result = std::move(cooked);
+                }
+            }
+        }
+        if (result.empty()) result = Preprocess(sourcePath).source;
+
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        s_Cache[sourcePath] = result;
+        return result;
+    }
+
+    void ShaderSource::ClearCache() {
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        s_Cache.clear();
+    }
+
+} // namespace graphics
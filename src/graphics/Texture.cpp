@@ -1,16 +1,58 @@
 #include "graphics/Texture.h"
-#include <stb_image.h>
+#include "graphics/GLExtensions.h"
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 
 namespace graphics {
 
+namespace {
+
+    // 资源尚未就绪时使用的1x1白色纹理，首次绑定时创建
+    GLuint GetPlaceholderTexture() {
+        static GLuint placeholder = 0;
+        if (placeholder == 0) {
+            const unsigned char white[4] = {255, 255, 255, 255};
+            glGenTextures(1, &placeholder);
+            glBindTexture(GL_TEXTURE_2D, placeholder);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        return placeholder;
+    }
+
+    // 按通道数选择像素格式与内部格式
+    void SelectFormat(int channels, bool useSRGB, GLenum& format, GLenum& internalFormat) {
+        switch (channels) {
+            case 1: format = internalFormat = GL_RED; break;
+            case 3:
+                format = GL_RGB;
+                internalFormat = useSRGB ? GL_SRGB : GL_RGB;
+                break;
+            case 4:
+                format = GL_RGBA;
+                internalFormat = useSRGB ? GL_SRGB_ALPHA : GL_RGBA;
+                break;
+            default:
+                throw std::runtime_error("Unsupported texture format");
+        }
+    }
+
+} // namespace
+
     Texture::Texture(const std::string& path, bool useSRGB) {
         LoadFromFile(path, useSRGB);
+        SetSource(path, useSRGB);
+    }
+
+    Texture::Texture(const ImageData& image, bool useSRGB) {
+        Upload(image, useSRGB);
     }
 
     Texture::~Texture() {
-        glDeleteTextures(1, &m_ID);
+        // 未上传的纹理不调用GL，可在无上下文的线程中创建与释放
+        if (m_ID != 0) glDeleteTextures(1, &m_ID);
     }
 
     Texture::Texture(Texture&& other) noexcept {
@@ -18,7 +60,15 @@ namespace graphics {
         m_Width = other.m_Width;
         m_Height = other.m_Height;
         m_Channels = other.m_Channels;
+        m_Ready = other.m_Ready;
+        m_HasMipChain = other.m_HasMipChain;
+        m_GpuBytes = other.m_GpuBytes;
+        m_SourcePath = std::move(other.m_SourcePath);
+        m_SRGB = other.m_SRGB;
+        m_LastUsedFrame.store(other.GetLastUsedFrame(), std::memory_order_relaxed);
+        m_Evicted = other.m_Evicted;
         other.m_ID = 0;
+        other.m_Ready = false;
     }
 
     Texture& Texture::operator=(Texture&& other) noexcept {
@@ -29,39 +79,121 @@ namespace graphics {
             m_Width = other.m_Width;
             m_Height = other.m_Height;
             m_Channels = other.m_Channels;
+            m_Ready = other.m_Ready;
+            m_HasMipChain = other.m_HasMipChain;
+            m_GpuBytes = other.m_GpuBytes;
+            m_SourcePath = std::move(other.m_SourcePath);
+            m_SRGB = other.m_SRGB;
+            m_LastUsedFrame.store(other.GetLastUsedFrame(), std::memory_order_relaxed);
+            m_Evicted = other.m_Evicted;
             other.m_ID = 0;
+            other.m_Ready = false;
         }
         return *this;
     }
 
     void Texture::LoadFromFile(const std::string& path, bool useSRGB) {
+        TextureSource source = TextureSource::Load(path, useSRGB);
+        try {
+            Upload(source, useSRGB);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Unsupported texture format: " + path);
+        }
+    }
 
+    void Texture::Upload(const ImageData& image, bool useSRGB) {
+        if (!image.IsValid())
+            throw std::runtime_error("Cannot upload an empty image");
 
-        unsigned char* data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_Channels, 0);
-        if (!data)
-            throw std::runtime_error("Failed to load texture: " + path);
+        AllocateStorage(image.width, image.height, image.channels, useSRGB);
 
         GLenum format, internalFormat;
-        switch (m_Channels) {
-            case 1: format = internalFormat = GL_RED; break;
-            case 3:
-                format = GL_RGB;
-                internalFormat = useSRGB ? GL_SRGB : GL_RGB;
-                break;
-            case 4:
-                format = GL_RGBA;
-                internalFormat = useSRGB ? GL_SRGB_ALPHA : GL_RGBA;
-                break;
-            default:
-                stbi_image_free(data);
-                throw std::runtime_error("Unsupported texture format: " + path);
+        SelectFormat(image.channels, useSRGB, format, internalFormat);
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, format, GL_UNSIGNED_BYTE, image.pixels.get());
+        FinishUpload();
+    }
+
+    void Texture::Upload(const TextureSource& source, bool useSRGB) {
+        if (!source.cooked) {
+            if (!source.image)
+                throw std::runtime_error("Cannot upload an empty texture source");
+            Upload(*source.image, useSRGB);
+            return;
         }
 
+        const TextureFile& file = *source.cooked;
+        AllocateStorage(file, useSRGB);
+        const TextureFormat format = file.GetFormat();
+        const GLenum internalFormat = GLExtensions::GetInternalFormat(format, useSRGB);
+        const auto& levels = file.GetLevels();
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const TextureLevel& level = levels[i];
+            if (IsBlockCompressed(format)) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), 0, 0, level.width, level.height,
+                                          internalFormat, static_cast<GLsizei>(level.size), level.data);
+            } else {
+                glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), 0, 0, level.width, level.height,
+                                GL_RGBA, GL_UNSIGNED_BYTE, level.data);
+            }
+        }
+        FinishUpload();
+    }
+
+    void Texture::AllocateStorage(const TextureFile& file, bool useSRGB) {
+        const TextureFormat format = file.GetFormat();
+        const GLenum internalFormat = GLExtensions::GetInternalFormat(format, useSRGB);
+
+        glDeleteTextures(1, &m_ID);
+        m_Width = file.GetWidth();
+        m_Height = file.GetHeight();
+        m_Channels = 4;
+        m_Ready = false;
+        m_HasMipChain = true;
+        m_GpuBytes = 0;
+
         glGenTextures(1, &m_ID);
         glBindTexture(GL_TEXTURE_2D, m_ID);
+        const auto& levels = file.GetLevels();
+        for (size_t i = 0; i < levels.size(); ++i) {
+            const TextureLevel& level = levels[i];
+            if (IsBlockCompressed(format)) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, level.width, level.height, 0,
+                                       static_cast<GLsizei>(level.size), nullptr);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, level.width, level.height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+            m_GpuBytes += level.size;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+    void Texture::AllocateStorage(int width, int height, int channels, bool useSRGB) {
+        GLenum format, internalFormat;
+        SelectFormat(channels, useSRGB, format, internalFormat);
+
+        glDeleteTextures(1, &m_ID);
+        m_Width = width;
+        m_Height = height;
+        m_Channels = channels;
+        m_Ready = false;
+        m_HasMipChain = false;
+        // 含 mip 链约为首级的 4/3
+        m_GpuBytes = static_cast<size_t>(width) * height * channels * 4 / 3;
+
+        glGenTextures(1, &m_ID);
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void Texture::FinishUpload() {
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+        if (!m_HasMipChain)
+            glGenerateMipmap(GL_TEXTURE_2D);
 
         // 常用采样设置
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -70,13 +202,34 @@ namespace graphics {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
         glBindTexture(GL_TEXTURE_2D, 0);
+        m_Ready = true;
+        m_Evicted = false;
+    }
+
+    bool Texture::Evict() {
+        if (!m_Ready || m_SourcePath.empty())
+            return false;
+        glDeleteTextures(1, &m_ID);
+        m_ID = 0;
+        m_Ready = false;
+        m_GpuBytes = 0;
+        m_Evicted = true;
+        return true;
+    }
 
-        stbi_image_free(data);
+    unsigned int Texture::GetBindID() const {
+        Touch();
+        return m_Ready ? m_ID : 0;
+    }
+
+    unsigned int Texture::GetPlaceholderID() {
+        return GetPlaceholderTexture();
     }
 
     void Texture::Bind(unsigned int slot) const {
+        Touch();
         glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, m_ID);
+        glBindTexture(GL_TEXTURE_2D, m_Ready ? m_ID : GetPlaceholderTexture());
     }
 
 }
@@ -0,0 +1,247 @@
+#include "graphics/TextureCache.h"
+#include "graphics/TextureFile.h"
+#include "utils/Hash.h"
+#include "utils/VirtualFileSystem.h"
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace graphics {
+
+    std::unique_ptr<const TextureCache::Table> TextureCache::s_Current = std::make_unique<const Table>();
+    std::atomic<const TextureCache::Table*> TextureCache::s_Table{TextureCache::s_Current.get()};
+    std::atomic<size_t> TextureCache::s_Readers{0};
+    std::mutex TextureCache::s_WriteMutex;
+    TextureCache::Table TextureCache::s_Pending;
+    std::vector<std::unique_ptr<const TextureCache::Table>> TextureCache::s_Retired;
+    std::atomic<size_t> TextureCache::s_Lookups{0};
+    std::atomic<size_t> TextureCache::s_PathHits{0};
+    std::atomic<size_t> TextureCache::s_ContentHits{0};
+
+    std::string TextureCache::GetCanonicalPath(const std::string& path) {
+        std::error_code ec;
+        fs::path canonical = fs::weakly_canonical(path, ec);
+        if (ec) canonical = fs::absolute(path, ec).lexically_normal();
+        return canonical.generic_string();
+    }
+
+    std::string TextureCache::MakePathKey(const std::string& canonicalPath, bool useSRGB) {
+        return canonicalPath + (useSRGB ? "|srgb" : "|linear");
+    }
+
+    uint64_t TextureCache::MakeContentKey(uint64_t contentHash, bool useSRGB) {
+        return utils::HashCombine(contentHash, useSRGB ? 1 : 0);
+    }
+
+    uint64_t TextureCache::HashContent(const std::string& path) {
+        for (const std::string& candidate : {path, TextureFile::GetCookedPath(path)}) {
+            if (!utils::VirtualFileSystem::Exists(candidate)) continue;
+            try {
+                const utils::FileView file = utils::VirtualFileSystem::Open(candidate);
+                // 源文件与烘焙文件的哈希不会相同，种子区分只是为了避免空文件冲突
+                return utils::HashBytes(file.Data(), file.Size(), candidate == path ? 1 : 2);
+            } catch (const std::exception&) {
+                // 读取失败时尝试下一个，仍失败则只按路径查找
+            }
+        }
+        return 0;
+    }
+
+    std::shared_ptr<Texture> TextureCache::FindPathLocked(const std::string& pathKey) {
+        auto pending = s_Pending.byPath.find(pathKey);
+        if (pending != s_Pending.byPath.end()) return pending->second;
+        auto it = s_Current->byPath.find(pathKey);
+        return it != s_Current->byPath.end() ? it->second : nullptr;
+    }
+
+    std::shared_ptr<Texture> TextureCache::FindContentLocked(uint64_t contentKey) {
+        auto pending = s_Pending.byContent.find(contentKey);
+        if (pending != s_Pending.byContent.end()) return pending->second;
+        auto it = s_Current->byContent.find(contentKey);
+        return it != s_Current->byContent.end() ? it->second : nullptr;
+    }
+
+    void TextureCache::PublishLocked(std::unique_ptr<const Table> table) {
+        s_Table.store(table.get());
+        s_Retired.push_back(std::move(s_Current));
+        s_Current = std::move(table);
+    }
+
+    void TextureCache::ReclaimLocked() {
+        // 读取方先计数再取表：发布之后计数为零，说明取得旧表的读取方都已结束，之后的读取方只会取得新表
+        if (!s_Retired.empty() && s_Readers.load() == 0) s_Retired.clear();
+    }
+
+    std::shared_ptr<Texture> TextureCache::Find(const std::string& path, bool useSRGB) {
+        // 先按原样查找登记过的写法，避免每次规范化路径的文件系统调用
+        const std::string aliasKey = MakePathKey(path, useSRGB);
+        {
+            ReadScope scope;
+            const Table* table = s_Table.load();
+            auto it = table->byPath.find(aliasKey);
+            if (it != table->byPath.end()) return it->second;
+        }
+        const std::string pathKey = MakePathKey(GetCanonicalPath(path), useSRGB);
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        std::shared_ptr<Texture> texture = FindPathLocked(aliasKey);
+        return texture ? texture : FindPathLocked(pathKey);
+    }
+
+    std::shared_ptr<Texture> TextureCache::Acquire(const std::string& path, bool useSRGB, bool& created) {
+        return AcquireImpl(path, useSRGB, true, created);
+    }
+
+    std::shared_ptr<Texture> TextureCache::AcquirePath(const std::string& path, bool useSRGB, bool& created) {
+        return AcquireImpl(path, useSRGB, false, created);
+    }
+
+    bool TextureCache::RegisterContent(const std::shared_ptr<Texture>& texture) {
+        const uint64_t contentHash = HashContent(texture->GetSourcePath());
+        if (contentHash == 0) return false;
+        const uint64_t contentKey = MakeContentKey(contentHash, texture->IsSRGB());
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        if (FindContentLocked(contentKey)) return false;
+        s_Pending.byContent[contentKey] = texture;
+        return true;
+    }
+
+    std::shared_ptr<Texture> TextureCache::AcquireImpl(const std::string& path, bool useSRGB, bool hashContent,
+                                                       bool& created) {
+        created = false;
+        ++s_Lookups;
+        const std::string aliasKey = MakePathKey(path, useSRGB);
+        {
+            ReadScope scope;
+            const Table* table = s_Table.load();
+            auto it = table->byPath.find(aliasKey);
+            if (it != table->byPath.end()) {
+                ++s_PathHits;
+                return it->second;
+            }
+        }
+
+        // 未发布的写法：规范化后再查找（含本帧的新登记），命中时把这种写法登记为别名
+        const std::string canonical = GetCanonicalPath(path);
+        const std::string pathKey = MakePathKey(canonical, useSRGB);
+        {
+            std::lock_guard<std::mutex> lock(s_WriteMutex);
+            std::shared_ptr<Texture> texture = FindPathLocked(aliasKey);
+            if (!texture) texture = FindPathLocked(pathKey);
+            if (texture) {
+                ++s_PathHits;
+                s_Pending.byPath.emplace(aliasKey, texture);
+                return texture;
+            }
+        }
+
+        // 读取文件计算哈希较慢，在锁外进行；只按路径登记时由 RegisterContent 随后补登
+        const uint64_t contentHash = hashContent ? HashContent(canonical) : 0;
+        const uint64_t contentKey = MakeContentKey(contentHash, useSRGB);
+
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        // 计算哈希期间其他线程可能已登记同一路径
+        std::shared_ptr<Texture> texture = FindPathLocked(pathKey);
+        if (texture) {
+            ++s_PathHits;
+            s_Pending.byPath.emplace(aliasKey, texture);
+            return texture;
+        }
+
+        texture = contentHash != 0 ? FindContentLocked(contentKey) : nullptr;
+        if (texture) {
+            ++s_ContentHits;
+        } else {
+            texture = std::make_shared<Texture>();
+            texture->SetSource(canonical, useSRGB);
+            if (contentHash != 0) s_Pending.byContent[contentKey] = texture;
+            created = true;
+        }
+        s_Pending.byPath[pathKey] = texture;
+        s_Pending.byPath[aliasKey] = texture;
+        return texture;
+    }
+
+    void TextureCache::Remove(const std::string& path, bool useSRGB) {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        const std::shared_ptr<Texture> texture = FindPathLocked(MakePathKey(GetCanonicalPath(path), useSRGB));
+        if (!texture) return;
+
+        // 同一纹理的全部写法与内容登记一并移除；已发布时立即发布移除后的表（只在加载失败时发生）
+        const auto erase = [&texture](Table& table) {
+            for (auto entry = table.byPath.begin(); entry != table.byPath.end();) {
+                if (entry->second == texture) entry = table.byPath.erase(entry);
+                else ++entry;
+            }
+            for (auto content = table.byContent.begin(); content != table.byContent.end();) {
+                if (content->second == texture) content = table.byContent.erase(content);
+                else ++content;
+            }
+        };
+        erase(s_Pending);
+        const bool published = std::any_of(s_Current->byPath.begin(), s_Current->byPath.end(),
+                                           [&texture](const auto& entry) { return entry.second == texture; });
+        if (published) {
+            auto table = std::make_unique<Table>(*s_Current);
+            erase(*table);
+            PublishLocked(std::move(table));
+        }
+    }
+
+    void TextureCache::EndFrame() {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        if (!s_Pending.byPath.empty() || !s_Pending.byContent.empty()) {
+            // 本帧全部新登记合并为一张新表，每帧至多复制一次
+            auto table = std::make_unique<Table>(*s_Current);
+            for (auto& entry : s_Pending.byPath) table->byPath.insert_or_assign(entry.first, std::move(entry.second));
+            for (auto& entry : s_Pending.byContent) table->byContent.insert_or_assign(entry.first, std::move(entry.second));
+            s_Pending = Table{};
+            PublishLocked(std::move(table));
+        }
+        ReclaimLocked();
+    }
+
+    std::vector<std::shared_ptr<Texture>> TextureCache::GetTextures() {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        std::vector<std::shared_ptr<Texture>> textures;
+        std::unordered_set<const Texture*> seen;
+        for (const Table* table : {s_Current.get(), static_cast<const Table*>(&s_Pending)}) {
+            for (const auto& entry : table->byPath) {
+                if (seen.insert(entry.second.get()).second) textures.push_back(entry.second);
+            }
+        }
+        return textures;
+    }
+
+    TextureCache::Stats TextureCache::GetStats() {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        Stats stats;
+        stats.lookups = s_Lookups.load();
+        stats.pathHits = s_PathHits.load();
+        stats.contentHits = s_ContentHits.load();
+        stats.paths = s_Current->byPath.size();
+        std::unordered_set<const Texture*> unique;
+        for (const auto& entry : s_Current->byPath) unique.insert(entry.second.get());
+        for (const auto& entry : s_Pending.byPath) {
+            if (!s_Current->byPath.count(entry.first)) ++stats.paths;
+            unique.insert(entry.second.get());
+        }
+        stats.textures = unique.size();
+        return stats;
+    }
+
+    void TextureCache::ResetStats() {
+        s_Lookups = 0;
+        s_PathHits = 0;
+        s_ContentHits = 0;
+    }
+
+    void TextureCache::Clear() {
+        std::lock_guard<std::mutex> lock(s_WriteMutex);
+        s_Pending = Table{};
+        PublishLocked(std::make_unique<const Table>());
+        ReclaimLocked();
+    }
+
+} // namespace graphics
@@ -0,0 +1,256 @@
+#include "graphics/TextureFile.h"
+#include "graphics/GLExtensions.h"
+#include "utils/Hash.h"
+#include <stb_image.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace graphics {
+
+namespace {
+
+    struct RTexHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t flags;
+        uint32_t width;
+        uint32_t height;
+        uint32_t levelCount;
+        uint32_t reserved;
+        uint64_t sourceHash;
+        uint64_t sourceSize;    ///< 写入时源文件的大小与修改时间，源文件不存在时为 0
+        int64_t sourceTime;
+    };
+
+    struct RTexLevelRecord {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(RTexHeader) == 56, "RTexHeader layout changed");
+    static_assert(offsetof(RTexHeader, sourceTime) == offsetof(RTexHeader, sourceSize) + sizeof(uint64_t),
+                  "RTexHeader source stamp must stay contiguous");
+    static_assert(sizeof(RTexLevelRecord) == 24, "RTexLevelRecord layout changed");
+
+    constexpr uint32_t kFlagSRGB = 1u << 0;
+    constexpr size_t kLevelAlignment = 16;
+
+} // namespace
+
+    std::string TextureFile::GetCookedPath(const std::string& sourcePath) {
+        return sourcePath + ".rtex";
+    }
+
+    TextureFile::CookOptions TextureFile::GetDefaultCookOptions(const std::string& sourcePath) {
+        std::string name = fs::path(sourcePath).stem().string();
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        auto contains = [&name](const char* token) { return name.find(token) != std::string::npos; };
+
+        CookOptions options;
+        if (contains("_ddn") || contains("normal")) {
+            options.normalMap = true;
+        } else if (contains("_alpha")) {
+            options.coverageChannel = 0;
+        } else if (!contains("spec") && !contains("refl")) {
+            options.srgb = true;
+        }
+        return options;
+    }
+
+    uint64_t TextureFile::HashSource(const std::string& sourcePath) {
+        utils::FileView file = utils::VirtualFileSystem::Open(sourcePath);
+        return utils::HashBytes(file.Data(), file.Size());
+    }
+
+    void TextureFile::Write(const std::string& cookedPath, TextureFormat format, bool srgb, int width, int height,
+                            const std::vector<std::vector<uint8_t>>& levels, uint64_t sourceHash,
+                            const utils::VirtualFileSystem::FileStamp& sourceStamp) {
+        RTexHeader header{};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.format = static_cast<uint32_t>(format);
+        header.flags = srgb ? kFlagSRGB : 0;
+        header.width = static_cast<uint32_t>(width);
+        header.height = static_cast<uint32_t>(height);
+        header.levelCount = static_cast<uint32_t>(levels.size());
+        header.sourceHash = sourceHash;
+        header.sourceSize = sourceStamp.size;
+        header.sourceTime = sourceStamp.mtime;
+
+        std::vector<RTexLevelRecord> records;
+        size_t offset = sizeof(RTexHeader) + levels.size() * sizeof(RTexLevelRecord);
+        int levelWidth = width, levelHeight = height;
+        for (const auto& level : levels) {
+            if (level.size() != GetTextureLevelSize(format, levelWidth, levelHeight))
+                throw std::runtime_error("Texture level size mismatch: " + cookedPath);
+            offset = (offset + kLevelAlignment - 1) & ~(kLevelAlignment - 1);
+            records.push_back({static_cast<uint32_t>(levelWidth), static_cast<uint32_t>(levelHeight), offset, level.size()});
+            offset += level.size();
+            levelWidth = std::max(1, levelWidth / 2);
+            levelHeight = std::max(1, levelHeight / 2);
+        }
+
+        std::string blob;
+        blob.reserve(offset);
+        blob.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        blob.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(RTexLevelRecord));
+        for (size_t i = 0; i < levels.size(); ++i) {
+            blob.resize(records[i].offset, '\0');
+            blob.append(reinterpret_cast<const char*>(levels[i].data()), levels[i].size());
+        }
+
+        const std::string tempPath = cookedPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Failed to create texture file: " + tempPath);
+            file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            if (!file)
+                throw std::runtime_error("Failed to write texture file: " + tempPath);
+        }
+        std::error_code ec;
+        fs::rename(tempPath, cookedPath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Failed to replace texture file: " + cookedPath);
+        }
+    }
+
+    TextureFile::CookStats TextureFile::Cook(const std::string& sourcePath, const std::string& cookedPath,
+                                             const CookOptions& options) {
+        // 未压缩显存按文件原通道数统计（与直接上传源图片一致）
+        int sourceWidth = 0, sourceHeight = 0, sourceChannels = 4;
+        stbi_info(sourcePath.c_str(), &sourceWidth, &sourceHeight, &sourceChannels);
+        ImageData image = ImageData::LoadFromFile(sourcePath, 4);
+
+        CookStats stats;
+        stats.width = image.width;
+        stats.height = image.height;
+        stats.format = BlockCompressor::ChooseFormat(sourcePath, image.pixels.get(), image.width, image.height,
+                                                     options.highQuality);
+
+        // 生成完整 mip 链（RGBA8）
+        MipGenerator::Options mipOptions;
+        mipOptions.filter = options.mipFilter;
+        mipOptions.srgb = options.srgb;
+        mipOptions.normalMap = options.normalMap;
+        mipOptions.coverageChannel = options.coverageChannel;
+        mipOptions.threadCount = options.threadCount;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::vector<uint8_t>> mips = MipGenerator::Generate(image.pixels.get(), image.width, image.height, mipOptions);
+        stats.mipMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<std::vector<uint8_t>> levels;
+        start = std::chrono::steady_clock::now();
+        int width = image.width, height = image.height;
+        for (const auto& mip : mips) {
+            levels.push_back(BlockCompressor::Compress(stats.format, mip.data(), width, height, options.threadCount));
+            stats.uncompressedBytes += static_cast<size_t>(width) * height * sourceChannels;
+            stats.cookedBytes += levels.back().size();
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+        stats.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // 时间戳早于哈希取得，哈希期间源文件被改写只会让下次打开多比对一次
+        utils::VirtualFileSystem::FileStamp stamp;
+        utils::VirtualFileSystem::GetStamp(sourcePath, stamp);
+        Write(cookedPath, stats.format, options.srgb, image.width, image.height, levels, HashSource(sourcePath), stamp);
+        return stats;
+    }
+
+    bool TextureFile::Open(const std::string& cookedPath, const std::string& sourcePath) {
+        m_Levels.clear();
+        if (!utils::VirtualFileSystem::Exists(cookedPath)) return false;
+
+        m_File = utils::VirtualFileSystem::Open(cookedPath);
+        const char* base = m_File.Data();
+        const size_t size = m_File.Size();
+
+        RTexHeader header{};
+        if (size < sizeof(header)) return false;
+        std::memcpy(&header, base, sizeof(header));
+        if (header.magic != kMagic || header.version != kVersion ||
+            header.format > static_cast<uint32_t>(TextureFormat::BC7) || header.levelCount == 0 ||
+            sizeof(RTexHeader) + static_cast<size_t>(header.levelCount) * sizeof(RTexLevelRecord) > size)
+            return false;
+
+        const auto format = static_cast<TextureFormat>(header.format);
+        std::vector<TextureLevel> levels(header.levelCount);
+        const char* cursor = base + sizeof(RTexHeader);
+        for (auto& level : levels) {
+            RTexLevelRecord record;
+            std::memcpy(&record, cursor, sizeof(record));
+            cursor += sizeof(record);
+            if (record.offset > size || record.size > size - record.offset ||
+                record.size != GetTextureLevelSize(format, static_cast<int>(record.width), static_cast<int>(record.height)))
+                return false;
+            level.width = static_cast<int>(record.width);
+            level.height = static_cast<int>(record.height);
+            level.data = reinterpret_cast<const uint8_t*>(base + record.offset);
+            level.size = record.size;
+        }
+
+        // 源文件不存在时（仅随发布包提供烘焙结果）直接信任；大小与时间变化时再比对内容哈希
+        utils::VirtualFileSystem::FileStamp stamp;
+        if (utils::VirtualFileSystem::GetStamp(sourcePath, stamp) &&
+            (stamp.size != header.sourceSize || stamp.mtime != header.sourceTime)) {
+            if (HashSource(sourcePath) != header.sourceHash) return false;
+            // 内容未变：改写文件头记录的大小与时间，下次打开不必再计算哈希
+            header.sourceSize = stamp.size;
+            header.sourceTime = stamp.mtime;
+            utils::VirtualFileSystem::PatchLooseFile(cookedPath, offsetof(RTexHeader, sourceSize),
+                                                     &header.sourceSize, sizeof(header.sourceSize) + sizeof(header.sourceTime));
+        }
+
+        m_Format = format;
+        m_SRGB = (header.flags & kFlagSRGB) != 0;
+        m_Width = static_cast<int>(header.width);
+        m_Height = static_cast<int>(header.height);
+        m_Levels = std::move(levels);
+        return true;
+    }
+
+    TextureSource TextureSource::Load(const std::string& path, bool useSRGB) {
+        TextureSource source;
+        const std::string cookedPath = TextureFile::GetCookedPath(path);
+        if (utils::VirtualFileSystem::Exists(cookedPath)) {
+            try {
+                auto file = std::make_shared<TextureFile>();
+                if (file->Open(cookedPath, path)) {
+                    if (GLExtensions::IsFormatSupported(file->GetFormat(), useSRGB)) {
+                        source.cooked = std::move(file);
+                        return source;
+                    }
+                    if (!utils::VirtualFileSystem::Exists(path)) {
+                        // 只有烘焙文件而GPU不支持其格式：CPU 解压首级，mip 由驱动生成
+                        const TextureLevel& level = file->GetLevels().front();
+                        std::vector<uint8_t> rgba = BlockCompressor::Decompress(file->GetFormat(), level.data, level.width, level.height);
+                        auto image = std::make_shared<ImageData>(ImageData::Allocate(level.width, level.height, 4));
+                        std::memcpy(image->pixels.get(), rgba.data(), rgba.size());
+                        source.image = std::move(image);
+                        return source;
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cout << "[Texture Warning] Ignoring cooked texture: " << e.what() << std::endl;
+            }
+        }
+
+        source.image = std::make_shared<ImageData>(ImageData::LoadFromFile(path));
+        return source;
+    }
+
+} // namespace graphics
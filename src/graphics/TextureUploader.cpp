@@ -0,0 +1,209 @@
+#include "graphics/TextureUploader.h"
+#include "graphics/GLExtensions.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace graphics {
+
+namespace {
+
+    GLenum GetPixelFormat(int channels) {
+        return channels == 1 ? GL_RED : (channels == 3 ? GL_RGB : GL_RGBA);
+    }
+
+    // 级别的上传行数：未压缩为像素行，块压缩为4像素高的块行
+    int GetRowCount(const TextureLevel& level, bool compressed) {
+        return compressed ? (level.height + 3) / 4 : level.height;
+    }
+
+} // namespace
+
+    std::deque<TextureUploader::Job> TextureUploader::s_Jobs;
+    std::vector<TextureUploader::Slot> TextureUploader::s_Slots;
+    size_t TextureUploader::s_NextSlot = 0;
+    size_t TextureUploader::s_SlotSize = 0;
+    size_t TextureUploader::s_FrameBudget = 8 * 1024 * 1024;
+    TextureUploader::Stats TextureUploader::s_Stats;
+
+    void TextureUploader::SetFrameBudget(size_t bytesPerFrame) {
+        s_FrameBudget = std::max(bytesPerFrame, kMinFrameBudget);
+    }
+
+    void TextureUploader::Enqueue(std::shared_ptr<Texture> texture,
+                                  TextureSource source,
+                                  bool useSRGB,
+                                  std::function<void()> onComplete) {
+        if (!texture || !source.IsValid())
+            throw std::runtime_error("Cannot stream an empty texture source");
+
+        Job job;
+        if (source.cooked) {
+            const TextureFile& file = *source.cooked;
+            texture->AllocateStorage(file, useSRGB);
+            job.levels = file.GetLevels();
+            job.compressed = IsBlockCompressed(file.GetFormat());
+            job.format = job.compressed ? GLExtensions::GetInternalFormat(file.GetFormat(), useSRGB) : GL_RGBA;
+        } else {
+            const ImageData& image = *source.image;
+            texture->AllocateStorage(image.width, image.height, image.channels, useSRGB);
+            job.levels.push_back({image.width, image.height, image.pixels.get(), image.GetByteSize()});
+            job.format = GetPixelFormat(image.channels);
+        }
+
+        for (const auto& level : job.levels) s_Stats.pendingBytes += level.size;
+        job.texture = std::move(texture);
+        job.source = std::move(source);
+        job.onComplete = std::move(onComplete);
+        s_Jobs.push_back(std::move(job));
+    }
+
+    void TextureUploader::SubmitBand(const Band& band, const uint8_t* pixels) {
+        const Job& job = *band.job;
+        const TextureLevel& level = job.levels[band.level];
+        const int rowHeight = job.compressed ? 4 : 1;
+        const int y = band.firstRow * rowHeight;
+        const int height = std::min(band.rowCount * rowHeight, level.height - y);
+        const size_t rowBytes = level.size / GetRowCount(level, job.compressed);
+
+        glBindTexture(GL_TEXTURE_2D, job.texture->GetID());
+        if (job.compressed) {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(band.level), 0, y, level.width, height, job.format,
+                                      static_cast<GLsizei>(band.rowCount * rowBytes), pixels);
+        } else {
+            glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(band.level), 0, y, level.width, height, job.format,
+                            GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+
+    void TextureUploader::CreateRing() {
+        s_SlotSize = s_FrameBudget;
+        s_Slots.resize(kRingSize);
+        for (auto& slot : s_Slots) {
+            glGenBuffers(1, &slot.pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(s_SlotSize), nullptr, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        s_NextSlot = 0;
+    }
+
+    void TextureUploader::DestroyRing() {
+        for (auto& slot : s_Slots) {
+            if (slot.fence) glDeleteSync(slot.fence);
+            glDeleteBuffers(1, &slot.pbo);
+        }
+        s_Slots.clear();
+        s_SlotSize = 0;
+    }
+
+    void TextureUploader::Update() {
+        s_Stats.lastFrameBytes = 0;
+        if (s_Jobs.empty()) return;
+
+        if (s_SlotSize != s_FrameBudget) {
+            DestroyRing();
+            CreateRing();
+        }
+
+        // 环中下一个PBO仍在被GPU读取时本帧不上传，避免同步等待
+        Slot& slot = s_Slots[s_NextSlot];
+        if (slot.fence) {
+            if (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+                ++s_Stats.skippedFrames;
+                return;
+            }
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        auto* mapped = static_cast<unsigned char*>(glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(s_SlotSize),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+        if (!mapped) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            return;
+        }
+
+        // 先把各纹理的连续行段拷入PBO，解除映射后再逐段提交
+        std::vector<Band> bands;
+        size_t used = 0;
+        size_t uploaded = 0;
+        bool full = false;
+        for (auto& job : s_Jobs) {
+            while (job.level < job.levels.size()) {
+                const TextureLevel& level = job.levels[job.level];
+                const int rowCount = GetRowCount(level, job.compressed);
+                const size_t rowBytes = level.size / rowCount;
+                if (rowBytes > s_SlotSize - used) {
+                    full = true;
+                    break;
+                }
+
+                int rows = static_cast<int>(std::min<size_t>((s_SlotSize - used) / rowBytes, rowCount - job.nextRow));
+                std::memcpy(mapped + used, level.data + job.nextRow * rowBytes, rows * rowBytes);
+                bands.push_back({&job, job.level, job.nextRow, rows, used});
+                used = std::min(s_SlotSize, (used + rows * rowBytes + 3) & ~static_cast<size_t>(3)); // 下一段4字节对齐
+                uploaded += rows * rowBytes;
+
+                job.nextRow += rows;
+                if (job.nextRow < rowCount) {
+                    full = true;
+                    break;
+                }
+                ++job.level;
+                job.nextRow = 0;
+            }
+            if (full) break;
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (const auto& band : bands) {
+            SubmitBand(band, reinterpret_cast<const uint8_t*>(band.offset));
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (bands.empty()) {
+            // 单行超过PBO容量的极宽纹理：直接从内存上传一行
+            Job& job = s_Jobs.front();
+            const TextureLevel& level = job.levels[job.level];
+            const int rowCount = GetRowCount(level, job.compressed);
+            const size_t rowBytes = level.size / rowCount;
+            SubmitBand({&job, job.level, job.nextRow, 1, 0}, level.data + job.nextRow * rowBytes);
+            uploaded = rowBytes;
+            if (++job.nextRow == rowCount) {
+                ++job.level;
+                job.nextRow = 0;
+            }
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (!bands.empty()) {
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            s_NextSlot = (s_NextSlot + 1) % s_Slots.size();
+        }
+
+        s_Stats.lastFrameBytes = uploaded;
+        s_Stats.peakFrameBytes = std::max(s_Stats.peakFrameBytes, uploaded);
+        s_Stats.pendingBytes -= std::min(s_Stats.pendingBytes, uploaded);
+
+        // 完成的纹理设置采样参数（必要时生成mipmap）并通知调用方
+        while (!s_Jobs.empty() && s_Jobs.front().level >= s_Jobs.front().levels.size()) {
+            Job job = std::move(s_Jobs.front());
+            s_Jobs.pop_front();
+            job.texture->FinishUpload();
+            ++s_Stats.texturesCompleted;
+            if (job.onComplete) job.onComplete();
+        }
+    }
+
+    void TextureUploader::Shutdown() {
+        s_Jobs.clear();
+        DestroyRing();
+        s_Stats = Stats{};
+    }
+
+} // namespace graphics
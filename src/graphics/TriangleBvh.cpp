@@ -0,0 +1,219 @@
+#include "graphics/TriangleBvh.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace graphics {
+
+namespace {
+
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    struct Bounds {
+        glm::vec3 min{kInfinity};
+        glm::vec3 max{-kInfinity};
+
+        void Grow(const glm::vec3& point) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+        void Grow(const Bounds& other) {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+        /// 表面积的一半（SAH 只比较相对大小）
+        float HalfArea() const {
+            const glm::vec3 e = glm::max(max - min, glm::vec3(0.0f));
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        }
+    };
+
+} // namespace
+
+    void TriangleBvh::Build(const glm::vec3* positions, size_t vertexCount, size_t stride, const unsigned int* indices,
+                            size_t indexCount) {
+        m_Nodes.clear();
+        m_Triangles.clear();
+        m_Depth = 0;
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) return;
+        if (triangleCount > std::numeric_limits<uint32_t>::max() / 2)
+            throw std::runtime_error("[TriangleBvh] Too many triangles");
+
+        const char* base = reinterpret_cast<const char*>(positions);
+        const auto position = [&](unsigned int index) {
+            if (index >= vertexCount) throw std::runtime_error("[TriangleBvh] Vertex index out of range");
+            return *reinterpret_cast<const glm::vec3*>(base + index * stride);
+        };
+
+        std::vector<Bounds> boxes(triangleCount);
+        std::vector<glm::vec3> centroids(triangleCount);
+        std::vector<uint32_t> order(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) boxes[t].Grow(position(indices[3 * t + k]));
+            centroids[t] = 0.5f * (boxes[t].min + boxes[t].max);
+            order[t] = static_cast<uint32_t>(t);
+        }
+
+        // 自顶向下：节点先登记三角形区间，出栈时计算包围盒并按 SAH 选择划分
+        m_Nodes.reserve(2 * triangleCount - 1);
+        m_Nodes.push_back(Node{glm::vec3(0.0f), 0, glm::vec3(0.0f), static_cast<uint32_t>(triangleCount)});
+        struct Task {
+            uint32_t node, depth;
+        };
+        std::vector<Task> tasks{{0, 1}};
+        while (!tasks.empty()) {
+            const Task task = tasks.back();
+            tasks.pop_back();
+            const uint32_t first = m_Nodes[task.node].first, count = m_Nodes[task.node].count;
+
+            Bounds bounds, centroidBounds;
+            for (uint32_t i = first; i < first + count; ++i) {
+                bounds.Grow(boxes[order[i]]);
+                centroidBounds.Grow(centroids[order[i]]);
+            }
+            m_Nodes[task.node].min = bounds.min;
+            m_Nodes[task.node].max = bounds.max;
+            m_Depth = std::max(m_Depth, task.depth);
+            if (count <= kMaxLeafTriangles || task.depth >= kMaxDepth) continue;
+
+            // 每个轴把质心范围等分为 kBinCount 个桶，在桶边界处取 左面积 × 左数量 + 右面积 × 右数量 最小者
+            const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+            float bestCost = kInfinity;
+            int bestAxis = -1;
+            uint32_t bestSplit = 0;
+            const auto binOf = [&](uint32_t triangle, int axis) {
+                const float scale = static_cast<float>(kBinCount) / extent[axis];
+                const auto bin = static_cast<uint32_t>((centroids[triangle][axis] - centroidBounds.min[axis]) * scale);
+                return std::min(bin, kBinCount - 1);
+            };
+            for (int axis = 0; axis < 3; ++axis) {
+                if (!(extent[axis] > 0.0f)) continue;
+                Bounds bins[kBinCount];
+                uint32_t binCounts[kBinCount] = {};
+                for (uint32_t i = first; i < first + count; ++i) {
+                    const uint32_t bin = binOf(order[i], axis);
+                    ++binCounts[bin];
+                    bins[bin].Grow(boxes[order[i]]);
+                }
+                float rightArea[kBinCount];
+                uint32_t rightCount[kBinCount];
+                Bounds accumulated;
+                uint32_t accumulatedCount = 0;
+                for (uint32_t bin = kBinCount - 1; bin > 0; --bin) {
+                    accumulated.Grow(bins[bin]);
+                    accumulatedCount += binCounts[bin];
+                    rightArea[bin] = accumulated.HalfArea();
+                    rightCount[bin] = accumulatedCount;
+                }
+                accumulated = Bounds{};
+                accumulatedCount = 0;
+                for (uint32_t split = 1; split < kBinCount; ++split) {
+                    accumulated.Grow(bins[split - 1]);
+                    accumulatedCount += binCounts[split - 1];
+                    if (accumulatedCount == 0 || rightCount[split] == 0) continue;
+                    const float cost = static_cast<float>(accumulatedCount) * accumulated.HalfArea() +
+                                       static_cast<float>(rightCount[split]) * rightArea[split];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            // 质心全部重合时无法按空间划分，按数量对半分
+            uint32_t middle = first + count / 2;
+            if (bestAxis >= 0) {
+                const auto begin = order.begin() + first;
+                middle = first + static_cast<uint32_t>(std::partition(begin, begin + count, [&](uint32_t triangle) {
+                    return binOf(triangle, bestAxis) < bestSplit;
+                }) - begin);
+            }
+
+            const auto left = static_cast<uint32_t>(m_Nodes.size());
+            m_Nodes.push_back(Node{glm::vec3(0.0f), first, glm::vec3(0.0f), middle - first});
+            m_Nodes.push_back(Node{glm::vec3(0.0f), middle, glm::vec3(0.0f), first + count - middle});
+            m_Nodes[task.node].first = left;
+            m_Nodes[task.node].count = 0;
+            tasks.push_back({left, task.depth + 1});
+            tasks.push_back({left + 1, task.depth + 1});
+        }
+
+        m_Triangles.resize(triangleCount);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            const uint32_t t = order[i];
+            const glm::vec3 v0 = position(indices[3 * t]);
+            m_Triangles[i] = Triangle{v0, position(indices[3 * t + 1]) - v0, position(indices[3 * t + 2]) - v0, t};
+        }
+    }
+
+    bool TriangleBvh::Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                RayHit& hit) const {
+        if (m_Nodes.empty()) return false;
+
+        const glm::vec3 inverse = InverseRayDirection(direction);
+        const auto enter = [&](const Node& node, float tMax) {
+            const glm::vec3 t1 = (node.min - origin) * inverse, t2 = (node.max - origin) * inverse;
+            const glm::vec3 tNear = glm::min(t1, t2), tFar = glm::max(t1, t2);
+            const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+            const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+            return tEnter <= tExit ? tEnter : kInfinity;
+        };
+
+        float best = maxDistance;
+        bool found = false;
+        if (enter(m_Nodes[0], best) == kInfinity) return false;
+
+        // 先进入较近的子节点，较远的入栈；出栈时跳过进入距离已超过当前最近交点的节点
+        struct Pending {
+            uint32_t node;
+            float tEnter;
+        };
+        Pending stack[kMaxDepth];
+        int count = 0;
+        uint32_t current = 0;
+        for (;;) {
+            const Node& node = m_Nodes[current];
+            if (node.count > 0) {
+                // Möller–Trumbore
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Triangle& triangle = m_Triangles[i];
+                    const glm::vec3 p = glm::cross(direction, triangle.edge2);
+                    const float det = glm::dot(triangle.edge1, p);
+                    if (det == 0.0f) continue;
+                    const float invDet = 1.0f / det;
+                    const glm::vec3 s = origin - triangle.v0;
+                    const float u = glm::dot(s, p) * invDet;
+                    if (u < 0.0f || u > 1.0f) continue;
+                    const glm::vec3 q = glm::cross(s, triangle.edge1);
+                    const float v = glm::dot(direction, q) * invDet;
+                    if (v < 0.0f || u + v > 1.0f) continue;
+                    const float t = glm::dot(triangle.edge2, q) * invDet;
+                    if (!(t > 0.0f) || t > best) continue;
+                    best = t;
+                    hit = RayHit{t, triangle.index, glm::vec2(u, v)};
+                    found = true;
+                }
+            } else {
+                const float tLeft = enter(m_Nodes[node.first], best);
+                const float tRight = enter(m_Nodes[node.first + 1], best);
+                if (tLeft != kInfinity && tRight != kInfinity) {
+                    const bool leftFirst = tLeft <= tRight;
+                    stack[count++] = {leftFirst ? node.first + 1 : node.first, leftFirst ? tRight : tLeft};
+                    current = leftFirst ? node.first : node.first + 1;
+                    continue;
+                }
+                if (tLeft != kInfinity || tRight != kInfinity) {
+                    current = tLeft != kInfinity ? node.first : node.first + 1;
+                    continue;
+                }
+            }
+
+            while (count > 0 && stack[count - 1].tEnter > best) --count;
+            if (count == 0) return found;
+            current = stack[--count].node;
+        }
+    }
+
+} // namespace graphics
@@ -0,0 +1,207 @@
+#include "graphics/VertexQuantizer.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace graphics {
+
+namespace {
+
+    // Compact16：位置 unorm16x3 + 1 个对齐填充，法线 snorm16x2，UV half2，共 16 字节
+    struct CompactVertex16 {
+        uint16_t position[4];
+        int16_t normal[2];
+        uint16_t texCoords[2];
+    };
+    static_assert(sizeof(CompactVertex16) == 16, "CompactVertex16 must be 16 bytes");
+
+    // Compact8：位置 unorm16x3，法线 snorm8x2，UV half2，共 12 字节
+    struct CompactVertex8 {
+        uint16_t position[3];
+        int8_t normal[2];
+        uint16_t texCoords[2];
+    };
+    static_assert(sizeof(CompactVertex8) == 12, "CompactVertex8 must be 12 bytes");
+
+    float SignNotZero(float v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+    uint16_t QuantizeUnorm16(float v) {
+        return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    /**
+     * @brief 八面体编码并量化为 snorm：在四个相邻格点中选取解码后与原法线夹角最小的一个
+     * 比直接四舍五入的最大误差小约一半，8 位时差异明显
+     */
+    void QuantizeOctahedral(const glm::vec3& n, float maxValue, int out[2]) {
+        const glm::vec2 e = VertexQuantizer::EncodeOctahedral(n) * maxValue;
+        const int x0 = static_cast<int>(std::floor(e.x)), y0 = static_cast<int>(std::floor(e.y));
+        const int limit = static_cast<int>(maxValue);
+        float bestDot = -2.0f;
+        for (int dy = 0; dy <= 1; ++dy) {
+            for (int dx = 0; dx <= 1; ++dx) {
+                const int qx = std::clamp(x0 + dx, -limit, limit);
+                const int qy = std::clamp(y0 + dy, -limit, limit);
+                const glm::vec3 decoded = VertexQuantizer::DecodeOctahedral(glm::vec2(qx, qy) / maxValue);
+                const float d = glm::dot(decoded, n);
+                if (d > bestDot) {
+                    bestDot = d;
+                    out[0] = qx;
+                    out[1] = qy;
+                }
+            }
+        }
+    }
+
+    float AngleDeg(const glm::vec3& a, const glm::vec3& b) {
+        return glm::degrees(std::acos(std::clamp(glm::dot(a, b), -1.0f, 1.0f)));
+    }
+
+} // namespace
+
+    uint32_t VertexQuantizer::GetStride(VertexFormat format) {
+        switch (format) {
+        case VertexFormat::Compact16: return sizeof(CompactVertex16);
+        case VertexFormat::Compact8: return sizeof(CompactVertex8);
+        default: return sizeof(Vertex);
+        }
+    }
+
+    glm::vec2 VertexQuantizer::EncodeOctahedral(const glm::vec3& n) {
+        const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (l1 <= 0.0f) return glm::vec2(0.0f);
+        glm::vec2 p = glm::vec2(n.x, n.y) / l1;
+        if (n.z < 0.0f) {
+            // 下半球沿对角线折叠到外侧三角形
+            p = glm::vec2((1.0f - std::abs(p.y)) * SignNotZero(p.x), (1.0f - std::abs(p.x)) * SignNotZero(p.y));
+        }
+        return p;
+    }
+
+    glm::vec3 VertexQuantizer::DecodeOctahedral(const glm::vec2& e) {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        if (n.z < 0.0f) {
+            n.x = (1.0f - std::abs(e.y)) * SignNotZero(e.x);
+            n.y = (1.0f - std::abs(e.x)) * SignNotZero(e.y);
+        }
+        return glm::normalize(n);
+    }
+
+    QuantizedVertices VertexQuantizer::Quantize(const Vertex* vertices, size_t vertexCount, VertexFormat format) {
+        QuantizedVertices result;
+        result.format = format;
+        result.stride = GetStride(format);
+        result.vertexCount = vertexCount;
+        result.data.resize(vertexCount * result.stride);
+        if (vertexCount == 0) return result;
+
+        if (format == VertexFormat::Float) {
+            std::memcpy(result.data.data(), vertices, vertexCount * sizeof(Vertex));
+            return result;
+        }
+
+        glm::vec3 boundsMin(vertices[0].Position), boundsMax(vertices[0].Position);
+        for (size_t i = 1; i < vertexCount; ++i) {
+            boundsMin = glm::min(boundsMin, vertices[i].Position);
+            boundsMax = glm::max(boundsMax, vertices[i].Position);
+        }
+        result.offset = boundsMin;
+        result.scale = boundsMax - boundsMin;
+        // 退化轴（平面网格）上所有量化值为 0，scale 为 0 即可还原
+        const glm::vec3 invScale(result.scale.x > 0.0f ? 1.0f / result.scale.x : 0.0f,
+                                 result.scale.y > 0.0f ? 1.0f / result.scale.y : 0.0f,
+                                 result.scale.z > 0.0f ? 1.0f / result.scale.z : 0.0f);
+
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const Vertex& v = vertices[i];
+            const glm::vec3 p = (v.Position - boundsMin) * invScale;
+            int oct[2] = {0, 0};
+            if (format == VertexFormat::Compact16) {
+                CompactVertex16 q{};
+                q.position[0] = QuantizeUnorm16(p.x);
+                q.position[1] = QuantizeUnorm16(p.y);
+                q.position[2] = QuantizeUnorm16(p.z);
+                QuantizeOctahedral(v.Normal, 32767.0f, oct);
+                q.normal[0] = static_cast<int16_t>(oct[0]);
+                q.normal[1] = static_cast<int16_t>(oct[1]);
+                q.texCoords[0] = glm::packHalf1x16(v.TexCoords.x);
+                q.texCoords[1] = glm::packHalf1x16(v.TexCoords.y);
+                std::memcpy(result.data.data() + i * result.stride, &q, sizeof(q));
+            } else {
+                CompactVertex8 q{};
+                q.position[0] = QuantizeUnorm16(p.x);
+                q.position[1] = QuantizeUnorm16(p.y);
+                q.position[2] = QuantizeUnorm16(p.z);
+                QuantizeOctahedral(v.Normal, 127.0f, oct);
+                q.normal[0] = static_cast<int8_t>(oct[0]);
+                q.normal[1] = static_cast<int8_t>(oct[1]);
+                q.texCoords[0] = glm::packHalf1x16(v.TexCoords.x);
+                q.texCoords[1] = glm::packHalf1x16(v.TexCoords.y);
+                std::memcpy(result.data.data() + i * result.stride, &q, sizeof(q));
+            }
+        }
+        return result;
+    }
+
+    Vertex VertexQuantizer::Dequantize(const QuantizedVertices& quantized, size_t index) {
+        const uint8_t* src = quantized.data.data() + index * quantized.stride;
+        Vertex v;
+        if (quantized.format == VertexFormat::Float) {
+            std::memcpy(&v, src, sizeof(Vertex));
+            return v;
+        }
+
+        const uint16_t* position;
+        glm::vec2 oct;
+        const uint16_t* texCoords;
+        CompactVertex16 q16;
+        CompactVertex8 q8;
+        if (quantized.format == VertexFormat::Compact16) {
+            std::memcpy(&q16, src, sizeof(q16));
+            position = q16.position;
+            oct = glm::max(glm::vec2(q16.normal[0], q16.normal[1]) / 32767.0f, glm::vec2(-1.0f));
+            texCoords = q16.texCoords;
+        } else {
+            std::memcpy(&q8, src, sizeof(q8));
+            position = q8.position;
+            oct = glm::max(glm::vec2(q8.normal[0], q8.normal[1]) / 127.0f, glm::vec2(-1.0f));
+            texCoords = q8.texCoords;
+        }
+        v.Position = glm::vec3(position[0], position[1], position[2]) / 65535.0f * quantized.scale + quantized.offset;
+        v.Normal = DecodeOctahedral(oct);
+        v.TexCoords = glm::vec2(glm::unpackHalf1x16(texCoords[0]), glm::unpackHalf1x16(texCoords[1]));
+        return v;
+    }
+
+    QuantizationError VertexQuantizer::Measure(const Vertex* vertices, const QuantizedVertices& quantized) {
+        QuantizationError error;
+        error.boundsDiagonal = glm::length(quantized.scale);
+        if (quantized.vertexCount == 0) return error;
+
+        double sumSquared = 0.0, sumAngle = 0.0;
+        size_t normalCount = 0;
+        for (size_t i = 0; i < quantized.vertexCount; ++i) {
+            const Vertex decoded = Dequantize(quantized, i);
+            const float positionError = glm::length(decoded.Position - vertices[i].Position);
+            error.maxPosition = std::max(error.maxPosition, positionError);
+            sumSquared += static_cast<double>(positionError) * positionError;
+
+            // 零长度法线（OBJ 缺失法线）不计入角度误差
+            const float length = glm::length(vertices[i].Normal);
+            if (length > 0.0f) {
+                const float angle = AngleDeg(vertices[i].Normal / length, decoded.Normal);
+                error.maxNormalDeg = std::max(error.maxNormalDeg, angle);
+                sumAngle += angle;
+                ++normalCount;
+            }
+
+            const glm::vec2 uvError = glm::abs(decoded.TexCoords - vertices[i].TexCoords);
+            error.maxTexCoord = std::max(error.maxTexCoord, std::max(uvError.x, uvError.y));
+        }
+        error.rmsPosition = static_cast<float>(std::sqrt(sumSquared / quantized.vertexCount));
+        error.meanNormalDeg = normalCount > 0 ? static_cast<float>(sumAngle / normalCount) : 0.0f;
+        return error;
+    }
+
+} // namespace graphics
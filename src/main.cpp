@@ -1,12 +1,19 @@
 ﻿    #include <glad/glad.h>
     #include <GLFW/glfw3.h>
     #include <iostream>
+    #include <algorithm>
+    #include <chrono>
+    #include <cmath>
+    #include <cstdlib>
+    #include <cstring>
 
     #include "core/Window.h"
+    #include "core/JobSystem.h"
     #include "resource/ResourceManager.h"
     #include "graphics/Camera.h"
     #include "graphics/CameraController.h"
     #include "graphics/Model.h"
+    #include "graphics/GLExtensions.h"
     #include "core/InputManager.h"
     #include "utils/Time.h"
 
@@ -14,8 +21,10 @@
     #include "pipeline/OutlinePipeline.h"
     #include "scene/Scene.h"
     #include "scene/Entity.h"
+    #include "scene/TransformSystem.h"
     #include "graphics/Light.h"
     #include "utils/PathResolver.h"
+    #include "utils/VirtualFileSystem.h"
     #include "ui/UIManager.h"
 
     using namespace core;
@@ -24,8 +33,25 @@
     using namespace pipeline;
     using namespace ui;
 
-    int main() {
+    int main(int argc, char** argv) {
+        // --stress N：额外在网格上摆放 N 个模型实例，用于观察 LOD 与剔除对帧耗时的影响
+        // --gpu-budget MB：显存预算，超出时驱逐最近最少使用的纹理与网格
+        int stressCount = 0;
+        int gpuBudgetMB = 0;
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::strcmp(argv[i], "--stress") == 0) stressCount = std::max(0, std::atoi(argv[i + 1]));
+            if (std::strcmp(argv[i], "--gpu-budget") == 0) gpuBudgetMB = std::max(0, std::atoi(argv[i + 1]));
+        }
+        // --no-shader-cache：不读写程序二进制缓存，用于测量冷启动编译耗时
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--no-shader-cache") == 0) Shader::SetBinaryCacheEnabled(false);
+        }
+
         try {
+            // 主线程作为 0 号工作线程，加载、变换传播与遮挡光栅化经任务系统分发到其余核心
+            JobSystem::Initialize();
+            TransformSystem::SetThreadCount(0);
+
             // 创建窗口
             auto windowPtr = std::make_shared<Window>(1280, 720, "Rrender Engine - BlinnPhong");
 
@@ -33,8 +59,17 @@
             if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
                 throw std::runtime_error("Failed to initialize GLAD");
             }
+            GLExtensions::Init((GLADloadproc)glfwGetProcAddress);
+
+            // 存在资源包时优先从包内读取，缺失的文件回退到 assets/ 与 shaders/ 下的松散文件
+            if (utils::VirtualFileSystem::Mount(PathResolver::Resolve("rrender.rpak")))
+                std::cout << "[VFS] Mounted rrender.rpak" << std::endl;
             
 
+            // 模型顶点使用 16 字节紧凑格式上传（着色器中反量化）
+            Mesh::SetDefaultFormat(VertexFormat::Compact16);
+            ResourceManager::SetGpuBudget(static_cast<size_t>(gpuBudgetMB) * 1024 * 1024);
+
             // 初始化输入和相机控制器
             InputManager::Init(windowPtr);
             auto cameraPtr = std::make_shared<Camera>(Camera::ProjectionType::Perspective);
@@ -46,27 +81,71 @@
             auto controllerPtr = std::make_shared<CameraController>(cameraPtr);
             InputManager::RegisterListener(controllerPtr);
 
-            // 载入着色器和模型资源
-            auto shader = ResourceManager::LoadShader(
-                PathResolver::Resolve("shaders/blinn_phong/blinnphong.vert"),
-                PathResolver::Resolve("shaders/blinn_phong/blinnphong.frag"));
-            auto model = ResourceManager::LoadModel(
-                PathResolver::Resolve("assets/objects/backpack/backpack.obj"));
+            // 载入着色器：全部程序先提交编译再统一等待，命中程序二进制缓存时跳过编译
+            const auto shaderStart = std::chrono::steady_clock::now();
+            auto shaders = ResourceManager::LoadShaders({
+                {PathResolver::Resolve("shaders/blinn_phong/blinnphong.vert"),
+                 PathResolver::Resolve("shaders/blinn_phong/blinnphong.frag")},
+                {PathResolver::Resolve("shaders/outline/outline.vert"),
+                 PathResolver::Resolve("shaders/outline/outline.frag")},
+            });
+            const auto& shaderStats = Shader::GetStats();
+            std::cout << "[Shader] " << shaderStats.programs << " programs ready in "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - shaderStart).count()
+                      << " ms (" << shaderStats.binaryHits << " from binary cache, " << shaderStats.compiled << " compiled)"
+                      << std::endl;
+            auto shader = shaders[0];
+
+            // 模型以后台任务并发加载，就绪前以占位网格绘制
+            struct ModelEntry {
+                const char* path;
+                glm::vec3 position;
+                float scale;
+            };
+            const ModelEntry modelEntries[] = {
+                {"assets/objects/backpack/backpack.obj", glm::vec3(0.0f, 0.0f, 0.0f), 1.0f},
+                {"assets/objects/cyborg/cyborg.obj", glm::vec3(-3.0f, 0.0f, 0.0f), 1.0f},
+                {"assets/objects/nanosuit/nanosuit.obj", glm::vec3(3.0f, 0.0f, 0.0f), 0.2f},
+                {"assets/objects/rock/rock.obj", glm::vec3(-3.0f, 0.0f, -4.0f), 1.0f},
+                {"assets/objects/planet/planet.obj", glm::vec3(3.0f, 2.0f, -6.0f), 0.5f},
+            };
+            std::vector<LoadHandle<Model>> modelHandles;
+            for (const auto& entry : modelEntries) {
+                modelHandles.push_back(ResourceManager::LoadModelAsync(PathResolver::Resolve(entry.path)));
+            }
 
             // 创建渲染管线
             //BlinnPhongPipeline pipeline(shader);
-            OutlinePipeline pipeline(
-                shader,
-                ResourceManager::LoadShader(
-                    PathResolver::Resolve("shaders/outline/outline.vert"),
-                    PathResolver::Resolve("shaders/outline/outline.frag")));
+            OutlinePipeline pipeline(shader, shaders[1]);
 
             // 创建场景和实体
             auto scenePtr = std::make_shared<Scene>();
-            auto entityPtr = std::make_shared<Entity>(model);
-            entityPtr->SetPosition(glm::vec3(0.0f));
-            entityPtr->SetScale(glm::vec3(1.0f));
-            scenePtr->AddEntity(entityPtr);
+            for (size_t i = 0; i < modelHandles.size(); ++i) {
+                auto entityPtr = std::make_shared<Entity>(modelHandles[i].Get());
+                entityPtr->SetPosition(modelEntries[i].position);
+                entityPtr->SetScale(glm::vec3(modelEntries[i].scale));
+                scenePtr->AddEntity(entityPtr);
+            }
+            // 背包、岩石与行星较为实心，作为遮挡体
+            for (size_t i : {0, 3, 4}) scenePtr->GetEntities()[i]->SetOccluder(true);
+
+            // 岩石卫星绕行星公转：旋转的空节点挂在行星下，卫星挂在空节点下
+            auto orbitPivot = std::make_shared<Entity>(nullptr);
+            orbitPivot->SetParent(scenePtr->GetEntities()[4]);
+            auto moon = std::make_shared<Entity>(modelHandles[3].Get());
+            moon->SetParent(orbitPivot);
+            moon->SetPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+            moon->SetScale(glm::vec3(0.3f));
+            scenePtr->AddEntity(moon);
+
+            const int gridSize = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(stressCount))));
+            for (int i = 0; i < stressCount; ++i) {
+                const size_t model = static_cast<size_t>(i) % modelHandles.size();
+                auto entityPtr = std::make_shared<Entity>(modelHandles[model].Get());
+                entityPtr->SetPosition(glm::vec3(4.0f * (i % gridSize - gridSize / 2), 0.0f, -8.0f - 4.0f * (i / gridSize)));
+                entityPtr->SetScale(glm::vec3(modelEntries[model].scale));
+                scenePtr->AddEntity(entityPtr);
+            }
 
             // 添加方向光
             auto dirLight = std::make_shared<DirectionalLight>();
@@ -77,11 +156,11 @@
 
             // 添加点光源
             auto pointLight = std::make_shared<PointLight>();
-            pointLight->SetPosition(glm::vec3(2.0f, 2.0f, 2.0f));
             pointLight->SetColor(glm::vec3(1.0f));
             pointLight->SetIntensity(1.0f);
             pointLight->SetAttenuation(1.0f, 0.09f, 0.032f);
             scenePtr->AddLight(pointLight);
+            scenePtr->AttachLight(pointLight, scenePtr->GetEntities()[0], glm::vec3(2.0f, 2.0f, 2.0f));
 
             // 添加聚光灯
             auto spotLight = std::make_shared<SpotLight>();
@@ -102,6 +181,14 @@
                 utils::Time::Update(glfwGetTime());
                 InputManager::Update();
 
+                // 上传已在后台完成读取和解码的资源
+                ResourceManager::Update();
+
+                // 批量重算本帧修改过的变换并沿层级传播，同步挂在实体上的光源
+                orbitPivot->SetRotation(glm::vec3(0.0f, 20.0f * utils::Time::GetTime(), 0.0f));
+                TransformSystem::Update();
+                scenePtr->Update();
+
                 // 聚光灯随相机移动和转向
                 spotLight->SetPosition(cameraPtr->GetPosition());
                 spotLight->SetDirection(glm::normalize(cameraPtr->GetFront()));
@@ -113,6 +200,12 @@
                 UIManager::BeginFrame();
 
                 // 渲染场景
+                MeshletCuller::ResetStats();
+                FrustumCuller::ResetStats();
+                OcclusionCuller::ResetStats();
+                Mesh::ResetDrawStats();
+                CommandExecutor::ResetStats();
+                RenderQueue::ResetStats();
                 pipeline.Render(scenePtr, cameraPtr);
 
                 // 渲染UI界面，传入相机和场景
@@ -121,12 +214,20 @@
                 // 结束UI绘制，提交绘制命令
                 UIManager::EndFrame();
 
+                // 统计显存，重新加载本帧用到的已驱逐资源，超出预算时驱逐未使用的资源
+                ResourceManager::EndFrame();
+
                 windowPtr->SwapBuffers();
             }
 
             // 关闭时清理ImGui
             UIManager::Shutdown();
 
+            // 在GL上下文销毁前停止加载线程并释放GPU资源
+            ResourceManager::Shutdown();
+            JobSystem::Shutdown();
+            utils::VirtualFileSystem::UnmountAll();
+
         } catch (const std::exception& e) {
             std::cerr << "[Error] " << e.what() << std::endl;
             return -1;
@@ -71,10 +71,30 @@ void BlinnPhongPipeline::Render(const std::shared_ptr<scene::Scene>& scene,
         }
     }
 
-    for (const auto& entity : scene->GetEntities()) {
-        m_Shader->SetUniform("u_Model", entity->GetModelMatrix());
-        entity->Draw();
-    }
+    // 细节级别在主线程选择，模型矩阵由录制线程只读取得
+    const auto& visible = scene->Cull(*camera);
+    for (const auto& entity : visible) entity->UpdateLod(*camera);
+
+    // 逐簇剔除与命令录制分段交给工作线程，主线程按排序键排序后执行
+    const unsigned int program = m_Shader->GetID();
+    const int modelLocation = m_Shader->GetUniformLocation("u_Model");
+    const graphics::Camera& view = *camera;
+    m_Commands.Record(visible.size(), [&](graphics::CommandBuffer& buffer, size_t begin, size_t end) {
+        buffer.BindPipeline(program, modelLocation);
+        for (size_t i = begin; i < end; ++i) {
+            const glm::mat4 model = visible[i]->GetModelMatrix();
+            const auto cullView = graphics::MeshletCullView::Create(view, model);
+            buffer.SetDrawData(model);
+            visible[i]->Record(buffer, &cullView);
+        }
+    });
+    m_Queue.Clear();
+    m_Queue.Add(m_Commands, graphics::RenderPass::Opaque, camera->GetPosition(), camera->GetFront(), camera->GetNear(),
+                camera->GetFar());
+    m_Queue.Sort();
+    graphics::CommandExecutor executor;
+    m_Queue.Submit(executor);
+    executor.Finish();
 
     m_Shader->Unbind();
 }
@@ -76,11 +76,50 @@ void OutlinePipeline::Render(const std::shared_ptr<scene::Scene>& scene,
         }
     }
 
-    for (const auto& entity : scene->GetEntities()) {
-        m_baseShader->SetUniform("u_Model", entity->GetModelMatrix());
-        entity->Draw();
-    }
+    // 视锥剔除只做一次，两个绘制阶段共用可见列表；
+    // 细节级别在主线程选择，模型矩阵由录制线程只读取得
+    const auto& visible = scene->Cull(*camera);
+    for (const auto& entity : visible) entity->UpdateLod(*camera);
+
+    // 两个阶段的命令都由工作线程分段录制，主线程各自按排序键排序后执行
+    const graphics::Camera& view = *camera;
+    const unsigned int baseProgram = m_baseShader->GetID();
+    const int baseModelLocation = m_baseShader->GetUniformLocation("u_Model");
+    m_baseCommands.Record(visible.size(), [&](graphics::CommandBuffer& buffer, size_t begin, size_t end) {
+        buffer.BindPipeline(baseProgram, baseModelLocation);
+        for (size_t i = begin; i < end; ++i) {
+            const glm::mat4 model = visible[i]->GetModelMatrix();
+            const auto cullView = graphics::MeshletCullView::Create(view, model);
+            buffer.SetDrawData(model);
+            visible[i]->Record(buffer, &cullView);
+        }
+    });
 
+    const float scale = 1.05f; // 放大比例
+    const unsigned int outlineProgram = m_outlineShader->GetID();
+    const int outlineModelLocation = m_outlineShader->GetUniformLocation("u_Model");
+    m_outlineCommands.Record(visible.size(), [&](graphics::CommandBuffer& buffer, size_t begin, size_t end) {
+        buffer.BindPipeline(outlineProgram, outlineModelLocation);
+        for (size_t i = begin; i < end; ++i) {
+            const glm::mat4 scaledModel = glm::scale(visible[i]->GetModelMatrix(), glm::vec3(scale));
+            const auto cullView = graphics::MeshletCullView::Create(view, scaledModel);
+            buffer.SetDrawData(scaledModel);
+            visible[i]->Record(buffer, &cullView);
+        }
+    });
+
+    m_baseQueue.Clear();
+    m_baseQueue.Add(m_baseCommands, graphics::RenderPass::Opaque, camera->GetPosition(), camera->GetFront(),
+                    camera->GetNear(), camera->GetFar());
+    m_baseQueue.Sort();
+    m_outlineQueue.Clear();
+    m_outlineQueue.Add(m_outlineCommands, graphics::RenderPass::Opaque, camera->GetPosition(), camera->GetFront(),
+                       camera->GetNear(), camera->GetFar());
+    m_outlineQueue.Sort();
+
+    graphics::CommandExecutor executor;
+    m_baseQueue.Submit(executor);
+    executor.Finish();
     m_baseShader->Unbind();
 
     // 第二步：绘制放大轮廓，仅模板不为1区域绘制
@@ -93,12 +132,8 @@ void OutlinePipeline::Render(const std::shared_ptr<scene::Scene>& scene,
     m_outlineShader->SetUniform("u_Projection", camera->GetProjectionMatrix());
     m_outlineShader->SetUniform("u_OutlineColor", glm::vec3(0.04f, 0.28f, 0.26f)); // 轮廓颜色，可以改
 
-    const float scale = 1.05f; // 放大比例
-    for (const auto& entity : scene->GetEntities()) {
-        glm::mat4 scaledModel = glm::scale(entity->GetModelMatrix(), glm::vec3(scale));
-        m_outlineShader->SetUniform("u_Model", scaledModel);
-        entity->Draw();
-    }
+    m_outlineQueue.Submit(executor);
+    executor.Finish();
 
     // 恢复状态
     glStencilMask(0xFF);
@@ -0,0 +1,445 @@
+#include "resource/AssetCooker.h"
+#include "core/JobSystem.h"
+#include "graphics/MeshCache.h"
+#include "graphics/MeshOptimizer.h"
+#include "graphics/Meshlet.h"
+#include "graphics/MeshSimplifier.h"
+#include "graphics/ObjParser.h"
+#include "graphics/ShaderSource.h"
+#include "graphics/TextureFile.h"
+#include "utils/Hash.h"
+#include "utils/MappedFile.h"
+#include "utils/VirtualFileSystem.h"
+#include "utils/PathResolver.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace core {
+
+namespace {
+
+constexpr const char* kDatabaseMagic = "RCOOK";
+constexpr int kDatabaseVersion = 1;
+
+struct FileStamp {
+    std::string path;
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+/// 一个资源的烘焙记录，files[0] 为主输入文件
+struct CookRecord {
+    AssetKind kind = AssetKind::Mesh;
+    uint32_t version = 0;   ///< 输出格式版本，格式升级后全部失效
+    uint32_t settings = 0;  ///< 影响输出的选项
+    uint64_t hash = 0;      ///< 全部输入文件的内容哈希
+    std::vector<FileStamp> files;
+};
+
+enum class JobResult {
+    UpToDate,
+    Rehashed,
+    Cooked,
+    Failed
+};
+
+struct CookJob {
+    std::string path;
+    AssetKind kind = AssetKind::Mesh;
+    uint64_t size = 0;
+    const CookRecord* previous = nullptr;
+    CookRecord record;
+    JobResult result = JobResult::Failed;
+};
+
+uint32_t GetKindVersion(AssetKind kind) {
+    switch (kind) {
+        case AssetKind::Mesh: return graphics::MeshCache::kVersion;
+        case AssetKind::Texture: return graphics::TextureFile::kVersion;
+        case AssetKind::Shader: return graphics::ShaderSource::kVersion;
+    }
+    return 0;
+}
+
+bool StampFile(const std::string& path, FileStamp& stamp) {
+    std::error_code ec;
+    stamp.path = path;
+    stamp.size = fs::file_size(path, ec);
+    if (ec) return false;
+    auto time = fs::last_write_time(path, ec);
+    if (ec) return false;
+    stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+uint64_t HashFiles(const std::vector<FileStamp>& files) {
+    uint64_t hash = 0;
+    for (const auto& file : files) {
+        utils::MappedFile mapped(file.path);
+        hash = utils::HashCombine(hash, mapped.Size() > 0 ? utils::HashBytes(mapped.Data(), mapped.Size()) : 0);
+    }
+    return hash;
+}
+
+/// 整个字段都是十进制整数时写入 value，截断或手工改坏的字段返回 false
+template <typename T>
+bool ParseInteger(const std::string& field, T& value) {
+    const char* end = field.data() + field.size();
+    const auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+// 数据库为文本格式，每行一个资源：kind version settings hash fileCount {path size mtime}...
+// 路径相对数据库所在目录存放
+std::unordered_map<std::string, CookRecord> LoadDatabase(const std::string& databasePath) {
+    std::unordered_map<std::string, CookRecord> records;
+    std::ifstream file(databasePath);
+    if (!file.is_open()) return records;
+
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != kDatabaseMagic || version != kDatabaseVersion) {
+        std::cout << "[Cook] Ignoring outdated database: " << databasePath << std::endl;
+        return records;
+    }
+
+    const fs::path baseDir = fs::absolute(databasePath).parent_path();
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        CookRecord record;
+        int kind = 0;
+        size_t fileCount = 0;
+        in >> kind >> record.version >> record.settings >> std::hex >> record.hash >> std::dec >> fileCount;
+        if (!in || fileCount == 0 || kind < 0 || kind > static_cast<int>(AssetKind::Shader)) continue;
+        record.kind = static_cast<AssetKind>(kind);
+
+        std::string field;
+        std::getline(in, field, '\t');
+        for (size_t i = 0; i < fileCount; ++i) {
+            FileStamp stamp;
+            std::string size, mtime;
+            if (!std::getline(in, field, '\t') || !std::getline(in, size, '\t') || !std::getline(in, mtime, '\t') ||
+                !ParseInteger(size, stamp.size) || !ParseInteger(mtime, stamp.mtime))
+                break;
+            stamp.path = (baseDir / fs::u8path(field)).lexically_normal().string();
+            record.files.push_back(std::move(stamp));
+        }
+        if (record.files.size() != fileCount) continue;
+        const std::string key = record.files.front().path;
+        records[key] = std::move(record);
+    }
+    return records;
+}
+
+void SaveDatabase(const std::string& databasePath, const std::unordered_map<std::string, CookRecord>& records) {
+    const fs::path baseDir = fs::absolute(databasePath).parent_path();
+    std::vector<const CookRecord*> sorted;
+    for (const auto& [path, record] : records) sorted.push_back(&record);
+    std::sort(sorted.begin(), sorted.end(), [](const CookRecord* a, const CookRecord* b) {
+        return a->files.front().path < b->files.front().path;
+    });
+
+    const std::string tempPath = databasePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error("Failed to create cook database: " + tempPath);
+        file << kDatabaseMagic << " " << kDatabaseVersion << "\n";
+        for (const CookRecord* record : sorted) {
+            file << static_cast<int>(record->kind) << " " << record->version << " " << record->settings << " "
+                 << std::hex << record->hash << std::dec << " " << record->files.size() << "\t";
+            for (const auto& stamp : record->files) {
+                file << fs::path(stamp.path).lexically_relative(baseDir).generic_u8string() << "\t"
+                     << stamp.size << "\t" << stamp.mtime << "\t";
+            }
+            file << "\n";
+        }
+        if (!file)
+            throw std::runtime_error("Failed to write cook database: " + tempPath);
+    }
+    std::error_code ec;
+    fs::rename(tempPath, databasePath, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        throw std::runtime_error("Failed to replace cook database: " + databasePath);
+    }
+}
+
+// 烘焙单个资源，返回主文件以外的输入文件
+std::vector<std::string> CookAsset(const std::string& path, AssetKind kind, const std::string& outputPath,
+                                   const AssetCooker::Options& options, unsigned int threadCount) {
+    std::vector<std::string> dependencies;
+    switch (kind) {
+        case AssetKind::Mesh: {
+            graphics::ObjData obj = graphics::ObjParser::Parse(path, threadCount);
+            std::vector<graphics::MeshData> meshes = graphics::ObjParser::BuildMeshes(obj, threadCount);
+            graphics::MeshOptimizer::OptimizeMeshes(meshes, threadCount);
+            graphics::MeshletBuilder::BuildMeshes(meshes, threadCount);
+            graphics::MeshSimplifier::GenerateLods(meshes, threadCount, {});
+            graphics::MeshCache::Write(outputPath, path, meshes, obj.materials, obj.materialLibraries);
+            const fs::path directory = fs::path(path).parent_path();
+            for (const auto& library : obj.materialLibraries) {
+                const std::string libraryPath = (directory / library).lexically_normal().string();
+                if (fs::exists(libraryPath)) dependencies.push_back(libraryPath);
+            }
+            break;
+        }
+        case AssetKind::Texture: {
+            graphics::TextureFile::CookOptions cookOptions = graphics::TextureFile::GetDefaultCookOptions(path);
+            cookOptions.highQuality = options.highQuality;
+            cookOptions.threadCount = threadCount;
+            graphics::TextureFile::Cook(path, outputPath, cookOptions);
+            break;
+        }
+        case AssetKind::Shader:
+            // 被 #include 的文件作为依赖记录，修改后重新烘焙
+            dependencies = graphics::ShaderSource::Cook(path, outputPath);
+            break;
+    }
+    return dependencies;
+}
+
+void ProcessJob(CookJob& job, const AssetCooker::Options& options, unsigned int innerThreads) {
+    const std::string outputPath = AssetCooker::GetOutputPath(job.path, job.kind);
+    CookRecord& record = job.record;
+    record.kind = job.kind;
+    record.version = GetKindVersion(job.kind);
+    record.settings = (job.kind == AssetKind::Texture && options.highQuality) ? 1u : 0u;
+
+    const CookRecord* previous = job.previous;
+    if (!options.force && previous && previous->kind == record.kind && previous->version == record.version &&
+        previous->settings == record.settings && fs::exists(outputPath)) {
+        std::vector<FileStamp> stamps;
+        bool unchanged = true;
+        for (const auto& old : previous->files) {
+            FileStamp stamp;
+            if (!StampFile(old.path, stamp)) {
+                stamps.clear();
+                break;
+            }
+            unchanged = unchanged && stamp.size == old.size && stamp.mtime == old.mtime;
+            stamps.push_back(std::move(stamp));
+        }
+        if (stamps.size() == previous->files.size()) {
+            if (unchanged) {
+                record = *previous;
+                job.result = JobResult::UpToDate;
+                return;
+            }
+            // 时间戳变化（如重新检出），内容相同则只刷新记录
+            if (HashFiles(stamps) == previous->hash) {
+                record.hash = previous->hash;
+                record.files = std::move(stamps);
+                job.result = JobResult::Rehashed;
+                return;
+            }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> inputs = CookAsset(job.path, job.kind, outputPath, options, innerThreads);
+    inputs.insert(inputs.begin(), job.path);
+    record.files.clear();
+    for (const auto& input : inputs) {
+        FileStamp stamp;
+        if (!StampFile(input, stamp))
+            throw std::runtime_error("Input disappeared while cooking: " + input);
+        record.files.push_back(std::move(stamp));
+    }
+    record.hash = HashFiles(record.files);
+    job.result = JobResult::Cooked;
+
+    if (options.verbose) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "[Cook] " << job.path << " -> " << fs::path(outputPath).filename().string() << ", "
+                  << elapsed.count() << " ms" << std::endl;
+    }
+}
+
+} // namespace
+
+std::string AssetCooker::GetDefaultDatabasePath() {
+    return PathResolver::Resolve("rrender_cook.db");
+}
+
+std::string AssetCooker::GetDefaultPackPath() {
+    return PathResolver::Resolve("rrender.rpak");
+}
+
+utils::PackFile::WriteStats AssetCooker::BuildPack(const std::vector<std::string>& roots, const std::string& packPath) {
+    struct PackItem {
+        std::string directory;
+        int rank = 0; ///< 同目录内：0 网格/材质/着色器，1 纹理
+        utils::PackFile::Input input;
+    };
+
+    std::vector<PackItem> items;
+    // 已烘焙网格的 MTL 与其 OBJ 一同保持松散：缓存记录的是松散文件的大小与时间，
+    // 放入包内后 MeshCache::Open 取到的是包文件时间，每次打开都会退回内容哈希
+    std::unordered_set<std::string> looseLibraries;
+    for (const auto& root : roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file()) continue;
+            const fs::path path = fs::absolute(it->path()).lexically_normal();
+            std::string ext = path.extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            PackItem item;
+            AssetKind kind;
+            if (ext == ".rmesh" || ext == ".rglsl" || ext == ".mtl") {
+                // 文本与网格压缩存放；.rmesh 保持零拷贝
+                item.input.compress = ext != ".rmesh";
+            } else if (ext == ".rtex") {
+                item.rank = 1;
+            } else if (Classify(path.string(), kind)) {
+                // 已有烘焙结果的源文件不放入包内
+                const std::string outputPath = GetOutputPath(path.string(), kind);
+                if (fs::exists(outputPath)) {
+                    std::vector<std::string> libraries;
+                    if (kind == AssetKind::Mesh && graphics::MeshCache::ReadDependencies(outputPath, libraries)) {
+                        for (const auto& library : libraries)
+                            looseLibraries.insert(utils::VirtualFileSystem::GetKey((path.parent_path() / library).string()));
+                    }
+                    continue;
+                }
+                item.rank = kind == AssetKind::Texture ? 1 : 0;
+                item.input.compress = kind != AssetKind::Texture;
+            } else {
+                continue;
+            }
+            item.directory = path.parent_path().generic_string();
+            item.input.path = path.string();
+            item.input.key = utils::VirtualFileSystem::GetKey(item.input.path);
+            items.push_back(std::move(item));
+        }
+    }
+
+    items.erase(std::remove_if(items.begin(), items.end(), [&looseLibraries](const PackItem& item) {
+        return looseLibraries.count(item.input.key) > 0;
+    }), items.end());
+
+    std::stable_sort(items.begin(), items.end(), [](const PackItem& a, const PackItem& b) {
+        if (a.directory != b.directory) return a.directory < b.directory;
+        if (a.rank != b.rank) return a.rank < b.rank;
+        return a.input.key < b.input.key;
+    });
+
+    std::vector<utils::PackFile::Input> inputs;
+    inputs.reserve(items.size());
+    for (auto& item : items) inputs.push_back(std::move(item.input));
+    return utils::PackFile::Write(packPath, inputs);
+}
+
+bool AssetCooker::Classify(const std::string& path, AssetKind& kind) {
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (ext == ".obj") {
+        kind = AssetKind::Mesh;
+    } else if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp") {
+        kind = AssetKind::Texture;
+    } else if (ext == ".vert" || ext == ".frag" || ext == ".geom" || ext == ".glsl") {
+        kind = AssetKind::Shader;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string AssetCooker::GetOutputPath(const std::string& path, AssetKind kind) {
+    switch (kind) {
+        case AssetKind::Mesh: return graphics::MeshCache::GetCachePath(path);
+        case AssetKind::Texture: return graphics::TextureFile::GetCookedPath(path);
+        case AssetKind::Shader: return graphics::ShaderSource::GetCookedPath(path);
+    }
+    return path;
+}
+
+AssetCooker::Stats AssetCooker::Run(const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+    const std::string databasePath = options.databasePath.empty() ? GetDefaultDatabasePath() : options.databasePath;
+    std::unordered_map<std::string, CookRecord> database = LoadDatabase(databasePath);
+
+    // 收集资源
+    std::vector<CookJob> jobs;
+    for (const auto& root : options.roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file()) continue;
+            CookJob job;
+            if (!Classify(it->path().string(), job.kind)) continue;
+            job.path = fs::absolute(it->path()).lexically_normal().string();
+            job.size = it->file_size();
+            auto found = database.find(job.path);
+            job.previous = found != database.end() ? &found->second : nullptr;
+            jobs.push_back(std::move(job));
+        }
+        if (ec)
+            std::cerr << "[Cook Error] Failed to scan " << root << ": " << ec.message() << std::endl;
+    }
+
+    // 大文件优先，避免最后只剩一个大纹理在单线程上烘焙
+    std::sort(jobs.begin(), jobs.end(), [](const CookJob& a, const CookJob& b) { return a.size > b.size; });
+
+    // 每个资源一个任务；资源内部的解析、编码等循环在任务中嵌套并行，空闲线程窃取其分段，
+    // 资源数少于线程数时不必再单独决定内层线程数
+    if (options.threadCount > 1) JobSystem::Initialize(options.threadCount - 1);
+    const unsigned int innerThreads = options.threadCount == 1 ? 1 : 0;
+    JobSystem::ParallelFor(jobs.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                ProcessJob(jobs[i], options, innerThreads);
+            } catch (const std::exception& e) {
+                std::cerr << "[Cook Error] " << jobs[i].path << ": " << e.what() << std::endl;
+                jobs[i].result = JobResult::Failed;
+            }
+        }
+    }, options.threadCount == 1 ? jobs.size() : 1);
+
+    // 合并结果：本次未扫描到但源文件仍在的记录保留（只烘焙了部分目录时）
+    std::unordered_map<std::string, CookRecord> updated;
+    for (auto& [path, record] : database) {
+        if (fs::exists(path)) updated.emplace(path, std::move(record));
+    }
+
+    Stats stats;
+    stats.scanned = jobs.size();
+    for (auto& job : jobs) {
+        switch (job.result) {
+            case JobResult::UpToDate: ++stats.upToDate; break;
+            case JobResult::Rehashed: ++stats.rehashed; break;
+            case JobResult::Cooked: {
+                ++stats.cooked;
+                for (const auto& input : job.record.files) stats.inputBytes += input.size;
+                std::error_code ec;
+                const auto outputSize = fs::file_size(GetOutputPath(job.path, job.kind), ec);
+                if (!ec) stats.outputBytes += outputSize;
+                break;
+            }
+            case JobResult::Failed:
+                ++stats.failed;
+                updated.erase(job.path);
+                continue;
+        }
+        updated[job.path] = std::move(job.record);
+    }
+    SaveDatabase(databasePath, updated);
+
+    stats.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace core
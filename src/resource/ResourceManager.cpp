@@ -1,6 +1,12 @@
 #include "resource/ResourceManager.h"
+#include "graphics/TextureCache.h"
+#include "graphics/TextureUploader.h"
 #include <filesystem>
 #include <iostream>
+#include <chrono>
+#include <thread>
+#include <limits>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
@@ -10,21 +16,45 @@ namespace core {
 std::unordered_map<std::string, std::shared_ptr<graphics::Shader>> ResourceManager::m_Shaders;
 std::unordered_map<std::string, std::shared_ptr<graphics::Texture>> ResourceManager::m_Textures;
 std::unordered_map<std::string, std::shared_ptr<graphics::Model>> ResourceManager::m_Models;
+std::unordered_map<std::string, std::shared_ptr<std::atomic<LoadState>>> ResourceManager::m_LoadStates;
 
-std::string ResourceManager::ExtractName(const std::string& path) {
-    fs::path p(path);
-    return p.stem().string();
+JobCounter ResourceManager::s_LoadJobs;
+std::atomic<size_t> ResourceManager::s_Pending{0};
+size_t ResourceManager::s_GpuBudget = 0;
+ResourceManager::GpuMemoryStats ResourceManager::s_GpuStats;
+std::unordered_set<const graphics::GpuResource*> ResourceManager::s_Reloading;
+
+std::string ResourceManager::MakeKey(const std::string& path) {
+    return graphics::TextureCache::GetCanonicalPath(path);
+}
+
+template <typename T>
+std::shared_ptr<T> ResourceManager::FindByName(const std::unordered_map<std::string, std::shared_ptr<T>>& resources,
+                                               const std::string& name) {
+    auto it = resources.find(name);
+    if (it != resources.end())
+        return it->second;
+    it = resources.find(MakeKey(name));
+    if (it != resources.end())
+        return it->second;
+
+    // 兼容按文件名查找；着色器键为 "顶点|片段"，取顶点着色器的文件名
+    for (const auto& entry : resources) {
+        if (fs::path(entry.first.substr(0, entry.first.find('|'))).stem().string() == name)
+            return entry.second;
+    }
+    return nullptr;
 }
 
 std::shared_ptr<graphics::Shader> ResourceManager::LoadShader(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string name = ExtractName(vertexPath);
-    auto it = m_Shaders.find(name);
+    std::string key = MakeKey(vertexPath) + "|" + MakeKey(fragmentPath);
+    auto it = m_Shaders.find(key);
     if (it != m_Shaders.end())
         return it->second;
 
     try {
         auto shader = std::make_shared<graphics::Shader>(vertexPath, fragmentPath);
-        m_Shaders[name] = shader;
+        m_Shaders[key] = shader;
         return shader;
     } catch (const std::exception& e) {
         std::cerr << "Failed to load shader: " << e.what() << std::endl;
@@ -33,44 +63,79 @@ std::shared_ptr<graphics::Shader> ResourceManager::LoadShader(const std::string&
 }
 
 std::shared_ptr<graphics::Shader> ResourceManager::GetShader(const std::string& name) {
-    auto it = m_Shaders.find(name);
-    if (it != m_Shaders.end())
-        return it->second;
-    return nullptr;
+    return FindByName(m_Shaders, name);
+}
+
+std::vector<std::shared_ptr<graphics::Shader>> ResourceManager::LoadShaders(
+    const std::vector<std::pair<std::string, std::string>>& programs) {
+    std::vector<std::shared_ptr<graphics::Shader>> shaders(programs.size());
+    std::vector<std::string> keys(programs.size());
+
+    // 第一遍只提交编译与链接（或加载程序二进制）
+    for (size_t i = 0; i < programs.size(); ++i) {
+        keys[i] = MakeKey(programs[i].first) + "|" + MakeKey(programs[i].second);
+        auto it = m_Shaders.find(keys[i]);
+        if (it != m_Shaders.end()) {
+            shaders[i] = it->second;
+            keys[i].clear();
+            continue;
+        }
+        try {
+            shaders[i] = std::make_shared<graphics::Shader>(programs[i].first, programs[i].second, true);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load shader: " << e.what() << std::endl;
+        }
+    }
+
+    // 第二遍等待结果并登记
+    for (size_t i = 0; i < programs.size(); ++i) {
+        if (!shaders[i] || keys[i].empty()) continue;
+        try {
+            shaders[i]->Finish();
+            m_Shaders[keys[i]] = shaders[i];
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load shader: " << e.what() << std::endl;
+            shaders[i] = nullptr;
+        }
+    }
+    return shaders;
 }
 
 std::shared_ptr<graphics::Texture> ResourceManager::LoadTexture(const std::string& texturePath) {
-    std::string name = ExtractName(texturePath);
-    auto it = m_Textures.find(name);
+    std::string key = MakeKey(texturePath);
+    auto it = m_Textures.find(key);
     if (it != m_Textures.end())
         return it->second;
 
-    try {
-        auto texture = std::make_shared<graphics::Texture>(texturePath);
-        m_Textures[name] = texture;
-        return texture;
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to load texture: " << e.what() << std::endl;
-        return nullptr;
+    // 已被模型材质或其他路径（内容相同）加载时直接共用
+    bool created = false;
+    auto texture = graphics::TextureCache::Acquire(texturePath, false, created);
+    if (created) {
+        try {
+            texture->Upload(graphics::TextureSource::Load(texturePath, false), false);
+        } catch (const std::exception& e) {
+            graphics::TextureCache::Remove(texturePath, false);
+            std::cerr << "Failed to load texture: " << e.what() << std::endl;
+            return nullptr;
+        }
     }
+    m_Textures[key] = texture;
+    return texture;
 }
 
 std::shared_ptr<graphics::Texture> ResourceManager::GetTexture(const std::string& name) {
-    auto it = m_Textures.find(name);
-    if (it != m_Textures.end())
-        return it->second;
-    return nullptr;
+    return FindByName(m_Textures, name);
 }
 
 std::shared_ptr<graphics::Model> ResourceManager::LoadModel(const std::string& modelPath) {
-    std::string name = ExtractName(modelPath);
-    auto it = m_Models.find(name);
+    std::string key = MakeKey(modelPath);
+    auto it = m_Models.find(key);
     if (it != m_Models.end())
         return it->second;
 
     try {
         auto model = std::make_shared<graphics::Model>(modelPath,false);
-        m_Models[name] = model;
+        m_Models[key] = model;
         return model;
     } catch (const std::exception& e) {
         std::cerr << "Failed to load model: " << e.what() << std::endl;
@@ -79,10 +144,305 @@ std::shared_ptr<graphics::Model> ResourceManager::LoadModel(const std::string& m
 }
 
 std::shared_ptr<graphics::Model> ResourceManager::GetModel(const std::string& name) {
-    auto it = m_Models.find(name);
-    if (it != m_Models.end())
-        return it->second;
-    return nullptr;
+    return FindByName(m_Models, name);
+}
+
+std::vector<std::shared_ptr<graphics::Model>> ResourceManager::LoadModelsAsync(const std::vector<std::string>& modelPaths) {
+    std::vector<std::shared_ptr<graphics::Model>> models;
+    models.reserve(modelPaths.size());
+    for (const auto& path : modelPaths) models.push_back(LoadModelAsync(path).Get());
+    return models;
+}
+
+std::string ResourceManager::GetModelPath(const std::shared_ptr<graphics::Model>& model) {
+    for (const auto& entry : m_Models) {
+        if (entry.second == model) return entry.first;
+    }
+    return {};
+}
+
+LoadHandle<graphics::Model> ResourceManager::LoadModelAsync(const std::string& modelPath) {
+    std::string key = MakeKey(modelPath);
+    auto it = m_Models.find(key);
+    if (it != m_Models.end()) {
+        auto& state = m_LoadStates[key];
+        if (!state) state = std::make_shared<std::atomic<LoadState>>(LoadState::Ready);
+        return {it->second, state};
+    }
+
+    // 先登记占位模型，上传完成前以占位网格绘制
+    auto model = std::make_shared<graphics::Model>();
+    auto state = std::make_shared<std::atomic<LoadState>>(LoadState::Loading);
+    m_Models[key] = model;
+    m_LoadStates[key] = state;
+    ++s_Pending;
+
+    auto fail = [state, modelPath](const std::string& reason) {
+        std::cerr << "Failed to load model: " << modelPath << "\nReason: " << reason << std::endl;
+        state->store(LoadState::Failed);
+        --s_Pending;
+    };
+
+    JobSystem::RunBackground([model, state, modelPath, fail]() {
+        std::shared_ptr<graphics::ModelData> data;
+        try {
+            data = std::make_shared<graphics::ModelData>(graphics::Model::LoadData(modelPath));
+        } catch (const std::exception& e) {
+            fail(e.what());
+            return;
+        }
+
+        auto upload = [model, state, data, fail]() {
+            try {
+                model->Upload(*data, false);
+                state->store(LoadState::Ready);
+                --s_Pending;
+            } catch (const std::exception& e) {
+                fail(e.what());
+            }
+        };
+
+        // 只预读取在全局缓存中新登记的纹理，已被其他模型加载的直接共用
+        std::vector<std::string> texturePaths;
+        for (const auto& path : data->GetTexturePaths()) {
+            bool created = false;
+            graphics::TextureCache::Acquire(path, false, created);
+            if (created) texturePaths.push_back(path);
+        }
+        if (texturePaths.empty()) {
+            JobSystem::PostToMainThread(upload);
+            return;
+        }
+
+        // 预先插入全部键，解码任务只写各自的值，避免并发修改容器结构
+        for (const auto& path : texturePaths) data->textures[path];
+        auto remaining = std::make_shared<std::atomic<size_t>>(texturePaths.size());
+        for (const auto& path : texturePaths) {
+            graphics::TextureSource* slot = &data->textures[path];
+            JobSystem::RunBackground([slot, path, remaining, upload]() {
+                try {
+                    *slot = graphics::TextureSource::Load(path, false);
+                } catch (const std::exception&) {
+                    // 留空，Upload 时回退为同步加载并输出错误
+                }
+                // 最后一张纹理解码完成后投递上传任务
+                if (--*remaining == 0)
+                    JobSystem::PostToMainThread(upload);
+            }, &s_LoadJobs);
+        }
+    }, &s_LoadJobs);
+
+    return {model, state};
+}
+
+LoadHandle<graphics::Texture> ResourceManager::LoadTextureAsync(const std::string& texturePath) {
+    std::string key = MakeKey(texturePath);
+    auto it = m_Textures.find(key);
+    if (it != m_Textures.end()) {
+        auto& state = m_LoadStates[key];
+        if (!state) state = std::make_shared<std::atomic<LoadState>>(LoadState::Ready);
+        return {it->second, state};
+    }
+
+    // 已被模型材质或同一文件的其他写法登记时直接共用；
+    // 此处只按路径查找，读取文件计算内容哈希留给后台任务，避免大纹理在主线程卡顿
+    bool created = false;
+    auto texture = graphics::TextureCache::AcquirePath(texturePath, false, created);
+    m_Textures[key] = texture;
+    if (!created) {
+        auto state = std::make_shared<std::atomic<LoadState>>(LoadState::Ready);
+        m_LoadStates[key] = state;
+        return {texture, state};
+    }
+
+    // 上传完成前绑定为占位纹理
+    auto state = std::make_shared<std::atomic<LoadState>>(LoadState::Loading);
+    m_LoadStates[key] = state;
+    ++s_Pending;
+
+    // 工作线程按内容登记，再读取烘焙文件或解码图片
+    JobSystem::RunBackground([texture, state, texturePath]() {
+        graphics::TextureSource source;
+        try {
+            graphics::TextureCache::RegisterContent(texture);
+            source = graphics::TextureSource::Load(texturePath, false);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load texture: " << e.what() << std::endl;
+            state->store(LoadState::Failed);
+            --s_Pending;
+            return;
+        }
+        JobSystem::PostToMainThread([texture, state, source]() {
+            graphics::TextureUploader::Enqueue(texture, source, false, [state]() {
+                state->store(LoadState::Ready);
+                --s_Pending;
+            });
+        });
+    }, &s_LoadJobs);
+
+    return {texture, state};
+}
+
+void ResourceManager::Update(double budgetMs) {
+    JobSystem::RunMainThreadJobs(budgetMs);
+
+    // 纹理像素按字节预算分帧上传
+    graphics::TextureUploader::Update();
+
+    // 发布本帧新登记的纹理，之后的查找无锁命中
+    graphics::TextureCache::EndFrame();
+}
+
+void ResourceManager::ReloadModel(const std::shared_ptr<graphics::Model>& model) {
+    if (!s_Reloading.insert(model.get()).second) return;
+    ++s_Pending;
+    ++s_GpuStats.reloads;
+
+    // 不预读取纹理：Upload 经全局 TextureCache 按路径查找，仍在缓存中的直接复用，
+    // 已被 LRU 淘汰的重新登记并同步加载
+    const std::string path = model->GetPath();
+    JobSystem::RunBackground([model, path]() {
+        std::shared_ptr<graphics::ModelData> data;
+        try {
+            data = std::make_shared<graphics::ModelData>(graphics::Model::LoadData(path));
+        } catch (const std::exception& e) {
+            // 保留在 s_Reloading 中，不再重试
+            std::cerr << "Failed to reload model: " << path << "\nReason: " << e.what() << std::endl;
+            --s_Pending;
+            return;
+        }
+        JobSystem::PostToMainThread([model, data]() {
+            try {
+                model->Upload(*data, false);
+                s_Reloading.erase(model.get());
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to reload model: " << data->path << "\nReason: " << e.what() << std::endl;
+            }
+            --s_Pending;
+        });
+    }, &s_LoadJobs);
+}
+
+void ResourceManager::ReloadTexture(const std::shared_ptr<graphics::Texture>& texture) {
+    if (!s_Reloading.insert(texture.get()).second) return;
+    ++s_Pending;
+    ++s_GpuStats.reloads;
+
+    const std::string path = texture->GetSourcePath();
+    const bool useSRGB = texture->IsSRGB();
+    JobSystem::RunBackground([texture, path, useSRGB]() {
+        graphics::TextureSource source;
+        try {
+            source = graphics::TextureSource::Load(path, useSRGB);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to reload texture: " << e.what() << std::endl;
+            --s_Pending;
+            return;
+        }
+        JobSystem::PostToMainThread([texture, source, useSRGB]() {
+            graphics::TextureUploader::Enqueue(texture, source, useSRGB, [texture]() {
+                s_Reloading.erase(texture.get());
+                --s_Pending;
+            });
+        });
+    }, &s_LoadJobs);
+}
+
+void ResourceManager::EndFrame() {
+    const uint64_t frame = graphics::GpuResource::GetCurrentFrame();
+
+    // 登记的纹理与模型材质纹理都在全局纹理缓存中
+    const std::vector<std::shared_ptr<graphics::Texture>> textures = graphics::TextureCache::GetTextures();
+
+    // 本帧绘制或绑定过的已驱逐资源重新加载，完成前以占位数据绘制
+    for (const auto& entry : m_Models) {
+        if (entry.second->IsEvicted() && entry.second->GetLastUsedFrame() == frame) ReloadModel(entry.second);
+    }
+    for (const auto& texture : textures) {
+        if (texture->IsEvicted() && texture->GetLastUsedFrame() == frame) ReloadTexture(texture);
+    }
+
+    GpuMemoryStats& stats = s_GpuStats;
+    stats.budgetBytes = s_GpuBudget;
+    stats.textureBytes = stats.meshBytes = 0;
+    stats.residentTextures = stats.residentModels = 0;
+    stats.evictedTextures = stats.evictedModels = 0;
+
+    // 驱逐候选：已就绪、本帧未使用；最久未使用的优先，同一帧内先驱逐占用大的
+    struct Candidate {
+        uint64_t lastUsed;
+        size_t bytes;
+        graphics::Texture* texture;
+        graphics::Model* model;
+    };
+    std::vector<Candidate> candidates;
+
+    for (const auto& texture : textures) {
+        const size_t bytes = texture->GetGpuByteSize();
+        stats.textureBytes += bytes;
+        if (texture->IsEvicted()) ++stats.evictedTextures;
+        else if (bytes > 0) ++stats.residentTextures;
+        if (texture->IsReady() && texture->GetLastUsedFrame() < frame && !texture->GetSourcePath().empty())
+            candidates.push_back({texture->GetLastUsedFrame(), bytes, texture.get(), nullptr});
+    }
+    for (const auto& entry : m_Models) {
+        const auto& model = entry.second;
+        const size_t bytes = model->GetGpuByteSize();
+        stats.meshBytes += bytes;
+        if (model->IsEvicted()) ++stats.evictedModels;
+        else if (model->IsReady()) ++stats.residentModels;
+        if (model->IsReady() && model->GetLastUsedFrame() < frame && !model->GetPath().empty())
+            candidates.push_back({model->GetLastUsedFrame(), bytes, nullptr, model.get()});
+    }
+    stats.currentBytes = stats.textureBytes + stats.meshBytes;
+    stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+
+    if (s_GpuBudget > 0 && stats.currentBytes > s_GpuBudget) {
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.lastUsed != b.lastUsed ? a.lastUsed < b.lastUsed : a.bytes > b.bytes;
+        });
+        for (const Candidate& candidate : candidates) {
+            if (stats.currentBytes <= s_GpuBudget) break;
+            if (candidate.texture && candidate.texture->Evict()) {
+                stats.textureBytes -= candidate.bytes;
+                --stats.residentTextures;
+                ++stats.evictedTextures;
+            } else if (candidate.model && candidate.model->Evict()) {
+                stats.meshBytes -= candidate.bytes;
+                --stats.residentModels;
+                ++stats.evictedModels;
+            } else {
+                continue;
+            }
+            stats.currentBytes -= candidate.bytes;
+            stats.evictedBytes += candidate.bytes;
+            ++stats.evictions;
+        }
+    }
+
+    graphics::GpuResource::AdvanceFrame();
+}
+
+void ResourceManager::WaitAll() {
+    while (s_Pending.load() > 0 || graphics::TextureUploader::GetStats().pendingBytes > 0) {
+        Update(std::numeric_limits<double>::max());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void ResourceManager::Shutdown() {
+    // 先等待后台加载任务结束，再丢弃未执行的上传任务
+    JobSystem::Wait(s_LoadJobs);
+    JobSystem::ClearMainThreadJobs();
+    s_Pending = 0;
+    graphics::TextureUploader::Shutdown();
+    s_Reloading.clear();
+
+    m_Models.clear();
+    m_Textures.clear();
+    graphics::TextureCache::Clear();
+    m_Shaders.clear();
+    m_LoadStates.clear();
 }
 
 } // namespace core
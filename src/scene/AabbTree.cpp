@@ -0,0 +1,373 @@
+#include "scene/AabbTree.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace scene {
+
+namespace {
+
+    /// 沿移动方向额外延伸的倍数（按两次更新间的位移）
+    constexpr float kDisplacementMultiplier = 2.0f;
+    /// 放大范围超过 margin 的这个倍数时收缩重插，避免停止移动后包围盒一直偏大
+    constexpr float kShrinkFactor = 4.0f;
+
+    graphics::BoundingBox Union(const graphics::BoundingBox& a, const graphics::BoundingBox& b) {
+        return graphics::BoundingBox{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+    }
+
+    bool Contains(const graphics::BoundingBox& outer, const graphics::BoundingBox& inner) {
+        return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::lessThanEqual(inner.max, outer.max));
+    }
+
+    /// 表面积的一半（只用于比较）
+    float Area(const graphics::BoundingBox& box) {
+        const glm::vec3 d = box.max - box.min;
+        return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+} // namespace
+
+    int32_t AabbTree::AllocateNode() {
+        int32_t node;
+        if (m_FreeList == kNullNode) {
+            node = static_cast<int32_t>(m_Nodes.size());
+            m_Nodes.emplace_back();
+        } else {
+            node = m_FreeList;
+            m_FreeList = m_Nodes[node].parent;
+            --m_FreeCount;
+            m_Nodes[node] = Node{};
+        }
+        return node;
+    }
+
+    void AabbTree::FreeNode(int32_t node) {
+        m_Nodes[node].parent = m_FreeList;
+        m_Nodes[node].child1 = m_Nodes[node].child2 = kNullNode;
+        m_Nodes[node].height = -1;
+        m_FreeList = node;
+        ++m_FreeCount;
+    }
+
+    int32_t AabbTree::CreateProxy(const graphics::BoundingBox& box, uint32_t userData) {
+        const int32_t proxy = AllocateNode();
+        Node& node = m_Nodes[proxy];
+        node.box = graphics::BoundingBox{box.min - glm::vec3(m_Margin), box.max + glm::vec3(m_Margin)};
+        node.userData = userData;
+        node.height = 0;
+        InsertLeaf(proxy);
+        ++m_ProxyCount;
+        return proxy;
+    }
+
+    void AabbTree::DestroyProxy(int32_t proxy) {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(m_Nodes.size()) || !m_Nodes[proxy].IsLeaf() ||
+            m_Nodes[proxy].height != 0) {
+            throw std::runtime_error("[AabbTree] Invalid proxy " + std::to_string(proxy));
+        }
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_ProxyCount;
+    }
+
+    bool AabbTree::MoveProxy(int32_t proxy, const graphics::BoundingBox& box) {
+        Node& node = m_Nodes[proxy];
+        const graphics::BoundingBox& fat = node.box;
+        if (Contains(fat, box)) {
+            // 仍在放大范围内；范围远大于所需时（例如快速移动后停下）收缩
+            const glm::vec3 limit(kShrinkFactor * m_Margin);
+            const graphics::BoundingBox huge{box.min - limit, box.max + limit};
+            if (Contains(huge, fat)) return false;
+        }
+
+        // 按新旧中心的位移沿移动方向延伸，匀速移动时大多数帧不需要重插
+        const glm::vec3 displacement = kDisplacementMultiplier * (box.GetCenter() - fat.GetCenter());
+        graphics::BoundingBox moved{box.min - glm::vec3(m_Margin), box.max + glm::vec3(m_Margin)};
+        moved.min += glm::min(displacement, glm::vec3(0.0f));
+        moved.max += glm::max(displacement, glm::vec3(0.0f));
+
+        RemoveLeaf(proxy);
+        node.box = moved;
+        InsertLeaf(proxy);
+        ++m_Reinserts;
+        return true;
+    }
+
+    void AabbTree::CreateProxies(const graphics::BoundingBox* boxes, const uint32_t* userData, size_t count,
+                                 int32_t* proxies) {
+        if (count == 0) return;
+        m_Nodes.reserve(m_Nodes.size() + 2 * count);
+        std::vector<int32_t> leaves(count);
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t proxy = AllocateNode();
+            Node& node = m_Nodes[proxy];
+            node.box = graphics::BoundingBox{boxes[i].min - glm::vec3(m_Margin), boxes[i].max + glm::vec3(m_Margin)};
+            node.userData = userData[i];
+            node.height = 0;
+            proxies[i] = leaves[i] = proxy;
+        }
+        InsertLeaf(BuildSubtree(leaves.data(), count));
+        m_ProxyCount += count;
+    }
+
+    int32_t AabbTree::BuildSubtree(int32_t* leaves, size_t count) {
+        if (count == 1) return leaves[0];
+        glm::vec3 centerMin(std::numeric_limits<float>::max()), centerMax(std::numeric_limits<float>::lowest());
+        for (size_t i = 0; i < count; ++i) {
+            const graphics::BoundingBox& box = m_Nodes[leaves[i]].box;
+            centerMin = glm::min(centerMin, box.min + box.max);
+            centerMax = glm::max(centerMax, box.min + box.max);
+        }
+        const glm::vec3 extent = centerMax - centerMin;
+        const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        const size_t half = count / 2;
+        std::nth_element(leaves, leaves + half, leaves + count, [&](int32_t a, int32_t b) {
+            return m_Nodes[a].box.min[axis] + m_Nodes[a].box.max[axis] < m_Nodes[b].box.min[axis] + m_Nodes[b].box.max[axis];
+        });
+
+        const int32_t child1 = BuildSubtree(leaves, half);
+        const int32_t child2 = BuildSubtree(leaves + half, count - half);
+        const int32_t node = AllocateNode();
+        m_Nodes[node].child1 = child1;
+        m_Nodes[node].child2 = child2;
+        m_Nodes[child1].parent = node;
+        m_Nodes[child2].parent = node;
+        Refit(node);
+        return node;
+    }
+
+    void AabbTree::Clear() {
+        m_Nodes.clear();
+        m_Root = kNullNode;
+        m_FreeList = kNullNode;
+        m_FreeCount = 0;
+        m_ProxyCount = 0;
+    }
+
+    void AabbTree::InsertLeaf(int32_t leaf) {
+        if (m_Root == kNullNode) {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = kNullNode;
+            return;
+        }
+
+        const graphics::BoundingBox leafBox = m_Nodes[leaf].box;
+        const int32_t sibling = FindBestSibling(leafBox);
+
+        // 新建父节点替换兄弟节点的位置
+        const int32_t oldParent = m_Nodes[sibling].parent;
+        const int32_t newParent = AllocateNode();
+        m_Nodes[newParent].parent = oldParent;
+        m_Nodes[newParent].child1 = sibling;
+        m_Nodes[newParent].child2 = leaf;
+        m_Nodes[newParent].box = Union(leafBox, m_Nodes[sibling].box);
+        m_Nodes[newParent].height = m_Nodes[sibling].height + 1;
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+        if (oldParent == kNullNode) {
+            m_Root = newParent;
+        } else if (m_Nodes[oldParent].child1 == sibling) {
+            m_Nodes[oldParent].child1 = newParent;
+        } else {
+            m_Nodes[oldParent].child2 = newParent;
+        }
+
+        // 向上重算高度与包围盒，沿途旋转
+        for (int32_t index = m_Nodes[leaf].parent; index != kNullNode; index = m_Nodes[index].parent) {
+            Refit(index);
+            Rotate(index);
+        }
+    }
+
+    void AabbTree::RemoveLeaf(int32_t leaf) {
+        if (leaf == m_Root) {
+            m_Root = kNullNode;
+            return;
+        }
+
+        // 兄弟节点顶替父节点的位置
+        const int32_t parent = m_Nodes[leaf].parent;
+        const int32_t grandParent = m_Nodes[parent].parent;
+        const int32_t sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+        if (grandParent == kNullNode) {
+            m_Root = sibling;
+            m_Nodes[sibling].parent = kNullNode;
+            FreeNode(parent);
+            return;
+        }
+        if (m_Nodes[grandParent].child1 == parent) m_Nodes[grandParent].child1 = sibling;
+        else m_Nodes[grandParent].child2 = sibling;
+        m_Nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        for (int32_t index = grandParent; index != kNullNode; index = m_Nodes[index].parent) {
+            Refit(index);
+            Rotate(index);
+        }
+    }
+
+    void AabbTree::Refit(int32_t node) {
+        Node& n = m_Nodes[node];
+        const Node& c1 = m_Nodes[n.child1];
+        const Node& c2 = m_Nodes[n.child2];
+        n.height = 1 + std::max(c1.height, c2.height);
+        n.box = Union(c1.box, c2.box);
+    }
+
+    void AabbTree::Rotate(int32_t iA) {
+        Node& A = m_Nodes[iA];
+        if (A.IsLeaf() || A.height < 2) return;
+
+        // 把 A 的一个子节点与另一侧的孙节点交换：A 的包围盒不变，只有被换入的那个子节点的包围盒改变，
+        // 选面积减少最多的一种；都不能减少时不动
+        const int32_t iB = A.child1, iC = A.child2;
+        const Node& B = m_Nodes[iB];
+        const Node& C = m_Nodes[iC];
+        float bestGain = 0.0f;
+        int32_t swapChild = kNullNode, swapParent = kNullNode;
+        bool swapFirst = false;
+        auto consider = [&](int32_t child, const Node& other, int32_t otherIndex) {
+            if (other.IsLeaf()) return;
+            const float area = Area(other.box);
+            const graphics::BoundingBox& childBox = m_Nodes[child].box;
+            // 与 other 的第一个子节点交换后 other 包住 child 与第二个子节点，反之亦然
+            const float gainFirst = area - Area(Union(childBox, m_Nodes[other.child2].box));
+            const float gainSecond = area - Area(Union(childBox, m_Nodes[other.child1].box));
+            if (gainFirst > bestGain) {
+                bestGain = gainFirst;
+                swapChild = child, swapParent = otherIndex, swapFirst = true;
+            }
+            if (gainSecond > bestGain) {
+                bestGain = gainSecond;
+                swapChild = child, swapParent = otherIndex, swapFirst = false;
+            }
+        };
+        consider(iB, C, iC);
+        consider(iC, B, iB);
+        if (swapChild == kNullNode) return;
+
+        Node& P = m_Nodes[swapParent];
+        const int32_t iG = swapFirst ? P.child1 : P.child2;
+        if (A.child1 == swapChild) A.child1 = iG;
+        else A.child2 = iG;
+        if (swapFirst) P.child1 = swapChild;
+        else P.child2 = swapChild;
+        m_Nodes[iG].parent = iA;
+        m_Nodes[swapChild].parent = swapParent;
+        Refit(swapParent);
+        Refit(iA);
+    }
+
+    int32_t AabbTree::FindBestSibling(const graphics::BoundingBox& leafBox) {
+        // 作为某节点兄弟的代价 = 新父节点面积 + 各祖先因包住新叶子而增加的面积。
+        // 沿下界较小的子节点单路下探，途中记录最优；两个子节点的下界都不优于当前最优时停止
+        const float leafArea = Area(leafBox);
+        int32_t best = m_Root;
+        float bestCost = Area(Union(m_Nodes[m_Root].box, leafBox));
+        float inherited = 0.0f;
+        int32_t index = m_Root;
+        while (!m_Nodes[index].IsLeaf()) {
+            const Node& node = m_Nodes[index];
+            inherited += Area(Union(node.box, leafBox)) - Area(node.box);
+
+            float lowerBound[2];
+            const int32_t children[2] = {node.child1, node.child2};
+            for (int i = 0; i < 2; ++i) {
+                const Node& child = m_Nodes[children[i]];
+                const float direct = Area(Union(child.box, leafBox));
+                if (direct + inherited < bestCost) {
+                    best = children[i];
+                    bestCost = direct + inherited;
+                }
+                // 子树内的代价不低于 叶子面积 + 祖先增量（含该子节点自身的增量）
+                lowerBound[i] = child.IsLeaf() ? bestCost : leafArea + inherited + direct - Area(child.box);
+            }
+            if (lowerBound[0] >= bestCost && lowerBound[1] >= bestCost) break;
+            index = lowerBound[0] <= lowerBound[1] ? children[0] : children[1];
+        }
+        return best;
+    }
+
+    bool AabbTree::Overlaps(const graphics::BoundingBox& a, const graphics::BoundingBox& b) {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+               a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    bool AabbTree::OverlapsSphere(const graphics::BoundingBox& box, const graphics::BoundingSphere& sphere) {
+        const glm::vec3 closest = glm::clamp(sphere.center, box.min, box.max);
+        const glm::vec3 d = closest - sphere.center;
+        return glm::dot(d, d) <= sphere.radius * sphere.radius;
+    }
+
+    AabbTree::Overlap AabbTree::ClassifyFrustum(const graphics::BoundingBox& box, const glm::vec4* planes) {
+        const glm::vec3 center = box.GetCenter();
+        const glm::vec3 extents = box.GetExtents();
+        Overlap result = kContains;
+        for (int i = 0; i < 6; ++i) {
+            const glm::vec3 normal(planes[i]);
+            const float distance = glm::dot(normal, center) + planes[i].w;
+            const float radius = glm::dot(glm::abs(normal), extents);
+            if (distance + radius < 0.0f) return kOutside;
+            if (distance - radius < 0.0f) result = kIntersects;
+        }
+        return result;
+    }
+
+    bool AabbTree::RayHit(const graphics::BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                          float maxDistance, float& enter) {
+        const glm::vec3 t1 = (box.min - origin) * inverseDirection;
+        const glm::vec3 t2 = (box.max - origin) * inverseDirection;
+        const glm::vec3 tNear = glm::min(t1, t2);
+        const glm::vec3 tFar = glm::max(t1, t2);
+        const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        enter = tEnter;
+        return tEnter <= tExit;
+    }
+
+    float AabbTree::GetAreaRatio() const {
+        if (m_Root == kNullNode) return 0.0f;
+        const float rootArea = Area(m_Nodes[m_Root].box);
+        if (rootArea <= 0.0f) return 0.0f;
+        float total = 0.0f;
+        for (const Node& node : m_Nodes) {
+            if (node.height > 0) total += Area(node.box);
+        }
+        return total / rootArea;
+    }
+
+    void AabbTree::Validate() const {
+        auto fail = [](const std::string& message) { throw std::runtime_error("[AabbTree] " + message); };
+        if (m_Root == kNullNode) {
+            if (m_ProxyCount != 0) fail("Empty tree with proxies");
+            return;
+        }
+        if (m_Nodes[m_Root].parent != kNullNode) fail("Root has a parent");
+
+        size_t leaves = 0, visited = 0;
+        std::vector<int32_t> stack{m_Root};
+        while (!stack.empty()) {
+            const int32_t index = stack.back();
+            stack.pop_back();
+            ++visited;
+            const Node& node = m_Nodes[index];
+            if (node.IsLeaf()) {
+                if (node.height != 0) fail("Leaf " + std::to_string(index) + " has height " + std::to_string(node.height));
+                ++leaves;
+                continue;
+            }
+            const Node& c1 = m_Nodes[node.child1];
+            const Node& c2 = m_Nodes[node.child2];
+            if (c1.parent != index || c2.parent != index) fail("Broken parent link at " + std::to_string(index));
+            if (node.height != 1 + std::max(c1.height, c2.height)) fail("Wrong height at " + std::to_string(index));
+            if (!Contains(node.box, c1.box) || !Contains(node.box, c2.box)) fail("Box does not enclose children");
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+        if (leaves != m_ProxyCount) fail("Leaf count mismatch");
+        if (visited != GetNodeCount()) fail("Unreachable nodes");
+    }
+
+} // namespace scene
@@ -1,55 +1,126 @@
 #include "scene/Entity.h"
+#include <algorithm>
+#include <cmath>
 
 namespace scene {
 
+    bool Entity::s_LodEnabled = true;
+    float Entity::s_LodThreshold = 0.001f;
+    float Entity::s_LodHysteresis = 0.3f;
+
     Entity::Entity(std::shared_ptr<graphics::Model> model)
-        : m_Model(std::move(model)) {}
+        : m_Model(std::move(model)), m_Transform(TransformSystem::Create()) {}
+
+    Entity::Entity(std::shared_ptr<graphics::Model> model, TransformHandle transform)
+        : m_Model(std::move(model)), m_Transform(transform) {}
+
+    Entity::~Entity() {
+        TransformSystem::Destroy(m_Transform);
+    }
 
     void Entity::SetModel(std::shared_ptr<graphics::Model> model) {
         m_Model = std::move(model);
     }
 
+    graphics::BoundingBox Entity::GetWorldBounds() const {
+        if (!m_Model) {
+            const glm::vec3 position(GetModelMatrix()[3]);
+            return graphics::BoundingBox{position, position};
+        }
+        return m_Model->GetBounds().Transform(GetModelMatrix());
+    }
+
     std::shared_ptr<graphics::Model> Entity::GetModel() const {
         return m_Model;
     }
 
     void Entity::SetPosition(const glm::vec3& position) {
-        m_Position = position;
+        TransformSystem::SetPosition(m_Transform, position);
     }
 
-    const glm::vec3& Entity::GetPosition() const {
-        return m_Position;
+    glm::vec3 Entity::GetPosition() const {
+        return TransformSystem::GetPosition(m_Transform);
     }
 
     void Entity::SetRotation(const glm::vec3& rotation) {
-        m_Rotation = rotation;
+        TransformSystem::SetRotation(m_Transform, rotation);
     }
 
-    const glm::vec3& Entity::GetRotation() const {
-        return m_Rotation;
+    glm::vec3 Entity::GetRotation() const {
+        return TransformSystem::GetRotation(m_Transform);
     }
 
     void Entity::SetScale(const glm::vec3& scale) {
-        m_Scale = scale;
+        TransformSystem::SetScale(m_Transform, scale);
+    }
+
+    glm::vec3 Entity::GetScale() const {
+        return TransformSystem::GetScale(m_Transform);
     }
 
-    const glm::vec3& Entity::GetScale() const {
-        return m_Scale;
+    void Entity::SetParent(const std::shared_ptr<Entity>& parent) {
+        TransformSystem::SetParent(m_Transform, parent ? parent->m_Transform : TransformHandle{});
+        m_Parent = parent;
     }
 
     glm::mat4 Entity::GetModelMatrix() const {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, m_Position);
-        model = glm::rotate(model, glm::radians(m_Rotation.x), glm::vec3(1, 0, 0));
-        model = glm::rotate(model, glm::radians(m_Rotation.y), glm::vec3(0, 1, 0));
-        model = glm::rotate(model, glm::radians(m_Rotation.z), glm::vec3(0, 0, 1));
-        model = glm::scale(model, m_Scale);
-        return model;
+        return TransformSystem::GetWorldMatrix(m_Transform);
+    }
+
+    void Entity::UpdateLod(const graphics::Camera& camera) {
+        if (!m_Model || !m_Model->IsReady() || !s_LodEnabled) {
+            m_Lod = 0;
+            return;
+        }
+        const uint32_t lodCount = m_Model->GetLodCount();
+        if (lodCount <= 1) {
+            m_Lod = 0;
+            return;
+        }
+
+        // 世界空间误差每单位对应的屏幕高度比例：透视为 P[1][1] / (2 * 深度)，正交为 P[1][1] / 2
+        // 缩放取世界矩阵各轴长度的最大值，包含父实体的缩放
+        const glm::mat4 projection = camera.GetProjectionMatrix();
+        const glm::mat4 model = GetModelMatrix();
+        const float maxScale = std::sqrt(std::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                                  std::max(glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                                           glm::dot(glm::vec3(model[2]), glm::vec3(model[2])))));
+        float screenPerUnit = 0.5f * projection[1][1];
+        if (camera.GetProjectionType() == graphics::Camera::ProjectionType::Perspective) {
+            const glm::vec3 center = glm::vec3(model * glm::vec4(m_Model->GetBoundsCenter(), 1.0f));
+            // 取包围球离相机最近处的深度，保守地高估误差
+            const float depth = glm::length(center - camera.GetPosition()) - m_Model->GetBoundsRadius() * maxScale;
+            screenPerUnit /= std::max(depth, 1e-3f);
+        }
+
+        float screenErrors[kMaxLods];
+        const uint32_t count = std::min(lodCount, kMaxLods);
+        for (uint32_t lod = 0; lod < count; ++lod)
+            screenErrors[lod] = m_Model->GetLodError(lod) * maxScale * screenPerUnit;
+        m_Lod = SelectLod(m_Lod, screenErrors, count);
+    }
+
+    uint32_t Entity::SelectLod(uint32_t current, const float* screenErrors, uint32_t lodCount) {
+        auto coarsestWithin = [&](float threshold) {
+            uint32_t lod = 0;
+            while (lod + 1 < lodCount && screenErrors[lod + 1] <= threshold) ++lod;
+            return lod;
+        };
+        const uint32_t allowed = coarsestWithin(s_LodThreshold);
+        const uint32_t relaxed = coarsestWithin(s_LodThreshold * (1.0f - s_LodHysteresis));
+        if (current > allowed) return allowed;
+        return std::max(current, relaxed);
+    }
+
+    void Entity::Draw(const graphics::MeshletCullView* cullView) const {
+        if (m_Model) {
+            m_Model->Draw(cullView, m_Lod);
+        }
     }
 
-    void Entity::Draw() const {
+    void Entity::Record(graphics::CommandBuffer& buffer, const graphics::MeshletCullView* cullView) const {
         if (m_Model) {
-            m_Model->Draw();
+            m_Model->Record(buffer, cullView, m_Lod);
         }
     }
 
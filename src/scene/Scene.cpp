@@ -1,18 +1,269 @@
 #include "scene/Scene.h"
+#include "scene/TransformSystem.h"
+#include "resource/ResourceManager.h"
+#include "utils/PathResolver.h"
+#include "utils/VirtualFileSystem.h"
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace scene {
 
+namespace {
+
+    constexpr uint32_t kSceneMagic = 0x4E435352;   ///< "RSCN"
+    constexpr uint32_t kSceneVersion = 1;
+    constexpr uint32_t kNoIndex = 0xFFFFFFFFu;
+    constexpr uint8_t kFlagOccluder = 1;
+    constexpr size_t kBlockAlignment = 16;
+
+    struct RSceneCameraRecord {
+        uint32_t present;
+        uint32_t projection;
+        float position[3];
+        float yaw;
+        float pitch;
+        uint32_t reserved;
+    };
+
+    struct RSceneHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entityCount;
+        uint32_t modelCount;
+        uint32_t lightCount;
+        uint32_t attachmentCount;
+        uint64_t modelOffset;         ///< uint32[modelCount]：模型路径在字符串表内的偏移
+        uint64_t positionOffset;
+        uint64_t rotationOffset;
+        uint64_t scaleOffset;
+        uint64_t modelIndexOffset;
+        uint64_t parentOffset;
+        uint64_t flagsOffset;
+        uint64_t lightOffset;
+        uint64_t attachmentOffset;
+        uint64_t stringTableOffset;
+        uint64_t stringTableSize;
+        RSceneCameraRecord camera;
+    };
+
+    struct RSceneLightRecord {
+        uint32_t type;
+        uint32_t enabled;
+        float color[3];
+        float intensity;
+        float position[3];
+        float direction[3];
+        float attenuation[3];   ///< 常数项、一次项、二次项
+        float cutOff[2];        ///< 内、外锥角的余弦
+        uint32_t reserved;
+    };
+
+    struct RSceneAttachmentRecord {
+        uint32_t light;
+        uint32_t entity;
+        float localPosition[3];
+        float localDirection[3];
+    };
+
+    static_assert(sizeof(RSceneCameraRecord) == 32, "RSceneCameraRecord layout changed");
+    static_assert(sizeof(RSceneHeader) == 144, "RSceneHeader layout changed");
+    static_assert(sizeof(RSceneLightRecord) == 72, "RSceneLightRecord layout changed");
+    static_assert(sizeof(RSceneAttachmentRecord) == 32, "RSceneAttachmentRecord layout changed");
+    static_assert(sizeof(glm::vec3) == 12, "vec3 arrays are written as float[3]");
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool ReadString(const char* table, uint64_t tableSize, uint32_t offset, std::string& out) {
+        uint32_t length = 0;
+        if (static_cast<uint64_t>(offset) + sizeof(length) > tableSize) return false;
+        std::memcpy(&length, table + offset, sizeof(length));
+        if (static_cast<uint64_t>(offset) + sizeof(length) + length > tableSize) return false;
+        out.assign(table + offset + sizeof(length), length);
+        return true;
+    }
+
+    /// 映射并校验过的场景文件，数组指针在 file 存活期间有效
+    struct SceneFileView {
+        utils::FileView file;
+        RSceneHeader header{};
+        std::vector<std::string> models;
+        const glm::vec3* positions = nullptr;
+        const glm::vec3* rotations = nullptr;
+        const glm::vec3* scales = nullptr;
+        const uint32_t* modelIndices = nullptr;
+        const uint32_t* parents = nullptr;
+        const uint8_t* flags = nullptr;
+        const RSceneLightRecord* lights = nullptr;
+        const RSceneAttachmentRecord* attachments = nullptr;
+    };
+
+    SceneFileView OpenSceneFile(const std::string& path) {
+        SceneFileView view;
+        view.file = utils::VirtualFileSystem::Open(path);
+        const char* base = view.file.Data();
+        const size_t size = view.file.Size();
+        const auto fail = [&](const char* reason) { return std::runtime_error("[Scene] " + path + ": " + reason); };
+
+        if (size < sizeof(RSceneHeader)) throw fail("file too small");
+        std::memcpy(&view.header, base, sizeof(RSceneHeader));
+        const RSceneHeader& header = view.header;
+        if (header.magic != kSceneMagic) throw fail("not a scene file");
+        if (header.version != kSceneVersion) throw fail("unsupported scene version");
+
+        // 数据块须按元素对齐且完整落在文件内
+        const auto block = [&](uint64_t offset, uint64_t count, size_t elementSize, size_t alignment) {
+            if (offset % alignment != 0 || offset > size || count > (size - offset) / elementSize)
+                throw fail("truncated or misaligned data block");
+            return base + offset;
+        };
+        const char* strings = block(header.stringTableOffset, header.stringTableSize, 1, 1);
+        const auto* modelRecords =
+            reinterpret_cast<const uint32_t*>(block(header.modelOffset, header.modelCount, sizeof(uint32_t), alignof(uint32_t)));
+        view.models.resize(header.modelCount);
+        for (uint32_t i = 0; i < header.modelCount; ++i) {
+            if (!ReadString(strings, header.stringTableSize, modelRecords[i], view.models[i])) throw fail("bad model path");
+        }
+
+        const uint32_t count = header.entityCount;
+        view.positions = reinterpret_cast<const glm::vec3*>(block(header.positionOffset, count, sizeof(glm::vec3), alignof(glm::vec3)));
+        view.rotations = reinterpret_cast<const glm::vec3*>(block(header.rotationOffset, count, sizeof(glm::vec3), alignof(glm::vec3)));
+        view.scales = reinterpret_cast<const glm::vec3*>(block(header.scaleOffset, count, sizeof(glm::vec3), alignof(glm::vec3)));
+        view.modelIndices = reinterpret_cast<const uint32_t*>(block(header.modelIndexOffset, count, sizeof(uint32_t), alignof(uint32_t)));
+        view.parents = reinterpret_cast<const uint32_t*>(block(header.parentOffset, count, sizeof(uint32_t), alignof(uint32_t)));
+        view.flags = reinterpret_cast<const uint8_t*>(block(header.flagsOffset, count, 1, 1));
+        view.lights = reinterpret_cast<const RSceneLightRecord*>(
+            block(header.lightOffset, header.lightCount, sizeof(RSceneLightRecord), alignof(RSceneLightRecord)));
+        view.attachments = reinterpret_cast<const RSceneAttachmentRecord*>(
+            block(header.attachmentOffset, header.attachmentCount, sizeof(RSceneAttachmentRecord), alignof(RSceneAttachmentRecord)));
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (view.modelIndices[i] != kNoIndex && view.modelIndices[i] >= header.modelCount) throw fail("bad model index");
+            if (view.parents[i] != kNoIndex && (view.parents[i] >= count || view.parents[i] == i)) throw fail("bad parent index");
+        }
+        // 沿父节点链检查环：0 未访问，1 在当前链上，2 已确认可到达根节点
+        std::vector<uint8_t> state(count, 0);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t node = i;
+            while (node != kNoIndex && state[node] == 0) {
+                state[node] = 1;
+                node = view.parents[node];
+            }
+            if (node != kNoIndex && state[node] == 1) throw fail("parent cycle");
+            for (node = i; node != kNoIndex && state[node] == 1; node = view.parents[node]) state[node] = 2;
+        }
+        for (uint32_t i = 0; i < header.lightCount; ++i) {
+            if (view.lights[i].type > static_cast<uint32_t>(graphics::Light::Type::Spot)) throw fail("bad light type");
+        }
+        for (uint32_t i = 0; i < header.attachmentCount; ++i) {
+            if (view.attachments[i].light >= header.lightCount || view.attachments[i].entity >= count)
+                throw fail("bad light attachment");
+        }
+        if (header.camera.present &&
+            header.camera.projection > static_cast<uint32_t>(graphics::Camera::ProjectionType::Orthographic))
+            throw fail("bad camera projection");
+        return view;
+    }
+
+    std::shared_ptr<graphics::Light> CreateLight(const RSceneLightRecord& record) {
+        std::shared_ptr<graphics::Light> light;
+        switch (static_cast<graphics::Light::Type>(record.type)) {
+            case graphics::Light::Type::Directional: light = std::make_shared<graphics::DirectionalLight>(); break;
+            case graphics::Light::Type::Point: light = std::make_shared<graphics::PointLight>(); break;
+            case graphics::Light::Type::Spot: light = std::make_shared<graphics::SpotLight>(); break;
+        }
+        light->SetEnabled(record.enabled != 0);
+        light->SetColor(glm::vec3(record.color[0], record.color[1], record.color[2]));
+        light->SetIntensity(record.intensity);
+        light->SetPosition(glm::vec3(record.position[0], record.position[1], record.position[2]));
+        light->SetDirection(glm::vec3(record.direction[0], record.direction[1], record.direction[2]));
+        light->SetAttenuation(record.attenuation[0], record.attenuation[1], record.attenuation[2]);
+        light->SetCutOff(record.cutOff[0], record.cutOff[1]);
+        return light;
+    }
+
+    void WriteVec3(std::ostream& out, const char* name, const float* v) {
+        out << ' ' << name << ' ' << v[0] << ' ' << v[1] << ' ' << v[2];
+    }
+
+    void WriteIndex(std::ostream& out, const char* name, uint32_t index) {
+        out << ' ' << name << ' ';
+        if (index == kNoIndex) out << '-';
+        else out << index;
+    }
+
+} // namespace
+
 void Scene::AddEntity(const std::shared_ptr<Entity>& entity) {
-    if (entity && std::find(m_Entities.begin(), m_Entities.end(), entity) == m_Entities.end()) {
+    if (!entity) return;
+    // 按变换槽位判重，避免大场景中线性查找
+    const uint32_t slot = entity->GetTransform().index;
+    if (slot >= m_Proxies.size()) m_Proxies.resize(slot + 1);
+    if (m_Proxies[slot].entity == entity) return;
+
+    m_Entities.push_back(entity);
+    m_Proxies[slot].entity = entity;
+    m_Proxies[slot].proxy = m_Tree.CreateProxy(entity->GetWorldBounds(), slot);
+    const auto& model = entity->GetModel();
+    if (model && !model->IsReady()) m_Pending.push_back(entity);
+}
+
+void Scene::AddEntities(const std::vector<std::shared_ptr<Entity>>& entities) {
+    uint32_t slotCount = static_cast<uint32_t>(m_Proxies.size());
+    for (const auto& entity : entities) {
+        if (entity) slotCount = std::max(slotCount, entity->GetTransform().index + 1);
+    }
+    m_Proxies.resize(slotCount);
+    m_Entities.reserve(m_Entities.size() + entities.size());
+
+    std::vector<graphics::BoundingBox> boxes;
+    std::vector<uint32_t> slots;
+    boxes.reserve(entities.size());
+    slots.reserve(entities.size());
+    for (const auto& entity : entities) {
+        if (!entity) continue;
+        const uint32_t slot = entity->GetTransform().index;
+        if (m_Proxies[slot].entity == entity) continue;
         m_Entities.push_back(entity);
+        m_Proxies[slot].entity = entity;
+        boxes.push_back(entity->GetWorldBounds());
+        slots.push_back(slot);
+        const auto& model = entity->GetModel();
+        if (model && !model->IsReady()) m_Pending.push_back(entity);
     }
+
+    std::vector<int32_t> proxies(slots.size());
+    m_Tree.CreateProxies(boxes.data(), slots.data(), slots.size(), proxies.data());
+    for (size_t i = 0; i < slots.size(); ++i) m_Proxies[slots[i]].proxy = proxies[i];
 }
 
 void Scene::RemoveEntity(const std::shared_ptr<Entity>& entity) {
-    auto it = std::remove(m_Entities.begin(), m_Entities.end(), entity);
-    if (it != m_Entities.end()) {
-        m_Entities.erase(it, m_Entities.end());
+    if (!entity) return;
+    const uint32_t slot = entity->GetTransform().index;
+    if (slot >= m_Proxies.size() || m_Proxies[slot].entity != entity) return;
+
+    m_Entities.erase(std::find(m_Entities.begin(), m_Entities.end(), entity));
+    m_Tree.DestroyProxy(m_Proxies[slot].proxy);
+    m_Proxies[slot] = SpatialProxy{};
+    m_Pending.erase(std::remove(m_Pending.begin(), m_Pending.end(), entity), m_Pending.end());
+}
+
+void Scene::RefreshBounds(const std::shared_ptr<Entity>& entity) {
+    if (!entity) return;
+    const uint32_t slot = entity->GetTransform().index;
+    if (slot >= m_Proxies.size() || m_Proxies[slot].entity != entity) return;
+    m_Tree.MoveProxy(m_Proxies[slot].proxy, entity->GetWorldBounds());
+    const auto& model = entity->GetModel();
+    if (model && !model->IsReady() && std::find(m_Pending.begin(), m_Pending.end(), entity) == m_Pending.end()) {
+        m_Pending.push_back(entity);
     }
 }
 
@@ -27,6 +278,436 @@ void Scene::RemoveLight(const std::shared_ptr<graphics::Light>& light) {
     if (it != m_Lights.end()) {
         m_Lights.erase(it, m_Lights.end());
     }
+    DetachLight(light);
+}
+
+void Scene::AttachLight(const std::shared_ptr<graphics::Light>& light, const std::shared_ptr<Entity>& entity,
+                        const glm::vec3& localPosition, const glm::vec3& localDirection) {
+    if (!light || !entity) return;
+    DetachLight(light);
+    m_LightAttachments.push_back({light, entity, localPosition, glm::normalize(localDirection)});
+}
+
+void Scene::DetachLight(const std::shared_ptr<graphics::Light>& light) {
+    m_LightAttachments.erase(std::remove_if(m_LightAttachments.begin(), m_LightAttachments.end(),
+                                            [&](const LightAttachment& a) { return a.light == light; }),
+                             m_LightAttachments.end());
+}
+
+void Scene::Update() {
+    // 只同步本帧移动过的实体（变换槽位可能属于其他场景的实体，按句柄核对）
+    for (const TransformHandle handle : TransformSystem::GetMoved()) {
+        if (handle.index >= m_Proxies.size()) continue;
+        const SpatialProxy& proxy = m_Proxies[handle.index];
+        if (!proxy.entity || proxy.entity->GetTransform() != handle) continue;
+        m_Tree.MoveProxy(proxy.proxy, proxy.entity->GetWorldBounds());
+    }
+    // 模型加载完成后包围盒由占位立方体变为实际大小
+    for (size_t i = 0; i < m_Pending.size();) {
+        const auto& entity = m_Pending[i];
+        const auto& model = entity->GetModel();
+        if (model && !model->IsReady()) {
+            ++i;
+            continue;
+        }
+        const uint32_t slot = entity->GetTransform().index;
+        m_Tree.MoveProxy(m_Proxies[slot].proxy, entity->GetWorldBounds());
+        m_Pending[i] = m_Pending.back();
+        m_Pending.pop_back();
+    }
+
+    m_LightAttachments.erase(std::remove_if(m_LightAttachments.begin(), m_LightAttachments.end(),
+                                            [](const LightAttachment& a) { return a.entity.expired(); }),
+                             m_LightAttachments.end());
+    for (const auto& attachment : m_LightAttachments) {
+        const glm::mat4 world = attachment.entity.lock()->GetModelMatrix();
+        attachment.light->SetPosition(glm::vec3(world * glm::vec4(attachment.localPosition, 1.0f)));
+        attachment.light->SetDirection(glm::normalize(glm::mat3(world) * attachment.localDirection));
+    }
+}
+
+const std::vector<std::shared_ptr<Entity>>& Scene::Cull(const graphics::Camera& camera) {
+    m_Visible.clear();
+    if (!graphics::FrustumCuller::IsEnabled()) {
+        for (const auto& entity : m_Entities) {
+            if (entity->GetModel()) m_Visible.push_back(entity);
+        }
+        return m_Visible;
+    }
+
+    // 空间索引按放大后的包围盒排除整棵子树，剩余的用实际包围盒批量测试
+    const glm::mat4 viewProjection = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+    const auto frustum = graphics::Frustum::FromMatrix(viewProjection);
+    m_Candidates.clear();
+    m_Boxes.Clear();
+    size_t reached = 0;
+    m_Tree.QueryFrustum(frustum, [&](uint32_t slot) {
+        const Entity& entity = *m_Proxies[slot].entity;
+        ++reached;
+        if (entity.GetModel()) {
+            m_Candidates.push_back(slot);
+            m_Boxes.Push(entity.GetWorldBounds());
+        }
+        return true;
+    });
+    graphics::FrustumCuller::CountRejected(m_Tree.GetProxyCount() - reached);
+    graphics::FrustumCuller::Cull(frustum, m_Boxes, m_VisibleIndices);
+
+    for (uint32_t candidate : m_VisibleIndices) {
+        m_Visible.push_back(m_Proxies[m_Candidates[candidate]].entity);
+    }
+    if (graphics::OcclusionCuller::IsEnabled()) CullOccluded(viewProjection);
+    return m_Visible;
+}
+
+void Scene::CullOccluded(const glm::mat4& viewProjection) {
+    const auto start = std::chrono::steady_clock::now();
+    m_Occlusion.Begin(viewProjection);
+    size_t occluders = 0;
+    for (const auto& entity : m_Visible) {
+        if (!entity->IsOccluder()) continue;
+        const auto& model = entity->GetModel();
+        if (!model->IsReady() || model->GetOccluder().IsEmpty()) continue;
+        m_Occlusion.AddOccluder(model->GetOccluder(), entity->GetModelMatrix());
+        ++occluders;
+    }
+    if (occluders == 0) return;
+    m_Occlusion.Rasterize(graphics::OcclusionCuller::GetThreadCount());
+    const auto rasterized = std::chrono::steady_clock::now();
+    graphics::OcclusionCuller::RecordRaster(occluders, m_Occlusion.GetTriangleCount(),
+                                            std::chrono::duration<double, std::milli>(rasterized - start).count());
+
+    // 遮挡体自身也参与测试：自己的表面不会遮住自己的包围盒
+    const size_t tested = m_Visible.size();
+    size_t kept = 0, drawCallsSaved = 0;
+    for (size_t i = 0; i < tested; ++i) {
+        if (m_Occlusion.IsVisible(m_Visible[i]->GetWorldBounds())) {
+            if (kept != i) m_Visible[kept] = std::move(m_Visible[i]);
+            ++kept;
+        } else {
+            drawCallsSaved += m_Visible[i]->GetModel()->GetMeshCount();
+        }
+    }
+    m_Visible.resize(kept);
+    graphics::OcclusionCuller::RecordTests(tested, tested - kept, drawCallsSaved,
+                                           std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rasterized).count());
+}
+
+void Scene::QueryBox(const graphics::BoundingBox& box, std::vector<std::shared_ptr<Entity>>& result) const {
+    result.clear();
+    m_Tree.QueryBox(box, [&](uint32_t slot) {
+        const auto& entity = m_Proxies[slot].entity;
+        const graphics::BoundingBox bounds = entity->GetWorldBounds();
+        if (glm::all(glm::lessThanEqual(bounds.min, box.max)) && glm::all(glm::lessThanEqual(box.min, bounds.max))) {
+            result.push_back(entity);
+        }
+        return true;
+    });
+}
+
+void Scene::QuerySphere(const graphics::BoundingSphere& sphere, std::vector<std::shared_ptr<Entity>>& result) const {
+    result.clear();
+    const float radiusSquared = sphere.radius * sphere.radius;
+    m_Tree.QuerySphere(sphere, [&](uint32_t slot) {
+        const auto& entity = m_Proxies[slot].entity;
+        const graphics::BoundingBox bounds = entity->GetWorldBounds();
+        const glm::vec3 d = glm::clamp(sphere.center, bounds.min, bounds.max) - sphere.center;
+        if (glm::dot(d, d) <= radiusSquared) result.push_back(entity);
+        return true;
+    });
+}
+
+void Scene::QueryFrustum(const graphics::Frustum& frustum, std::vector<std::shared_ptr<Entity>>& result) const {
+    result.clear();
+    m_Tree.QueryFrustum(frustum, [&](uint32_t slot) {
+        const auto& entity = m_Proxies[slot].entity;
+        if (frustum.Intersects(entity->GetWorldBounds())) result.push_back(entity);
+        return true;
+    });
+}
+
+std::shared_ptr<Entity> Scene::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                       float* distance) const {
+    std::shared_ptr<Entity> nearest;
+    const glm::vec3 inverseDirection = graphics::InverseRayDirection(direction);
+    m_Tree.RayCast(origin, direction, maxDistance, [&](uint32_t slot, float, float tMax) {
+        const auto& entity = m_Proxies[slot].entity;
+        const graphics::BoundingBox bounds = entity->GetWorldBounds();
+        const glm::vec3 t1 = (bounds.min - origin) * inverseDirection;
+        const glm::vec3 t2 = (bounds.max - origin) * inverseDirection;
+        const glm::vec3 tNear = glm::min(t1, t2), tFar = glm::max(t1, t2);
+        const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+        if (tEnter > tExit) return tMax;
+        // 命中后裁剪射线，更远的子树不再访问
+        nearest = entity;
+        if (distance) *distance = tEnter;
+        return std::max(tEnter, 1e-30f);
+    });
+    return nearest;
+}
+
+Scene::PickResult Scene::Pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+    PickResult result;
+    m_Tree.RayCast(origin, direction, maxDistance, [&](uint32_t slot, float, float tMax) {
+        const auto& entity = m_Proxies[slot].entity;
+        const auto& model = entity->GetModel();
+        if (!model || !model->IsReady()) return tMax;
+        // 方向只做线性变换、不归一化，模型空间中的 t 与世界空间相同
+        const glm::mat4 inverse = glm::inverse(entity->GetModelMatrix());
+        const glm::vec3 localOrigin = glm::vec3(inverse * glm::vec4(origin, 1.0f));
+        const glm::vec3 localDirection = glm::mat3(inverse) * direction;
+        graphics::RayHit hit;
+        uint32_t mesh = 0;
+        if (!model->Intersect(localOrigin, localDirection, tMax, hit, mesh)) return tMax;
+        result.entity = entity;
+        result.mesh = mesh;
+        result.triangle = hit.triangle;
+        result.barycentric = hit.barycentric;
+        result.distance = hit.distance;
+        return std::max(hit.distance, 1e-30f);
+    });
+    if (result.entity) result.position = origin + result.distance * direction;
+    return result;
+}
+
+void Scene::Save(const std::string& path, const graphics::Camera* camera) const {
+    const size_t entityCount = m_Entities.size();
+    // 变换槽位 → 实体序号，用于写出父实体
+    std::vector<uint32_t> indexOfSlot(m_Proxies.size(), kNoIndex);
+    for (size_t i = 0; i < entityCount; ++i) indexOfSlot[m_Entities[i]->GetTransform().index] = static_cast<uint32_t>(i);
+
+    std::string strings;
+    const auto addString = [&](const std::string& str) {
+        const auto offset = static_cast<uint32_t>(strings.size());
+        const auto length = static_cast<uint32_t>(str.size());
+        strings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        strings.append(str);
+        return offset;
+    };
+
+    std::vector<uint32_t> modelRecords;
+    std::unordered_map<const graphics::Model*, uint32_t> modelIndex;
+    std::vector<glm::vec3> positions(entityCount), rotations(entityCount), scales(entityCount);
+    std::vector<uint32_t> models(entityCount, kNoIndex), parents(entityCount, kNoIndex);
+    std::vector<uint8_t> flags(entityCount, 0);
+    for (size_t i = 0; i < entityCount; ++i) {
+        const Entity& entity = *m_Entities[i];
+        positions[i] = entity.GetPosition();
+        rotations[i] = entity.GetRotation();
+        scales[i] = entity.GetScale();
+        flags[i] = entity.IsOccluder() ? kFlagOccluder : 0;
+        if (const auto parent = entity.GetParent()) {
+            const uint32_t slot = parent->GetTransform().index;
+            if (slot < m_Proxies.size() && m_Proxies[slot].entity == parent) {
+                parents[i] = indexOfSlot[slot];
+            } else {
+                // 父实体不在本场景中：按根节点保存其世界变换，载入后位置不变
+                TransformSystem::DecomposeMatrix(entity.GetModelMatrix(), positions[i], rotations[i], scales[i]);
+            }
+        }
+        if (const auto model = entity.GetModel()) {
+            const auto inserted = modelIndex.emplace(model.get(), static_cast<uint32_t>(modelRecords.size()));
+            if (inserted.second) {
+                // 尚未上传的模型没有路径，按 ResourceManager 的登记查找
+                std::string modelPath = model->GetPath();
+                if (modelPath.empty()) modelPath = core::ResourceManager::GetModelPath(model);
+                if (modelPath.empty()) throw std::runtime_error("[Scene] Cannot save a model without a file path");
+                modelRecords.push_back(addString(utils::VirtualFileSystem::GetKey(modelPath)));
+            }
+            models[i] = inserted.first->second;
+        }
+    }
+
+    std::unordered_map<const graphics::Light*, uint32_t> lightIndex;
+    std::vector<RSceneLightRecord> lights;
+    for (const auto& light : m_Lights) {
+        RSceneLightRecord record{};
+        record.type = static_cast<uint32_t>(light->GetType());
+        record.enabled = light->IsEnabled() ? 1 : 0;
+        std::memcpy(record.color, &light->GetColor().x, sizeof(record.color));
+        record.intensity = light->GetIntensity();
+        std::memcpy(record.position, &light->GetPosition().x, sizeof(record.position));
+        std::memcpy(record.direction, &light->GetDirection().x, sizeof(record.direction));
+        record.attenuation[0] = light->GetConstant();
+        record.attenuation[1] = light->GetLinear();
+        record.attenuation[2] = light->GetQuadratic();
+        record.cutOff[0] = light->GetInnerCutOff();
+        record.cutOff[1] = light->GetOuterCutOff();
+        lightIndex.emplace(light.get(), static_cast<uint32_t>(lights.size()));
+        lights.push_back(record);
+    }
+    std::vector<RSceneAttachmentRecord> attachments;
+    for (const auto& attachment : m_LightAttachments) {
+        const auto entity = attachment.entity.lock();
+        const auto light = lightIndex.find(attachment.light.get());
+        if (!entity || light == lightIndex.end()) continue;
+        const uint32_t slot = entity->GetTransform().index;
+        if (slot >= m_Proxies.size() || m_Proxies[slot].entity != entity) continue;
+        RSceneAttachmentRecord record{};
+        record.light = light->second;
+        record.entity = indexOfSlot[slot];
+        std::memcpy(record.localPosition, &attachment.localPosition.x, sizeof(record.localPosition));
+        std::memcpy(record.localDirection, &attachment.localDirection.x, sizeof(record.localDirection));
+        attachments.push_back(record);
+    }
+
+    RSceneHeader header{};
+    header.magic = kSceneMagic;
+    header.version = kSceneVersion;
+    header.entityCount = static_cast<uint32_t>(entityCount);
+    header.modelCount = static_cast<uint32_t>(modelRecords.size());
+    header.lightCount = static_cast<uint32_t>(lights.size());
+    header.attachmentCount = static_cast<uint32_t>(attachments.size());
+    if (camera) {
+        header.camera.present = 1;
+        header.camera.projection = static_cast<uint32_t>(camera->GetProjectionType());
+        std::memcpy(header.camera.position, &camera->GetPosition().x, sizeof(header.camera.position));
+        header.camera.yaw = camera->GetYaw();
+        header.camera.pitch = camera->GetPitch();
+    }
+
+    // 先计算各块偏移，再依次追加
+    struct Block {
+        uint64_t* offset;
+        const void* data;
+        size_t bytes;
+    };
+    const Block blocks[] = {
+        {&header.modelOffset, modelRecords.data(), modelRecords.size() * sizeof(uint32_t)},
+        {&header.positionOffset, positions.data(), entityCount * sizeof(glm::vec3)},
+        {&header.rotationOffset, rotations.data(), entityCount * sizeof(glm::vec3)},
+        {&header.scaleOffset, scales.data(), entityCount * sizeof(glm::vec3)},
+        {&header.modelIndexOffset, models.data(), entityCount * sizeof(uint32_t)},
+        {&header.parentOffset, parents.data(), entityCount * sizeof(uint32_t)},
+        {&header.flagsOffset, flags.data(), entityCount},
+        {&header.lightOffset, lights.data(), lights.size() * sizeof(RSceneLightRecord)},
+        {&header.attachmentOffset, attachments.data(), attachments.size() * sizeof(RSceneAttachmentRecord)},
+        {&header.stringTableOffset, strings.data(), strings.size()},
+    };
+    size_t offset = sizeof(RSceneHeader);
+    for (const Block& block : blocks) {
+        offset = AlignUp(offset, kBlockAlignment);
+        *block.offset = offset;
+        offset += block.bytes;
+    }
+    header.stringTableSize = strings.size();
+
+    std::string blob;
+    blob.reserve(offset);
+    blob.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Block& block : blocks) {
+        blob.resize(*block.offset, '\0');
+        blob.append(static_cast<const char*>(block.data), block.bytes);
+    }
+
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) throw std::runtime_error("[Scene] Failed to create scene file: " + tempPath);
+        file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!file) throw std::runtime_error("[Scene] Failed to write scene file: " + tempPath);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        throw std::runtime_error("[Scene] Failed to replace scene file: " + path);
+    }
+}
+
+size_t Scene::Load(const std::string& path, graphics::Camera* camera) {
+    const SceneFileView view = OpenSceneFile(path);
+    const RSceneHeader& header = view.header;
+    const size_t count = header.entityCount;
+
+    // 模型表：相对路径按项目根目录解析，一次提交全部加载
+    std::vector<std::string> modelPaths;
+    modelPaths.reserve(view.models.size());
+    for (const auto& model : view.models)
+        modelPaths.push_back(std::filesystem::path(model).is_relative() ? PathResolver::Resolve(model) : model);
+    const auto models = core::ResourceManager::LoadModelsAsync(modelPaths);
+
+    std::vector<TransformHandle> handles(count);
+    TransformSystem::CreateBatch(count, view.positions, view.rotations, view.scales, handles.data());
+
+    // 实体各自分配，释放或移除后立即析构并销毁其变换
+    std::vector<std::shared_ptr<Entity>> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t model = view.modelIndices[i];
+        auto entity = std::make_shared<Entity>(model == kNoIndex ? nullptr : models[model], handles[i]);
+        entity->SetOccluder((view.flags[i] & kFlagOccluder) != 0);
+        entities.push_back(std::move(entity));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (view.parents[i] != kNoIndex) entities[i]->SetParent(entities[view.parents[i]]);
+    }
+    AddEntities(entities);
+
+    std::vector<std::shared_ptr<graphics::Light>> lights;
+    lights.reserve(header.lightCount);
+    for (uint32_t i = 0; i < header.lightCount; ++i) {
+        lights.push_back(CreateLight(view.lights[i]));
+        AddLight(lights.back());
+    }
+    for (uint32_t i = 0; i < header.attachmentCount; ++i) {
+        const RSceneAttachmentRecord& record = view.attachments[i];
+        AttachLight(lights[record.light], entities[record.entity],
+                    glm::vec3(record.localPosition[0], record.localPosition[1], record.localPosition[2]),
+                    glm::vec3(record.localDirection[0], record.localDirection[1], record.localDirection[2]));
+    }
+
+    if (camera && header.camera.present) {
+        camera->setProjectionType(static_cast<graphics::Camera::ProjectionType>(header.camera.projection));
+        camera->SetPosition(glm::vec3(header.camera.position[0], header.camera.position[1], header.camera.position[2]));
+        camera->SetRotation(header.camera.yaw, header.camera.pitch);
+    }
+    return count;
+}
+
+void Scene::ExportText(const std::string& path, std::ostream& out) {
+    const SceneFileView view = OpenSceneFile(path);
+    const RSceneHeader& header = view.header;
+    const char* lightTypes[] = {"directional", "point", "spot"};
+    const auto flags = out.flags();
+    const auto precision = out.precision(9);
+
+    out << "rscene " << header.version << '\n';
+    if (header.camera.present) {
+        out << "camera " << (header.camera.projection == 0 ? "perspective" : "orthographic");
+        WriteVec3(out, "position", header.camera.position);
+        out << " yaw " << header.camera.yaw << " pitch " << header.camera.pitch << '\n';
+    }
+    for (uint32_t i = 0; i < header.modelCount; ++i) out << "model " << i << ' ' << view.models[i] << '\n';
+    for (uint32_t i = 0; i < header.entityCount; ++i) {
+        out << "entity " << i;
+        WriteIndex(out, "model", view.modelIndices[i]);
+        WriteIndex(out, "parent", view.parents[i]);
+        WriteVec3(out, "position", &view.positions[i].x);
+        WriteVec3(out, "rotation", &view.rotations[i].x);
+        WriteVec3(out, "scale", &view.scales[i].x);
+        out << " occluder " << ((view.flags[i] & kFlagOccluder) ? 1 : 0) << '\n';
+    }
+    for (uint32_t i = 0; i < header.lightCount; ++i) {
+        const RSceneLightRecord& light = view.lights[i];
+        out << "light " << i << ' ' << lightTypes[light.type] << " enabled " << light.enabled;
+        WriteVec3(out, "color", light.color);
+        out << " intensity " << light.intensity;
+        WriteVec3(out, "position", light.position);
+        WriteVec3(out, "direction", light.direction);
+        WriteVec3(out, "attenuation", light.attenuation);
+        out << " cutoff " << light.cutOff[0] << ' ' << light.cutOff[1] << '\n';
+    }
+    for (uint32_t i = 0; i < header.attachmentCount; ++i) {
+        const RSceneAttachmentRecord& attachment = view.attachments[i];
+        out << "attachment " << i << " light " << attachment.light << " entity " << attachment.entity;
+        WriteVec3(out, "position", attachment.localPosition);
+        WriteVec3(out, "direction", attachment.localDirection);
+        out << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
 }
 
 const std::vector<std::shared_ptr<Entity>>& Scene::GetEntities() const {
@@ -0,0 +1,716 @@
+#include "scene/TransformSystem.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RRENDER_TRANSFORM_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace scene {
+
+    TransformSystem::Storage TransformSystem::s_Storage;
+    TransformSystem::Stats TransformSystem::s_Stats;
+    bool TransformSystem::s_SimdEnabled = true;
+    unsigned int TransformSystem::s_ThreadCount = 1;
+
+namespace {
+
+    constexpr float kDegToRad = 3.14159265358979f / 180.0f;
+
+    // 脏标记：只改位置时矩阵只需重写平移列
+    constexpr uint8_t kDirtyTranslation = 1;
+    constexpr uint8_t kDirtyBasis = 2;
+
+    constexpr uint32_t kNone = TransformHandle::kInvalidIndex;
+    /// 每层节点数达到两块以上时才分块并行传播
+    constexpr uint32_t kPropagateChunk = 4096;
+    /// 批量重算每块的矩阵数（8 的倍数，块内仍按 SIMD 宽度处理）
+    constexpr size_t kComputeChunk = 4096;
+
+    /// 对每个按紧密下标存放的数组调用 fn（parent 在重排时重新生成，不在其中）
+    template <typename S, typename Fn>
+    void ForEachPool(S& st, Fn&& fn) {
+        fn(st.positionX);
+        fn(st.positionY);
+        fn(st.positionZ);
+        fn(st.rotationX);
+        fn(st.rotationY);
+        fn(st.rotationZ);
+        fn(st.scaleX);
+        fn(st.scaleY);
+        fn(st.scaleZ);
+        fn(st.world);
+        fn(st.local);
+        fn(st.dirty);
+        fn(st.parentSlot);
+        fn(st.slots);
+    }
+
+    /// out = a × b（列主序，out 不能与 a、b 相同）
+    inline void Multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+#ifdef RRENDER_TRANSFORM_SSE
+        const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+        const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+        const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+        const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+        for (int c = 0; c < 4; ++c) {
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[c][0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[c][1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[c][2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[c][3])));
+            _mm_storeu_ps(&out[c][0], r);
+        }
+#else
+        out = a * b;
+#endif
+    }
+
+    /**
+     * @brief 由 R = Rx·Ry·Rz 的各项与缩放拼出矩阵
+     * c 为 (cos x, cos y, cos z)，s 为对应正弦，列 j 乘以缩放的第 j 个分量
+     */
+    glm::mat4 Compose(const glm::vec3& t, const glm::vec3& c, const glm::vec3& s, const glm::vec3& k) {
+        glm::mat4 m(1.0f);
+        m[0] = glm::vec4(c.y * c.z, c.x * s.z + s.x * s.y * c.z, s.x * s.z - c.x * s.y * c.z, 0.0f) * k.x;
+        m[1] = glm::vec4(-c.y * s.z, c.x * c.z - s.x * s.y * s.z, s.x * c.z + c.x * s.y * s.z, 0.0f) * k.y;
+        m[2] = glm::vec4(s.y, -s.x * c.y, c.x * c.y, 0.0f) * k.z;
+        m[3] = glm::vec4(t, 1.0f);
+        return m;
+    }
+
+#ifdef RRENDER_TRANSFORM_SSE
+
+    /// 4 路 SSE2 运算
+    struct Sse {
+        using F = __m128;
+        using I = __m128i;
+        static constexpr size_t kWidth = 4;
+
+        static F Set(float x) { return _mm_set1_ps(x); }
+        static F Add(F a, F b) { return _mm_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F Xor(F a, F b) { return _mm_xor_ps(a, b); }
+        static F And(F a, F b) { return _mm_and_ps(a, b); }
+        static F Select(F mask, F a, F b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static I Round(F a) { return _mm_cvtps_epi32(a); }
+        static F ToFloat(I a) { return _mm_cvtepi32_ps(a); }
+        static I AddInt(I a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+        /// (a & bit) != 0 的掩码
+        static F TestBit(I a, int bit) {
+            const I b = _mm_set1_epi32(bit);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, b), b));
+        }
+
+        /// 连续下标直接加载，否则逐个收集
+        static F Load(const float* base, const uint32_t* idx, bool contiguous) {
+            if (contiguous) return _mm_loadu_ps(base + idx[0]);
+            return _mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]);
+        }
+
+        /// cols 为 4 列 × xyz（第 3 列为平移），转置后写入 4 个矩阵
+        static void Store(const F* cols, glm::mat4* world, const uint32_t* idx) {
+            for (int col = 0; col < 4; ++col) {
+                F a = cols[col * 3], b = cols[col * 3 + 1], c = cols[col * 3 + 2];
+                F d = col == 3 ? _mm_set1_ps(1.0f) : _mm_setzero_ps();
+                _MM_TRANSPOSE4_PS(a, b, c, d);
+                _mm_storeu_ps(&world[idx[0]][col][0], a);
+                _mm_storeu_ps(&world[idx[1]][col][0], b);
+                _mm_storeu_ps(&world[idx[2]][col][0], c);
+                _mm_storeu_ps(&world[idx[3]][col][0], d);
+            }
+        }
+    };
+
+#ifdef __AVX2__
+    /// 8 路 AVX2 运算，写回时拆成两组 SSE 转置
+    struct Avx {
+        using F = __m256;
+        using I = __m256i;
+        static constexpr size_t kWidth = 8;
+
+        static F Set(float x) { return _mm256_set1_ps(x); }
+        static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F Xor(F a, F b) { return _mm256_xor_ps(a, b); }
+        static F And(F a, F b) { return _mm256_and_ps(a, b); }
+        static F Select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+        static I Round(F a) { return _mm256_cvtps_epi32(a); }
+        static F ToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+        static I AddInt(I a, int b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+        static F TestBit(I a, int bit) {
+            const I b = _mm256_set1_epi32(bit);
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, b), b));
+        }
+
+        static F Load(const float* base, const uint32_t* idx, bool contiguous) {
+            if (contiguous) return _mm256_loadu_ps(base + idx[0]);
+            return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+        }
+
+        static void Store(const F* cols, glm::mat4* world, const uint32_t* idx) {
+            __m128 lo[12], hi[12];
+            for (int i = 0; i < 12; ++i) {
+                lo[i] = _mm256_castps256_ps128(cols[i]);
+                hi[i] = _mm256_extractf128_ps(cols[i], 1);
+            }
+            Sse::Store(lo, world, idx);
+            Sse::Store(hi, world, idx + 4);
+        }
+    };
+#endif
+
+    /**
+     * @brief 同时求正弦与余弦（弧度）
+     * 按 π/2 取整做区间约简（π/2 拆成三段以保留精度），[-π/4, π/4] 内用 Cephes 的多项式，
+     * 再按象限交换并翻转符号；误差约 1e-7 量级，与 std::sin 一致到 float 精度
+     */
+    template <typename V>
+    void SinCos(typename V::F x, typename V::F& s, typename V::F& c) {
+        using F = typename V::F;
+        const auto q = V::Round(V::Mul(x, V::Set(0.63661977236758134f)));
+        const F j = V::ToFloat(q);
+        F r = V::Sub(x, V::Mul(j, V::Set(1.5703125f)));
+        r = V::Sub(r, V::Mul(j, V::Set(4.837512969970703125e-4f)));
+        r = V::Sub(r, V::Mul(j, V::Set(7.54978995489188216e-8f)));
+
+        const F r2 = V::Mul(r, r);
+        F sp = V::Add(V::Mul(r2, V::Set(-1.9515295891e-4f)), V::Set(8.3321608736e-3f));
+        sp = V::Add(V::Mul(sp, r2), V::Set(-1.6666654611e-1f));
+        sp = V::Add(V::Mul(V::Mul(sp, r2), r), r);
+        F cp = V::Add(V::Mul(r2, V::Set(2.443315711809948e-5f)), V::Set(-1.388731625493765e-3f));
+        cp = V::Add(V::Mul(cp, r2), V::Set(4.166664568298827e-2f));
+        cp = V::Add(V::Sub(V::Mul(V::Mul(cp, r2), r2), V::Mul(r2, V::Set(0.5f))), V::Set(1.0f));
+
+        // 象限 1、3 交换；象限 2、3 正弦取反，象限 1、2 余弦取反
+        const F swap = V::TestBit(q, 1);
+        const F signBit = V::Set(-0.0f);
+        s = V::Xor(V::Select(swap, cp, sp), V::And(V::TestBit(q, 2), signBit));
+        c = V::Xor(V::Select(swap, sp, cp), V::And(V::TestBit(V::AddInt(q, 1), 2), signBit));
+    }
+
+    /// 计算 idx 指向的 V::kWidth 个矩阵
+    template <typename V>
+    void ComputeSimdBatch(const float* const* pools, glm::mat4* world, const uint32_t* idx) {
+        using F = typename V::F;
+        const bool contiguous = idx[V::kWidth - 1] - idx[0] == V::kWidth - 1;
+        F in[9];
+        for (int i = 0; i < 9; ++i) in[i] = V::Load(pools[i], idx, contiguous);
+
+        F sx, cx, sy, cy, sz, cz;
+        const F toRad = V::Set(kDegToRad);
+        SinCos<V>(V::Mul(in[3], toRad), sx, cx);
+        SinCos<V>(V::Mul(in[4], toRad), sy, cy);
+        SinCos<V>(V::Mul(in[5], toRad), sz, cz);
+
+        const F sxsy = V::Mul(sx, sy);
+        const F cxsy = V::Mul(cx, sy);
+        F cols[12];
+        cols[0] = V::Mul(V::Mul(cy, cz), in[6]);
+        cols[1] = V::Mul(V::Add(V::Mul(cx, sz), V::Mul(sxsy, cz)), in[6]);
+        cols[2] = V::Mul(V::Sub(V::Mul(sx, sz), V::Mul(cxsy, cz)), in[6]);
+        cols[3] = V::Mul(V::Xor(V::Mul(cy, sz), V::Set(-0.0f)), in[7]);
+        cols[4] = V::Mul(V::Sub(V::Mul(cx, cz), V::Mul(sxsy, sz)), in[7]);
+        cols[5] = V::Mul(V::Add(V::Mul(sx, cz), V::Mul(cxsy, sz)), in[7]);
+        cols[6] = V::Mul(sy, in[8]);
+        cols[7] = V::Mul(V::Xor(V::Mul(sx, cy), V::Set(-0.0f)), in[8]);
+        cols[8] = V::Mul(V::Mul(cx, cy), in[8]);
+        cols[9] = in[0];
+        cols[10] = in[1];
+        cols[11] = in[2];
+        V::Store(cols, world, idx);
+    }
+
+#endif
+
+} // namespace
+
+    TransformHandle TransformSystem::Create(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
+        Storage& st = s_Storage;
+        uint32_t slot;
+        if (!st.freeSlots.empty()) {
+            slot = st.freeSlots.back();
+            st.freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(st.denseIndex.size());
+            st.denseIndex.push_back(0);
+            st.generations.push_back(0);
+            st.childCount.push_back(0);
+            st.firstChild.push_back(kNone);
+            st.nextSibling.push_back(kNone);
+            st.prevSibling.push_back(kNone);
+        }
+
+        const uint32_t dense = static_cast<uint32_t>(st.slots.size());
+        st.denseIndex[slot] = dense;
+        st.slots.push_back(slot);
+        st.positionX.push_back(position.x);
+        st.positionY.push_back(position.y);
+        st.positionZ.push_back(position.z);
+        st.rotationX.push_back(rotation.x);
+        st.rotationY.push_back(rotation.y);
+        st.rotationZ.push_back(rotation.z);
+        st.scaleX.push_back(scale.x);
+        st.scaleY.push_back(scale.y);
+        st.scaleZ.push_back(scale.z);
+        st.world.emplace_back(1.0f);
+        st.local.emplace_back(1.0f);
+        st.dirty.push_back(0);
+        st.parentSlot.push_back(kNone);
+        MarkDirty(dense, kDirtyTranslation | kDirtyBasis);
+        // 新的根节点追加在末尾，存在层级时需要重排以保持按层连续
+        if (st.linkCount > 0) st.orderDirty = true;
+        s_Stats.transforms = st.slots.size();
+        return TransformHandle{slot, st.generations[slot]};
+    }
+
+    void TransformSystem::Destroy(TransformHandle handle) {
+        if (!IsAlive(handle)) return;
+        Storage& st = s_Storage;
+        const uint32_t slot = handle.index;
+        const uint32_t dense = st.denseIndex[slot];
+        const uint32_t last = static_cast<uint32_t>(st.slots.size() - 1);
+
+        // 子节点脱离成为根节点，保留各自的局部变换
+        for (uint32_t child = st.firstChild[slot]; child != kNone;) {
+            const uint32_t next = st.nextSibling[child];
+            const uint32_t childDense = st.denseIndex[child];
+            st.parentSlot[childDense] = kNone;
+            st.nextSibling[child] = st.prevSibling[child] = kNone;
+            --st.linkCount;
+            MarkDirty(childDense, kDirtyTranslation | kDirtyBasis);
+            child = next;
+        }
+        st.firstChild[slot] = kNone;
+        st.childCount[slot] = 0;
+        if (st.parentSlot[dense] != kNone) Unlink(slot, st.parentSlot[dense]);
+        st.orderDirty = true;
+
+        // 末尾元素移入空位，保持数组连续
+        const uint8_t movedFlags = st.dirty[last];
+        const uint32_t movedSlot = st.slots[last];
+        ForEachPool(st, [&](auto& pool) {
+            pool[dense] = pool[last];
+            pool.pop_back();
+        });
+        if (dense != last) {
+            st.denseIndex[movedSlot] = dense;
+            st.dirty[dense] = 0;
+            if (movedFlags) MarkDirty(dense, movedFlags);
+        }
+
+        ++st.generations[slot];
+        st.freeSlots.push_back(slot);
+        s_Stats.transforms = st.slots.size();
+    }
+
+    bool TransformSystem::IsAlive(TransformHandle handle) {
+        const Storage& st = s_Storage;
+        return handle.index < st.generations.size() && st.generations[handle.index] == handle.generation &&
+               st.denseIndex[handle.index] < st.slots.size() && st.slots[st.denseIndex[handle.index]] == handle.index;
+    }
+
+    uint32_t TransformSystem::Resolve(TransformHandle handle) {
+        const Storage& st = s_Storage;
+        if (handle.index >= st.generations.size() || st.generations[handle.index] != handle.generation) {
+            throw std::runtime_error("[TransformSystem] Invalid transform handle");
+        }
+        return st.denseIndex[handle.index];
+    }
+
+    void TransformSystem::Link(uint32_t slot, uint32_t parent) {
+        Storage& st = s_Storage;
+        const uint32_t next = st.firstChild[parent];
+        st.prevSibling[slot] = kNone;
+        st.nextSibling[slot] = next;
+        if (next != kNone) st.prevSibling[next] = slot;
+        st.firstChild[parent] = slot;
+        ++st.childCount[parent];
+        ++st.linkCount;
+    }
+
+    void TransformSystem::Unlink(uint32_t slot, uint32_t parent) {
+        Storage& st = s_Storage;
+        const uint32_t prev = st.prevSibling[slot], next = st.nextSibling[slot];
+        if (prev != kNone) st.nextSibling[prev] = next;
+        else st.firstChild[parent] = next;
+        if (next != kNone) st.prevSibling[next] = prev;
+        st.prevSibling[slot] = st.nextSibling[slot] = kNone;
+        --st.childCount[parent];
+        --st.linkCount;
+    }
+
+    void TransformSystem::CreateBatch(size_t count, const glm::vec3* positions, const glm::vec3* rotations,
+                                      const glm::vec3* scales, TransformHandle* handles) {
+        Storage& st = s_Storage;
+        const size_t reused = std::min(count, st.freeSlots.size());
+        const size_t slotBase = st.denseIndex.size();
+        const size_t slotCount = slotBase + (count - reused);
+        st.denseIndex.resize(slotCount, 0);
+        st.generations.resize(slotCount, 0);
+        st.childCount.resize(slotCount, 0);
+        st.firstChild.resize(slotCount, kNone);
+        st.nextSibling.resize(slotCount, kNone);
+        st.prevSibling.resize(slotCount, kNone);
+
+        const size_t denseBase = st.slots.size();
+        const size_t denseCount = denseBase + count;
+        for (auto* component : {&st.positionX, &st.positionY, &st.positionZ, &st.rotationX, &st.rotationY,
+                                &st.rotationZ, &st.scaleX, &st.scaleY, &st.scaleZ})
+            component->resize(denseCount);
+        st.slots.resize(denseCount);
+        st.world.resize(denseCount, glm::mat4(1.0f));
+        st.local.resize(denseCount, glm::mat4(1.0f));
+        st.dirty.resize(denseCount, 0);
+        st.parentSlot.resize(denseCount, kNone);
+        st.dirtyList.reserve(st.dirtyList.size() + count);
+
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t slot;
+            if (i < reused) {
+                slot = st.freeSlots.back();
+                st.freeSlots.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(slotBase + (i - reused));
+            }
+            const auto dense = static_cast<uint32_t>(denseBase + i);
+            st.denseIndex[slot] = dense;
+            st.slots[dense] = slot;
+            st.positionX[dense] = positions[i].x;
+            st.positionY[dense] = positions[i].y;
+            st.positionZ[dense] = positions[i].z;
+            st.rotationX[dense] = rotations[i].x;
+            st.rotationY[dense] = rotations[i].y;
+            st.rotationZ[dense] = rotations[i].z;
+            st.scaleX[dense] = scales[i].x;
+            st.scaleY[dense] = scales[i].y;
+            st.scaleZ[dense] = scales[i].z;
+            MarkDirty(dense, kDirtyTranslation | kDirtyBasis);
+            handles[i] = TransformHandle{slot, st.generations[slot]};
+        }
+        if (st.linkCount > 0 && count > 0) st.orderDirty = true;
+        s_Stats.transforms = st.slots.size();
+    }
+
+    void TransformSystem::MarkDirty(uint32_t dense, uint8_t flags) {
+        if (!s_Storage.dirty[dense]) s_Storage.dirtyList.push_back(dense);
+        s_Storage.dirty[dense] |= flags;
+    }
+
+    void TransformSystem::SetPosition(TransformHandle handle, const glm::vec3& position) {
+        const uint32_t dense = Resolve(handle);
+        s_Storage.positionX[dense] = position.x;
+        s_Storage.positionY[dense] = position.y;
+        s_Storage.positionZ[dense] = position.z;
+        MarkDirty(dense, kDirtyTranslation);
+    }
+
+    glm::vec3 TransformSystem::GetPosition(TransformHandle handle) {
+        const uint32_t dense = Resolve(handle);
+        return {s_Storage.positionX[dense], s_Storage.positionY[dense], s_Storage.positionZ[dense]};
+    }
+
+    void TransformSystem::SetRotation(TransformHandle handle, const glm::vec3& rotation) {
+        const uint32_t dense = Resolve(handle);
+        s_Storage.rotationX[dense] = rotation.x;
+        s_Storage.rotationY[dense] = rotation.y;
+        s_Storage.rotationZ[dense] = rotation.z;
+        MarkDirty(dense, kDirtyBasis);
+    }
+
+    glm::vec3 TransformSystem::GetRotation(TransformHandle handle) {
+        const uint32_t dense = Resolve(handle);
+        return {s_Storage.rotationX[dense], s_Storage.rotationY[dense], s_Storage.rotationZ[dense]};
+    }
+
+    void TransformSystem::SetScale(TransformHandle handle, const glm::vec3& scale) {
+        const uint32_t dense = Resolve(handle);
+        s_Storage.scaleX[dense] = scale.x;
+        s_Storage.scaleY[dense] = scale.y;
+        s_Storage.scaleZ[dense] = scale.z;
+        MarkDirty(dense, kDirtyBasis);
+    }
+
+    glm::vec3 TransformSystem::GetScale(TransformHandle handle) {
+        const uint32_t dense = Resolve(handle);
+        return {s_Storage.scaleX[dense], s_Storage.scaleY[dense], s_Storage.scaleZ[dense]};
+    }
+
+    void TransformSystem::SetParent(TransformHandle child, TransformHandle parent) {
+        Storage& st = s_Storage;
+        const uint32_t dense = Resolve(child);
+        uint32_t newParent = kNone;
+        if (parent.IsValid()) {
+            Resolve(parent);
+            // 只有已有子节点时才可能成环，此时沿新父节点的祖先链检查
+            const bool hasChildren = st.childCount[child.index] > 0;
+            for (uint32_t slot = parent.index; slot != kNone; slot = st.parentSlot[st.denseIndex[slot]]) {
+                if (slot == child.index) throw std::runtime_error("[TransformSystem] SetParent would create a cycle");
+                if (!hasChildren) break;
+            }
+            newParent = parent.index;
+        }
+
+        uint32_t& current = st.parentSlot[dense];
+        if (current == newParent) return;
+        if (current != kNone) Unlink(child.index, current);
+        if (newParent != kNone) Link(child.index, newParent);
+        current = newParent;
+        st.orderDirty = true;
+        // 根节点的矩阵直接写入世界矩阵、子节点写入局部矩阵，切换后两者都要重算
+        MarkDirty(dense, kDirtyTranslation | kDirtyBasis);
+    }
+
+    TransformHandle TransformSystem::GetParent(TransformHandle handle) {
+        const uint32_t slot = s_Storage.parentSlot[Resolve(handle)];
+        if (slot == kNone) return TransformHandle{};
+        return TransformHandle{slot, s_Storage.generations[slot]};
+    }
+
+    size_t TransformSystem::GetChildCount(TransformHandle handle) {
+        Resolve(handle);
+        return s_Storage.childCount[handle.index];
+    }
+
+    glm::mat4 TransformSystem::GetWorldMatrix(TransformHandle handle) {
+        const Storage& st = s_Storage;
+        const uint32_t dense = Resolve(handle);
+        if (st.dirtyList.empty()) return st.world[dense];
+
+        // 找出自身及祖先中最上面的脏节点，没有时存储的世界矩阵仍是最新的
+        uint32_t top = kNone;
+        for (uint32_t node = dense;; node = st.denseIndex[st.parentSlot[node]]) {
+            if (st.dirty[node]) top = node;
+            if (st.parentSlot[node] == kNone) break;
+        }
+        if (top == kNone) return st.world[dense];
+
+        // 自下而上左乘局部矩阵直到 top，再乘 top 父节点（不脏）的世界矩阵。
+        // 只读不写，可在任意线程调用；脏标记保留，由下一次 Update() 统一传播
+        glm::mat4 world = ComputeLocal(dense);
+        for (uint32_t node = dense; node != top;) {
+            node = st.denseIndex[st.parentSlot[node]];
+            glm::mat4 product;
+            Multiply(ComputeLocal(node), world, product);
+            world = product;
+        }
+        if (st.parentSlot[top] != kNone) {
+            glm::mat4 product;
+            Multiply(st.world[st.denseIndex[st.parentSlot[top]]], world, product);
+            world = product;
+        }
+        return world;
+    }
+
+    uint32_t TransformSystem::GetSimdWidth() {
+#if defined(RRENDER_TRANSFORM_SSE) && defined(__AVX2__)
+        return s_SimdEnabled ? 8 : 1;
+#elif defined(RRENDER_TRANSFORM_SSE)
+        return s_SimdEnabled ? 4 : 1;
+#else
+        return 1;
+#endif
+    }
+
+    glm::mat4 TransformSystem::ComposeMatrix(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
+        const glm::vec3 radians = rotation * kDegToRad;
+        const glm::vec3 c(std::cos(radians.x), std::cos(radians.y), std::cos(radians.z));
+        const glm::vec3 s(std::sin(radians.x), std::sin(radians.y), std::sin(radians.z));
+        return Compose(position, c, s, scale);
+    }
+
+    void TransformSystem::DecomposeMatrix(const glm::mat4& matrix, glm::vec3& position, glm::vec3& rotation,
+                                          glm::vec3& scale) {
+        position = glm::vec3(matrix[3]);
+        glm::vec3 axes[3] = {glm::vec3(matrix[0]), glm::vec3(matrix[1]), glm::vec3(matrix[2])};
+        scale = glm::vec3(glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]));
+        // 镜像时把负号归到 x 轴缩放上
+        if (glm::dot(glm::cross(axes[0], axes[1]), axes[2]) < 0.0f) scale.x = -scale.x;
+        for (int k = 0; k < 3; ++k) {
+            if (scale[k] != 0.0f) axes[k] /= scale[k];
+        }
+
+        // Compose 的旋转为 Rx · Ry · Rz：第三列为 (sy, -sx·cy, cx·cy)，第一、二列首行为 cy·cz 与 -cy·sz
+        const float sy = std::clamp(axes[2].x, -1.0f, 1.0f);
+        glm::vec3 radians(0.0f, std::asin(sy), 0.0f);
+        if (std::abs(sy) < 0.9999f) {
+            radians.x = std::atan2(-axes[2].y, axes[2].z);
+            radians.z = std::atan2(-axes[1].x, axes[0].x);
+        } else {
+            // 万向锁：x 与 z 只能确定其组合，取 z = 0
+            radians.x = std::atan2(axes[1].z, axes[1].y);
+        }
+        rotation = radians / kDegToRad;
+    }
+
+    glm::mat4 TransformSystem::ComputeLocal(uint32_t dense) {
+        const Storage& st = s_Storage;
+        return ComposeMatrix({st.positionX[dense], st.positionY[dense], st.positionZ[dense]},
+                             {st.rotationX[dense], st.rotationY[dense], st.rotationZ[dense]},
+                             {st.scaleX[dense], st.scaleY[dense], st.scaleZ[dense]});
+    }
+
+    void TransformSystem::ComputeBatch(const uint32_t* batch, size_t count, glm::mat4* out) {
+        const Storage& st = s_Storage;
+        size_t i = 0;
+#ifdef RRENDER_TRANSFORM_SSE
+        if (s_SimdEnabled) {
+            const float* pools[9] = {st.positionX.data(), st.positionY.data(), st.positionZ.data(),
+                                     st.rotationX.data(), st.rotationY.data(), st.rotationZ.data(),
+                                     st.scaleX.data(), st.scaleY.data(), st.scaleZ.data()};
+#ifdef __AVX2__
+            for (; i + Avx::kWidth <= count; i += Avx::kWidth)
+                ComputeSimdBatch<Avx>(pools, out, batch + i);
+#endif
+            for (; i + Sse::kWidth <= count; i += Sse::kWidth)
+                ComputeSimdBatch<Sse>(pools, out, batch + i);
+        }
+#endif
+        for (; i < count; ++i) out[batch[i]] = ComputeLocal(batch[i]);
+    }
+
+    void TransformSystem::ComputeBatchParallel(const std::vector<uint32_t>& batch, glm::mat4* out) {
+        const size_t count = batch.size();
+        if (s_ThreadCount == 1 || count < 2 * kComputeChunk) {
+            ComputeBatch(batch.data(), count, out);
+            return;
+        }
+        // 以 8 个为单位拆分，各段起点保持 SIMD 宽度对齐；各段写入 out 中互不重叠的位置
+        constexpr size_t kGroup = 8;
+        core::JobSystem::ParallelFor((count + kGroup - 1) / kGroup, [&](size_t begin, size_t end) {
+            const size_t first = begin * kGroup;
+            ComputeBatch(batch.data() + first, std::min(count, end * kGroup) - first, out);
+        }, kComputeChunk / kGroup);
+    }
+
+    void TransformSystem::Rebuild() {
+        Storage& st = s_Storage;
+        const uint32_t count = static_cast<uint32_t>(st.slots.size());
+        st.orderDirty = false;
+        st.levels.assign(1, 0);
+        if (st.linkCount == 0) {
+            st.levels.push_back(count);
+            return;
+        }
+        ++s_Stats.rebuilds;
+
+        // 广度优先：根节点保持原有相对顺序，之后逐层追加，同一父节点的子节点相邻
+        std::vector<uint32_t> order;
+        order.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (st.parentSlot[i] == kNone) order.push_back(i);
+        }
+        for (size_t head = 0; head < order.size();) {
+            const size_t levelEnd = order.size();
+            st.levels.push_back(static_cast<uint32_t>(levelEnd));
+            for (; head < levelEnd; ++head) {
+                for (uint32_t c = st.firstChild[st.slots[order[head]]]; c != kNone; c = st.nextSibling[c])
+                    order.push_back(st.denseIndex[c]);
+            }
+        }
+
+        ForEachPool(st, [&](auto& pool) {
+            std::decay_t<decltype(pool)> permuted(count);
+            for (uint32_t i = 0; i < count; ++i) permuted[i] = pool[order[i]];
+            pool.swap(permuted);
+        });
+        st.parent.resize(count);
+        for (uint32_t i = 0; i < count; ++i) st.denseIndex[st.slots[i]] = i;
+        for (uint32_t i = 0; i < count; ++i)
+            st.parent[i] = st.parentSlot[i] == kNone ? kNone : st.denseIndex[st.parentSlot[i]];
+
+        st.dirtyList.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (st.dirty[i]) st.dirtyList.push_back(i);
+        }
+    }
+
+    void TransformSystem::Update() {
+        const auto start = std::chrono::steady_clock::now();
+        Storage& st = s_Storage;
+        if (st.orderDirty) Rebuild();
+        const bool hierarchy = st.linkCount > 0;
+        const size_t size = st.slots.size();
+        if (hierarchy) st.changed.assign(size, 0);
+
+        // 过滤过期与重复项，只改了位置的直接重写平移列，其余按下标排序后批量重算
+        // （整体遍历修改时脏列表本身有序，批内下标连续，可直接加载）。
+        // 根节点的结果即世界矩阵，子节点的结果为局部矩阵，随后逐层乘上父节点的世界矩阵
+        st.batch.resize(st.dirtyList.size());
+        st.childBatch.resize(st.dirtyList.size());
+        // 无层级时有变化的就是脏节点，有层级时传播结束后按 changed 收集
+        st.moved.clear();
+        size_t rootCount = 0, childCount = 0, translated = 0;
+        for (uint32_t dense : st.dirtyList) {
+            if (dense >= size) continue;
+            const uint8_t flags = st.dirty[dense];
+            if (!flags) continue;
+            st.dirty[dense] = 0;
+            const bool isChild = hierarchy && st.parentSlot[dense] != kNone;
+            if (hierarchy) st.changed[dense] = 1;
+            else st.moved.push_back(TransformHandle{st.slots[dense], st.generations[st.slots[dense]]});
+            if (flags & kDirtyBasis) {
+                if (isChild) st.childBatch[childCount++] = dense;
+                else st.batch[rootCount++] = dense;
+            } else {
+                glm::mat4& target = isChild ? st.local[dense] : st.world[dense];
+                target[3] = glm::vec4(st.positionX[dense], st.positionY[dense], st.positionZ[dense], 1.0f);
+                ++translated;
+            }
+        }
+        st.batch.resize(rootCount);
+        st.childBatch.resize(childCount);
+        st.dirtyList.clear();
+        if (!std::is_sorted(st.batch.begin(), st.batch.end())) std::sort(st.batch.begin(), st.batch.end());
+        if (!std::is_sorted(st.childBatch.begin(), st.childBatch.end()))
+            std::sort(st.childBatch.begin(), st.childBatch.end());
+        ComputeBatchParallel(st.batch, st.world.data());
+        ComputeBatchParallel(st.childBatch, st.local.data());
+
+        // 逐层传播：自身或父节点本次有变化的节点重算世界矩阵，同层节点互不依赖，可以并行
+        size_t propagated = 0;
+        if (hierarchy && rootCount + childCount + translated > 0) {
+            auto propagate = [&st](uint32_t begin, uint32_t end) {
+                size_t n = 0;
+                for (uint32_t i = begin; i < end; ++i) {
+                    const uint32_t p = st.parent[i];
+                    if (!(st.changed[i] | st.changed[p])) continue;
+                    Multiply(st.world[p], st.local[i], st.world[i]);
+                    st.changed[i] = 1;
+                    ++n;
+                }
+                return n;
+            };
+            for (size_t level = 1; level + 1 < st.levels.size(); ++level) {
+                const uint32_t begin = st.levels[level], end = st.levels[level + 1];
+                if (s_ThreadCount == 1 || end - begin < 2 * kPropagateChunk) {
+                    propagated += propagate(begin, end);
+                    continue;
+                }
+                std::atomic<size_t> levelCount{0};
+                core::JobSystem::ParallelFor(end - begin, [&](size_t first, size_t last) {
+                    levelCount += propagate(begin + static_cast<uint32_t>(first), begin + static_cast<uint32_t>(last));
+                }, kPropagateChunk);
+                propagated += levelCount;
+            }
+        }
+        if (hierarchy && rootCount + childCount + translated > 0) {
+            for (uint32_t i = 0; i < size; ++i) {
+                if (st.changed[i]) st.moved.push_back(TransformHandle{st.slots[i], st.generations[st.slots[i]]});
+            }
+        }
+
+        s_Stats.updated = rootCount + childCount + translated;
+        s_Stats.propagated = propagated;
+        s_Stats.totalUpdated += rootCount + childCount + translated;
+        s_Stats.levels = hierarchy ? st.levels.size() - 1 : (size > 0 ? 1 : 0);
+        s_Stats.updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace scene
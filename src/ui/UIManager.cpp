@@ -5,7 +5,17 @@
 
 #include "graphics/Light.h"
 #include "scene/Entity.h"
+#include "scene/TransformSystem.h"
 #include "resource/ResourceManager.h"
+#include "graphics/TextureUploader.h"
+#include "graphics/Frustum.h"
+#include "graphics/Meshlet.h"
+#include "graphics/OcclusionCuller.h"
+#include "graphics/RenderQueue.h"
+#include "core/InputManager.h"
+#include "utils/Time.h"
+#include <algorithm>
+#include <chrono>
 
 namespace ui {
 
@@ -66,6 +76,137 @@ void UIManager::RenderUI(const std::shared_ptr<graphics::Camera>& camera,
     ImGui::Text("Camera Pos: %.2f %.2f %.2f", pos.x, pos.y, pos.z);
     ImGui::Text("Camera Front: %.2f %.2f %.2f", front.x, front.y, front.z);
 
+    // 资源加载与纹理流式上传
+    if (ImGui::CollapsingHeader("Resources")) {
+        const auto& upload = graphics::TextureUploader::GetStats();
+        ImGui::Text("Pending loads: %zu", core::ResourceManager::GetPendingCount());
+        ImGui::Text("Texture upload: %.2f MB pending, %.1f KB last frame, %.1f KB peak",
+                    upload.pendingBytes / (1024.0 * 1024.0), upload.lastFrameBytes / 1024.0, upload.peakFrameBytes / 1024.0);
+        ImGui::Text("Textures streamed: %zu, skipped frames: %zu", upload.texturesCompleted, upload.skippedFrames);
+        int budgetKB = static_cast<int>(graphics::TextureUploader::GetFrameBudget() / 1024);
+        if (ImGui::SliderInt("Upload budget (KB/frame)", &budgetKB, 256, 32768)) {
+            graphics::TextureUploader::SetFrameBudget(static_cast<size_t>(budgetKB) * 1024);
+        }
+
+        // 显存预算与驱逐
+        const auto& gpu = core::ResourceManager::GetGpuMemoryStats();
+        constexpr double kMB = 1024.0 * 1024.0;
+        ImGui::Text("GPU memory: %.1f MB (peak %.1f MB), textures %.1f MB, meshes %.1f MB",
+                    gpu.currentBytes / kMB, gpu.peakBytes / kMB, gpu.textureBytes / kMB, gpu.meshBytes / kMB);
+        ImGui::Text("Resident: %zu textures, %zu models; evicted: %zu textures, %zu models", gpu.residentTextures,
+                    gpu.residentModels, gpu.evictedTextures, gpu.evictedModels);
+        ImGui::Text("Evictions: %zu (%.1f MB), reloads: %zu", gpu.evictions, gpu.evictedBytes / kMB, gpu.reloads);
+        int gpuBudgetMB = static_cast<int>(core::ResourceManager::GetGpuBudget() / (1024 * 1024));
+        if (ImGui::SliderInt("GPU budget (MB, 0 = off)", &gpuBudgetMB, 0, 2048)) {
+            core::ResourceManager::SetGpuBudget(static_cast<size_t>(gpuBudgetMB) * 1024 * 1024);
+        }
+    }
+
+    // 帧耗时与提交量（统计包含本帧所有绘制通道）
+    if (ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const auto& draw = graphics::Mesh::GetDrawStats();
+        ImGui::Text("Frame: %.2f ms, %zu entities", utils::Time::GetDeltaTime() * 1000.0f, scene->GetEntities().size());
+        ImGui::Text("Draw calls: %zu, triangles: %zu", draw.drawCalls, draw.triangles);
+        const auto& transforms = scene::TransformSystem::GetStats();
+        ImGui::Text("Transforms: %zu in %zu levels, updated %zu + %zu propagated (%.3f ms)", transforms.transforms,
+                    transforms.levels, transforms.updated, transforms.propagated, transforms.updateMs);
+
+        bool sortDraws = graphics::RenderQueue::IsSortEnabled();
+        if (ImGui::Checkbox("Sort draws", &sortDraws)) graphics::RenderQueue::SetSortEnabled(sortDraws);
+        const auto& queue = graphics::RenderQueue::GetStats();
+        const auto& binds = graphics::CommandExecutor::GetStats();
+        ImGui::Text("Queue: %zu items, %zu sort passes (build %.3f ms, sort %.3f ms)", queue.items, queue.sortPasses,
+                    queue.buildMs, queue.sortMs);
+        ImGui::Text("Binds: %zu issued, %zu saved (program %zu, texture %zu, mesh %zu, model %zu)", binds.GetIssued(),
+                    binds.GetSaved(), binds.programs.skipped, binds.textures.skipped, binds.meshes.skipped,
+                    binds.drawData.skipped);
+
+        bool lodEnabled = scene::Entity::IsLodEnabled();
+        if (ImGui::Checkbox("LOD", &lodEnabled)) scene::Entity::SetLodEnabled(lodEnabled);
+        float threshold = scene::Entity::GetLodThreshold() * 1000.0f;
+        if (ImGui::SliderFloat("LOD error (px @1000)", &threshold, 0.1f, 20.0f, "%.1f"))
+            scene::Entity::SetLodThreshold(threshold / 1000.0f);
+        float hysteresis = scene::Entity::GetLodHysteresis();
+        if (ImGui::SliderFloat("LOD hysteresis", &hysteresis, 0.0f, 0.9f, "%.2f"))
+            scene::Entity::SetLodHysteresis(hysteresis);
+        size_t lodHistogram[4] = {};
+        for (const auto& entity : scene->GetEntities()) lodHistogram[std::min<uint32_t>(entity->GetLod(), 3)]++;
+        ImGui::Text("Entities per LOD: %zu / %zu / %zu / %zu", lodHistogram[0], lodHistogram[1], lodHistogram[2],
+                    lodHistogram[3]);
+    }
+
+    // 视锥剔除（实体级别每帧一次，子网格统计包含所有绘制通道）
+    if (ImGui::CollapsingHeader("Frustum Culling")) {
+        bool enabled = graphics::FrustumCuller::IsEnabled();
+        if (ImGui::Checkbox("Enabled##frustum", &enabled)) graphics::FrustumCuller::SetEnabled(enabled);
+        bool simd = graphics::FrustumCuller::IsSimdEnabled();
+        if (ImGui::Checkbox("SIMD##frustum", &simd)) graphics::FrustumCuller::SetSimdEnabled(simd);
+        const auto& frustum = graphics::FrustumCuller::GetStats();
+        ImGui::Text("Entities: %zu / %zu visible, %zu culled (%.3f ms)", frustum.visible, frustum.tested,
+                    frustum.culled, frustum.cullMs);
+        ImGui::Text("Submeshes: %zu / %zu culled", frustum.meshesCulled, frustum.meshesTested);
+        const auto& tree = scene->GetSpatialIndex();
+        ImGui::Text("Spatial index: %zu proxies, height %d, %zu reinserts", tree.GetProxyCount(), tree.GetHeight(),
+                    tree.GetReinsertCount());
+    }
+
+    // 遮挡剔除（CPU 深度缓冲）
+    if (ImGui::CollapsingHeader("Occlusion Culling")) {
+        bool enabled = graphics::OcclusionCuller::IsEnabled();
+        if (ImGui::Checkbox("Enabled##occlusion", &enabled)) graphics::OcclusionCuller::SetEnabled(enabled);
+        bool simd = graphics::OcclusionCuller::IsSimdEnabled();
+        if (ImGui::Checkbox("SIMD##occlusion", &simd)) graphics::OcclusionCuller::SetSimdEnabled(simd);
+        const auto& occlusion = graphics::OcclusionCuller::GetStats();
+        const auto& buffer = scene->GetOcclusionBuffer();
+        ImGui::Text("Occluders: %zu, %zu triangles at %ux%u (%.3f ms)", occlusion.occluders, occlusion.triangles,
+                    buffer.GetWidth(), buffer.GetHeight(), occlusion.rasterMs);
+        ImGui::Text("Entities: %zu / %zu occluded, %zu draw calls saved (%.3f ms)", occlusion.occluded,
+                    occlusion.tested, occlusion.drawCallsSaved, occlusion.testMs);
+    }
+
+    // 射线拾取：光标可见时左键点击 UI 窗口以外的区域（结果不持有实体）
+    static scene::Scene::PickResult pick;
+    static size_t pickedIndex = 0;
+    static double pickUs = 0.0;
+    static bool picked = false;
+    GLFWwindow* glfwWindow = glfwGetCurrentContext();
+    if (glfwWindow && glfwGetInputMode(glfwWindow, GLFW_CURSOR) == GLFW_CURSOR_NORMAL &&
+        ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGui::GetIO().WantCaptureMouse) {
+        const auto [mouseX, mouseY] = core::InputManager::GetMousePosition();
+        const ImVec2 display = ImGui::GetIO().DisplaySize;
+        const auto [origin, direction] = camera->ScreenPointToRay(static_cast<float>(mouseX),
+                                                                  static_cast<float>(mouseY), display.x, display.y);
+        const auto start = std::chrono::steady_clock::now();
+        pick = scene->Pick(origin, direction);
+        pickUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        const auto& entities = scene->GetEntities();
+        picked = pick.entity != nullptr;
+        pickedIndex = std::find(entities.begin(), entities.end(), pick.entity) - entities.begin();
+        pick.entity.reset();
+    }
+    if (ImGui::CollapsingHeader("Picking")) {
+        ImGui::TextUnformatted("Tab shows the cursor, then left-click an object");
+        if (picked) {
+            ImGui::Text("Entity %zu, mesh %u, triangle %u (%.1f us)", pickedIndex, pick.mesh, pick.triangle, pickUs);
+            ImGui::Text("Barycentric: %.3f %.3f, distance %.3f", pick.barycentric.x, pick.barycentric.y, pick.distance);
+            ImGui::Text("Hit: %.2f %.2f %.2f", pick.position.x, pick.position.y, pick.position.z);
+        } else {
+            ImGui::Text("No hit (%.1f us)", pickUs);
+        }
+    }
+
+    // 逐簇剔除（统计包含本帧所有绘制通道）
+    if (ImGui::CollapsingHeader("Meshlet Culling")) {
+        bool enabled = graphics::MeshletCuller::IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled)) graphics::MeshletCuller::SetEnabled(enabled);
+        bool backface = graphics::MeshletCuller::IsBackfaceCullingEnabled();
+        if (ImGui::Checkbox("Backface cones", &backface)) graphics::MeshletCuller::SetBackfaceCulling(backface);
+        const auto& cull = graphics::MeshletCuller::GetStats();
+        ImGui::Text("Meshlets: %zu / %zu visible, %zu draw ranges", cull.visibleMeshlets, cull.meshlets, cull.drawRanges);
+        ImGui::Text("Triangles: %zu / %zu visible (frustum -%zu, backface -%zu)", cull.visibleTriangles,
+                    cull.triangles, cull.frustumCulledTriangles, cull.backfaceCulledTriangles);
+    }
+
     // 光源
     auto& lights = scene->GetLights();
     for (size_t i = 0; i < lights.size(); ++i) {
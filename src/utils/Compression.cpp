@@ -0,0 +1,120 @@
+#include "utils/Compression.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace utils {
+
+namespace {
+
+    constexpr size_t kMinMatch = 4;
+    constexpr size_t kMaxOffset = 65535;
+    constexpr int kHashBits = 16;
+    // 末尾若干字节只作为字面量，匹配扩展不越界
+    constexpr size_t kTailLiterals = 12;
+
+    inline uint32_t Read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t HashSequence(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - kHashBits);
+    }
+
+    void WriteLength(std::vector<uint8_t>& out, size_t length) {
+        for (; length >= 255; length -= 255) out.push_back(255);
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    void EmitLiterals(std::vector<uint8_t>& out, const uint8_t* literals, size_t count, size_t matchCode) {
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(count, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        if (count >= 15) WriteLength(out, count - 15);
+        out.insert(out.end(), literals, literals + count);
+    }
+
+} // namespace
+
+    std::vector<uint8_t> LzCompress(const void* data, size_t size) {
+        const uint8_t* in = static_cast<const uint8_t*>(data);
+        std::vector<uint8_t> out;
+        out.reserve(size + size / 255 + 16);
+
+        std::vector<size_t> table(size_t(1) << kHashBits, SIZE_MAX);
+        size_t anchor = 0;
+        size_t i = 0;
+        const size_t limit = size > kTailLiterals ? size - kTailLiterals : 0;
+        while (i < limit) {
+            const uint32_t sequence = Read32(in + i);
+            const uint32_t h = HashSequence(sequence);
+            const size_t candidate = table[h];
+            table[h] = i;
+            if (candidate == SIZE_MAX || i - candidate > kMaxOffset || Read32(in + candidate) != sequence) {
+                ++i;
+                continue;
+            }
+
+            size_t length = kMinMatch;
+            while (i + length < size - kTailLiterals / 2 && in[candidate + length] == in[i + length]) ++length;
+
+            const size_t matchCode = length - kMinMatch;
+            EmitLiterals(out, in + anchor, i - anchor, matchCode);
+            const size_t offset = i - candidate;
+            out.push_back(static_cast<uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+            if (matchCode >= 15) WriteLength(out, matchCode - 15);
+
+            i += length;
+            anchor = i;
+        }
+        EmitLiterals(out, in + anchor, size - anchor, 0);
+        return out;
+    }
+
+    bool LzDecompress(const void* data, size_t size, void* output, size_t outputSize) {
+        const uint8_t* ip = static_cast<const uint8_t*>(data);
+        const uint8_t* const inputEnd = ip + size;
+        uint8_t* const outputBegin = static_cast<uint8_t*>(output);
+        uint8_t* op = outputBegin;
+        uint8_t* const outputEnd = op + outputSize;
+
+        auto readLength = [&](size_t& length) {
+            uint8_t byte;
+            do {
+                if (ip >= inputEnd) return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (ip < inputEnd) {
+            const uint8_t token = *ip++;
+            size_t literalCount = token >> 4;
+            if (literalCount == 15 && !readLength(literalCount)) return false;
+            if (literalCount > static_cast<size_t>(inputEnd - ip) || literalCount > static_cast<size_t>(outputEnd - op))
+                return false;
+            std::memcpy(op, ip, literalCount);
+            ip += literalCount;
+            op += literalCount;
+            if (ip == inputEnd) break;
+
+            // 匹配段
+            if (inputEnd - ip < 2) return false;
+            const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - outputBegin)) return false;
+            size_t length = token & 0x0F;
+            if (length == 15 && !readLength(length)) return false;
+            length += kMinMatch;
+            if (length > static_cast<size_t>(outputEnd - op)) return false;
+            // 偏移可能小于长度（重复模式），逐字节拷贝
+            const uint8_t* match = op - offset;
+            for (size_t k = 0; k < length; ++k) op[k] = match[k];
+            op += length;
+        }
+        return op == outputEnd;
+    }
+
+} // namespace utils
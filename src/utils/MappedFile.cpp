@@ -0,0 +1,129 @@
+#include "utils/MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils {
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::string& path) {
+        // 允许其他句柄写入：缓存命中后会就地改写记录的源文件时间戳
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Failed to open file: " + path);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to query file size: " + path);
+        }
+
+        m_FileHandle = file;
+        m_Size = static_cast<size_t>(size.QuadPart);
+        m_Opened = true;
+        if (m_Size == 0) return; // 空文件无法映射，保持 Data() 为空
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            Close();
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        m_MappingHandle = mapping;
+
+        m_Data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data) {
+            Close();
+            throw std::runtime_error("Failed to map file view: " + path);
+        }
+    }
+
+    void MappedFile::Close() {
+        if (m_Data) UnmapViewOfFile(m_Data);
+        if (m_MappingHandle) CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+        if (m_FileHandle) CloseHandle(static_cast<HANDLE>(m_FileHandle));
+        m_Data = nullptr;
+        m_MappingHandle = m_FileHandle = nullptr;
+        m_Size = 0;
+        m_Opened = false;
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Failed to open file: " + path);
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to query file size: " + path);
+        }
+
+        m_Size = static_cast<size_t>(st.st_size);
+        m_Opened = true;
+        if (m_Size > 0) {
+            void* ptr = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            ::madvise(ptr, m_Size, MADV_SEQUENTIAL);
+            m_Data = static_cast<const char*>(ptr);
+        }
+        // 映射建立后即可关闭描述符
+        ::close(fd);
+    }
+
+    void MappedFile::Close() {
+        if (m_Data) ::munmap(const_cast<char*>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Opened = false;
+    }
+
+#endif
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            m_Opened = other.m_Opened;
+#ifdef _WIN32
+            m_FileHandle = other.m_FileHandle;
+            m_MappingHandle = other.m_MappingHandle;
+            other.m_FileHandle = other.m_MappingHandle = nullptr;
+#endif
+            other.m_Data = nullptr;
+            other.m_Size = 0;
+            other.m_Opened = false;
+        }
+        return *this;
+    }
+
+} // namespace utils
@@ -0,0 +1,184 @@
+#include "utils/PackFile.h"
+#include "utils/Compression.h"
+#include "utils/Hash.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t namesOffset;
+    };
+
+    struct PackEntryRecord {
+        uint64_t pathHash;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t size;
+        uint32_t compression;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(PackHeader) == 32, "PackHeader layout changed");
+    static_assert(sizeof(PackEntryRecord) == 48, "PackEntryRecord layout changed");
+
+    // 与 .rtex/.rmesh 内部对齐一致，条目映射后可直接作为顶点/纹理数据使用
+    constexpr size_t kDataAlignment = 16;
+
+} // namespace
+
+    PackFile::WriteStats PackFile::Write(const std::string& packPath, const std::vector<Input>& inputs) {
+        WriteStats stats;
+        std::vector<PackEntryRecord> records;
+        std::string names;
+
+        const std::string tempPath = packPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Failed to create pack file: " + tempPath);
+
+            PackHeader header{};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            uint64_t offset = sizeof(header);
+
+            for (const auto& input : inputs) {
+                MappedFile source(input.path);
+                PackEntryRecord record{};
+                record.pathHash = HashString(input.key);
+                record.size = source.Size();
+                record.nameOffset = static_cast<uint32_t>(names.size());
+                record.nameLength = static_cast<uint32_t>(input.key.size());
+                names += input.key;
+
+                const char* data = source.Data();
+                size_t storedSize = source.Size();
+                std::vector<uint8_t> compressed;
+                if (input.compress && source.Size() > 0) {
+                    compressed = LzCompress(source.Data(), source.Size());
+                    if (compressed.size() < source.Size()) {
+                        record.compression = static_cast<uint32_t>(Compression::Lz);
+                        data = reinterpret_cast<const char*>(compressed.data());
+                        storedSize = compressed.size();
+                    }
+                }
+
+                const uint64_t aligned = (offset + kDataAlignment - 1) & ~static_cast<uint64_t>(kDataAlignment - 1);
+                static const char kPadding[kDataAlignment] = {};
+                file.write(kPadding, static_cast<std::streamsize>(aligned - offset));
+                record.offset = aligned;
+                record.storedSize = storedSize;
+                if (storedSize > 0) file.write(data, static_cast<std::streamsize>(storedSize));
+                offset = aligned + storedSize;
+                records.push_back(record);
+
+                ++stats.fileCount;
+                stats.originalBytes += source.Size();
+                stats.storedBytes += storedSize;
+            }
+
+            std::sort(records.begin(), records.end(), [](const PackEntryRecord& a, const PackEntryRecord& b) {
+                return a.pathHash < b.pathHash;
+            });
+            header.magic = kMagic;
+            header.version = kVersion;
+            header.entryCount = static_cast<uint32_t>(records.size());
+            header.indexOffset = offset;
+            header.namesOffset = offset + records.size() * sizeof(PackEntryRecord);
+            file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(PackEntryRecord)));
+            file.write(names.data(), static_cast<std::streamsize>(names.size()));
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!file)
+                throw std::runtime_error("Failed to write pack file: " + tempPath);
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, packPath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Failed to replace pack file: " + packPath);
+        }
+        return stats;
+    }
+
+    PackFile::PackFile(const std::string& packPath)
+        : m_Path(packPath), m_File(packPath) {
+        std::error_code ec;
+        const auto time = fs::last_write_time(packPath, ec);
+        if (!ec) m_ModifiedTime = static_cast<int64_t>(time.time_since_epoch().count());
+        const char* base = m_File.Data();
+        const size_t size = m_File.Size();
+
+        PackHeader header{};
+        if (size < sizeof(header))
+            throw std::runtime_error("Pack file too small: " + packPath);
+        std::memcpy(&header, base, sizeof(header));
+        if (header.magic != kMagic || header.version != kVersion)
+            throw std::runtime_error("Unsupported pack file: " + packPath);
+        if (header.indexOffset > size || header.namesOffset > size ||
+            header.entryCount > (size - header.indexOffset) / sizeof(PackEntryRecord))
+            throw std::runtime_error("Corrupt pack index: " + packPath);
+
+        m_Entries.resize(header.entryCount);
+        for (uint32_t i = 0; i < header.entryCount; ++i) {
+            PackEntryRecord record;
+            std::memcpy(&record, base + header.indexOffset + i * sizeof(PackEntryRecord), sizeof(record));
+            // 以减法比较，避免损坏的偏移相加溢出；未压缩条目直接映射，两个大小必须一致；
+            // 压缩条目解压时按 size 分配，不能超过压缩数据可能展开的上限（storedSize 不超过文件大小，乘法不会溢出）
+            const uint64_t namesSize = size - header.namesOffset;
+            if (record.offset > size || record.storedSize > size - record.offset ||
+                record.nameOffset > namesSize || record.nameLength > namesSize - record.nameOffset ||
+                record.compression > static_cast<uint32_t>(Compression::Lz) ||
+                (record.compression == static_cast<uint32_t>(Compression::None) && record.size != record.storedSize) ||
+                (record.compression == static_cast<uint32_t>(Compression::Lz) &&
+                 record.size > record.storedSize * kLzMaxExpansion))
+                throw std::runtime_error("Corrupt pack entry: " + packPath);
+
+            Entry& entry = m_Entries[i];
+            entry.pathHash = record.pathHash;
+            entry.offset = record.offset;
+            entry.storedSize = record.storedSize;
+            entry.size = record.size;
+            entry.compression = static_cast<Compression>(record.compression);
+            entry.path.assign(base + header.namesOffset + record.nameOffset, record.nameLength);
+        }
+    }
+
+    const PackFile::Entry* PackFile::Find(const std::string& key) const {
+        const uint64_t hash = HashString(key);
+        auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), hash,
+                                   [](const Entry& entry, uint64_t value) { return entry.pathHash < value; });
+        // 哈希冲突时逐个比较路径
+        for (; it != m_Entries.end() && it->pathHash == hash; ++it) {
+            if (it->path == key) return &*it;
+        }
+        return nullptr;
+    }
+
+    FileView PackFile::Read(const std::shared_ptr<const PackFile>& self, const Entry& entry) {
+        const char* stored = self->m_File.Data() + entry.offset;
+        if (entry.compression == Compression::None)
+            return FileView(stored, static_cast<size_t>(entry.size), self);
+
+        auto buffer = std::make_shared<std::vector<char>>(static_cast<size_t>(entry.size));
+        if (!LzDecompress(stored, static_cast<size_t>(entry.storedSize), buffer->data(), buffer->size()))
+            throw std::runtime_error("Corrupt pack entry " + entry.path + " in " + self->m_Path);
+        return FileView(buffer->data(), buffer->size(), buffer);
+    }
+
+} // namespace utils
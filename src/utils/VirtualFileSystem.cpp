@@ -0,0 +1,140 @@
+#include "utils/VirtualFileSystem.h"
+#include "project_root_config.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+    using MountList = std::vector<std::shared_ptr<const PackFile>>;
+
+    // 挂载列表写时复制：读取方经 std::atomic_load 取得快照（标准库以内部锁实现，临界区只有引用计数），
+    // 修改方另由 s_MountMutex 串行化，并发挂载不会丢失资源包
+    std::shared_ptr<const MountList> VirtualFileSystem::s_Mounts = std::make_shared<const MountList>();
+    std::mutex VirtualFileSystem::s_MountMutex;
+    std::atomic<bool> VirtualFileSystem::s_LooseFilesEnabled{true};
+    std::atomic<size_t> VirtualFileSystem::s_PackReads{0};
+    std::atomic<size_t> VirtualFileSystem::s_LooseReads{0};
+    std::atomic<size_t> VirtualFileSystem::s_DecompressedBytes{0};
+
+    std::shared_ptr<const MountList> VirtualFileSystem::GetMounts() {
+        return std::atomic_load(&s_Mounts);
+    }
+
+    bool VirtualFileSystem::Mount(const std::string& packPath) {
+        if (!fs::exists(packPath)) return false;
+        auto pack = std::make_shared<const PackFile>(packPath);
+
+        std::lock_guard<std::mutex> lock(s_MountMutex);
+        auto mounts = std::make_shared<MountList>();
+        mounts->push_back(std::move(pack));
+        const auto current = GetMounts();
+        mounts->insert(mounts->end(), current->begin(), current->end());
+        std::atomic_store(&s_Mounts, std::shared_ptr<const MountList>(std::move(mounts)));
+        return true;
+    }
+
+    void VirtualFileSystem::UnmountAll() {
+        // 已打开的视图仍持有各自的资源包，映射在视图释放后才解除
+        std::lock_guard<std::mutex> lock(s_MountMutex);
+        std::atomic_store(&s_Mounts, std::make_shared<const MountList>());
+    }
+
+    std::string VirtualFileSystem::GetKey(const std::string& path) {
+        static const std::string root = fs::path(PROJECT_ROOT).lexically_normal().generic_string();
+        std::string key = fs::path(path).lexically_normal().generic_string();
+        if (key.size() > root.size() && key.compare(0, root.size(), root) == 0 && key[root.size()] == '/')
+            key.erase(0, root.size() + 1);
+        return key;
+    }
+
+    bool VirtualFileSystem::Exists(const std::string& path) {
+        const auto mounts = GetMounts();
+        if (!mounts->empty()) {
+            const std::string key = GetKey(path);
+            for (const auto& pack : *mounts) {
+                if (pack->Find(key)) return true;
+            }
+        }
+        std::error_code ec;
+        return s_LooseFilesEnabled && fs::exists(path, ec);
+    }
+
+    bool VirtualFileSystem::GetStamp(const std::string& path, FileStamp& stamp) {
+        const auto mounts = GetMounts();
+        if (!mounts->empty()) {
+            const std::string key = GetKey(path);
+            for (const auto& pack : *mounts) {
+                if (const PackFile::Entry* entry = pack->Find(key)) {
+                    stamp.size = entry->size;
+                    stamp.mtime = pack->GetModifiedTime();
+                    return true;
+                }
+            }
+        }
+        if (!s_LooseFilesEnabled) return false;
+
+        std::error_code ec;
+        stamp.size = fs::file_size(path, ec);
+        if (ec) return false;
+        const auto time = fs::last_write_time(path, ec);
+        if (ec) return false;
+        stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    bool VirtualFileSystem::PatchLooseFile(const std::string& path, uint64_t offset, const void* data, size_t size) {
+        if (!s_LooseFilesEnabled) return false;
+        const auto mounts = GetMounts();
+        if (!mounts->empty()) {
+            const std::string key = GetKey(path);
+            for (const auto& pack : *mounts) {
+                if (pack->Find(key)) return false;
+            }
+        }
+
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) return false;
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return static_cast<bool>(file);
+    }
+
+    FileView VirtualFileSystem::Open(const std::string& path) {
+        const auto mounts = GetMounts();
+        if (!mounts->empty()) {
+            const std::string key = GetKey(path);
+            for (const auto& pack : *mounts) {
+                if (const PackFile::Entry* entry = pack->Find(key)) {
+                    ++s_PackReads;
+                    if (entry->compression != PackFile::Compression::None)
+                        s_DecompressedBytes += static_cast<size_t>(entry->size);
+                    return PackFile::Read(pack, *entry);
+                }
+            }
+        }
+
+        if (!s_LooseFilesEnabled)
+            throw std::runtime_error("File not found in mounted packs: " + path);
+        ++s_LooseReads;
+        auto file = std::make_shared<MappedFile>(path);
+        return FileView(file->Data(), file->Size(), file);
+    }
+
+    VirtualFileSystem::Stats VirtualFileSystem::GetStats() {
+        Stats stats;
+        stats.packReads = s_PackReads.load();
+        stats.looseReads = s_LooseReads.load();
+        stats.decompressedBytes = s_DecompressedBytes.load();
+        return stats;
+    }
+
+    void VirtualFileSystem::ResetStats() {
+        s_PackReads = 0;
+        s_LooseReads = 0;
+        s_DecompressedBytes = 0;
+    }
+
+} // namespace utils
@@ -0,0 +1,81 @@
+#include "resource/AssetCooker.h"
+#include "utils/PathResolver.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+    void PrintUsage() {
+        std::cout << "Usage: RrenderCook [options] [directories...]\n"
+                  << "  默认烘焙项目根目录下的 assets/ 与 shaders/\n"
+                  << "  --force        忽略依赖数据库，全部重新烘焙\n"
+                  << "  --hq           颜色贴图使用 BC7\n"
+                  << "  --threads N    烘焙线程数（默认全部核心）\n"
+                  << "  --db PATH      依赖数据库路径（默认 rrender_cook.db）\n"
+                  << "  --pack         烘焙后生成资源包（默认 rrender.rpak）\n"
+                  << "  --pack-file P  资源包输出路径\n"
+                  << "  --verbose      逐个输出烘焙结果\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    core::AssetCooker::Options options;
+    bool buildPack = false;
+    std::string packPath = core::AssetCooker::GetDefaultPackPath();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--force") == 0) {
+            options.force = true;
+        } else if (std::strcmp(argv[i], "--hq") == 0) {
+            options.highQuality = true;
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threadCount = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--db") == 0 && i + 1 < argc) {
+            options.databasePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--pack") == 0) {
+            buildPack = true;
+        } else if (std::strcmp(argv[i], "--pack-file") == 0 && i + 1 < argc) {
+            buildPack = true;
+            packPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--help") == 0 || argv[i][0] == '-') {
+            PrintUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : -1;
+        } else {
+            options.roots.push_back(argv[i]);
+        }
+    }
+    if (options.roots.empty()) {
+        options.roots.push_back(PathResolver::Resolve("assets"));
+        options.roots.push_back(PathResolver::Resolve("shaders"));
+    }
+
+    core::AssetCooker::Stats stats;
+    try {
+        stats = core::AssetCooker::Run(options);
+    } catch (const std::exception& e) {
+        std::cerr << "[Cook Error] " << e.what() << std::endl;
+        return -1;
+    }
+
+    std::cout << "[Cook] " << stats.scanned << " assets: " << stats.cooked << " cooked, " << stats.upToDate
+              << " up to date, " << stats.rehashed << " rehashed, " << stats.failed << " failed in "
+              << stats.totalMs << " ms (" << stats.inputBytes / (1024.0 * 1024.0) << " MB -> "
+              << stats.outputBytes / (1024.0 * 1024.0) << " MB)" << std::endl;
+    if (stats.failed > 0) return -1;
+
+    if (buildPack) {
+        try {
+            auto packStats = core::AssetCooker::BuildPack(options.roots, packPath);
+            std::cout << "[Cook] Packed " << packStats.fileCount << " files into " << packPath << " ("
+                      << packStats.originalBytes / (1024.0 * 1024.0) << " MB -> "
+                      << packStats.storedBytes / (1024.0 * 1024.0) << " MB)" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "[Cook Error] " << e.what() << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}